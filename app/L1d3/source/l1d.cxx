@@ -96,7 +96,11 @@ int main(int argc, char **argv)
     FILE *infile,                    /* beginning flow state         */
         *outfile,                    /* computed solution            */
         *hisfile1,                   /* single cell history          */
-        *hisfile2;                   /* x-location  history          */
+        *hisfile2,                   /* x-location  history          */
+        *idxfile,                    /* index of computed solutions  */
+        *hisidx1,                    /* index of cell history        */
+        *hisidx2;                    /* index of x-location history  */
+    int nsnapshot, nhistory;         /* records written so far       */
     int left_slug, right_slug, end_id;
     int left_slug_end, right_slug_end;
     double pressure, left_p, right_p, end_dx;
@@ -234,6 +238,9 @@ int main(int argc, char **argv)
     string oname = string(base_file_name) + ".Ls";
     string hname1 = string(base_file_name) + ".hc";
     string hname2 = string(base_file_name) + ".hx";
+    string xname = string(base_file_name) + ".Lsi";
+    string xname1 = string(base_file_name) + ".hci";
+    string xname2 = string(base_file_name) + ".hxi";
     string efname = string(base_file_name) + ".event";
     string dname = string(base_file_name) + ".dump";
 
@@ -366,6 +373,25 @@ int main(int argc, char **argv)
         printf("\nCould not open %s; BAILING OUT\n", hname2.c_str());
         return FAILURE;
     }
+    // The index files let the postprocessors seek directly to a
+    // particular solution time rather than reading from the start.
+    if ((idxfile = fopen(xname.c_str(), "w")) == NULL) {
+        printf("\nCould not open %s; BAILING OUT\n", xname.c_str());
+        return FAILURE;
+    }
+    if ((hisidx1 = fopen(xname1.c_str(), "w")) == NULL) {
+        printf("\nCould not open %s; BAILING OUT\n", xname1.c_str());
+        return FAILURE;
+    }
+    if ((hisidx2 = fopen(xname2.c_str(), "w")) == NULL) {
+        printf("\nCould not open %s; BAILING OUT\n", xname2.c_str());
+        return FAILURE;
+    }
+    L_write_index_header(idxfile, oname.c_str());
+    L_write_index_header(hisidx1, hname1.c_str());
+    L_write_index_header(hisidx2, hname2.c_str());
+    nsnapshot = 0;
+    nhistory = 0;
 
     newly_adapted = 0;
     step = 0;   /* Global Iteration Count    */
@@ -1012,14 +1038,19 @@ int main(int argc, char **argv)
         // 5a. Full flow along tube, diaphragm and piston states
         if ( SD.sim_time >= tplot ) {
             tplot += SD.get_dt_plot();
+            L_write_index_entry(idxfile, nsnapshot, A[0].sim_time, ftell(outfile));
+            ++nsnapshot;
             for (jp = 0; jp < SD.npiston; ++jp) Pist[jp].write_state(outfile);
             for (jd = 0; jd < SD.ndiaphragm; ++jd) Diaph[jd].write_state(outfile);
+            for (jv = 0; jv < SD.nvalve; ++jv) Valve[jv].write_state(outfile);
             for (js = 0; js < SD.nslug; ++js) A[js].write_state(outfile);
-            for (jv = 0; jv < SD.nvalve; ++jv) A[jv].write_state(outfile);
         }
         // 5b. Selected history points.
         if ( SD.sim_time >= thistory ) {
             thistory += SD.get_dt_history();
+            L_write_index_entry(hisidx1, nhistory, SD.sim_time, ftell(hisfile1));
+            L_write_index_entry(hisidx2, nhistory, SD.sim_time, ftell(hisfile2));
+            ++nhistory;
             fprintf(hisfile1, "%e %d %d %d # sim_time, hncell, nsp, nmodes\n", 
 		    SD.sim_time, SD.hncell, nsp, nmodes);
             for (js = 0; js < SD.nslug; ++js)
@@ -1102,6 +1133,7 @@ int main(int argc, char **argv)
 			    cfl_max, cfl_tiny, time_tiny );
     printf("\nTotal number of steps = %d\n", step);
 
+    L_write_index_entry(idxfile, nsnapshot, A[0].sim_time, ftell(outfile));
     for (jp = 0; jp < SD.npiston; ++jp) Pist[jp].write_state(outfile);
     for (jd = 0; jd < SD.ndiaphragm; ++jd) Diaph[jd].write_state(outfile);
     for (jv = 0; jv < SD.nvalve; ++jv) Valve[jv].write_state(outfile); 
@@ -1110,6 +1142,9 @@ int main(int argc, char **argv)
     if (outfile != NULL) fclose(outfile);
     if (hisfile1 != NULL) fclose(hisfile1);
     if (hisfile2 != NULL) fclose(hisfile2);
+    if (idxfile != NULL) fclose(idxfile);
+    if (hisidx1 != NULL) fclose(hisidx1);
+    if (hisidx2 != NULL) fclose(hisidx2);
 
     dispose_workspace_for_apply_rivp();
     Pist.clear();
@@ -226,8 +226,10 @@ int LCell::scan_iface_values_from_string(char *bufptr)
     char *cptr = strchr(bufptr, '\n');
     if ( cptr != NULL ) *cptr = '\0';
     // Now, we should have a string with only numbers separated by spaces.
-    x = atof(strtok( bufptr, " " )); // tokenize on space characters
-    area = atof(strtok( NULL, " " ));
+    // strtod() is used in preference to strtok() so that several
+    // solution files may be scanned concurrently.
+    x = strtod( bufptr, &cptr );
+    area = strtod( cptr, &cptr );
     return SUCCESS;
 } // end scan_iface_values_from_string()
 
@@ -275,27 +277,27 @@ int LCell::scan_cell_values_from_string(char *bufptr)
     char *cptr = strchr(bufptr, '\n');
     if ( cptr != NULL ) *cptr = '\0';
     // Now, we should have a string with only numbers separated by spaces.
-    xmid = atof(strtok( bufptr, " " )); // tokenize on space characters
-    volume = atof(strtok( NULL, " " ));
-    u = atof(strtok( NULL, " " ));
-    L_bar = atof(strtok( NULL, " " ));
-    gas->rho = atof(strtok( NULL, " " ));
-    gas->p = atof(strtok( NULL, " " ));
-    gas->a = atof(strtok( NULL, " " ));
-    shear_stress = atof(strtok( NULL, " " ));
-    heat_flux = atof(strtok( NULL, " " ));
-    entropy = atof(strtok( NULL, " " ));
+    xmid = strtod( bufptr, &cptr ); // numbers are separated by spaces
+    volume = strtod( cptr, &cptr );
+    u = strtod( cptr, &cptr );
+    L_bar = strtod( cptr, &cptr );
+    gas->rho = strtod( cptr, &cptr );
+    gas->p = strtod( cptr, &cptr );
+    gas->a = strtod( cptr, &cptr );
+    shear_stress = strtod( cptr, &cptr );
+    heat_flux = strtod( cptr, &cptr );
+    entropy = strtod( cptr, &cptr );
     size_t nsp = gas->massf.size();
     for ( size_t isp = 0; isp < nsp; ++isp ) {
-	gas->massf[isp] = atof(strtok( NULL, " " ));
+	gas->massf[isp] = strtod( cptr, &cptr );
     }
-    if ( nsp > 1 ) dt_chem = atof(strtok( NULL, " " ));
+    if ( nsp > 1 ) dt_chem = strtod( cptr, &cptr );
     size_t nmodes = gas->T.size();
     for ( size_t imode = 0; imode < nmodes; ++imode ) {
-	gas->e[imode] = atof(strtok( NULL, " " ));
-	gas->T[imode] = atof(strtok( NULL, " " ));
+	gas->e[imode] = strtod( cptr, &cptr );
+	gas->T[imode] = strtod( cptr, &cptr );
     }
-    if ( nmodes > 1 ) dt_therm = atof(strtok( NULL, " " ));
+    if ( nmodes > 1 ) dt_therm = strtod( cptr, &cptr );
     return SUCCESS;
 } // end scan_cell_values_from_string()
 
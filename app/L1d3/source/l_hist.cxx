@@ -18,6 +18,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 #include "../../../lib/util/source/useful.h"
 #include "l1d.hh"
 #include "l_kernel.hh"
@@ -232,6 +233,23 @@ int main(int argc, char **argv)
         exit(1);
     }   /* end if */
 
+    /*
+     * If l1d wrote an index for the history file, skip directly
+     * to the first record at or after the requested start time.
+     */
+    std::vector<double> t_index;
+    std::vector<long> offset_index;
+    strcat(iname, "i");
+    if ( tstart > 0.0 && L_read_index(iname, t_index, offset_index) == SUCCESS &&
+	 t_index.size() > 0 ) {
+	int irec = L_find_first_index_at_time(t_index, tstart);
+	if ( fseek(infile, offset_index[irec], SEEK_SET) == 0 ) {
+	    printf("Starting from record %d, t=%e\n", irec, t_index[irec]);
+	} else {
+	    rewind(infile);
+	}
+    }   /* end if */
+
     /*
      * Allocate memory in order to accumulate the history. 
      */
@@ -316,6 +334,7 @@ int main(int argc, char **argv)
      */
     printf( "Begin main loop.\n" );
     count = 0;
+    LCell* icell = new LCell(gmodel);
     for (i = 1; i <= maxsol; ++i) {
         /* 
          * Read the x-location or cell data from a single line.
@@ -347,7 +366,6 @@ int main(int argc, char **argv)
          * If we reached this point, the time-stamp was OK so
          * assume that all of the following lines are present. 
          */
-	LCell* icell = new LCell(gmodel);
         for (j = 0; j < hnloc; ++j) {
 	    if ( fgets(line, NCHAR, infile) == NULL ) {
 		printf("Problem reading file.\n");
@@ -474,6 +492,7 @@ int main(int argc, char **argv)
     }   /* end for i... */
 
     printf("Event count = %d, final t = %e\n", count, sim_time[count - 1]);
+    delete icell;
 
     if (infile != NULL)
         fclose(infile);
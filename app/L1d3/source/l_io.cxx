@@ -155,3 +155,143 @@ int L_write_x_history(double xloc, std::vector<GasSlug>& A, FILE* hisfile)
     fflush(hisfile);
     return SUCCESS;
 } // end function L_write_x_history
+
+
+int L_write_index_header(FILE* idxfile, const char* data_file_name)
+// Write the comment lines at the start of an index file.
+{
+    fprintf(idxfile, "# index for %s\n", data_file_name);
+    fprintf(idxfile, "# record sim_time byte_offset\n");
+    fflush(idxfile);
+    return SUCCESS;
+} // end function L_write_index_header
+
+
+int L_write_index_entry(FILE* idxfile, int nt, double sim_time, long offset)
+// Record the start of a snapshot (or history record) in the index file.
+// The time is written with the same format as the data files so that
+// selections made from the index agree with those made from the data.
+{
+    if ( idxfile == NULL ) return SUCCESS;
+    fprintf(idxfile, "%d %e %ld\n", nt, sim_time, offset);
+    fflush(idxfile);
+    return SUCCESS;
+} // end function L_write_index_entry
+
+
+int L_read_index(const char* idxname, std::vector<double>& t, std::vector<long>& offset)
+// Read an index file written by l1d.
+// Returns FILE_ERROR if the file cannot be opened and
+// BAD_INPUT_ERROR if the offsets are not increasing.
+{
+#   define NCHAR 132
+    char line[NCHAR];
+    int nt;
+    double tt;
+    long off;
+    FILE *idxfile;
+    t.clear();
+    offset.clear();
+    if ((idxfile = fopen(idxname, "r")) == NULL) {
+        return FILE_ERROR;
+    }
+    while ( fgets(line, NCHAR, idxfile) != NULL ) {
+	if ( line[0] == '#' ) continue;
+	if ( sscanf(line, "%d %lf %ld", &nt, &tt, &off) != 3 ) break;
+	if ( offset.size() > 0 && off <= offset.back() ) {
+	    printf("L_read_index(): offsets in %s are not increasing.\n", idxname);
+	    fclose(idxfile);
+	    return BAD_INPUT_ERROR;
+	}
+	t.push_back(tt);
+	offset.push_back(off);
+    }
+    fclose(idxfile);
+    return SUCCESS;
+#   undef NCHAR
+} // end function L_read_index
+
+
+int L_read_snapshot(FILE* infile, long offset, SimulationData& SD,
+		    std::vector<PistonData>& Pist, std::vector<DiaphragmData>& Diaph,
+		    std::vector<ValveData>& Valve, std::vector<GasSlug>& A)
+// Position the solution file at the start of a snapshot and read
+// the pistons, diaphragms, valves and gas slugs, in that order.
+// A negative offset reads from the current position.
+{
+    if ( offset >= 0 && fseek(infile, offset, SEEK_SET) != 0 ) {
+	printf("L_read_snapshot(): could not seek to offset %ld\n", offset);
+	return FAILURE;
+    }
+    for (int jp = 0; jp < SD.npiston; ++jp) {
+	if ( Pist[jp].read_state(infile) != SUCCESS ) return FAILURE;
+    }
+    for (int jd = 0; jd < SD.ndiaphragm; ++jd) {
+	if ( Diaph[jd].read_state(infile) != SUCCESS ) return FAILURE;
+    }
+    for (int jv = 0; jv < SD.nvalve; ++jv) {
+	if ( Valve[jv].read_state(infile) != SUCCESS ) return FAILURE;
+    }
+    for (int js = 0; js < SD.nslug; ++js) {
+	if ( A[js].read_state(infile) != SUCCESS ) return FAILURE;
+    }
+    return SUCCESS;
+} // end function L_read_snapshot
+
+
+int L_get_snapshot_index(const char* base_file_name, SimulationData& SD,
+			 std::vector<PistonData>& Pist, std::vector<DiaphragmData>& Diaph,
+			 std::vector<ValveData>& Valve, std::vector<GasSlug>& A,
+			 std::vector<double>& t, std::vector<long>& offset)
+// Get the time and byte offset of every snapshot in <base>.Ls.
+// The index file <base>.Lsi written by l1d is used if it is present and
+// consistent with the solution file, otherwise the solution file is
+// scanned once (using the supplied objects as workspace) and the index
+// is written so that subsequent post-processing runs can seek directly.
+{
+    string iname = string(base_file_name) + ".Ls";
+    string xname = string(base_file_name) + ".Lsi";
+    FILE *infile;
+    if ((infile = fopen(iname.c_str(), "r")) == NULL) {
+        printf("\nCould not open %s\n", iname.c_str());
+        return FILE_ERROR;
+    }
+    fseek(infile, 0, SEEK_END);
+    long file_size = ftell(infile);
+    if ( L_read_index(xname.c_str(), t, offset) == SUCCESS &&
+	 offset.size() > 0 && offset.back() < file_size ) {
+	fclose(infile);
+	return SUCCESS;
+    }
+    printf("Building snapshot index %s\n", xname.c_str());
+    t.clear();
+    offset.clear();
+    rewind(infile);
+    while ( 1 ) {
+	long off = ftell(infile);
+	if ( L_read_snapshot(infile, -1, SD, Pist, Diaph, Valve, A) != SUCCESS ) break;
+	t.push_back(A[0].sim_time);
+	offset.push_back(off);
+    }
+    fclose(infile);
+    FILE *idxfile;
+    if ((idxfile = fopen(xname.c_str(), "w")) != NULL) {
+	L_write_index_header(idxfile, iname.c_str());
+	for ( size_t i = 0; i < t.size(); ++i ) {
+	    L_write_index_entry(idxfile, (int) i, t[i], offset[i]);
+	}
+	fclose(idxfile);
+    }
+    return SUCCESS;
+} // end function L_get_snapshot_index
+
+
+int L_find_first_index_at_time(std::vector<double>& t, double t_select)
+// Returns the first record with time at or beyond t_select,
+// or the last record if the selected time is never reached.
+{
+    for ( size_t i = 0; i < t.size(); ++i ) {
+	if ( t[i] >= t_select ) return (int) i;
+    }
+    return (int) t.size() - 1;
+} // end function L_find_first_index_at_time
@@ -21,4 +21,19 @@ int log_event( const char* efname, const char* event_message );
 int L_write_cell_history(GasSlug& A, FILE * hisfile);
 int L_write_x_history(double xloc, std::vector<GasSlug>& A, FILE* hisfile);
 
+// Snapshot index files (<base>.Lsi, <base>.hci, <base>.hxi) hold one line
+// per record of the corresponding data file: record number, sim_time and
+// the byte offset at which that record starts.
+int L_write_index_header(FILE* idxfile, const char* data_file_name);
+int L_write_index_entry(FILE* idxfile, int nt, double sim_time, long offset);
+int L_read_index(const char* idxname, std::vector<double>& t, std::vector<long>& offset);
+int L_read_snapshot(FILE* infile, long offset, SimulationData& SD,
+		    std::vector<PistonData>& Pist, std::vector<DiaphragmData>& Diaph,
+		    std::vector<ValveData>& Valve, std::vector<GasSlug>& A);
+int L_get_snapshot_index(const char* base_file_name, SimulationData& SD,
+			 std::vector<PistonData>& Pist, std::vector<DiaphragmData>& Diaph,
+			 std::vector<ValveData>& Valve, std::vector<GasSlug>& A,
+			 std::vector<double>& t, std::vector<long>& offset);
+int L_find_first_index_at_time(std::vector<double>& t, double t_select);
+
 #endif
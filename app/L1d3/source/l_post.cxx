@@ -198,9 +198,16 @@ int main(int argc, char **argv)
     int nsp = gmodel->get_number_of_species();
 
     /*
-     * Read and discard solutions until the requested solution
-     * time is exceeded.
+     * Find the first solution at or beyond the requested time
+     * in the snapshot index and read just that solution.
      */
+    std::vector<double> t_index;
+    std::vector<long> offset_index;
+    if ( L_get_snapshot_index(base_file_name, SD, Pist, Diaph, Valve, A,
+			      t_index, offset_index) != SUCCESS ) {
+        printf("\nCould not index the solution file; BAILING OUT\n");
+        exit(1);
+    }
     strcpy(iname, base_file_name);
     strcat(iname, ".Ls");
     printf("infile       : %s\n", iname);
@@ -209,19 +216,12 @@ int main(int argc, char **argv)
         exit(1);
     }
     found_solution = 0;
-    for (i = 1; i <= max_sol; ++i) {
-        printf(".");
-        fflush(stdout);
-        for (jp = 0; jp < SD.npiston; ++jp) Pist[jp].read_state(infile);
-        for (jd = 0; jd < SD.ndiaphragm; ++jd) Diaph[jd].read_state(infile);
-	for (jv = 0; jv < SD.nvalve; ++jv) Valve[jv].read_state(infile);
-        for (js = 0; js < SD.nslug; ++js) A[js].read_state(infile);
-        if (A[0].sim_time >= tstop) {
-            found_solution = 1;
-            break;
-        }
-    }   /* end for i ... */
-    printf("\n");
+    i = L_find_first_index_at_time(t_index, tstop);
+    if ( i >= 0 && i < max_sol && t_index[i] >= tstop ) {
+	if ( L_read_snapshot(infile, offset_index[i], SD, Pist, Diaph, Valve, A) == SUCCESS ) {
+	    found_solution = 1;
+	}
+    }
     if (infile != NULL)
         fclose(infile);
 
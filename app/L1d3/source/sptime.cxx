@@ -15,6 +15,9 @@
  * \version 6.1 --  17-Nov-02, Jan Martinez-Schramm added TECPLOT output
  * \version 24-Jul-06, C++ port.
  * \version 29-Oct-13, Stefan Brieschenk added acoustic impedance output option.
+ * \version 18-Oct-26, Snapshots are located via the <base>.Lsi index and
+ *                     decoded in parallel; several variables may be
+ *                     selected and are written in the one pass.
  */
 
 /*-----------------------------------------------------------------*/
@@ -24,37 +27,67 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
-#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_thread_num() 0
+#define omp_get_max_threads() 1
+#endif
 #include "../../../lib/util/source/useful.h"
 #include "../../../lib/util/source/config_parser.hh"
 #include "l1d.hh"
 #include "l_kernel.hh"
 #include "l_diaph.hh"
 #include "l_piston.hh"
+#include "l_valve.hh"
 #include "l_cell.hh"
 #include "l_io.hh"
 
+#define  SELECT_RHO  1
+#define  SELECT_U    2
+#define  SELECT_E    3
+#define  SELECT_P    4
+#define  SELECT_A    5
+#define  SELECT_T    6
+#define  SELECT_TAU  7
+#define  SELECT_Q    8
+#define  SELECT_S    9
+#define  SELECT_Z    10
+#define  SELECT_Ma   11
+
+double select_value(int option, LCell& c);
+int write_space_time_file(const char* base_file_name, int option, int takelog,
+			  int tecplot_format, int nslug, int nt_write,
+			  std::vector<int>& nnx_initial,
+			  std::vector< std::vector<double> >& xarray,
+			  std::vector< std::vector<double> >& tarray,
+			  std::vector< std::vector<double> >& varray);
+
 /*-----------------------------------------------------------------*/
 
 int main(int argc, char **argv)
 {
-    int js, jp, jd;
+    int js, jp, jd, jv;
     vector<int> nnx_initial;
     std::vector<GasSlug> A;               /* several gas slugs        */
     std::vector<PistonData> Pist;          /* room for several pistons */
     std::vector<DiaphragmData> Diaph;      /* diaphragms            */
+    std::vector<ValveData> Valve;          /* valves                */
 
     double tstart, tstop;
-    int i, max_sol, tecplot_format;
-    char oname[40], pname[40], iname[40];
-    char base_file_name[32], name_tag[10];
-    FILE *infile,            /* flow solution file           */
-        *outfile;           /* plot file                    */
-    char var_name[132],var_name_tec[132];
+    int i, max_sol, tecplot_format, nthreads;
+    char pname[40], iname[40];
+    char base_file_name[32];
 
-#   define  BLOCKS  10
-    double **xarray[BLOCKS], **tarray[BLOCKS], **varray[BLOCKS];
-    int nt, nt_read, nt_write, ix, nx, nxtot, option;
+    /*
+     * The data is accumulated as [slug][snapshot][point] for x and t
+     * and as [variable][slug][snapshot * nnx_initial + point] for the
+     * selected flow variables.
+     */
+    std::vector< std::vector<double> > xarray, tarray;
+    std::vector< std::vector< std::vector<double> > > varray;
+    std::vector<int> options;
+    int nt, nt_write, ix, nx, option, iv, nvar;
     int takelog;
     int found, ixmin, ixmax;
     double dx, xloc, xL, xR;
@@ -78,18 +111,7 @@ int main(int argc, char **argv)
     tstop = 0.0;
     takelog = 0;
     tecplot_format = 0;
-#   define  SELECT_RHO  1
-#   define  SELECT_U    2
-#   define  SELECT_E    3
-#   define  SELECT_P    4
-#   define  SELECT_A    5
-#   define  SELECT_T    6
-#   define  SELECT_TAU  7
-#   define  SELECT_Q    8
-#   define  SELECT_S    9
-#   define  SELECT_Z    10
-#   define  SELECT_Ma   11
-    option = SELECT_P;
+    nthreads = 0;
     echo_input = 0;
 
     /*
@@ -105,7 +127,7 @@ int main(int argc, char **argv)
     i = 1;
     while (i < argc) {
         /* process the next command-line argument */
-
+	option = 0;
         if (strcmp(argv[i], "-f") == 0) {
             /* Set the base file name. */
             i++;
@@ -150,6 +172,16 @@ int main(int argc, char **argv)
             sscanf(argv[i], "%d", &max_sol);
             i++;
             printf("Setting max_sol = %d\n", max_sol);
+        } else if (strcmp(argv[i], "-nthreads") == 0) {
+            /* Set the number of threads used to decode the solutions. */
+            i++;
+            if (i >= argc) {
+                command_line_error = 1;
+                goto usage;
+            }
+            sscanf(argv[i], "%d", &nthreads);
+            i++;
+            printf("Setting nthreads = %d\n", nthreads);
         } else if (strcmp(argv[i], "-tecplot") == 0) {
             tecplot_format = 1;
             i++;
@@ -169,7 +201,7 @@ int main(int argc, char **argv)
         } else if (strcmp(argv[i], "-tau") == 0) {
             option = SELECT_TAU;
             i++;
-            printf("Density, option = %d.\n", option);
+            printf("Shear stress, option = %d.\n", option);
         } else if (strcmp(argv[i], "-u") == 0) {
             option = SELECT_U;
             i++;
@@ -211,7 +243,16 @@ int main(int argc, char **argv)
             command_line_error = 1;
             goto usage;
         }   /* end if */
+	if ( option != 0 ) {
+	    /* Variables may be selected more than once; keep just one copy. */
+	    found = 0;
+	    for (iv = 0; iv < (int) options.size(); ++iv) {
+		if ( options[iv] == option ) found = 1;
+	    }
+	    if ( !found ) options.push_back(option);
+	}
     }   /* end while */
+    if ( options.size() == 0 ) options.push_back(SELECT_P);
 
     /*
      * If the command line arguments are incorrect,
@@ -221,14 +262,16 @@ int main(int argc, char **argv)
     if (command_line_error == 1) {
         printf("Purpose:\n");
         printf("Pick up a solution file <base_file_name>.Ls, select one\n");
-        printf("of the flow variables and then either save the x-t data\n");
+        printf("or more of the flow variables and then save the x-t data\n");
         printf
-            ("for that variable in a format suitable for contour plotting.\n");
+            ("for each variable in a format suitable for contour plotting.\n");
         printf
             ("When reformatting, a logarithmic scale can be used, however,\n");
         printf
             ("taking the logarithm of velocity or shear stress is probably\n");
         printf("a bad idea.\n");
+        printf("The snapshot index <base_file_name>.Lsi is used to locate the\n");
+        printf("solutions; it is rebuilt if missing.\n");
         printf("\n");
 
         printf("Command-line options: (defaults are shown in parentheses)\n");
@@ -237,14 +280,16 @@ int main(int argc, char **argv)
         printf("-tstart <time>            (0.0)\n");
         printf("-tstop <time>             (0.0)\n");
         printf("-maxsol <n>               (%d)\n", max_sol);
+        printf("-nthreads <n>             (all available)\n");
         printf("-log                      (linear)\n");
         printf("-tecplot                  (generic)\n");
         printf("-help                     (print this message)\n");
-        printf("To select a variable, pick one of:\n");
+        printf("To select variables, pick one or more of:\n");
         printf("-p -rho -u -e -T -a -q -tau -S -Z -Ma   (default is -p)\n");
         printf("\n");
         exit(1);
     }   /* end if command_line_error */
+    nvar = (int) options.size();
 
     /*
      * * Read the input parameter file.
@@ -263,120 +308,109 @@ int main(int argc, char **argv)
         Diaph.push_back(DiaphragmData(jd, pname, echo_input));
         Diaph[jd].sim_time = 0.0;
     }
+    for (jv = 0; jv < SD.nvalve; ++jv) {
+        Valve.push_back(ValveData(jv, pname, echo_input));
+        Valve[jv].sim_time = 0.0;
+    }
     for (js = 0; js < SD.nslug; ++js) {
         A.push_back(GasSlug(js, SD, pname, echo_input));
         A[js].sim_time = 0.0;
         nnx_initial[js] = A[js].nnx;
     }
 
+    /*
+     * Select the solutions to be processed from the snapshot index.
+     * We start at the first solution at or after tstart and stop
+     * after the first solution at or after tstop.
+     */
+    std::vector<double> t_index;
+    std::vector<long> offset_index;
+    if ( L_get_snapshot_index(base_file_name, SD, Pist, Diaph, Valve, A,
+			      t_index, offset_index) != SUCCESS ) {
+        printf("\nCould not index the solution file; BAILING OUT\n");
+        exit(1);
+    }
+    std::vector<long> selected;
+    for (nt = 0; nt < (int) t_index.size(); ++nt) {
+	if ( t_index[nt] < tstart ) continue;
+	selected.push_back(offset_index[nt]);
+	if ( t_index[nt] >= tstop || (int) selected.size() >= max_sol ) break;
+    }
+    nt_write = (int) selected.size();
+    printf("Number of solutions in file: %d\n", (int) t_index.size());
+    printf("Number of solutions selected: %d\n", nt_write);
+
     /*
      * Allocate enough memory to accumulate the data.
      */
+    xarray.resize(SD.nslug);
+    tarray.resize(SD.nslug);
+    varray.resize(nvar);
     for (js = 0; js < SD.nslug; ++js) {
-        if ((xarray[js] = (double **) calloc(max_sol,sizeof(double *)))
-            == NULL) {
-            printf("Memory alloc problem.\n");
-            exit(-1);
-        }   /* end if */
-        if ((tarray[js] = (double **) calloc(max_sol,sizeof(double *)))
-            == NULL) {
-            printf("Memory alloc problem.\n");
-            exit(-1);
-        }   /* end if */
-        if ((varray[js] = (double **) calloc(max_sol,sizeof(double *)))
-            == NULL) {
-            printf("Memory alloc problem.\n");
-            exit(-1);
-        }   /* end if */
-        for (nt = 0; nt < max_sol; ++nt) {
-            nxtot = nnx_initial[js];
-            if ((xarray[js][nt] = (double *) calloc(nxtot,sizeof(double)))
-                == NULL) {
-                printf("Memory alloc problem.\n");
-                exit(-1);
-            }   /* end if */
-            if ((tarray[js][nt] = (double *) calloc(nxtot,sizeof(double)))
-                == NULL) {
-                printf("Memory alloc problem.\n");
-                exit(-1);
-            }   /* end if */
-            if ((varray[js][nt] = (double *) calloc(nxtot,sizeof(double)))
-                == NULL) {
-                printf("Memory alloc problem.\n");
-                exit(-1);
-            }   /* end if */
-        }   /* end for (nt = 0;...  */
-
-    }   /* end for (js = 0;...  */
+	xarray[js].resize(nt_write * nnx_initial[js]);
+	tarray[js].resize(nt_write * nnx_initial[js]);
+    }
+    for (iv = 0; iv < nvar; ++iv) {
+	varray[iv].resize(SD.nslug);
+	for (js = 0; js < SD.nslug; ++js) {
+	    varray[iv][js].resize(nt_write * nnx_initial[js]);
+	}
+    }
 
     /*
-     * Read all of the solutions and save the requested data.
+     * Each thread works with its own copy of the pistons, diaphragms,
+     * valves and slugs, and its own handle on the solution file.
      */
+    if ( nthreads < 1 ) nthreads = omp_get_max_threads();
+    if ( nthreads > nt_write ) nthreads = (nt_write > 0) ? nt_write : 1;
     strcpy(iname, base_file_name);
     strcat(iname, ".Ls");
     printf("infile       : %s\n", iname);
-    if ((infile = fopen(iname, "r")) == NULL) {
-        printf("\nCould not open %s; BAILING OUT\n", iname);
-        exit(1);
-    }   /* end if */
+    std::vector<FILE *> infile(nthreads);
+    std::vector< std::vector<PistonData> > Pist_t(nthreads, Pist);
+    std::vector< std::vector<DiaphragmData> > Diaph_t(nthreads, Diaph);
+    std::vector< std::vector<ValveData> > Valve_t(nthreads, Valve);
+    std::vector< std::vector<GasSlug> > A_t(nthreads, A);
+    std::vector<LCell *> icell(nthreads);
+    for (i = 0; i < nthreads; ++i) {
+	if ((infile[i] = fopen(iname, "r")) == NULL) {
+	    printf("\nCould not open %s; BAILING OUT\n", iname);
+	    exit(1);
+	}   /* end if */
+	icell[i] = new LCell(gmodel);
+    }
 
-    nt_write = 0;
-    nt_read  = 0;
-    for (nt = 0; nt < max_sol; ++nt) {
-        for (jp = 0; jp < SD.npiston; ++jp) Pist[jp].read_state(infile);
-        for (jd = 0; jd < SD.ndiaphragm; ++jd) Diaph[jd].read_state(infile);
-        for (js = 0; js < SD.nslug; ++js) A[js].read_state(infile);
-	++nt_read;
-
-	if ( A[0].sim_time < tstart ) {
-	    /* Don't add this solution to our collection, continue reading. */
-	    printf(".");
-	    fflush(stdout);
+    int read_error = 0;
+#   ifdef _OPENMP
+#   pragma omp parallel for private(nt, js, ix, nx, iv, ixmin, ixmax, xL, xR, dx, xloc, found) schedule(dynamic) num_threads(nthreads)
+#   endif
+    for (nt = 0; nt < nt_write; ++nt) {
+	int ithread = omp_get_thread_num();
+	std::vector<GasSlug> &B = A_t[ithread];
+	if ( L_read_snapshot(infile[ithread], selected[nt], SD, Pist_t[ithread],
+			     Diaph_t[ithread], Valve_t[ithread], B) != SUCCESS ) {
+#           ifdef _OPENMP
+#           pragma omp atomic
+#           endif
+	    read_error += 1;
 	    continue;
-        }
+	}
 
         for (js = 0; js < SD.nslug; ++js) {
-            if (A[js].adaptive == 0) {
+	    int n0 = nt * nnx_initial[js];
+            if (B[js].adaptive == 0) {
                 /*
                  * For a slug with constant number of cells, 
                  * use individual cell data.
                  */
                 nx = 0;
-                for (ix = A[js].ixmin; ix <= A[js].ixmax; ++ix) {
-                    xarray[js][nt_write][nx] = 0.5 *
-                        (A[js].Cell[ix - 1].x + A[js].Cell[ix].x);
-                    tarray[js][nt_write][nx] = A[js].sim_time;
-                    if (option == SELECT_RHO) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].gas->rho;
-                    } else if (option == SELECT_U) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].u;
-                    } else if (option == SELECT_E) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].gas->e[0]; // FIX-ME -- should also process other modes
-                    } else if (option == SELECT_P) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].gas->p;
-                    } else if (option == SELECT_A) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].gas->a;
-                    } else if (option == SELECT_T) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].gas->T[0]; // FIX-ME -- should also process other modes
-                    } else if (option == SELECT_TAU) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].shear_stress;
-                    } else if (option == SELECT_Q) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].heat_flux;
-                    } else if (option == SELECT_S) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].entropy;
-                    } else if (option == SELECT_Z) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].gas->rho*A[js].Cell[ix].gas->a;
-                    } else if (option == SELECT_Ma) {
-                        varray[js][nt_write][nx] = A[js].Cell[ix].u/A[js].Cell[ix].gas->a;
-		    } else {
-                        printf("Invalid option: start again.\n");
-                        exit(-1);
-                    }   /* end if */
-
-                    if (takelog == 1) {
-                        varray[js][nt_write][nx] = log10(fmax(fabs(varray[js][nt_write][nx]),1.0e-30));
-                    }
-                    /* end if */
+                for (ix = B[js].ixmin; ix <= B[js].ixmax; ++ix) {
+                    xarray[js][n0 + nx] = 0.5 *
+                        (B[js].Cell[ix - 1].x + B[js].Cell[ix].x);
+                    tarray[js][n0 + nx] = B[js].sim_time;
+		    for (iv = 0; iv < nvar; ++iv) {
+			varray[iv][js][n0 + nx] = select_value(options[iv], B[js].Cell[ix]);
+		    }
                     ++nx;
                 }   /* end for ix */
             } else {
@@ -385,69 +419,101 @@ int main(int argc, char **argv)
                  * interpolate the data from the actual cells onto
                  * an evenly distributed number of points.
                  */
-		LCell* icell = new LCell(gmodel);
-                ixmin = A[js].ixmin;
-                ixmax = A[js].ixmax;
-                xL = 0.5 * (A[js].Cell[ixmin - 1].x + A[js].Cell[ixmin].x);
-                xR = 0.5 * (A[js].Cell[ixmax - 1].x + A[js].Cell[ixmax].x);
+                ixmin = B[js].ixmin;
+                ixmax = B[js].ixmax;
+                xL = 0.5 * (B[js].Cell[ixmin - 1].x + B[js].Cell[ixmin].x);
+                xR = 0.5 * (B[js].Cell[ixmax - 1].x + B[js].Cell[ixmax].x);
                 dx = (xR - xL) / (nnx_initial[js] - 1);
                 for (nx = 0; nx < nnx_initial[js]; ++nx) {
                     xloc = xL + dx * nx;
-                    found = A[js].interpolate_cell_data(xloc, *icell);
+		    /* The interpolation evaluates the (shared) gas model. */
+#                   ifdef _OPENMP
+#                   pragma omp critical
+#                   endif
+                    found = B[js].interpolate_cell_data(xloc, *icell[ithread]);
 		    if ( !found ) {
 			printf("Warning: interpolate_cell_data failed for xloc=%g\n", xloc);
 		    }
-                    xarray[js][nt_write][nx] = xloc;
-                    tarray[js][nt_write][nx] = A[js].sim_time;
-                    if (option == SELECT_RHO) {
-                        varray[js][nt_write][nx] = icell->gas->rho;
-                    } else if (option == SELECT_U) {
-                        varray[js][nt_write][nx] = icell->u;
-                    } else if (option == SELECT_E) {
-                        varray[js][nt_write][nx] = icell->gas->e[0]; // FIX-ME -- should also process other modes
-                    } else if (option == SELECT_P) {
-                        varray[js][nt_write][nx] = icell->gas->p;
-                    } else if (option == SELECT_A) {
-                        varray[js][nt_write][nx] = icell->gas->a;
-                    } else if (option == SELECT_T) {
-                        varray[js][nt_write][nx] = icell->gas->T[0]; // FIX-ME -- should also process other modes
-                    } else if (option == SELECT_TAU) {
-                        varray[js][nt_write][nx] = icell->shear_stress;
-                    } else if (option == SELECT_Q) {
-                        varray[js][nt_write][nx] = icell->heat_flux;
-                    } else if (option == SELECT_S) {
-                        varray[js][nt_write][nx] = icell->entropy;
-                    } else if (option == SELECT_Z) {
-                        varray[js][nt_write][nx] = icell->gas->rho*icell->gas->a;
-                    } else if (option == SELECT_Ma) {
-                        varray[js][nt_write][nx] = icell->u/icell->gas->a;
-                    } else {
-                        printf("Invalid option: start again.\n");
-                        exit(-1);
-                    }   /* end if */
-
-                    if (takelog == 1) {
-                        varray[js][nt_write][nx] = log10(fmax(fabs(varray[js][nt_write][nx]),1.0e-30));
-                    }   /* end if */
+                    xarray[js][n0 + nx] = xloc;
+                    tarray[js][n0 + nx] = B[js].sim_time;
+		    for (iv = 0; iv < nvar; ++iv) {
+			varray[iv][js][n0 + nx] = select_value(options[iv], *icell[ithread]);
+		    }
                 }   /* end for */
             }   /* end if */
         }   /* end for js */
 
-	printf("%%");
-	fflush(stdout);
-        ++nt_write;
-
-        if (A[0].sim_time >= tstop || nt_write >= max_sol)
-            break;
+	if ( takelog == 1 ) {
+	    for (iv = 0; iv < nvar; ++iv) {
+		for (js = 0; js < SD.nslug; ++js) {
+		    for (nx = 0; nx < nnx_initial[js]; ++nx) {
+			double &v = varray[iv][js][nt * nnx_initial[js] + nx];
+			v = log10(fmax(fabs(v),1.0e-30));
+		    }
+		}
+	    }
+	}
     }   /* end for nt... */
 
-    printf("\n");
-    if (infile != NULL) fclose(infile);
-    printf("Number of solutions read: %d\n", nt_read);
-    printf("Final time = %g\n", A[0].sim_time);
-
+    for (i = 0; i < nthreads; ++i) {
+	if (infile[i] != NULL) fclose(infile[i]);
+	delete icell[i];
+    }
+    if ( read_error > 0 ) {
+	printf("Failed to read %d of the selected solutions; BAILING OUT\n", read_error);
+	exit(1);
+    }
+    if ( nt_write > 0 ) {
+	printf("Final time = %g\n", tarray[0][(nt_write - 1) * nnx_initial[0]]);
+    }
 
     printf("Now, write out the contouring data.\n");
+    for (iv = 0; iv < nvar; ++iv) {
+	write_space_time_file(base_file_name, options[iv], takelog, tecplot_format,
+			      SD.nslug, nt_write, nnx_initial, xarray, tarray, varray[iv]);
+    }
+    printf("Number of solutions written: %d\n", nt_write);
+
+    return 0;
+}   /* end function main */
+
+/*-----------------------------------------------------------------*/
+
+double select_value(int option, LCell& c)
+// Pick the requested flow variable out of a cell.
+{
+    switch ( option ) {
+    case SELECT_RHO: return c.gas->rho;
+    case SELECT_U: return c.u;
+    case SELECT_E: return c.gas->e[0]; // FIX-ME -- should also process other modes
+    case SELECT_P: return c.gas->p;
+    case SELECT_A: return c.gas->a;
+    case SELECT_T: return c.gas->T[0]; // FIX-ME -- should also process other modes
+    case SELECT_TAU: return c.shear_stress;
+    case SELECT_Q: return c.heat_flux;
+    case SELECT_S: return c.entropy;
+    case SELECT_Z: return c.gas->rho * c.gas->a;
+    case SELECT_Ma: return c.u / c.gas->a;
+    default:
+	printf("Invalid option: start again.\n");
+	exit(-1);
+    }
+    return 0.0;
+} // end select_value()
+
+
+int write_space_time_file(const char* base_file_name, int option, int takelog,
+			  int tecplot_format, int nslug, int nt_write,
+			  std::vector<int>& nnx_initial,
+			  std::vector< std::vector<double> >& xarray,
+			  std::vector< std::vector<double> >& tarray,
+			  std::vector< std::vector<double> >& varray)
+// Write the x-t data for one variable to <base>_<tag>.gen (or .plt).
+{
+    char oname[40], name_tag[10];
+    char var_name[132],var_name_tec[132];
+    FILE *outfile;
+    int js, nx, nt;
 
     strcpy(oname, base_file_name);
     if (takelog == 1) {
@@ -514,7 +580,7 @@ int main(int argc, char **argv)
 
     if ((outfile = fopen(oname, "w")) == NULL) {
         printf("\nCould not open %s; BAILING OUT\n", oname);
-        exit(-1);
+        return FILE_ERROR;
     }   /* end if */
     if ( tecplot_format ) {
 	fprintf(outfile, "TITLE=\"L1D:Space-time plot\"\n");
@@ -526,10 +592,10 @@ int main(int argc, char **argv)
 	fprintf(outfile, "x,m\n");
 	fprintf(outfile, "t,s\n");
 	fprintf(outfile, "%s\n", var_name );
-	fprintf(outfile, "%d   <== number of slugs\n", SD.nslug);
+	fprintf(outfile, "%d   <== number of slugs\n", nslug);
     }
 
-    for (js = 0; js < SD.nslug; ++js) {
+    for (js = 0; js < nslug; ++js) {
 	if ( tecplot_format ) {
 	    fprintf(outfile, "ZONE T=\"SLUG-%0d\"\n",js);
 	    fprintf(outfile, "I=%d, J=%d, K=1, F=POINT\n", 
@@ -540,16 +606,15 @@ int main(int argc, char **argv)
 	}
         for (nx = 0; nx < nnx_initial[js]; ++nx) {
             for (nt = 0; nt < nt_write; ++nt) {
-                fprintf(outfile, "%e %e %e\n", xarray[js][nt][nx],
-                        tarray[js][nt][nx], varray[js][nt][nx]);
+		int n = nt * nnx_initial[js] + nx;
+                fprintf(outfile, "%e %e %e\n", xarray[js][n],
+                        tarray[js][n], varray[js][n]);
             }   /* end for nt */
         }   /* end for nx */
     }   /* end for (js = 0;... */
 
     if (outfile != NULL) fclose(outfile);
-    printf("Number of solutions written: %d\n", nt_write);
-
-    return 0;
-}   /* end function main */
+    return SUCCESS;
+} // end write_space_time_file()
 
 /*================ end of sptime.c =================*/
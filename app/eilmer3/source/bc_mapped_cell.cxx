@@ -100,6 +100,31 @@ MappedCellBC::MappedCellBC(Block *bdp, int which_boundary,
     fstrm.close();
 }
 
+/// \brief The ghost cell that receives the data of mapped_cells[ghost_cell_index].
+///
+/// The mapped cells are listed in the order in which they are read from the file
+/// by the constructor above: two ghost cells (inner first) for each boundary cell,
+/// with the first index of the boundary varying fastest.
+FV_Cell *mapped_ghost_cell(Block &bd, int which_boundary, size_t ghost_cell_index)
+{
+    size_t ghost_cell_count = ghost_cell_index % 2 + 1;
+    size_t n = ghost_cell_index / 2;
+    switch ( which_boundary ) {
+    case NORTH:
+	return bd.get_cell(bd.imin + n % bd.nni, bd.jmax + ghost_cell_count, bd.kmin + n / bd.nni);
+    case SOUTH:
+	return bd.get_cell(bd.imin + n % bd.nni, bd.jmin - ghost_cell_count, bd.kmin + n / bd.nni);
+    case EAST:
+	return bd.get_cell(bd.imax + ghost_cell_count, bd.jmin + n % bd.nnj, bd.kmin + n / bd.nnj);
+    case WEST:
+	return bd.get_cell(bd.imin - ghost_cell_count, bd.jmin + n % bd.nnj, bd.kmin + n / bd.nnj);
+    case TOP:
+	return bd.get_cell(bd.imin + n % bd.nni, bd.jmin + n / bd.nni, bd.kmax + ghost_cell_count);
+    default:
+	return bd.get_cell(bd.imin + n % bd.nni, bd.jmin + n / bd.nni, bd.kmin - ghost_cell_count);
+    }
+} // end mapped_ghost_cell()
+
 MappedCellBC::MappedCellBC(const MappedCellBC &bc)
     : BoundaryCondition(bc.bdp, bc.which_boundary, bc.type_code) 
 {
@@ -28,4 +28,6 @@ public:
     // default apply_viscous() (does nothing)
 };
 
+FV_Cell *mapped_ghost_cell(Block &bd, int which_boundary, size_t ghost_cell_index);
+
 #endif
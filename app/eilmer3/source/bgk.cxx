@@ -4,6 +4,7 @@
 ///
 /// \author DB
 /// \version 14-Sep-12 initial coding
+/// \version 19-Oct-26 velocity-space kernels for the discrete-velocity update
 
 #include <math.h>
 
@@ -35,3 +36,67 @@ Vector3 Shakhov(double rho, double U, double V, double T, double qx, double qy,
 
     return gh;
 }
+
+/// \brief The reduced Shakhov distributions for all of the discrete velocities.
+///
+/// Same model as above, evaluated for the nv velocities (u[i],v[i]) into g and h.
+void Shakhov(double rho, double U, double V, double T, double qx, double qy, double R, double Pr,
+	     size_t nv, const double *u, const double *v, double *g, double *h)
+{
+    double RT = R*T;
+    double RT3 = RT*RT*RT;
+    double A = rho/(2.0*M_PI);
+    double B = -1.0/(2.0*RT);
+    double C = (Pr - 1)/(5*RT3*rho);
+    BGK_SIMD
+    for ( size_t i = 0; i < nv; ++i ) {
+	double uU = u[i] - U;
+	double vV = v[i] - V;
+	double UV = uU*uU + vV*vV;
+	double EXP = A*exp(B*UV);
+	double Q = C*(qx*uU + qy*vV);
+	g[i] = (1/RT)*EXP*(1 - Q*(UV-4*RT));
+	h[i] = EXP*(1 - Q*(UV-2*RT));
+    }
+}
+
+/// \brief Density, velocity and specific total energy from the reduced distributions.
+///
+/// w holds the quadrature weights of the discrete velocities.
+/// The energy includes the contribution of the reduced degree of freedom, h/2.
+void BGK_moments(size_t nv, const double *u, const double *v, const double *w,
+		 const double *g, const double *h,
+		 double &rho, double &U, double &V, double &E)
+{
+    double m0 = 0.0, mu = 0.0, mv = 0.0, me = 0.0;
+    BGK_SIMD_SUM(m0,mu,mv,me)
+    for ( size_t i = 0; i < nv; ++i ) {
+	double wg = w[i]*g[i];
+	m0 += wg;
+	mu += u[i]*wg;
+	mv += v[i]*wg;
+	me += 0.5*((u[i]*u[i] + v[i]*v[i])*wg + w[i]*h[i]);
+    }
+    rho = m0;
+    U = mu/m0;
+    V = mv/m0;
+    E = me/m0;
+}
+
+/// \brief Heat-flux vector from the reduced distributions, about the velocity (U,V).
+void BGK_heat_flux(size_t nv, const double *u, const double *v, const double *w,
+		   const double *g, const double *h, double U, double V,
+		   double &qx, double &qy)
+{
+    double sx = 0.0, sy = 0.0;
+    BGK_SIMD_SUM(sx,sy)
+    for ( size_t i = 0; i < nv; ++i ) {
+	double uU = u[i] - U;
+	double vV = v[i] - V;
+	double e = 0.5*w[i]*((uU*uU + vV*vV)*g[i] + h[i]);
+	sx += uU*e;
+	sy += vV*e;
+    }
+    qx = sx;
+    qy = sy;
+}
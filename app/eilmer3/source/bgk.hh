@@ -4,16 +4,39 @@
  * 
  * \author DB
  * \version 14-Sep-12 initial coding
+ * \version 19-Oct-26 velocity-space kernels for the discrete-velocity update
  */
 
 
 #ifndef BGK_HH
 #define BGK_HH
 
+#include <cstddef>
 #include "../../../lib/geometry2/source/geom.hh"
 
+// The loops over the velocity buckets carry no dependencies between buckets,
+// so we ask the compiler to vectorise them where OpenMP 4 is available.
+#if defined(_OPENMP) && _OPENMP >= 201307
+#   define BGK_STR(x) #x
+#   define BGK_SIMD _Pragma("omp simd")
+#   define BGK_SIMD_SUM(...) _Pragma(BGK_STR(omp simd reduction(+:__VA_ARGS__)))
+#else
+#   define BGK_SIMD
+#   define BGK_SIMD_SUM(...)
+#endif
+
 Vector3 Shakhov(double rho, double U, double V, double T, 
 		double qx, double q, double R, double Pr,
 		double u, double v);
+void Shakhov(double rho, double U, double V, double T,
+	     double qx, double qy, double R, double Pr,
+	     size_t nv, const double *u, const double *v,
+	     double *g, double *h);
+void BGK_moments(size_t nv, const double *u, const double *v, const double *w,
+		 const double *g, const double *h,
+		 double &rho, double &U, double &V, double &E);
+void BGK_heat_flux(size_t nv, const double *u, const double *v, const double *w,
+		   const double *g, const double *h, double U, double V,
+		   double &qx, double &qy);
 
 #endif
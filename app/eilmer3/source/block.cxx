@@ -45,6 +45,8 @@ Block::Block(const Block &b)
       jmin(b.jmin), jmax(b.jmax),
       kmin(b.kmin), kmax(b.kmax),
       active_cells(b.active_cells),
+      exchange_send_cells(b.exchange_send_cells),
+      exchange_ghost_cells(b.exchange_ghost_cells),
       bcp(b.bcp),
       ctr_(b.ctr_),
       ifi_(b.ifi_), ifj_(b.ifj_), ifk_(b.ifk_),
@@ -70,6 +72,8 @@ Block & Block::operator=(const Block &b)
 	jmin = b.jmin; jmax = b.jmax;
 	kmin = b.kmin; kmax = b.kmax;
 	active_cells = b.active_cells;
+	exchange_send_cells = b.exchange_send_cells;
+	exchange_ghost_cells = b.exchange_ghost_cells;
 	bcp = b.bcp;
 	ctr_ = b.ctr_;
 	ifi_ = b.ifi_; ifj_ = b.ifj_; ifk_ = b.ifk_;
@@ -182,6 +186,10 @@ int Block::array_cleanup(size_t dimensions)
     sifj_.clear();
     sifk_.clear();
     active_cells.clear();
+    active_gas_states.clear();
+    exchange_send_cells.clear();
+    exchange_ghost_cells.clear();
+    release_flow_state_snapshot();
     return SUCCESS;
 } // end of array_cleanup()
 
@@ -232,6 +240,102 @@ int Block::bind_interfaces_to_cells( size_t dimensions )
     return SUCCESS;
 } // end bind_interfaces_to_cells()
 
+// Each boundary face is indexed by (p,q) along two of the block index
+// directions: (i,k) on NORTH and SOUTH, (j,k) on EAST and WEST and (i,j)
+// on TOP and BOTTOM.  Looking out of the block, these axes are right-handed
+// on EAST, SOUTH and TOP and left-handed on the other faces.
+static void face_extents(const Block &bd, int bndry, size_t &np, size_t &nq)
+{
+    switch ( bndry ) {
+    case NORTH: case SOUTH: np = bd.nni; nq = bd.nnk; break;
+    case EAST: case WEST: np = bd.nnj; nq = bd.nnk; break;
+    default: np = bd.nni; nq = bd.nnj;
+    }
+}
+
+static bool face_is_right_handed(int bndry)
+{
+    return bndry == EAST || bndry == SOUTH || bndry == TOP;
+}
+
+// The cell at (p,q) on the face, depth cells in from the boundary.
+// A depth of 0 is the active cell against the boundary and
+// negative depths are the ghost cells outside it.
+static FV_Cell *face_cell(Block &bd, int bndry, size_t p, size_t q, int depth)
+{
+    switch ( bndry ) {
+    case NORTH: return bd.get_cell(bd.imin+p, bd.jmax-depth, bd.kmin+q);
+    case SOUTH: return bd.get_cell(bd.imin+p, bd.jmin+depth, bd.kmin+q);
+    case EAST: return bd.get_cell(bd.imax-depth, bd.jmin+p, bd.kmin+q);
+    case WEST: return bd.get_cell(bd.imin+depth, bd.jmin+p, bd.kmin+q);
+    case TOP: return bd.get_cell(bd.imin+p, bd.jmin+q, bd.kmax-depth);
+    default: return bd.get_cell(bd.imin+p, bd.jmin+q, bd.kmin+depth);
+    }
+}
+
+/// \brief Build the lists of cells for the exchange of data with adjacent blocks.
+///
+/// The send list of a boundary holds the two layers of active cells next
+/// to it, boundary layer first, and (p,q) in row-major order within a layer.
+/// The ghost-cell list holds our ghost cells in the order of the send list
+/// of the neighbour face, taking account of its orientation, so that the
+/// shared-memory copy and the MPI buffers are straight loops over the lists.
+/// Only our own block is needed, so this works when the neighbour is on
+/// another MPI process.  Call after array_alloc() and the setting of the
+/// boundary conditions.
+int Block::build_exchange_maps(size_t dimensions)
+{
+    const size_t nlayer = 2;
+    int nbndry = (dimensions == 3) ? 6 : 4;
+    exchange_send_cells.assign(N_INTERFACE, std::vector<FV_Cell *>());
+    exchange_ghost_cells.assign(N_INTERFACE, std::vector<FV_Cell *>());
+    for ( int bndry = 0; bndry < nbndry; ++bndry ) {
+	if ( bcp[bndry]->neighbour_block < 0 ) continue;
+	int other_face = bcp[bndry]->neighbour_face;
+	int orientation = (dimensions == 3) ? bcp[bndry]->neighbour_orientation : 0;
+	if ( other_face < 0 || other_face >= nbndry || orientation < 0 || orientation > 3 ) {
+	    cerr << "build_exchange_maps(): block " << id << " boundary " << bndry
+		 << " has invalid neighbour face " << other_face
+		 << " or orientation " << orientation << endl;
+	    return VALUE_ERROR;
+	}
+	size_t np, nq;
+	face_extents(*this, bndry, np, nq);
+	std::vector<FV_Cell *> &send = exchange_send_cells[bndry];
+	std::vector<FV_Cell *> &ghost = exchange_ghost_cells[bndry];
+	for ( size_t layer = 0; layer < nlayer; ++layer ) {
+	    for ( size_t p = 0; p < np; ++p ) {
+		for ( size_t q = 0; q < nq; ++q ) {
+		    send.push_back(face_cell(*this, bndry, p, q, layer));
+		}
+	    }
+	}
+	// Our face position (p,q) sits against (a,b) on the neighbour face.
+	// Each orientation is a quarter turn of the neighbour face; where the
+	// two faces have the same handedness, there is also a reflection.
+	int turn = face_is_right_handed(bndry) ? (4 - orientation) % 4 : orientation;
+	bool swap = (turn == 1 || turn == 3);
+	bool reverse_a = (turn == 1 || turn == 2);
+	bool reverse_b = (turn == 2 || turn == 3);
+	if ( face_is_right_handed(bndry) == face_is_right_handed(other_face) ) reverse_a = !reverse_a;
+	size_t na = swap ? nq : np;
+	size_t nb = swap ? np : nq;
+	ghost.resize(nlayer * np * nq);
+	for ( size_t layer = 0; layer < nlayer; ++layer ) {
+	    for ( size_t p = 0; p < np; ++p ) {
+		for ( size_t q = 0; q < nq; ++q ) {
+		    size_t a = swap ? q : p;
+		    size_t b = swap ? p : q;
+		    if ( reverse_a ) a = na - 1 - a;
+		    if ( reverse_b ) b = nb - 1 - b;
+		    ghost[layer*na*nb + a*nb + b] = face_cell(*this, bndry, p, q, -static_cast<int>(layer)-1);
+		}
+	    }
+	}
+    }
+    return SUCCESS;
+} // end build_exchange_maps()
+
 
 /// \brief Set the base heat source values for this block.
 int Block::set_base_qdot(global_data &gd, size_t gtl)
@@ -362,6 +466,25 @@ int Block::clear_fluxes_of_conserved_quantities(size_t dimensions)
     return SUCCESS;
 }
 
+/// \brief Fill in the gas states of the active cells after their conserved
+///        quantities have been decoded with FV_Cell::decode_conserved_deferred().
+///
+/// Each property is evaluated for the whole block in one call to the
+/// gas model, so that models with a batched evaluation can use it.
+int Block::eval_gas_state_of_active_cells()
+{
+    global_data &G = *get_global_data_ptr();
+    Gas_model *gmodel = get_gas_model_ptr();
+    active_gas_states.clear();
+    for ( FV_Cell *cp: active_cells ) active_gas_states.push_back(cp->fs->gas);
+    gmodel->eval_thermo_state_rhoe_batch(active_gas_states);
+    if ( G.viscous ) gmodel->eval_transport_coefficients_batch(active_gas_states);
+    if ( G.diffusion ) {
+	for ( Gas_data *gas: active_gas_states ) gmodel->eval_diffusion_coefficients(*gas);
+    }
+    return SUCCESS;
+} // end eval_gas_state_of_active_cells()
+
 int Block::propagate_data_west_to_east(size_t dimensions)
 // Propagate data from the west ghost cell, right across the block.
 // This is a useful starting state for the block-sequenced calculation
@@ -457,6 +580,53 @@ int Block::count_invalid_cells(size_t dimensions, size_t gtl)
 } // end of count_invalid_cells()
 
 
+int Block::save_flow_state_snapshot()
+/// \brief Copy the flow state of each active cell into flow_state_snapshot.
+///
+/// The snapshot storage is allocated on first use and whenever the number
+/// of active cells changes (as it does when the grid level is swapped).
+{
+    if ( flow_state_snapshot.size() != active_cells.size() ) {
+	release_flow_state_snapshot();
+	flow_state_snapshot.reserve(active_cells.size());
+	for ( FV_Cell *cellp: active_cells ) {
+	    flow_state_snapshot.push_back(new FlowState(*(cellp->fs)));
+	}
+	return SUCCESS;
+    }
+    for ( size_t n = 0; n < active_cells.size(); ++n ) {
+	flow_state_snapshot[n]->copy_values_from(*(active_cells[n]->fs));
+    }
+    return SUCCESS;
+} // end of save_flow_state_snapshot()
+
+
+int Block::restore_flow_state_snapshot()
+/// \brief Put the flow state saved by save_flow_state_snapshot() back into the cells.
+///
+/// This is the same state that decoding U[0] would give, but without
+/// evaluating the equation of state and transport coefficients again.
+{
+    if ( flow_state_snapshot.size() != active_cells.size() ) {
+	throw std::runtime_error("Block::restore_flow_state_snapshot(): "
+				 "no snapshot of the current active cells for block "+
+				 tostring(id)+".");
+    }
+    for ( size_t n = 0; n < active_cells.size(); ++n ) {
+	active_cells[n]->fs->copy_values_from(*(flow_state_snapshot[n]));
+    }
+    return SUCCESS;
+} // end of restore_flow_state_snapshot()
+
+
+int Block::release_flow_state_snapshot()
+{
+    for ( FlowState *fsp: flow_state_snapshot ) delete fsp;
+    flow_state_snapshot.clear();
+    return SUCCESS;
+} // end of release_flow_state_snapshot()
+
+
 int Block::init_residuals(size_t dimensions)
 /// \brief Initialization of data for later computing residuals.
 {
@@ -519,6 +689,7 @@ int Block::determine_time_step_size()
 /// \brief Compute the local time step limit for all cells in the block.
 ///
 /// The overall time step is limited by the worst-case cell.
+/// Each cell also keeps its own recommended time step, for local time stepping.
 /// \returns 0 on success, DT_SEARCH_FAILED otherwise.
 ///
 /// \verbatim
@@ -554,6 +725,7 @@ int Block::determine_time_step_size()
 	signal = cp->signal_frequency(gdp->dimensions, with_k_omega);
 	cfl_local = gdp->dt_global * signal; // Current (Local) CFL number
 	dt_local = gdp->cfl_target / signal; // Recommend a time step size.
+	cp->dt_local = dt_local;
 	if ( first ) {
 	    cfl_min = cfl_local;
 	    cfl_max = cfl_local;
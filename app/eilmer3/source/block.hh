@@ -81,6 +81,39 @@ public:
     size_t kmin, kmax;
 
     std::vector<FV_Cell *> active_cells; // to be used in range for statements.
+    // Gas states of the active cells, gathered for the batched gas-model calls.
+    std::vector<Gas_data *> active_gas_states;
+
+    // Cells taking part in the exchange with adjacent blocks, indexed by boundary.
+    // exchange_send_cells[bndry] holds the two layers of active cells next to
+    // the boundary in the standard order (see build_exchange_maps) and
+    // exchange_ghost_cells[bndry] holds our ghost cells in the order of the
+    // neighbour's send list, so that an exchange is a copy along the lists.
+    std::vector<std::vector<FV_Cell *> > exchange_send_cells;
+    std::vector<std::vector<FV_Cell *> > exchange_ghost_cells;
+
+    // Flow state of the active cells, in the order of active_cells, as it was
+    // at the start of the current step, so that a failed attempt at the step
+    // can be undone by copying rather than decoding the conserved quantities.
+    std::vector<FlowState *> flow_state_snapshot;
+
+    // Discrete velocity distributions for the BGK solver, held contiguously
+    // as [cell][velocity] for all cells (ghost cells included) in the order
+    // of to_global_index(), together with their rates of change.
+    // The velocities and weights are copied out of the global set so that
+    // the loops over velocity read plain arrays.
+    std::vector<double> bgk_G, bgk_H, bgk_dGdt, bgk_dHdt;
+    std::vector<double> bgk_u, bgk_v, bgk_w;
+    // Gas constant and Prandtl number of each active cell (i varying fastest)
+    // from the serial gas-model pass of BGK_update().
+    std::vector<double> bgk_R, bgk_Pr;
+    // Kinetic wall conditions, indexed by boundary: the fraction of molecules
+    // re-emitted diffusely (0 for a specular wall, negative where the boundary
+    // is not a wall), the wall temperature and, where there is specular
+    // reflection, the index of the mirror-image velocity for each velocity
+    // at each interface along the boundary, as [interface][velocity].
+    std::vector<double> bgk_wall_sigma, bgk_wall_T;
+    std::vector<std::vector<size_t> > bgk_mirror;
 
     // boundary-condition object pointers.
     std::vector<BoundaryCondition *> bcp;
@@ -143,12 +176,17 @@ public:
     int array_alloc(size_t dimensions);
     int array_cleanup(size_t dimensions);
     int bind_interfaces_to_cells(size_t dimensions);
+    int build_exchange_maps(size_t dimensions);
     int set_base_qdot(global_data &gdp, size_t gtl); 
     int identify_reaction_zones(global_data &gdp, size_t gtl);
     int identify_turbulent_zones(global_data &gdp, size_t gtl);
     int clear_fluxes_of_conserved_quantities(size_t dimensions);
+    int eval_gas_state_of_active_cells();
     int propagate_data_west_to_east(size_t dimensions);
     int count_invalid_cells(size_t dimensions, size_t gtl);
+    int save_flow_state_snapshot();
+    int restore_flow_state_snapshot();
+    int release_flow_state_snapshot();
     int init_residuals(size_t dimensions);
     int compute_residuals(size_t dimensions, size_t gtl);
     int determine_time_step_size();
@@ -185,8 +223,11 @@ public:
 		   bool zip_file=true, size_t gtl=0);
     int read_solution(std::string filename, double *sim_time, size_t dimensions,
 		      bool zip_file=true, size_t gtl=0);
+    int read_solution_from_string(const std::string &text, double *sim_time,
+				  size_t dimensions, size_t gtl=0);
     int write_solution(std::string filename, double sim_time, size_t dimensions,
 		       bool zip_file=true, size_t gtl=0);
+    int write_solution_to_string(std::string &text, double sim_time, size_t gtl=0);
     int write_profile(std::string filename, int which_face, double sim_time,
 		      bool write_header=false, size_t gtl=0);
     int write_history(std::string filename, double sim_time,
@@ -203,6 +244,19 @@ public:
     int initialise_BGK_equilibrium( void );
     int write_BGK(std::string filename, double sim_time, 
 		  size_t dimensions, bool zip_file=true);
+    int allocate_BGK_storage(size_t dimensions);
+    int copy_BGK_from_cells( void );
+    int copy_BGK_to_cells( void );
+    int set_up_BGK_walls( void );
+    int fill_BGK_ghost_cells( void );
+    int BGK_update(double dt);
+    double BGK_allowable_dt(double cfl);
+
+    // in block_grid_levels.cxx
+    void swap_grid_level(Block &other);
+    int coarsen_grid_from(Block &fine, size_t stride, size_t dimensions);
+    int restrict_flow_from(Block &fine, size_t stride, size_t dimensions);
+    int prolong_flow_from(Block &coarse, size_t dimensions);
 
     // in block_filter.cxx
     int apply_spatial_filter_diffusion( double alpha, size_t npass, size_t dimensions );
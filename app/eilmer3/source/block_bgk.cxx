@@ -3,6 +3,8 @@
 /// \brief Daryl Bond's BGK-specific functions that work on the block data.
 ///
 /// \version 23-Mar-2013 extracted from block.cxx
+/// \version 19-Oct-2026 discrete-velocity update on contiguous distributions
+/// \version 19-Oct-2026 specular and diffuse kinetic walls
 ///
 
 #include <string>
@@ -12,6 +14,8 @@
 #include <sstream>
 #include <stdio.h>
 #include <unistd.h>
+#include <math.h>
+#include <algorithm>
 extern "C" {
 #include <zlib.h>
 }
@@ -19,6 +23,9 @@ extern "C" {
 #include "kernel.hh"
 #include "block.hh"
 #include "bc.hh"
+#include "bc_fixed_t.hh"
+#include "bc_jump_wall.hh"
+#include "bgk.hh"
 
 //-----------------------------------------------------------------------------
 
@@ -191,3 +198,456 @@ int Block::write_BGK( std::string filename, double sim_time, size_t dimensions,
     return SUCCESS;
 } // end of Block::write_BGK()
 
+
+//-----------------------------------------------------------------------------
+// The discrete-velocity update.
+//
+// The distributions live in the block's contiguous arrays while the solution
+// is advanced; the vectors G and H of each cell's FlowState are used only
+// to exchange data with neighbouring blocks and to read and write files.
+// The update is for two-dimensional planar flow and is first-order in
+// space and time: upwind kinetic fluxes through the cell interfaces
+// followed by an implicit relaxation toward the Shakhov distribution.
+
+/// \brief Set up the contiguous storage for the distributions.
+int Block::allocate_BGK_storage(size_t dimensions)
+{
+    global_data &G = *get_global_data_ptr();
+    size_t nv = get_velocity_buckets();
+    if ( nv == 0 || dimensions != 2 || G.axisymmetric ) {
+	cerr << "allocate_BGK_storage(): block " << id << ": the BGK update is "
+	     << "available only for two-dimensional planar flow with a velocity set." << endl;
+	return FAILURE;
+    }
+    // The distributions carry the viscous and heat-conduction effects
+    // themselves, so a separate viscous update would count them twice.
+    // The chemistry, thermal-exchange and turbulence updates act on the
+    // macroscopic flow state, which the distributions would then overwrite.
+    if ( (G.viscous && G.separate_update_for_viscous_terms) ||
+	 G.turbulence_model != TM_NONE || G.reacting || G.thermal_energy_exchange ) {
+	cerr << "allocate_BGK_storage(): block " << id << ": the BGK update cannot be "
+	     << "combined with a separate viscous update or with turbulent, "
+	     << "reacting or thermal-exchange runs." << endl;
+	return FAILURE;
+    }
+    // Kinetic walls: SLIP_WALL reflects specularly, FIXED_T re-emits
+    // diffusely at the wall temperature and JUMP_WALL mixes the two
+    // with its accommodation coefficient (Maxwell's model).
+    bgk_wall_sigma.assign(4, -1.0);
+    bgk_wall_T.assign(4, 0.0);
+    bgk_mirror.assign(4, std::vector<size_t>());
+    for ( int face = NORTH; face <= WEST; ++face ) {
+	BoundaryCondition *bc = bcp[face];
+	if ( !bc->is_wall() ) continue;
+	if ( bc->type_code == SLIP_WALL ) {
+	    bgk_wall_sigma[face] = 0.0;
+	} else if ( bc->type_code == FIXED_T ) {
+	    bgk_wall_sigma[face] = 1.0;
+	    bgk_wall_T[face] = dynamic_cast<FixedTBC *>(bc)->Twall;
+	} else if ( bc->type_code == JUMP_WALL ) {
+	    JumpWallBC *jbc = dynamic_cast<JumpWallBC *>(bc);
+	    bgk_wall_sigma[face] = jbc->sigma_jump;
+	    bgk_wall_T[face] = jbc->Twall;
+	} else {
+	    cerr << "allocate_BGK_storage(): block " << id << ", " << get_face_name(face)
+		 << " boundary: the BGK update has kinetic walls only for SLIP_WALL, "
+		 << "FIXED_T and JUMP_WALL boundaries." << endl;
+	    return FAILURE;
+	}
+	if ( bgk_wall_sigma[face] < 0.0 || bgk_wall_sigma[face] > 1.0 ) {
+	    cerr << "allocate_BGK_storage(): block " << id << ", " << get_face_name(face)
+		 << " boundary: the accommodation coefficient must be in [0,1]." << endl;
+	    return FAILURE;
+	}
+    }
+    std::vector<Vector3> &vc = *get_vcoords_ptr();
+    std::vector<double> &vw = *get_vweights_ptr();
+    bgk_u.resize(nv); bgk_v.resize(nv); bgk_w.resize(nv);
+    for ( size_t iv = 0; iv < nv; ++iv ) {
+	bgk_u[iv] = vc[iv].x;
+	bgk_v[iv] = vc[iv].y;
+	bgk_w[iv] = vw[iv];
+    }
+    size_t n = nidim * njdim * nkdim * nv;
+    bgk_G.assign(n, 0.0); bgk_H.assign(n, 0.0);
+    bgk_dGdt.assign(n, 0.0); bgk_dHdt.assign(n, 0.0);
+    bgk_R.assign(nni*nnj, 0.0); bgk_Pr.assign(nni*nnj, 0.0);
+    return SUCCESS;
+} // end of Block::allocate_BGK_storage()
+
+
+/// \brief Load the distributions of the active cells into the contiguous arrays.
+int Block::copy_BGK_from_cells( void )
+{
+    size_t nv = bgk_u.size();
+    for ( size_t k = kmin; k <= kmax; ++k ) {
+	for ( size_t j = jmin; j <= jmax; ++j ) {
+	    for ( size_t i = imin; i <= imax; ++i ) {
+		size_t gid = to_global_index(i,j,k);
+		FlowState &fs = *(ctr_[gid]->fs);
+		std::copy(fs.G.begin(), fs.G.end(), bgk_G.begin() + gid*nv);
+		std::copy(fs.H.begin(), fs.H.end(), bgk_H.begin() + gid*nv);
+	    }
+	}
+    }
+    return SUCCESS;
+} // end of Block::copy_BGK_from_cells()
+
+
+/// \brief Put the distributions of the active cells back into the cells' flow states,
+/// ready for an exchange with neighbouring blocks or for writing.
+int Block::copy_BGK_to_cells( void )
+{
+    size_t nv = bgk_u.size();
+    for ( size_t k = kmin; k <= kmax; ++k ) {
+	for ( size_t j = jmin; j <= jmax; ++j ) {
+	    for ( size_t i = imin; i <= imax; ++i ) {
+		size_t gid = to_global_index(i,j,k);
+		FlowState &fs = *(ctr_[gid]->fs);
+		std::copy(bgk_G.begin() + gid*nv, bgk_G.begin() + (gid+1)*nv, fs.G.begin());
+		std::copy(bgk_H.begin() + gid*nv, bgk_H.begin() + (gid+1)*nv, fs.H.begin());
+	    }
+	}
+    }
+    return SUCCESS;
+} // end of Block::copy_BGK_to_cells()
+
+
+namespace {
+    // Interface on a boundary and the cells either side of it,
+    // for the m-th position along the boundary.
+    // out is +1 where the interface normal points out of the block.
+    FV_Interface *BGK_boundary_interface(Block &bd, int face, size_t m,
+					 size_t &inside, size_t &ghost, double &out)
+    {
+	size_t i, j;
+	FV_Interface *iface;
+	switch ( face ) {
+	case NORTH:
+	    i = bd.imin+m; j = bd.jmax; iface = bd.get_ifj(i, j+1);
+	    inside = bd.to_global_index(i, j, bd.kmin); ghost = bd.to_global_index(i, j+1, bd.kmin);
+	    out = 1.0; break;
+	case EAST:
+	    i = bd.imax; j = bd.jmin+m; iface = bd.get_ifi(i+1, j);
+	    inside = bd.to_global_index(i, j, bd.kmin); ghost = bd.to_global_index(i+1, j, bd.kmin);
+	    out = 1.0; break;
+	case SOUTH:
+	    i = bd.imin+m; j = bd.jmin; iface = bd.get_ifj(i, j);
+	    inside = bd.to_global_index(i, j, bd.kmin); ghost = bd.to_global_index(i, j-1, bd.kmin);
+	    out = -1.0; break;
+	default:
+	    i = bd.imin; j = bd.jmin+m; iface = bd.get_ifi(i, j);
+	    inside = bd.to_global_index(i, j, bd.kmin); ghost = bd.to_global_index(i-1, j, bd.kmin);
+	    out = -1.0;
+	}
+	return iface;
+    }
+
+    // Index of the velocity that is the mirror image of each velocity in the
+    // wall with unit normal (nx,ny).  Returns false if the velocity set is not
+    // symmetric about the wall, in position and in quadrature weight.
+    bool BGK_mirror_velocities(size_t nv, const double *u, const double *v, const double *w,
+			       double nx, double ny, size_t *mirror)
+    {
+	double c_max = 0.0;
+	for ( size_t iv = 0; iv < nv; ++iv ) c_max = std::max(c_max, fabs(u[iv]) + fabs(v[iv]));
+	double tol = 1.0e-6 * c_max;
+	for ( size_t iv = 0; iv < nv; ++iv ) {
+	    double cn = u[iv]*nx + v[iv]*ny;
+	    double ur = u[iv] - 2.0*cn*nx;
+	    double vr = v[iv] - 2.0*cn*ny;
+	    size_t best = 0;
+	    double d_best = 1.0e300;
+	    for ( size_t jv = 0; jv < nv; ++jv ) {
+		double d = fabs(u[jv] - ur) + fabs(v[jv] - vr);
+		if ( d < d_best ) { d_best = d; best = jv; }
+	    }
+	    if ( d_best > tol || fabs(w[best] - w[iv]) > 1.0e-9 * w[iv] ) return false;
+	    mirror[iv] = best;
+	}
+	return true;
+    }
+}
+
+/// \brief Find the mirror-image velocities for the walls that reflect specularly.
+///
+/// Needs the interface normals, so it is called after the geometry is computed.
+/// Neighbouring interfaces along a straight wall share the same map.
+int Block::set_up_BGK_walls( void )
+{
+    size_t nv = bgk_u.size();
+    for ( int face = NORTH; face <= WEST; ++face ) {
+	if ( !(bgk_wall_sigma[face] >= 0.0 && bgk_wall_sigma[face] < 1.0) ) continue;
+	size_t n = ( face == NORTH || face == SOUTH ) ? nni : nnj;
+	std::vector<size_t> &mirror = bgk_mirror[face];
+	mirror.resize(n*nv);
+	Vector3 n_prev(0.0, 0.0, 0.0);
+	for ( size_t m = 0; m < n; ++m ) {
+	    size_t inside, ghost;
+	    double out;
+	    FV_Interface *iface = BGK_boundary_interface(*this, face, m, inside, ghost, out);
+	    if ( m > 0 && fabs(iface->n.x - n_prev.x) + fabs(iface->n.y - n_prev.y) < 1.0e-12 ) {
+		std::copy(mirror.begin() + (m-1)*nv, mirror.begin() + m*nv, mirror.begin() + m*nv);
+	    } else if ( !BGK_mirror_velocities(nv, &bgk_u[0], &bgk_v[0], &bgk_w[0],
+					       iface->n.x, iface->n.y, &mirror[m*nv]) ) {
+		cerr << "set_up_BGK_walls(): block " << id << ", " << get_face_name(face)
+		     << " boundary: specular reflection needs a velocity set that is "
+		     << "symmetric about the wall." << endl;
+		return FAILURE;
+	    }
+	    n_prev = iface->n;
+	}
+    }
+    return SUCCESS;
+} // end of Block::set_up_BGK_walls()
+
+
+/// \brief Set the distributions in the first layer of ghost cells.
+///
+/// Across a connection to another block, the ghost cells already hold
+/// the neighbour's distributions (exchanged with the flow state).
+/// At a wall, the ghost-cell distribution supplies the molecules leaving
+/// the (stationary) wall: those arriving at a specular wall come back with
+/// their normal velocity reversed, while a diffuse wall re-emits them as
+/// a Maxwellian at the wall temperature, with its density set so that
+/// no mass passes through the wall.  A fraction sigma of the molecules
+/// is re-emitted diffusely and the rest specularly.
+/// Elsewhere, the boundary condition has set the macroscopic state of the
+/// ghost cell and we use the equilibrium distribution for that state.
+int Block::fill_BGK_ghost_cells( void )
+{
+    Gas_model *gmodel = get_gas_model_ptr();
+    size_t nv = bgk_u.size();
+    const double *u = &bgk_u[0];
+    const double *v = &bgk_v[0];
+    const double *w = &bgk_w[0];
+    std::vector<double> g_wall(nv), h_wall(nv);
+    for ( int face = NORTH; face <= WEST; ++face ) {
+	bc_t type = bcp[face]->type_code;
+	bool exchanged = ( type == ADJACENT || type == ADJACENT_PLUS_UDF || type == MAPPED_CELL );
+	double sigma = bgk_wall_sigma[face];
+	size_t n = ( face == NORTH || face == SOUTH ) ? nni : nnj;
+	for ( size_t m = 0; m < n; ++m ) {
+	    size_t inside, gid;
+	    double out;
+	    FV_Interface *iface = BGK_boundary_interface(*this, face, m, inside, gid, out);
+	    FlowState &fs = *(ctr_[gid]->fs);
+	    double *g = &bgk_G[gid*nv];
+	    double *h = &bgk_H[gid*nv];
+	    int status;
+	    if ( exchanged ) {
+		std::copy(fs.G.begin(), fs.G.end(), g);
+		std::copy(fs.H.begin(), fs.H.end(), h);
+	    } else if ( sigma >= 0.0 ) {
+		const double *gi = &bgk_G[inside*nv];
+		const double *hi = &bgk_H[inside*nv];
+		double nx = out * iface->n.x;
+		double ny = out * iface->n.y;
+		double rho_w = 0.0;
+		if ( sigma > 0.0 ) {
+		    // Unit-density Maxwellian at the wall, scaled to balance
+		    // the mass flux arriving at the wall.
+		    double R = gmodel->R(*(ctr_[inside]->fs->gas), status);
+		    Shakhov(1.0, 0.0, 0.0, bgk_wall_T[face], 0.0, 0.0, R, 1.0,
+			    nv, u, v, &g_wall[0], &h_wall[0]);
+		    double arriving = 0.0, leaving = 0.0;
+		    for ( size_t iv = 0; iv < nv; ++iv ) {
+			double cn = u[iv]*nx + v[iv]*ny;
+			if ( cn > 0.0 ) arriving += w[iv]*cn*gi[iv];
+			else leaving -= w[iv]*cn*g_wall[iv];
+		    }
+		    rho_w = ( leaving > 0.0 ) ? arriving / leaving : 0.0;
+		}
+		const size_t *mirror = ( sigma < 1.0 ) ? &bgk_mirror[face][m*nv] : 0;
+		for ( size_t iv = 0; iv < nv; ++iv ) {
+		    double gs = 0.0, hs = 0.0;
+		    if ( mirror ) { gs = gi[mirror[iv]]; hs = hi[mirror[iv]]; }
+		    g[iv] = (1.0 - sigma)*gs + sigma*rho_w*g_wall[iv];
+		    h[iv] = (1.0 - sigma)*hs + sigma*rho_w*h_wall[iv];
+		}
+	    } else {
+		double R = gmodel->R(*(fs.gas), status);
+		Shakhov(fs.gas->rho, fs.vel.x, fs.vel.y, fs.gas->T[0], 0.0, 0.0, R, 1.0,
+			nv, u, v, g, h);
+	    }
+	}
+    }
+    return SUCCESS;
+} // end of Block::fill_BGK_ghost_cells()
+
+
+namespace {
+    // Upwind kinetic flux of the distributions through one interface,
+    // accumulated into the rates of change of the cells either side.
+    // aL and aR are the interface area divided by the cell volumes
+    // (zero for a ghost cell, whose rates are not wanted).
+    void BGK_interface_flux(size_t nv, const double *u, const double *v,
+			    double nx, double ny, double aL, double aR,
+			    const double *gL, const double *hL,
+			    const double *gR, const double *hR,
+			    double *dgL, double *dhL, double *dgR, double *dhR)
+    {
+	BGK_SIMD
+	for ( size_t iv = 0; iv < nv; ++iv ) {
+	    double cn = u[iv]*nx + v[iv]*ny;
+	    double cp = 0.5*(cn + fabs(cn));
+	    double cm = cn - cp;
+	    double fg = cp*gL[iv] + cm*gR[iv];
+	    double fh = cp*hL[iv] + cm*hR[iv];
+	    dgL[iv] -= aL*fg; dhL[iv] -= aL*fh;
+	    dgR[iv] += aR*fg; dhR[iv] += aR*fh;
+	}
+    }
+}
+
+/// \brief Advance the distributions of the active cells by dt and
+/// recover the macroscopic flow state of each cell.
+///
+/// The ghost cells must have been filled first.
+/// Returns FAILURE if any cell ends up with non-physical moments.
+int Block::BGK_update(double dt)
+{
+    Gas_model *gmodel = get_gas_model_ptr();
+    size_t nv = bgk_u.size();
+    const double *u = &bgk_u[0];
+    const double *v = &bgk_v[0];
+    const double *w = &bgk_w[0];
+    std::fill(bgk_dGdt.begin(), bgk_dGdt.end(), 0.0);
+    std::fill(bgk_dHdt.begin(), bgk_dHdt.end(), 0.0);
+
+    // 1. Fluxes through the i-faces, one row of cells per thread,
+    //    then through the j-faces, one column per thread.
+    int jj, ii;
+#   ifdef _OPENMP
+#   pragma omp parallel for private(jj) schedule(static)
+#   endif
+    for ( jj = static_cast<int>(jmin); jj <= static_cast<int>(jmax); ++jj ) {
+	size_t j = jj;
+	for ( size_t i = imin; i <= imax+1; ++i ) {
+	    FV_Interface *iface = get_ifi(i,j,kmin);
+	    size_t L = to_global_index(i-1,j,kmin);
+	    size_t R = to_global_index(i,j,kmin);
+	    double aL = ( i > imin ) ? iface->area[0] / ctr_[L]->volume[0] : 0.0;
+	    double aR = ( i <= imax ) ? iface->area[0] / ctr_[R]->volume[0] : 0.0;
+	    BGK_interface_flux(nv, u, v, iface->n.x, iface->n.y, aL, aR,
+			       &bgk_G[L*nv], &bgk_H[L*nv], &bgk_G[R*nv], &bgk_H[R*nv],
+			       &bgk_dGdt[L*nv], &bgk_dHdt[L*nv], &bgk_dGdt[R*nv], &bgk_dHdt[R*nv]);
+	}
+    }
+#   ifdef _OPENMP
+#   pragma omp parallel for private(ii) schedule(static)
+#   endif
+    for ( ii = static_cast<int>(imin); ii <= static_cast<int>(imax); ++ii ) {
+	size_t i = ii;
+	for ( size_t j = jmin; j <= jmax+1; ++j ) {
+	    FV_Interface *iface = get_ifj(i,j,kmin);
+	    size_t L = to_global_index(i,j-1,kmin);
+	    size_t R = to_global_index(i,j,kmin);
+	    double aL = ( j > jmin ) ? iface->area[0] / ctr_[L]->volume[0] : 0.0;
+	    double aR = ( j <= jmax ) ? iface->area[0] / ctr_[R]->volume[0] : 0.0;
+	    BGK_interface_flux(nv, u, v, iface->n.x, iface->n.y, aL, aR,
+			       &bgk_G[L*nv], &bgk_H[L*nv], &bgk_G[R*nv], &bgk_H[R*nv],
+			       &bgk_dGdt[L*nv], &bgk_dHdt[L*nv], &bgk_dGdt[R*nv], &bgk_dHdt[R*nv]);
+	}
+    }
+
+    // 2. Transport, then relaxation toward the Shakhov distribution.
+    //    Collisions conserve mass, momentum and energy, so the target
+    //    distribution is built from the moments after transport and
+    //    the relaxation can be done implicitly, cell by cell.
+    //    The gas model keeps working storage in its mixing rules,
+    //    so it is evaluated serially, between the two threaded loops.
+    int ncells = static_cast<int>(nni * nnj);
+    int ic;
+#   ifdef _OPENMP
+#   pragma omp parallel for private(ic) schedule(static)
+#   endif
+    for ( ic = 0; ic < ncells; ++ic ) {
+	size_t gid = to_global_index(imin + ic % nni, jmin + ic / nni, kmin);
+	double *g = &bgk_G[gid*nv];
+	double *h = &bgk_H[gid*nv];
+	const double *dg = &bgk_dGdt[gid*nv];
+	const double *dh = &bgk_dHdt[gid*nv];
+	BGK_SIMD
+	for ( size_t iv = 0; iv < nv; ++iv ) {
+	    g[iv] += dt*dg[iv];
+	    h[iv] += dt*dh[iv];
+	}
+	double rho, U, V, E;
+	BGK_moments(nv, u, v, w, g, h, rho, U, V, E);
+	FlowState &fs = *(ctr_[gid]->fs);
+	fs.gas->rho = rho;
+	fs.gas->e[0] = E - 0.5*(U*U + V*V);
+	fs.vel.x = U;
+	fs.vel.y = V;
+	fs.vel.z = 0.0;
+    }
+    int nbad = 0;
+    for ( ic = 0; ic < ncells; ++ic ) {
+	size_t gid = to_global_index(imin + ic % nni, jmin + ic / nni, kmin);
+	Gas_data &Q = *(ctr_[gid]->fs->gas);
+	if ( !(Q.rho > 0.0) || !(Q.e[0] > 0.0) ||
+	     gmodel->eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    ++nbad;
+	    continue;
+	}
+	gmodel->eval_transport_coefficients(Q);
+	int status;
+	bgk_R[ic] = gmodel->R(Q, status);
+	bgk_Pr[ic] = gmodel->Prandtl(Q.mu, gmodel->Cp(Q, status), Q.k[0]);
+    }
+    if ( nbad > 0 ) {
+	cerr << "BGK_update(): block " << id << ": " << nbad
+	     << " cell(s) with non-physical moments." << endl;
+	return FAILURE;
+    }
+#   ifdef _OPENMP
+#   pragma omp parallel
+#   endif
+    {
+	std::vector<double> g_eq(nv), h_eq(nv);
+	int jc;
+#       ifdef _OPENMP
+#       pragma omp for schedule(static)
+#       endif
+	for ( jc = 0; jc < ncells; ++jc ) {
+	    size_t gid = to_global_index(imin + jc % nni, jmin + jc / nni, kmin);
+	    double *g = &bgk_G[gid*nv];
+	    double *h = &bgk_H[gid*nv];
+	    FV_Cell *cell = ctr_[gid];
+	    const Gas_data &Q = *(cell->fs->gas);
+	    double U = cell->fs->vel.x;
+	    double V = cell->fs->vel.y;
+	    double qx, qy;
+	    BGK_heat_flux(nv, u, v, w, g, h, U, V, qx, qy);
+	    Shakhov(Q.rho, U, V, Q.T[0], qx, qy, bgk_R[jc], bgk_Pr[jc], nv, u, v, &g_eq[0], &h_eq[0]);
+	    double f = dt * Q.p / Q.mu; // dt / relaxation time
+	    double a = 1.0 / (1.0 + f);
+	    const double *ge = &g_eq[0];
+	    const double *he = &h_eq[0];
+	    BGK_SIMD
+	    for ( size_t iv = 0; iv < nv; ++iv ) {
+		g[iv] = a*(g[iv] + f*ge[iv]);
+		h[iv] = a*(h[iv] + f*he[iv]);
+	    }
+	    cell->encode_conserved(0, 0, omegaz, false);
+	} // end for jc
+    } // end parallel region
+    return SUCCESS;
+} // end of Block::BGK_update()
+
+
+/// \brief Largest time step for which the fastest discrete velocity
+/// crosses no more than cfl of the smallest cell length.
+double Block::BGK_allowable_dt(double cfl)
+{
+    double c_max = 0.0;
+    for ( size_t iv = 0; iv < bgk_u.size(); ++iv ) {
+	c_max = std::max(c_max, sqrt(bgk_u[iv]*bgk_u[iv] + bgk_v[iv]*bgk_v[iv]));
+    }
+    double L = 1.0e6;
+    for ( FV_Cell *cp: active_cells ) {
+	L = std::min(L, std::min(cp->iLength, cp->jLength));
+    }
+    return ( c_max > 0.0 ) ? cfl * L / c_max : 1.0e6;
+} // end of Block::BGK_allowable_dt()
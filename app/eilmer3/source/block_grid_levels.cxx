@@ -0,0 +1,285 @@
+/// \file block_grid_levels.cxx
+/// \brief Coarse grid levels of a block, for grid sequencing.
+/// \ingroup eilmer3
+///
+/// A coarse level keeps every stride-th vertex of the full grid, so that
+/// each coarse cell covers stride cells in each index direction.
+/// The flow is restricted onto a coarse level by volume-weighted averages
+/// of the conserved quantities and prolongated back, one level at a time,
+/// with a limited linear variation within each coarse cell.
+/// Both transfers keep the volume-weighted total of each conserved quantity
+/// over the fine cells covered by a coarse cell.
+///
+/// \version 18-Oct-2026
+///
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <math.h>
+#include "cell.hh"
+#include "kernel.hh"
+#include "block.hh"
+
+namespace {
+
+// Conserved quantities as a flat list of numbers, so that we can do arithmetic on them.
+size_t number_of_conserved_values(const ConservedQuantities &U)
+{
+    return 11 + U.massf.size() + U.energies.size() + U.G.size() + U.H.size();
+}
+
+void pack_conserved(const ConservedQuantities &U, double *v)
+{
+    *v++ = U.mass;
+    *v++ = U.momentum.x; *v++ = U.momentum.y; *v++ = U.momentum.z;
+    *v++ = U.B.x; *v++ = U.B.y; *v++ = U.B.z;
+    *v++ = U.total_energy;
+    for ( double value : U.massf ) *v++ = value;
+    for ( double value : U.energies ) *v++ = value;
+    *v++ = U.tke; *v++ = U.omega;
+    *v++ = U.psi;
+    for ( double value : U.G ) *v++ = value;
+    for ( double value : U.H ) *v++ = value;
+}
+
+void unpack_conserved(const double *v, ConservedQuantities &U)
+{
+    U.mass = *v++;
+    U.momentum.x = *v++; U.momentum.y = *v++; U.momentum.z = *v++;
+    U.B.x = *v++; U.B.y = *v++; U.B.z = *v++;
+    U.total_energy = *v++;
+    for ( double &value : U.massf ) value = *v++;
+    for ( double &value : U.energies ) value = *v++;
+    U.tke = *v++; U.omega = *v++;
+    U.psi = *v++;
+    for ( double &value : U.G ) value = *v++;
+    for ( double &value : U.H ) value = *v++;
+}
+
+// A child state that cannot be decoded into a physical gas state.
+bool is_unphysical(const ConservedQuantities &U, bool with_k_omega)
+{
+    if ( !(U.mass > 0.0) ) return true;
+    for ( double value : U.massf ) if ( value < 0.0 ) return true;
+    double ke = 0.5 * dot(U.momentum, U.momentum) / U.mass;
+    double e = U.total_energy - ke;
+    if ( with_k_omega ) e -= U.tke;
+    if ( get_global_data_ptr()->MHD ) e -= 0.5 * dot(U.B, U.B);
+    return !(e > 0.0);
+}
+
+double minmod(double a, double b)
+{
+    if ( a * b <= 0.0 ) return 0.0;
+    return (fabs(a) < fabs(b)) ? a : b;
+}
+
+} // end anonymous namespace
+
+
+/// \brief Swap the grid-dependent data with another block.
+///
+/// This covers the dimensions, the cell, interface and vertex arrays,
+/// the boundary conditions (which are sized for a particular grid) and
+/// the sample and monitor cells.  The block identity and configuration
+/// stay where they are, so that a coarse level can stand in for the
+/// full grid while the full-grid data is parked in another Block.
+void Block::swap_grid_level(Block &other)
+{
+    std::swap(nidim, other.nidim); std::swap(njdim, other.njdim); std::swap(nkdim, other.nkdim);
+    std::swap(nni, other.nni); std::swap(nnj, other.nnj); std::swap(nnk, other.nnk);
+    std::swap(imin, other.imin); std::swap(imax, other.imax);
+    std::swap(jmin, other.jmin); std::swap(jmax, other.jmax);
+    std::swap(kmin, other.kmin); std::swap(kmax, other.kmax);
+    std::swap(L_min, other.L_min);
+    std::swap(bounding_box_min, other.bounding_box_min);
+    std::swap(bounding_box_max, other.bounding_box_max);
+    std::swap(hncell, other.hncell);
+    hicell.swap(other.hicell); hjcell.swap(other.hjcell); hkcell.swap(other.hkcell);
+    std::swap(mncell, other.mncell);
+    micell.swap(other.micell); mjcell.swap(other.mjcell); mkcell.swap(other.mkcell);
+    initial_T_value.swap(other.initial_T_value);
+    transient_profile_faces.swap(other.transient_profile_faces);
+    active_cells.swap(other.active_cells);
+    exchange_send_cells.swap(other.exchange_send_cells);
+    exchange_ghost_cells.swap(other.exchange_ghost_cells);
+    flow_state_snapshot.swap(other.flow_state_snapshot);
+    bcp.swap(other.bcp);
+    ctr_.swap(other.ctr_);
+    ifi_.swap(other.ifi_); ifj_.swap(other.ifj_); ifk_.swap(other.ifk_);
+    vtx_.swap(other.vtx_);
+    sifi_.swap(other.sifi_); sifj_.swap(other.sifj_); sifk_.swap(other.sifk_);
+    return;
+} // end swap_grid_level()
+
+
+/// \brief Set up this (empty) block as a coarsened version of the fine block.
+///
+/// The grid takes every stride-th vertex of the fine grid.
+/// The boundary conditions are not set here; they need to be
+/// created for this block before build_exchange_maps() is called.
+/// There are no sample or monitor cells on a coarse level.
+int Block::coarsen_grid_from(Block &fine, size_t stride, size_t dimensions)
+{
+    global_data &G = *get_global_data_ptr();
+    if ( stride < 2 || fine.nni % stride != 0 || fine.nnj % stride != 0 ||
+	 (dimensions == 3 && fine.nnk % stride != 0) ) {
+	cerr << "coarsen_grid_from(): block " << id << " with " << fine.nni << "x"
+	     << fine.nnj << "x" << fine.nnk << " cells cannot be coarsened by "
+	     << stride << endl;
+	return VALUE_ERROR;
+    }
+    nni = fine.nni / stride;
+    nnj = fine.nnj / stride;
+    nidim = nni + 2 * G.nghost;
+    njdim = nnj + 2 * G.nghost;
+    imin = G.nghost; imax = imin + nni - 1;
+    jmin = G.nghost; jmax = jmin + nnj - 1;
+    if ( dimensions == 3 ) {
+	nnk = fine.nnk / stride;
+	nkdim = nnk + 2 * G.nghost;
+	kmin = G.nghost; kmax = kmin + nnk - 1;
+    } else {
+	nnk = 1; nkdim = 1;
+	kmin = 0; kmax = 0;
+    }
+    hncell = 0; mncell = 0;
+    if ( array_alloc(dimensions) != SUCCESS ) return MEMORY_ERROR;
+    bind_interfaces_to_cells(dimensions);
+    size_t krange = (dimensions == 3) ? nnk + 1 : 1;
+    for ( size_t k = 0; k < krange; ++k ) {
+	for ( size_t j = 0; j <= nnj; ++j ) {
+	    for ( size_t i = 0; i <= nni; ++i ) {
+		FV_Vertex *src = fine.get_vtx(fine.imin + stride*i, fine.jmin + stride*j,
+					      fine.kmin + stride*k);
+		get_vtx(imin + i, jmin + j, kmin + k)->pos[0] = src->pos[0];
+	    }
+	}
+    }
+    return SUCCESS;
+} // end coarsen_grid_from()
+
+
+/// \brief Fill the active cells with the volume-weighted average of the
+///        conserved quantities in the fine cells that each one covers.
+///
+/// Both blocks need their cell geometry computed.
+int Block::restrict_flow_from(Block &fine, size_t stride, size_t dimensions)
+{
+    global_data &G = *get_global_data_ptr();
+    bool with_k_omega = (G.turbulence_model == TM_K_OMEGA);
+    size_t kstride = (dimensions == 3) ? stride : 1;
+    size_t nv = number_of_conserved_values(*(fine.get_cell(fine.imin, fine.jmin, fine.kmin)->U[0]));
+    std::vector<double> sum(nv), v(nv);
+    for ( size_t k = kmin; k <= kmax; ++k ) {
+	for ( size_t j = jmin; j <= jmax; ++j ) {
+	    for ( size_t i = imin; i <= imax; ++i ) {
+		std::fill(sum.begin(), sum.end(), 0.0);
+		double vol = 0.0;
+		for ( size_t kk = 0; kk < kstride; ++kk ) {
+		    for ( size_t jj = 0; jj < stride; ++jj ) {
+			for ( size_t ii = 0; ii < stride; ++ii ) {
+			    FV_Cell *fcell = fine.get_cell(fine.imin + stride*(i-imin) + ii,
+							   fine.jmin + stride*(j-jmin) + jj,
+							   fine.kmin + kstride*(k-kmin) + kk);
+			    pack_conserved(*(fcell->U[0]), &v[0]);
+			    for ( size_t n = 0; n < nv; ++n ) sum[n] += v[n] * fcell->volume[0];
+			    vol += fcell->volume[0];
+			}
+		    }
+		}
+		for ( size_t n = 0; n < nv; ++n ) sum[n] /= vol;
+		FV_Cell *cell = get_cell(i, j, k);
+		unpack_conserved(&sum[0], *(cell->U[0]));
+		cell->decode_conserved(0, 0, omegaz, with_k_omega);
+	    }
+	}
+    }
+    return SUCCESS;
+} // end restrict_flow_from()
+
+
+/// \brief Fill the active cells from a block on the next-coarser level.
+///
+/// Within each coarse cell, the conserved quantities vary linearly in index
+/// space with minmod-limited slopes (zero at the block edges), then are shifted
+/// so that the volume-weighted average over the children equals the coarse value.
+/// Where that would give a child an unphysical state, the children just
+/// take the coarse value.  Both blocks need their cell geometry computed.
+int Block::prolong_flow_from(Block &coarse, size_t dimensions)
+{
+    global_data &G = *get_global_data_ptr();
+    bool with_k_omega = (G.turbulence_model == TM_K_OMEGA);
+    if ( nni != 2*coarse.nni || nnj != 2*coarse.nnj ||
+	 (dimensions == 3 && nnk != 2*coarse.nnk) ) {
+	cerr << "prolong_flow_from(): block " << id << " is not twice as fine as its coarse level." << endl;
+	return VALUE_ERROR;
+    }
+    size_t kstride = (dimensions == 3) ? 2 : 1;
+    size_t nchild = 4 * kstride;
+    size_t nv = number_of_conserved_values(*(coarse.get_cell(coarse.imin, coarse.jmin, coarse.kmin)->U[0]));
+    std::vector<double> uc(nv), up(nv), um(nv), slope_i(nv), slope_j(nv), slope_k(nv);
+    std::vector<double> child(nchild*nv), mean(nv);
+    std::vector<FV_Cell *> children(nchild);
+    for ( size_t k = coarse.kmin; k <= coarse.kmax; ++k ) {
+	for ( size_t j = coarse.jmin; j <= coarse.jmax; ++j ) {
+	    for ( size_t i = coarse.imin; i <= coarse.imax; ++i ) {
+		pack_conserved(*(coarse.get_cell(i, j, k)->U[0]), &uc[0]);
+		std::fill(slope_i.begin(), slope_i.end(), 0.0);
+		std::fill(slope_j.begin(), slope_j.end(), 0.0);
+		std::fill(slope_k.begin(), slope_k.end(), 0.0);
+		if ( i > coarse.imin && i < coarse.imax ) {
+		    pack_conserved(*(coarse.get_cell(i+1, j, k)->U[0]), &up[0]);
+		    pack_conserved(*(coarse.get_cell(i-1, j, k)->U[0]), &um[0]);
+		    for ( size_t n = 0; n < nv; ++n ) slope_i[n] = minmod(up[n]-uc[n], uc[n]-um[n]);
+		}
+		if ( j > coarse.jmin && j < coarse.jmax ) {
+		    pack_conserved(*(coarse.get_cell(i, j+1, k)->U[0]), &up[0]);
+		    pack_conserved(*(coarse.get_cell(i, j-1, k)->U[0]), &um[0]);
+		    for ( size_t n = 0; n < nv; ++n ) slope_j[n] = minmod(up[n]-uc[n], uc[n]-um[n]);
+		}
+		if ( dimensions == 3 && k > coarse.kmin && k < coarse.kmax ) {
+		    pack_conserved(*(coarse.get_cell(i, j, k+1)->U[0]), &up[0]);
+		    pack_conserved(*(coarse.get_cell(i, j, k-1)->U[0]), &um[0]);
+		    for ( size_t n = 0; n < nv; ++n ) slope_k[n] = minmod(up[n]-uc[n], uc[n]-um[n]);
+		}
+		// Children sit a quarter of the coarse cell either side of its centre.
+		std::fill(mean.begin(), mean.end(), 0.0);
+		double vol = 0.0;
+		size_t c = 0;
+		for ( size_t kk = 0; kk < kstride; ++kk ) {
+		    for ( size_t jj = 0; jj < 2; ++jj ) {
+			for ( size_t ii = 0; ii < 2; ++ii ) {
+			    FV_Cell *cell = get_cell(imin + 2*(i-coarse.imin) + ii,
+						     jmin + 2*(j-coarse.jmin) + jj,
+						     kmin + kstride*(k-coarse.kmin) + kk);
+			    double di = ii ? 0.25 : -0.25;
+			    double dj = jj ? 0.25 : -0.25;
+			    double dk = (kstride == 2) ? (kk ? 0.25 : -0.25) : 0.0;
+			    double *u = &child[c*nv];
+			    for ( size_t n = 0; n < nv; ++n ) {
+				u[n] = uc[n] + di*slope_i[n] + dj*slope_j[n] + dk*slope_k[n];
+				mean[n] += u[n] * cell->volume[0];
+			    }
+			    vol += cell->volume[0];
+			    children[c++] = cell;
+			}
+		    }
+		}
+		bool use_injection = false;
+		for ( c = 0; c < nchild; ++c ) {
+		    double *u = &child[c*nv];
+		    for ( size_t n = 0; n < nv; ++n ) u[n] += uc[n] - mean[n] / vol;
+		    unpack_conserved(u, *(children[c]->U[0]));
+		    if ( is_unphysical(*(children[c]->U[0]), with_k_omega) ) use_injection = true;
+		}
+		for ( FV_Cell *cell : children ) {
+		    if ( use_injection ) unpack_conserved(&uc[0], *(cell->U[0]));
+		    cell->decode_conserved(0, 0, omegaz, with_k_omega);
+		}
+	    }
+	}
+    }
+    return SUCCESS;
+} // end prolong_flow_from()
@@ -212,40 +212,16 @@ int Block::write_grid(std::string filename, double sim_time, size_t dimensions,
 } // end of Block::write_grid()
 
 
-/// \brief Read the flow solution (i.e. the flow data at cell centers) from a file.
-/// Returns a status flag.
-int Block::read_solution(std::string filename, double *sim_time, size_t dimensions,
-			 bool zip_file, size_t gtl)
+/// \brief Read the flow solution from an open plain (fp) or gzipped (zfp) stream.
+static int read_solution_from_stream(Block &bd, FILE *fp, gzFile zfp, double *sim_time,
+				     size_t dimensions)
 {
 #   define NCHAR 4000
     char line[NCHAR];
     char *gets_result;
     unsigned int i, j, k;
-    size_t retries = 10;
-    FILE *fp = NULL;
-    gzFile zfp = NULL;
+    bool zip_file = (zfp != NULL);
     global_data &G = *get_global_data_ptr();
-    if ( G.verbosity_level >= 1 && id == 0 ) {
-	printf("read_solution(): Start block %d.\n", static_cast<int>(id));
-    }
-    if (zip_file) filename += ".gz";
-    while (retries > 0 && zfp == NULL && fp == NULL) {
-	if (zip_file) {
-	    zfp = gzopen(filename.c_str(), "r");
-	} else {
-	    fp = fopen(filename.c_str(), "r");
-	}
-	if (zfp == NULL && fp == NULL) {
-	    --retries;
-	    cerr << "read_solution(): Could not open " << filename 
-		 << "; " << retries << " retries to go." << endl;
-	    sleep(2);
-	}
-    }
-    if (zfp == NULL && fp == NULL) {
-	cerr << "read_solution(): Could not open " << filename << "; BAILING OUT" << endl;
-	return FILE_ERROR;
-    }
     if (zip_file) {
 	gets_result = gzgets(zfp, line, NCHAR);
     } else {
@@ -256,7 +232,7 @@ int Block::read_solution(std::string filename, double *sim_time, size_t dimensio
 	return BAD_INPUT_ERROR;
     }
     sscanf(line, "%lf", sim_time);
-    if ( G.verbosity_level >= 1 && id == 0 ) {
+    if ( G.verbosity_level >= 1 && bd.id == 0 ) {
 	printf("read_solution(): Time = %e\n", *sim_time);
     }
     if (zip_file) {
@@ -279,15 +255,15 @@ int Block::read_solution(std::string filename, double *sim_time, size_t dimensio
 	return BAD_INPUT_ERROR;
     }
     sscanf(line, "%u %u %u", &i, &j, &k);
-    if ( i != nni || j != nnj || k != ((dimensions == 3) ? nnk : 1) ) {
-	printf("read_solution(): block %d, mismatch in cell numbers\n", static_cast<int>(id));
+    if ( i != bd.nni || j != bd.nnj || k != ((dimensions == 3) ? bd.nnk : 1) ) {
+	printf("read_solution(): block %d, mismatch in cell numbers\n", static_cast<int>(bd.id));
 	printf("    This misalignment could be caused by a having a different number\n");
 	printf("    of fields for each cell's entry.\n");
 	return BAD_INPUT_ERROR;
     }
-    for ( k = kmin; k <= kmax; ++k ) {
-	for ( j = jmin; j <= jmax; ++j ) {
-	    for ( i = imin; i <= imax; ++i ) {
+    for ( k = bd.kmin; k <= bd.kmax; ++k ) {
+	for ( j = bd.jmin; j <= bd.jmax; ++j ) {
+	    for ( i = bd.imin; i <= bd.imax; ++i ) {
 		// The new format for Elmer3 puts all cell data onto one line.
 		if (zip_file) {
 		    gets_result = gzgets(zfp, line, NCHAR);
@@ -298,20 +274,107 @@ int Block::read_solution(std::string filename, double *sim_time, size_t dimensio
 		    printf("read_solution(): Empty flow field file while reading cell data.\n");
 		    return BAD_INPUT_ERROR;
 		}
-		get_cell(i,j,k)->scan_values_from_string(line);
+		bd.get_cell(i,j,k)->scan_values_from_string(line);
 	    }
 	}
     }
+    return SUCCESS;
+#   undef NCHAR
+} // end of read_solution_from_stream()
+
+
+/// \brief Write the flow solution to an open plain (fp) or gzipped (zfp) stream.
+static int write_solution_to_stream(Block &bd, FILE *fp, gzFile zfp, double sim_time)
+{
+    string str;
+    bool zip_file = (zfp != NULL);
+    if (zip_file) {
+	gzprintf(zfp, "%20.16e\n", sim_time);
+	gzprintf(zfp, "%s\n", variable_list_for_cell().c_str());
+	gzprintf(zfp, "%d %d %d\n", static_cast<int>(bd.nni), static_cast<int>(bd.nnj),
+		 static_cast<int>(bd.nnk));
+    } else {
+	fprintf(fp, "%20.16e\n", sim_time);
+	fprintf(fp, "%s\n", variable_list_for_cell().c_str());
+	fprintf(fp, "%d %d %d\n", static_cast<int>(bd.nni), static_cast<int>(bd.nnj),
+		static_cast<int>(bd.nnk));
+    }
+    for ( size_t k = bd.kmin; k <= bd.kmax; ++k ) {
+	for ( size_t j = bd.jmin; j <= bd.jmax; ++j ) {
+	    for ( size_t i = bd.imin; i <= bd.imax; ++i ) {
+		str = bd.get_cell(i,j,k)->write_values_to_string();
+		if (zip_file) {
+		    gzputs(zfp, str.c_str()); gzputc(zfp, '\n');
+		} else {
+		    fputs(str.c_str(), fp); fputc('\n', fp);
+		}
+	    } // i-loop
+	} // j-loop
+    } // k-loop
+    return SUCCESS;
+} // end of write_solution_to_stream()
+
+
+/// \brief Read the flow solution (i.e. the flow data at cell centers) from a file.
+/// Returns a status flag.
+int Block::read_solution(std::string filename, double *sim_time, size_t dimensions,
+			 bool zip_file, size_t gtl)
+{
+    size_t retries = 10;
+    FILE *fp = NULL;
+    gzFile zfp = NULL;
+    global_data &G = *get_global_data_ptr();
+    if ( G.verbosity_level >= 1 && id == 0 ) {
+	printf("read_solution(): Start block %d.\n", static_cast<int>(id));
+    }
+    if (zip_file) filename += ".gz";
+    while (retries > 0 && zfp == NULL && fp == NULL) {
+	if (zip_file) {
+	    zfp = gzopen(filename.c_str(), "r");
+	} else {
+	    fp = fopen(filename.c_str(), "r");
+	}
+	if (zfp == NULL && fp == NULL) {
+	    --retries;
+	    cerr << "read_solution(): Could not open " << filename 
+		 << "; " << retries << " retries to go." << endl;
+	    sleep(2);
+	}
+    }
+    if (zfp == NULL && fp == NULL) {
+	cerr << "read_solution(): Could not open " << filename << "; BAILING OUT" << endl;
+	return FILE_ERROR;
+    }
+    int flag = read_solution_from_stream(*this, fp, zfp, sim_time, dimensions);
     if (zip_file) {
 	gzclose(zfp);
     } else {
 	fclose(fp);
     }
-    return SUCCESS;
-#   undef NCHAR
+    return flag;
 } // end of Block::read_solution()
 
 
+/// \brief Read the flow solution for this block from the text of a flow file,
+///        as held in a flow-file collection.
+int Block::read_solution_from_string(const std::string &text, double *sim_time,
+				     size_t dimensions, size_t gtl)
+{
+    if ( text.empty() ) {
+	printf("read_solution(): Empty flow field text for block %d.\n", static_cast<int>(id));
+	return BAD_INPUT_ERROR;
+    }
+    FILE *fp = fmemopen(const_cast<char *>(text.data()), text.size(), "r");
+    if ( fp == NULL ) {
+	cerr << "read_solution(): Could not open flow text for block " << id << endl;
+	return FILE_ERROR;
+    }
+    int flag = read_solution_from_stream(*this, fp, NULL, sim_time, dimensions);
+    fclose(fp);
+    return flag;
+} // end of Block::read_solution_from_string()
+
+
 int Block::write_solution(std::string filename, double sim_time, size_t dimensions,
 			  bool zip_file, size_t gtl)
 /// \brief Write the flow solution (i.e. the primary variables at the
@@ -321,7 +384,6 @@ int Block::write_solution(std::string filename, double sim_time, size_t dimensio
 {
     FILE *fp;
     gzFile zfp;
-    string str;
     global_data &G = *get_global_data_ptr();
     if ( G.verbosity_level >= 1 && id == 0 && G.flow_induced_moving == 0 ) {
 	printf("write_solution(): At t = %e, start block = %d.\n",
@@ -334,33 +396,14 @@ int Block::write_solution(std::string filename, double sim_time, size_t dimensio
 	    cerr << "write_solution(): Could not open " << filename << "; BAILING OUT" << endl;
 	    exit( FILE_ERROR );
 	}
-	gzprintf(zfp, "%20.16e\n", sim_time);
-	gzprintf(zfp, "%s\n", variable_list_for_cell().c_str());
-	gzprintf(zfp, "%d %d %d\n", static_cast<int>(nni), static_cast<int>(nnj),
-		 static_cast<int>(nnk));
     } else {
 	zfp = NULL;
 	if ((fp = fopen(filename.c_str(), "w")) == NULL) {
 	    cerr << "write_solution(): Could not open " << filename << "; BAILING OUT" << endl;
 	    exit( FILE_ERROR );
 	}
-	fprintf(fp, "%20.16e\n", sim_time);
-	fprintf(fp, "%s\n", variable_list_for_cell().c_str());
-	fprintf(fp, "%d %d %d\n", static_cast<int>(nni), static_cast<int>(nnj),
-		static_cast<int>(nnk));
     }
-    for ( size_t k = kmin; k <= kmax; ++k ) {
-	for ( size_t j = jmin; j <= jmax; ++j ) {
-	    for ( size_t i = imin; i <= imax; ++i ) {
-		str = get_cell(i,j,k)->write_values_to_string();
-		if (zip_file) {
-		    gzputs(zfp, str.c_str()); gzputc(zfp, '\n');
-		} else {
-		    fputs(str.c_str(), fp); fputc('\n', fp);
-		}
-	    } // i-loop
-	} // j-loop
-    } // k-loop
+    write_solution_to_stream(*this, fp, zfp, sim_time);
     if (zip_file) {
 	gzclose(zfp);
     } else {
@@ -370,6 +413,25 @@ int Block::write_solution(std::string filename, double sim_time, size_t dimensio
 } // end of Block::write_solution()
 
 
+/// \brief Format the flow solution for this block, exactly as it would
+///        appear in its (unzipped) flow file.
+int Block::write_solution_to_string(std::string &text, double sim_time, size_t gtl)
+{
+    char *buf = NULL;
+    size_t size = 0;
+    FILE *fp = open_memstream(&buf, &size);
+    if ( fp == NULL ) {
+	cerr << "write_solution(): Could not open memory stream for block " << id << endl;
+	return MEMORY_ERROR;
+    }
+    write_solution_to_stream(*this, fp, NULL, sim_time);
+    fclose(fp);
+    text.assign(buf, size);
+    free(buf);
+    return SUCCESS;
+} // end of Block::write_solution_to_string()
+
+
 int Block::write_profile(std::string filename, int which_face, double sim_time,
 			 bool write_header, size_t gtl)
 /// \brief Write out the flow solution for a full face of cells.
@@ -601,7 +601,7 @@ int FV_Vertex::copy_grid_level_to_level(size_t from_level, size_t to_level)
 
 FV_Cell::FV_Cell(Gas_model *gm)
     : id(0), status(NORMAL_CELL), fr_reactions_allowed(false),
-      dt_chem(0.0), dt_therm(0.0), in_turbulent_zone(false),
+      dt_chem(0.0), dt_therm(0.0), dt_local(0.0), in_turbulent_zone(false),
       base_qdot(0.0), pos(N_LEVEL,Vector3(0.0,0.0,0.0)),
       volume(N_LEVEL,0.0), area(N_LEVEL,0.0), uf(0.0),
       iLength(0.0), jLength(0.0), kLength(0.0), L_min(0.0),
@@ -625,7 +625,7 @@ FV_Cell::FV_Cell(Gas_model *gm)
 
 FV_Cell::FV_Cell()
     : id(0), status(NORMAL_CELL), fr_reactions_allowed(false),
-      dt_chem(0.0), dt_therm(0.0), in_turbulent_zone(false),
+      dt_chem(0.0), dt_therm(0.0), dt_local(0.0), in_turbulent_zone(false),
       base_qdot(0.0), pos(N_LEVEL,Vector3(0.0,0.0,0.0)),
       volume(N_LEVEL,0.0), area(N_LEVEL,0.0), uf(0.0),
       iLength(0.0), jLength(0.0), kLength(0.0), L_min(0.0),
@@ -646,7 +646,7 @@ FV_Cell::FV_Cell()
 FV_Cell::FV_Cell(const FV_Cell &cell)
     : id(cell.id), status(cell.status), 
       fr_reactions_allowed(cell.fr_reactions_allowed),
-      dt_chem(cell.dt_chem), dt_therm(cell.dt_therm),
+      dt_chem(cell.dt_chem), dt_therm(cell.dt_therm), dt_local(cell.dt_local),
       in_turbulent_zone(cell.in_turbulent_zone),
       base_qdot(cell.base_qdot), pos(cell.pos),
       volume(cell.volume), area(cell.area), uf(cell.uf),
@@ -676,7 +676,7 @@ FV_Cell & FV_Cell::operator=(const FV_Cell &cell)
     if ( this != &cell ) { // Avoid aliasing
 	id = cell.id; status = cell.status;
 	fr_reactions_allowed = cell.fr_reactions_allowed;
-	dt_chem = cell.dt_chem; dt_therm = cell.dt_therm;
+	dt_chem = cell.dt_chem; dt_therm = cell.dt_therm; dt_local = cell.dt_local;
 	in_turbulent_zone = cell.in_turbulent_zone;
 	base_qdot = cell.base_qdot;
 	pos = cell.pos; volume = cell.volume;
@@ -1103,6 +1103,41 @@ std::string FV_Cell::write_values_to_string() const
     return ost.str();
 } // end of write_values_to_string()
 
+/// \brief Copy the same values as write_values_to_string() into a vector of doubles,
+///        for recorders that want to avoid the text conversion.
+int FV_Cell::write_values_to_vector(std::vector<double> &values) const
+{
+    global_data &G = *get_global_data_ptr();
+    size_t nsp = fs->gas->massf.size();
+    size_t nmodes = fs->gas->T.size();
+    values.clear();
+    values.push_back(pos[0].x); values.push_back(pos[0].y); values.push_back(pos[0].z);
+    values.push_back(volume[0]); values.push_back(fs->gas->rho);
+    values.push_back(fs->vel.x); values.push_back(fs->vel.y); values.push_back(fs->vel.z);
+    if ( G.MHD ) {
+	values.push_back(fs->B.x); values.push_back(fs->B.y); values.push_back(fs->B.z);
+	values.push_back(fs->psi); values.push_back(fs->divB);
+    }
+    values.push_back(fs->gas->p); values.push_back(fs->gas->a); values.push_back(fs->gas->mu);
+    for ( size_t imode = 0; imode < nmodes; ++imode ) {
+	values.push_back(fs->gas->k[imode]);
+    }
+    values.push_back(fs->mu_t); values.push_back(fs->k_t); values.push_back(fs->S);
+    if ( G.radiation ) {
+	values.push_back(Q_rad_org); values.push_back(f_rad_org); values.push_back(Q_rE_rad);
+    }
+    values.push_back(fs->tke); values.push_back(fs->omega);
+    for ( size_t isp = 0; isp < nsp; ++isp ) {
+	values.push_back(fs->gas->massf[isp]);
+    }
+    if ( nsp > 1 ) values.push_back(dt_chem);
+    for ( size_t imode = 0; imode < nmodes; ++imode ) {
+	values.push_back(fs->gas->e[imode]); values.push_back(fs->gas->T[imode]);
+    }
+    if ( nmodes > 1 ) values.push_back(dt_therm);
+    return SUCCESS;
+} // end of write_values_to_vector()
+
 /// \brief Scan a string, extracting the discrete samples of the BGK velocity distribution function
 int FV_Cell::scan_BGK_from_string(char *bufptr)
 // There isn't any checking of the file content.
@@ -1214,8 +1249,25 @@ int FV_Cell::encode_conserved(size_t gtl, size_t ftl, double omegaz, bool with_k
 int FV_Cell::decode_conserved(size_t gtl, size_t ftl, double omegaz, bool with_k_omega)
 {
     global_data &G = *get_global_data_ptr();
-    ConservedQuantities &myU = *(U[ftl]);
     Gas_model *gmodel = get_gas_model_ptr();
+    decode_conserved_deferred(gtl, ftl, omegaz, with_k_omega);
+    // Fill out the other variables; P, T, a and
+    // check the species mass fractions.
+    // Update the viscous transport coefficients.
+    gmodel->eval_thermo_state_rhoe(*(fs->gas));
+    if ( G.viscous ) gmodel->eval_transport_coefficients(*(fs->gas));
+    if ( G.diffusion ) gmodel->eval_diffusion_coefficients(*(fs->gas));
+    return SUCCESS;
+} // end of decode_conserved()
+
+
+/// \brief Decode the conserved quantities as far as the gas density, energies
+///        and mass fractions, leaving the evaluation of the rest of the gas
+///        state to the caller (see Block::eval_gas_state_of_active_cells()).
+int FV_Cell::decode_conserved_deferred(size_t gtl, size_t ftl, double omegaz, bool with_k_omega)
+{
+    global_data &G = *get_global_data_ptr();
+    ConservedQuantities &myU = *(U[ftl]);
     double e, ke, dinv, rE, me;
 
     // Mass / unit volume = Density
@@ -1285,15 +1337,8 @@ int FV_Cell::decode_conserved(size_t gtl, size_t ftl, double omegaz, bool with_k
     else {
 	fs->gas->e[0] = e;
     }
-    // Fill out the other variables; P, T, a and
-    // check the species mass fractions.
-    // Update the viscous transport coefficients.
-    gmodel->eval_thermo_state_rhoe(*(fs->gas));
-    if ( G.viscous ) gmodel->eval_transport_coefficients(*(fs->gas));
-    if ( G.diffusion ) gmodel->eval_diffusion_coefficients(*(fs->gas));
-
     return SUCCESS;
-} // end of decode_conserved()
+} // end of decode_conserved_deferred()
 
 
 /// \brief Check the primary flow data for a specified cell.
@@ -2964,7 +3009,8 @@ int number_of_values_in_cell_copy(int type_of_copy)
 std::string variable_list_for_cell( void )
 {
     // This function needs to be kept consistent with functions
-    // FV_Cell::write_values_to_string, FV_Cell::scan_values_from_string
+    // FV_Cell::write_values_to_string, FV_Cell::write_values_to_vector,
+    // FV_Cell::scan_values_from_string
     // (found above) and with the corresponding Python functions
     // write_cell_data and variable_list_for_cell
     // that may be found in app/eilmer3/source/e3_flow.py.
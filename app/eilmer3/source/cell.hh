@@ -208,6 +208,7 @@ public:
     bool fr_reactions_allowed; ///> \brief if true, will call chemical_increment (also thermal_increment)
     double dt_chem; ///> \brief acceptable time step for finite-rate chemistry
     double dt_therm; ///> \brief acceptable time step for thermal relaxation
+    double dt_local; ///> \brief CFL-limited time step for this cell, for local time stepping
     bool in_turbulent_zone; ///> \brief if true, we will keep the turbulence viscosity
     double base_qdot; ///> \brief base-level of heat addition to cell, W/m**3
     // Geometry
@@ -259,6 +260,7 @@ public:
     int replace_flow_data_with_average(std::vector<FV_Cell *> src);
     int scan_values_from_string(char *bufptr);
     std::string write_values_to_string() const;
+    int write_values_to_vector(std::vector<double> &values) const;
     int scan_BGK_from_string(char *bufptr);
     std::string write_BGK_to_string() const;
     int impose_chemistry_timestep(double dt);
@@ -266,6 +268,7 @@ public:
     int set_fr_reactions_allowed(int flag);
     int encode_conserved(size_t gtl, size_t ftl, double omegaz, bool with_k_omega);
     int decode_conserved(size_t gtl, size_t ftl, double omegaz, bool with_k_omega);
+    int decode_conserved_deferred(size_t gtl, size_t ftl, double omegaz, bool with_k_omega);
     bool check_flow_data(void);
     int time_derivatives(size_t gtl, size_t ftl, size_t dimensions, bool with_k_omega);
     int stage_1_update_for_flow_on_fixed_grid(double dt, bool force_euler, bool with_k_omega);
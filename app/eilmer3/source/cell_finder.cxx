@@ -4,6 +4,7 @@
  **/
 
 #include <iostream>
+#include <cmath>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -279,348 +280,389 @@ test_cell( const FV_Cell * cell, const Vector3 &p, int *dc )
 }
 
 CellFinder3D::CellFinder3D( size_t nvertices )
-: CellFinder( nvertices )
+: CellFinder( nvertices ), ncells_( 0 ), bucket_size_( 0.0 )
 {
-    // initialise vp_, a_ and dc_ arrays for each thread
+    if ( nvertices==4 ) {
+	// tetrahedron
+	cout << "CellFinder3D::CellFinder3D()" << endl
+	     << "CellFinder3D is not yet able to handle unstructured grids" << endl
+	     << "Exiting program." << endl;
+	exit( BAD_INPUT_ERROR );
+    }
+    
+    // initialise the march state for each thread
     size_t nthreads = omp_get_max_threads();
 
     cout << "CellFinder3D::CellFinder3D()" << endl
          << "nthreads = " << nthreads << endl;
-         
-    vp_.resize( nthreads );
-    a_.resize( nthreads );
-    dc_.resize( nthreads );
     
-    for ( size_t ithread=0; ithread<nthreads; ++ithread ) {
-	vp_[ithread].resize( 3 );	// need vectors to 3 points to test a plane
-	if ( nvertices==8 ) {
-	    // hexahedron
-	    a_[ithread].resize( 6 );
-	}
-	else if ( nvertices==4 ) {
-	    // tetrahedron
-	    cout << "CellFinder3D::CellFinder3D()" << endl
-		 << "CellFinder3D is not yet able to handle unstructured grids" << endl
-		 << "Exiting program." << endl;
-	    exit( BAD_INPUT_ERROR );
-	}
-	
-	dc_[ithread] = new int[3];	// cell stepping has 3 degrees of freedom
-    }
+    state_.resize( nthreads );
+    for ( size_t ithread=0; ithread<nthreads; ++ithread )
+    	state_[ithread].cell = -1;
+    
+    build_cell_table();
+    build_spatial_index();
+    connect_blocks();
 }
 
-CellFinder3D::~CellFinder3D()
+CellFinder3D::~CellFinder3D() {}
+
+// Vertices of each face in cyclic order, indexed by face (NORTH...BOTTOM)
+static size_t hex_face_vertices[6][4] = { { 3, 2, 6, 7 },
+					  { 1, 2, 6, 5 },
+					  { 0, 1, 5, 4 },
+					  { 0, 3, 7, 4 },
+					  { 4, 5, 6, 7 },
+					  { 0, 1, 2, 3 } };
+
+static int opposite_face[6] = { SOUTH, WEST, NORTH, EAST, BOTTOM, TOP };
+
+static Vector3 hex_face_centre( const FV_Cell * cell, int iface )
 {
-    for ( size_t ithread=0; ithread<dc_.size(); ++ithread )
-    	delete [] dc_[ithread];
+    Vector3 c( 0.0, 0.0, 0.0 );
+    for ( size_t iv=0; iv<4; ++iv )
+    	c += cell->vtx[ hex_face_vertices[iface][iv] ]->pos[0];
+    return 0.25 * c;
 }
 
-int
+void
 CellFinder3D::
-find_cell( const Vector3 &p, size_t &ib, size_t &ic, size_t &jc, size_t &kc )
+build_cell_table()
 {
-    // &p -> address of spatial point we are looking for
-    // ib -> block indice
-    // ic, jc, kc -> cell indices
+    global_data &G = *get_global_data_ptr();
     
-    // NOTE: assuming single block for the moment
+    block_offset_.assign( G.nblock, -1 );
+    block_ni_.assign( G.nblock, 0 );
+    block_nj_.assign( G.nblock, 0 );
+    ncells_ = 0;
+    for ( size_t jb=0; jb<G.my_blocks.size(); ++jb ) {
+	Block * A = G.my_blocks[jb];
+	block_offset_[A->id] = ncells_;
+	block_ni_[A->id] = A->imax - A->imin + 1;
+	block_nj_[A->id] = A->jmax - A->jmin + 1;
+	ncells_ += block_ni_[A->id] * block_nj_[A->id] * ( A->kmax - A->kmin + 1 );
+    }
     
-    size_t ithread = omp_get_thread_num();
+    faces_.resize( 24*ncells_ );
+    nbr_.resize( 6*ncells_ );
+    centre_.resize( ncells_ );
+    size_.resize( ncells_ );
+    ijk_.resize( 4*ncells_ );
     
-    // Get pointers to the block and cell
-    Block * A = get_block_data_ptr(ib);
-    FV_Cell * cell = A->get_cell(ic,jc,kc);
+    for ( size_t jb=0; jb<G.my_blocks.size(); ++jb ) {
+	Block * A = G.my_blocks[jb];
+	for ( size_t k=A->kmin; k<=A->kmax; ++k ) {
+	    for ( size_t j=A->jmin; j<=A->jmax; ++j ) {
+		for ( size_t i=A->imin; i<=A->imax; ++i ) {
+		    int c = get_cell_index( A->id, i, j, k );
+		    FV_Cell * cell = A->get_cell( i, j, k );
+		    ijk_[4*c] = A->id; ijk_[4*c+1] = i; ijk_[4*c+2] = j; ijk_[4*c+3] = k;
+		    centre_[c] = cell->pos[0];
+		    size_[c] = 0.0;
+		    for ( int iface=0; iface<6; ++iface ) {
+			// The normal from the diagonals and the point from the average
+			// of the vertices give the same plane for both cells sharing a face.
+			const size_t *fv = hex_face_vertices[iface];
+			Vector3 n = cross( cell->vtx[fv[2]]->pos[0] - cell->vtx[fv[0]]->pos[0],
+					   cell->vtx[fv[3]]->pos[0] - cell->vtx[fv[1]]->pos[0] );
+			Vector3 fc = hex_face_centre( cell, iface );
+			n = unit( n );
+			if ( dot( n, fc - centre_[c] ) < 0.0 ) n = -1.0 * n;
+			double *f = &faces_[24*c + 4*iface];
+			f[0] = n.x; f[1] = n.y; f[2] = n.z; f[3] = dot( n, fc );
+			size_[c] = max( size_[c], 2.0 * vabs( fc - centre_[c] ) );
+		    }
+		    // Neighbours within the block; adjacent blocks are connected later
+		    nbr_[6*c+NORTH]  = ( j < A->jmax ) ? get_cell_index( A->id, i, j+1, k ) : -1;
+		    nbr_[6*c+EAST]   = ( i < A->imax ) ? get_cell_index( A->id, i+1, j, k ) : -1;
+		    nbr_[6*c+SOUTH]  = ( j > A->jmin ) ? get_cell_index( A->id, i, j-1, k ) : -1;
+		    nbr_[6*c+WEST]   = ( i > A->imin ) ? get_cell_index( A->id, i-1, j, k ) : -1;
+		    nbr_[6*c+TOP]    = ( k < A->kmax ) ? get_cell_index( A->id, i, j, k+1 ) : -1;
+		    nbr_[6*c+BOTTOM] = ( k > A->kmin ) ? get_cell_index( A->id, i, j, k-1 ) : -1;
+		}
+	    }
+	}
+    }
     
-    // Pointer for the neighbour block
-    Block * B;
+    return;
+}
+
+void
+CellFinder3D::
+build_spatial_index()
+{
+    global_data &G = *get_global_data_ptr();
     
-    // Search for the containing cell starting with the given guess
-    dc_[ithread][0] = 1; dc_[ithread][1] = 1; dc_[ithread][2] = 1;
-    size_t count = 0;
-    int status = INSIDE_GRID;    
-    while ( abs(dc_[ithread][0]) + abs(dc_[ithread][1]) + abs(dc_[ithread][2]) != 0 ) {
-	// Check that predicted cell is inside the block domain
-	if ( ic < A->imin ) {
-	    // cout << "Outside the block: West" << endl;
-	    if ( A->bcp[WEST]->type_code == ADJACENT ) {
-	    	// set the block index to the neighbour
-	    	ib = A->bcp[WEST]->neighbour_block;
-	    	B = get_block_data_ptr( ib );
-	    	// make sure jc and kc are back in-range
-	    	jc -= dc_[ithread][1]; kc -= dc_[ithread][2];
-	    	if ( A->bcp[WEST]->neighbour_face==EAST ) {
-	    	    // kc and jc stay the same, ic goes to new imax
-	    	    ic = B->imax;
-	    	}
-	    	else if ( A->bcp[WEST]->neighbour_face==SOUTH ) {
-	    	    // ic goes to jc, jc goes to new jmin, kc stays the same
-	    	    ic = jc; jc = B->jmin;
-	    	}
-	    	else if ( A->bcp[WEST]->neighbour_face==WEST ) {
-	    	    // ic goes to new imin, jc goes to new jmax - jc, kc stays the same
-	    	    ic = B->imin; jc = B->jmax - jc + B->jmin;
-	    	}
-	    	else if ( A->bcp[WEST]->neighbour_face==NORTH ) {
-	    	    // ic goes to new imax - jc, jc goes to new jmax, kc stays the same
-	    	    ic = B->imax - jc + B->imin; jc = B->jmax;
-	    	}
-	    	else if ( A->bcp[WEST]->neighbour_face==BOTTOM ) {
-	    	    // ic goes to new imin, jc goes to new jmax - jc, kc stays the same
-	    	    ic = jc; jc = B->jmax - kc + B->jmin; kc = B->kmin;
-	    	}
-	    	else if ( A->bcp[WEST]->neighbour_face==TOP ) {
-	    	    // ic goes to new imax - jc, jc goes to new jmax, kc stays the same
-	    	    ic = jc; jc = kc; kc = B->kmax;
-	    	}
-	    }
-	    else {
-	    	// the ray is leaving the grid
-	    	// step back inside the grid
-	    	ic-=dc_[ithread][0]; 
-	    	jc-=dc_[ithread][1];
-	    	kc-=dc_[ithread][2];
-	    	// set status flag to the exit direction
-	    	status = WEST;
+    if ( ncells_==0 ) return;
+    
+    // Bounding box of each cell and of the grid
+    vector<Vector3> lo( ncells_ ), hi( ncells_ );
+    for ( size_t jb=0; jb<G.my_blocks.size(); ++jb ) {
+	Block * A = G.my_blocks[jb];
+	for ( size_t k=A->kmin; k<=A->kmax; ++k ) {
+	    for ( size_t j=A->jmin; j<=A->jmax; ++j ) {
+		for ( size_t i=A->imin; i<=A->imax; ++i ) {
+		    int c = get_cell_index( A->id, i, j, k );
+		    FV_Cell * cell = A->get_cell( i, j, k );
+		    lo[c] = hi[c] = cell->vtx[0]->pos[0];
+		    for ( size_t iv=1; iv<8; ++iv ) {
+			const Vector3 &v = cell->vtx[iv]->pos[0];
+			lo[c].x = min( lo[c].x, v.x ); hi[c].x = max( hi[c].x, v.x );
+			lo[c].y = min( lo[c].y, v.y ); hi[c].y = max( hi[c].y, v.y );
+			lo[c].z = min( lo[c].z, v.z ); hi[c].z = max( hi[c].z, v.z );
+		    }
+		}
 	    }
 	}
-	else if ( ic > A->imax ) {
-	    // cout << "Outside the block: East" << endl;
-	    if ( A->bcp[EAST]->type_code == ADJACENT ) {
-	    	// set the block index to the neighbour
-	    	ib = A->bcp[EAST]->neighbour_block;
-	    	B = get_block_data_ptr( ib );
-	    	// make sure jc and kc are back in-range
-	    	jc -= dc_[ithread][1]; kc -= dc_[ithread][2];
-	    	if ( A->bcp[EAST]->neighbour_face==WEST ) {
-	    	    // jc and kc stay the same, ic goes to new imin
-	    	    ic = B->imin;
-	    	}
-	    	else if ( A->bcp[EAST]->neighbour_face==NORTH ) {
-	    	    // ic goes to jc, jc goes to new jmax, kc stays the same
-	    	    ic = jc; jc = B->jmax;
-	    	}
-	    	else if ( A->bcp[EAST]->neighbour_face==EAST ) {
-	    	    // ic goes to new imax, jc goes to new jmax - jc, kc stays the same
-	    	    ic = B->imax; jc = B->jmax - jc + B->jmin;
-	    	}
-	    	else if ( A->bcp[EAST]->neighbour_face==SOUTH ) {
-	    	    // ic goes to new imax - jc, jc goes to new jmin, kc stays the same
-	    	    ic = B->imax - jc + B->imin; jc = B->jmin;
-	    	}
-	    	else if ( A->bcp[EAST]->neighbour_face==BOTTOM ) {
-	    	    // ic goes to new imax - jc, jc goes to new jmax - kc, kc goes to new kmin
-	    	    ic = B->imax - jc + B->imin; jc = B->jmax - kc + B->jmin; kc = B->kmin;
-	    	}
-	    	else if ( A->bcp[EAST]->neighbour_face==TOP ) {
-	    	    // ic goes to new imax - jc, jc goes to kc, kc goes to new kmax
-	    	    ic = B->imax - jc + B->imin; jc = kc; kc = B->kmax;
-	    	}
-	    }
-	    else {
-	    	// the ray is leaving the grid
-	    	// step back inside the grid
-	    	ic-=dc_[ithread][0]; 
-	    	jc-=dc_[ithread][1];
-	    	kc-=dc_[ithread][2];
-	    	// set status flag to the exit direction
-	    	status = EAST;
-	    }
+    }
+    Vector3 bb_max = hi[0];
+    bb_min_ = lo[0];
+    for ( size_t c=1; c<ncells_; ++c ) {
+	bb_min_.x = min( bb_min_.x, lo[c].x ); bb_max.x = max( bb_max.x, hi[c].x );
+	bb_min_.y = min( bb_min_.y, lo[c].y ); bb_max.y = max( bb_max.y, hi[c].y );
+	bb_min_.z = min( bb_min_.z, lo[c].z ); bb_max.z = max( bb_max.z, hi[c].z );
+    }
+    
+    // Cubic buckets holding a few cells each on average
+    Vector3 L = bb_max - bb_min_;
+    double L_max = max( L.x, max( L.y, L.z ) );
+    double L_min = 1.0e-6 * L_max;
+    double V = max( L.x, L_min ) * max( L.y, L_min ) * max( L.z, L_min );
+    bucket_size_ = pow( V * CELL_FINDER_CELLS_PER_BUCKET / double(ncells_), 1.0/3.0 );
+    double L_d[3] = { L.x, L.y, L.z };
+    for ( int d=0; d<3; ++d ) {
+	nbucket_[d] = int( L_d[d] / bucket_size_ ) + 1;
+	if ( nbucket_[d] > CELL_FINDER_MAX_BUCKETS ) nbucket_[d] = CELL_FINDER_MAX_BUCKETS;
+    }
+    // the bucket size must cover the grid in every direction
+    for ( int d=0; d<3; ++d )
+	bucket_size_ = max( bucket_size_, L_d[d] / double(nbucket_[d]) * ( 1.0 + 1.0e-12 ) );
+    
+    // Two passes: count the cells in each bucket, then fill the buckets
+    size_t nb = size_t(nbucket_[0]) * nbucket_[1] * nbucket_[2];
+    bucket_start_.assign( nb + 1, 0 );
+    for ( int pass=0; pass<2; ++pass ) {
+	vector<size_t> fill;
+	if ( pass==1 ) {
+	    for ( size_t b=0; b<nb; ++b ) bucket_start_[b+1] += bucket_start_[b];
+	    bucket_cells_.resize( bucket_start_[nb] );
+	    fill.assign( bucket_start_.begin(), bucket_start_.end() - 1 );
 	}
-	else if ( jc < A->jmin ) {
-	    // cout << "Outside the block: SOUTH" << endl;
-	    if ( A->bcp[SOUTH]->type_code == ADJACENT ) {
-	    	// set the block index to the neighbour
-	    	ib = A->bcp[SOUTH]->neighbour_block;
-	    	B = get_block_data_ptr( ib );
-	    	// make sure ic and kc are back in-range
-	    	ic -= dc_[ithread][0]; kc -= dc_[ithread][2];
-	    	if ( A->bcp[SOUTH]->neighbour_face==NORTH ) {
-	    	    // ic stays the same, jc goes to new jmax, kc stays the same
-	    	    jc = B->jmax;
-	    	}
-	    	else if ( A->bcp[SOUTH]->neighbour_face==EAST ) {
-	    	    // ic goes to new imax, jc goes to new jmax - ic, kc stays the same
-	    	    ic = B->imax; jc = B->jmax - ic + B->jmin;
-	    	}
-	    	else if ( A->bcp[SOUTH]->neighbour_face==SOUTH ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmin, kc stays the same
-	    	    ic = B->imax - ic + B->imin; jc = B->jmin;
-	    	}
-	    	else if ( A->bcp[SOUTH]->neighbour_face==WEST ) {
-	    	    // ic goes to new imin, jc goes to ic, kc stays the same
-	    	    ic = B->imin; jc = B->jmin;
-	    	}
-	    	else if ( A->bcp[SOUTH]->neighbour_face==BOTTOM ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmax - kc, kc goes to new kmin
-	    	    ic = B->imax - ic + B->imin; jc = B->jmax - kc + B->jmin; kc = B->kmin;
-	    	}
-	    	else if ( A->bcp[SOUTH]->neighbour_face==TOP ) {
-	    	    // ic goes to jc, jc kc, kc goes to new kmax
-	    	    ic = jc; jc = kc; kc = B->kmax;
-	    	}
+	for ( size_t c=0; c<ncells_; ++c ) {
+	    int b_lo[3], b_hi[3];
+	    double x_lo[3] = { lo[c].x, lo[c].y, lo[c].z };
+	    double x_hi[3] = { hi[c].x, hi[c].y, hi[c].z };
+	    double x_0[3] = { bb_min_.x, bb_min_.y, bb_min_.z };
+	    for ( int d=0; d<3; ++d ) {
+		b_lo[d] = min( int( ( x_lo[d] - x_0[d] ) / bucket_size_ ), nbucket_[d] - 1 );
+		b_hi[d] = min( int( ( x_hi[d] - x_0[d] ) / bucket_size_ ), nbucket_[d] - 1 );
 	    }
-	    else {
-	    	// the ray is leaving the grid
-	    	// step back inside the grid
-	    	ic-=dc_[ithread][0]; 
-	    	jc-=dc_[ithread][1];
-	    	kc-=dc_[ithread][2];
-	    	// set status flag to the exit direction
-	    	status = SOUTH;
+	    for ( int bk=b_lo[2]; bk<=b_hi[2]; ++bk ) {
+		for ( int bj=b_lo[1]; bj<=b_hi[1]; ++bj ) {
+		    for ( int bi=b_lo[0]; bi<=b_hi[0]; ++bi ) {
+			size_t b = ( size_t(bk) * nbucket_[1] + bj ) * nbucket_[0] + bi;
+			if ( pass==0 ) ++bucket_start_[b+1];
+			else bucket_cells_[ fill[b]++ ] = c;
+		    }
+		}
 	    }
 	}
-	else if ( jc > A->jmax ) {
-	    // cout << "Outside the block: NORTH" << endl;
-	    if ( A->bcp[NORTH]->type_code == ADJACENT ) {
-	    	// set the block index to the neighbour
-	    	ib = A->bcp[NORTH]->neighbour_block;
-	    	B = get_block_data_ptr( ib );
-	    	// make sure ic and kc is back in-range
-	    	ic -= dc_[ithread][0]; kc -= dc_[ithread][2];
-	    	if ( A->bcp[NORTH]->neighbour_face==SOUTH ) {
-	    	    // ic stays the same, jc goes to new jmin, kc stays the same
-	    	    jc = B->jmin;
-	    	}
-	    	else if ( A->bcp[NORTH]->neighbour_face==WEST ) {
-	    	    // ic goes to new imin, jc goes to new jmax - ic, kc stays the same
-	    	    ic = B->imin; jc = B->jmax - ic + B->jmin;
-	    	}
-	    	else if ( A->bcp[NORTH]->neighbour_face==NORTH ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmax, kc stays the same
-	    	    ic = B->imax - ic + B->imin; jc = B->jmax;
-	    	}
-	    	else if ( A->bcp[NORTH]->neighbour_face==EAST ) {
-	    	    // ic goes to new imax, jc goes to ic, kc stays the same
-	    	    ic = B->imax; jc = ic;
-	    	}
-	    	else if ( A->bcp[NORTH]->neighbour_face==BOTTOM ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmax - kc, kc goes to new kmin
-	    	    ic = B->imax - ic + B->imin; jc = B->jmax - kc + B->jmin; kc = B->kmin;
-	    	}
-	    	else if ( A->bcp[NORTH]->neighbour_face==TOP ) {
-	    	    // ic stays the same, jc goes to kc, kc goes to new kmax
-	    	    jc = kc; kc = B->kmax;
-	    	}
-	    }
-	    else {
-	    	// the ray is leaving the grid
-	    	// step back inside the grid
-	    	ic-=dc_[ithread][0]; 
-	    	jc-=dc_[ithread][1];
-	    	kc-=dc_[ithread][2];
-	    	// set status flag to the exit direction
-	    	status = NORTH;
+    }
+    
+    return;
+}
+
+void
+CellFinder3D::
+connect_blocks()
+{
+    global_data &G = *get_global_data_ptr();
+    
+    // Each boundary cell on an adjacent block face is matched to the cell of the
+    // neighbour block whose face on the neighbour_face boundary has the nearest centre.
+    for ( size_t jb=0; jb<G.my_blocks.size(); ++jb ) {
+	Block * A = G.my_blocks[jb];
+	for ( int iface=0; iface<6; ++iface ) {
+	    if ( A->bcp[iface]->type_code != ADJACENT ) continue;
+	    int nb_id = A->bcp[iface]->neighbour_block;
+	    int nb_face = A->bcp[iface]->neighbour_face;
+	    if ( nb_id < 0 || block_offset_[nb_id] < 0 ) continue;	// not on this process
+	    size_t i0 = A->imin, i1 = A->imax, j0 = A->jmin, j1 = A->jmax, k0 = A->kmin, k1 = A->kmax;
+	    if ( iface==NORTH ) j0 = j1;
+	    else if ( iface==EAST ) i0 = i1;
+	    else if ( iface==SOUTH ) j1 = j0;
+	    else if ( iface==WEST ) i1 = i0;
+	    else if ( iface==TOP ) k0 = k1;
+	    else k1 = k0;
+	    for ( size_t k=k0; k<=k1; ++k ) {
+		for ( size_t j=j0; j<=j1; ++j ) {
+		    for ( size_t i=i0; i<=i1; ++i ) {
+			int c = get_cell_index( A->id, i, j, k );
+			Vector3 fc = hex_face_centre( A->get_cell( i, j, k ), iface );
+			int b = get_bucket( fc );
+			if ( b < 0 ) continue;
+			int c_nb = -1;
+			double d_min = 0.0;
+			for ( size_t ibc=bucket_start_[b]; ibc<bucket_start_[b+1]; ++ibc ) {
+			    int cb = bucket_cells_[ibc];
+			    if ( int(ijk_[4*cb]) != nb_id ) continue;
+			    FV_Cell * cell_nb = get_block_data_ptr( nb_id )->get_cell( ijk_[4*cb+1], ijk_[4*cb+2], ijk_[4*cb+3] );
+			    double d = vabs( hex_face_centre( cell_nb, nb_face ) - fc );
+			    if ( c_nb < 0 || d < d_min ) {
+				c_nb = cb; d_min = d;
+			    }
+			}
+			if ( c_nb >= 0 && d_min < 1.0e-6 * size_[c] ) {
+			    nbr_[6*c+iface] = c_nb;
+			}
+			else {
+			    cout << "CellFinder3D::connect_blocks()" << endl
+				 << "No matching cell found in block " << nb_id << " for cell ["
+				 << i << "," << j << "," << k << "] of block " << A->id << endl;
+			}
+		    }
+		}
 	    }
 	}
-	else if ( kc < A->kmin ) {
-	    // cout << "Outside the block: BOTTOM" << endl;
-	    if ( A->bcp[BOTTOM]->type_code == ADJACENT ) {
-	    	// set the block index to the neighbour
-	    	ib = A->bcp[BOTTOM]->neighbour_block;
-	    	B = get_block_data_ptr( ib );
-	    	// make sure ic and jc are back in-range
-	    	ic -= dc_[ithread][0]; jc -= dc_[ithread][1];
-	    	if ( A->bcp[BOTTOM]->neighbour_face==SOUTH ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmin, kc goes to new kmax - jc
-	    	    ic = B->imax - ic + B->imin; kc = B->kmax - jc + B->kmin;  jc = B->jmin;
-	    	}
-	    	else if ( A->bcp[BOTTOM]->neighbour_face==WEST ) {
-	    	    // ic goes to new imin, jc goes to ic, kc goes to new kmax - jc
-	    	    ic = B->imin; kc = B->kmax - jc + B->kmin; jc = ic;
-	    	}
-	    	else if ( A->bcp[BOTTOM]->neighbour_face==NORTH ) {
-	    	    // ic stays the same, jc goes to new jmax, kc goes to new kmax - jc
-	    	    kc = B->kmax - jc + B->kmin; jc = B->jmax;
-	    	}
-	    	else if ( A->bcp[BOTTOM]->neighbour_face==EAST ) {
-	    	    // ic goes to new imax, jc goes to new jmax - ic, kc goes to new kmax - jc
-	    	    kc = B->kmax - jc + B->kmin; jc = B->jmax - ic + B->jmin; ic = B->imax;
-	    	}
-	    	else if ( A->bcp[BOTTOM]->neighbour_face==BOTTOM ) {
-	    	    // ic goes to new imax - ic, jc stays the same, kc goes to new kmin
-	    	    ic = B->imax - ic + B->imin; kc = B->kmin;
-	    	}
-	    	else if ( A->bcp[BOTTOM]->neighbour_face==TOP ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmax - jc, kc goes to new kmax
-	    	    ic = B->imax - ic + B->imin; jc = B->jmax - jc + B->jmin; kc = B->kmax;
-	    	}
-	    }
-	    else {
-	    	// the ray is leaving the grid
-	    	// step back inside the grid
-	    	ic-=dc_[ithread][0]; 
-	    	jc-=dc_[ithread][1];
-	    	kc-=dc_[ithread][2];
-	    	// set status flag to the exit direction
-	    	status = BOTTOM;
-	    }
+    }
+    
+    return;
+}
+
+int
+CellFinder3D::
+get_cell_index( size_t ib, size_t ic, size_t jc, size_t kc ) const
+{
+    if ( block_offset_[ib] < 0 ) return -1;
+    Block * A = get_block_data_ptr( ib );
+    return block_offset_[ib] + int( ( ( kc - A->kmin ) * block_nj_[ib] + ( jc - A->jmin ) ) * block_ni_[ib] + ( ic - A->imin ) );
+}
+
+void
+CellFinder3D::
+get_cell_indices( int c, size_t &ib, size_t &ic, size_t &jc, size_t &kc ) const
+{
+    ib = ijk_[4*c]; ic = ijk_[4*c+1]; jc = ijk_[4*c+2]; kc = ijk_[4*c+3];
+}
+
+int
+CellFinder3D::
+get_bucket( const Vector3 &p ) const
+{
+    if ( bucket_start_.empty() ) return -1;
+    double x[3] = { p.x - bb_min_.x, p.y - bb_min_.y, p.z - bb_min_.z };
+    int b[3];
+    for ( int d=0; d<3; ++d ) {
+	if ( x[d] < 0.0 ) return -1;
+	b[d] = int( x[d] / bucket_size_ );
+	if ( b[d] >= nbucket_[d] ) return -1;
+    }
+    return ( b[2] * nbucket_[1] + b[1] ) * nbucket_[0] + b[0];
+}
+
+bool
+CellFinder3D::
+contains( int c, const Vector3 &p ) const
+{
+    // NOTE: on a face is as good as in the cell
+    const double *f = &faces_[24*c];
+    for ( int iface=0; iface<6; ++iface, f+=4 ) {
+	if ( f[0]*p.x + f[1]*p.y + f[2]*p.z > f[3] ) return false;
+    }
+    return true;
+}
+
+int
+CellFinder3D::
+locate( const Vector3 &p ) const
+{
+    int b = get_bucket( p );
+    if ( b < 0 ) return -1;
+    for ( size_t ibc=bucket_start_[b]; ibc<bucket_start_[b+1]; ++ibc ) {
+	if ( contains( bucket_cells_[ibc], p ) ) return bucket_cells_[ibc];
+    }
+    return -1;
+}
+
+int
+CellFinder3D::
+find_cell( const Vector3 &p, size_t &ib, size_t &ic, size_t &jc, size_t &kc )
+{
+    // &p -> address of spatial point we are looking for
+    // ib -> block index
+    // ic, jc, kc -> cell indices (the guess on entry)
+    
+    MarchState &ms = state_[omp_get_thread_num()];
+    
+    int c = get_cell_index( ib, ic, jc, kc );
+    if ( c < 0 ) {
+	cout << "CellFinder3D::find_cell()" << endl
+	     << "Block " << ib << " is not on this process." << endl;
+	return ERROR;
+    }
+    
+    // March from the last point found when the guess is its cell,
+    // otherwise from the centre of the guessed cell.
+    Vector3 q = ( ms.cell==c ) ? ms.p : centre_[c];
+    Vector3 dir = p - q;
+    
+    // A long jump is seeded from the bucket index; if p is in no bucketed
+    // cell it is outside the grid and the march finds where the ray left.
+    if ( vabs( dir ) > CELL_FINDER_JUMP_CELLS * size_[c] ) {
+	int c_jump = locate( p );
+	if ( c_jump >= 0 ) {
+	    get_cell_indices( c_jump, ib, ic, jc, kc );
+	    ms.cell = c_jump; ms.p = p;
+	    return INSIDE_GRID;
 	}
-	else if ( kc > A->kmax ) {
-	    // cout << "Outside the block: TOP" << endl;
-	    if ( A->bcp[TOP]->type_code == ADJACENT ) {
-	    	// set the block index to the neighbour
-	    	ib = A->bcp[TOP]->neighbour_block;
-	    	B = get_block_data_ptr( ib );
-	    	// make sure ic and jc are back in-range
-	    	ic -= dc_[ithread][0]; jc -= dc_[ithread][1];
-	    	if ( A->bcp[TOP]->neighbour_face==SOUTH ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmin, kc goes to jc
-	    	    ic = B->imax - ic + B->imin; kc = jc;  jc = B->jmin;
-	    	}
-	    	else if ( A->bcp[TOP]->neighbour_face==WEST ) {
-	    	    // ic goes to new imin, jc goes to ic, kc goes to jc
-	    	    ic = B->imin; kc = jc; jc = ic;
-	    	}
-	    	else if ( A->bcp[TOP]->neighbour_face==NORTH ) {
-	    	    // ic stays the same, jc goes to new jmax, kc goes to jc
-	    	    kc = jc; jc = B->jmax;
-	    	}
-	    	else if ( A->bcp[TOP]->neighbour_face==EAST ) {
-	    	    // ic goes to new imax, jc goes to new jmax - ic, kc goes to jc
-	    	    kc = jc; jc = B->jmax - ic + B->jmin; ic = B->imax;
-	    	}
-	    	else if ( A->bcp[TOP]->neighbour_face==BOTTOM ) {
-	    	    // ic goes to new imax - ic, jc goes to new jmax - jc, kc goes to new kmin
-	    	    ic = B->imax - ic + B->imin; jc = B->jmax - jc + B->jmin; kc = B->kmin;
-	    	}
-	    	else if ( A->bcp[TOP]->neighbour_face==TOP ) {
-	    	    // ic goes to new imax - ic, jc stays the same, kc goes to new kmax
-	    	    ic = B->imax - ic + B->imin; kc = B->kmax;
-	    	}
-	    }
-	    else {
-	    	// the ray is leaving the grid
-	    	// step back inside the grid
-	    	ic-=dc_[ithread][0]; 
-	    	jc-=dc_[ithread][1];
-	    	kc-=dc_[ithread][2];
-	    	// set status flag to the exit direction
-	    	status = TOP;
+    }
+    
+    int entry = -1;
+    size_t count = 0;
+    while ( true ) {
+	// Leave c through the face the segment q->p crosses first;
+	// if it crosses none before p, then p is in c.
+	const double *f = &faces_[24*c];
+	double t_exit = 1.0;
+	int exit_face = -1;
+	for ( int iface=0; iface<6; ++iface, f+=4 ) {
+	    if ( iface==entry ) continue;
+	    double n_dir = f[0]*dir.x + f[1]*dir.y + f[2]*dir.z;
+	    if ( n_dir <= 0.0 ) continue;
+	    double t = ( f[3] - ( f[0]*q.x + f[1]*q.y + f[2]*q.z ) ) / n_dir;
+	    if ( t < t_exit ) {
+		t_exit = t; exit_face = iface;
 	    }
 	}
-	// else -> do nothing, retain INSIDE_GRID status
+	if ( exit_face < 0 ) break;
 	
-	A = get_block_data_ptr( ib );
-	cell = A->get_cell( ic, jc, kc );
+	int c_nb = nbr_[6*c+exit_face];
+	if ( c_nb < 0 ) {
+	    // the ray is leaving the grid through this face of the block
+	    get_cell_indices( c, ib, ic, jc, kc );
+	    ms.cell = -1;
+	    return exit_face;
+	}
+	// the face we came in through, in the neighbour's frame
+	if ( ijk_[4*c_nb]==ijk_[4*c] )
+	    entry = opposite_face[exit_face];
+	else
+	    entry = get_block_data_ptr( ijk_[4*c] )->bcp[exit_face]->neighbour_face;
+	c = c_nb;
 	
-	// break if we are no longer inside the grid
-	if ( status != INSIDE_GRID ) break;
-
-	// Otherwise test the predicted cell
-	test_cell( cell, p, dc_[ithread] );
-	ic += dc_[ithread][0]; jc += dc_[ithread][1]; kc += dc_[ithread][2];
-
-	// increment search counter
-	++count;
 	// A conservative check to see that we are not in an 'infinite' loop
-	if ( count > (A->imax + A->jmax + A->kmax) ) {
+	if ( ++count > ncells_ ) {
 	    cout << "Cell search seems to be looping." << endl;
-	    status = ERROR;
-	    break;
+	    get_cell_indices( c, ib, ic, jc, kc );
+	    ms.cell = -1;
+	    return ERROR;
 	}
     }
     
-    return status;
+    get_cell_indices( c, ib, ic, jc, kc );
+    ms.cell = c; ms.p = p;
+    
+    return INSIDE_GRID;
 }
 
 static size_t hex_vertex_indices[6][3] = { { 2, 6, 7 },
@@ -636,36 +678,36 @@ test_cell( const FV_Cell * cell, const Vector3 &p, int *dc )
 {
     // NOTE: this function should be applicable to all polyhedral cells
     
-    size_t ithread = omp_get_thread_num();
+    Vector3 vp[3];
+    double a[6];
     
     // calculate 'a' for all faces
-    for ( size_t iface=0; iface<a_[ithread].size(); ++iface ) {
-    	for ( size_t ivtx=0; ivtx<vp_[ithread].size(); ++ ivtx ) {
+    for ( size_t iface=0; iface<6; ++iface ) {
+    	for ( size_t ivtx=0; ivtx<3; ++ ivtx ) {
     	    // get ordered (clockwise) vertex indices from hex_vertex_indices
-    	    vp_[ithread][ivtx] = cell->vtx[ hex_vertex_indices[iface][ivtx] ]->pos[0] - p;
+    	    vp[ivtx] = cell->vtx[ hex_vertex_indices[iface][ivtx] ]->pos[0] - p;
     	}
-    	a_[ithread][iface] = dot( vp_[ithread][0], cross( vp_[ithread][1], vp_[ithread][2] ) );
+    	a[iface] = dot( vp[0], cross( vp[1], vp[2] ) );
     }
     
-    // if an a_ value is negative, it is on the 'correct' side of that face
-    // if all a_ values are negative, then point is inside cell
+    // if an a value is negative, it is on the 'correct' side of that face
+    // if all a values are negative, then point is inside cell
     // NOTE: - we are assuming on the line is as good as in the cell.
     //       - and that eilmer3 will be be consistent with vertex indices.
     
     dc[0] = 0; dc[1] = 0; dc[2] = 0;
     
     // i direction
-    if ( a_[ithread][EAST] > 0.0 && a_[ithread][WEST] < 0.0 ) dc[0] = 1;
-    else if ( a_[ithread][EAST] < 0.0 && a_[ithread][WEST] > 0.0 ) dc[0] = -1;
+    if ( a[EAST] > 0.0 && a[WEST] < 0.0 ) dc[0] = 1;
+    else if ( a[EAST] < 0.0 && a[WEST] > 0.0 ) dc[0] = -1;
     
     // j direction
-    if ( a_[ithread][NORTH] > 0.0 && a_[ithread][SOUTH] < 0.0 ) dc[1] = 1;
-    else if ( a_[ithread][NORTH] < 0.0 && a_[ithread][SOUTH] > 0.0 ) dc[1] = -1;
+    if ( a[NORTH] > 0.0 && a[SOUTH] < 0.0 ) dc[1] = 1;
+    else if ( a[NORTH] < 0.0 && a[SOUTH] > 0.0 ) dc[1] = -1;
     
     // k direction
-    if ( a_[ithread][TOP] > 0.0 && a_[ithread][BOTTOM] < 0.0 ) dc[2] = 1;
-    else if ( a_[ithread][TOP] < 0.0 && a_[ithread][BOTTOM] > 0.0 ) dc[2] = -1;
+    if ( a[TOP] > 0.0 && a[BOTTOM] < 0.0 ) dc[2] = 1;
+    else if ( a[TOP] < 0.0 && a[BOTTOM] > 0.0 ) dc[2] = -1;
     
     return;
 }
-
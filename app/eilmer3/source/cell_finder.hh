@@ -11,6 +11,10 @@
 #include "block.hh"
 #include "cell.hh"
 
+#define CELL_FINDER_JUMP_CELLS       8.0	// march length (in cell sizes) above which the bucket index is tried
+#define CELL_FINDER_CELLS_PER_BUCKET 4.0
+#define CELL_FINDER_MAX_BUCKETS      256	// per direction
+
 class CellFinder {
 public:
     CellFinder( size_t nvertices );
@@ -45,6 +49,16 @@ private:
     std::vector< int* > dc_;
 };
 
+/// \brief Ray-marching cell finder for hexahedral grids
+///
+/// The cells of the local blocks are flattened into one table holding,
+/// for each of the six faces, the outward plane (n, d with n.x <= d inside)
+/// and the table index of the neighbour across it, including neighbours
+/// in adjacent blocks.  find_cell() marches the segment from the last
+/// point found (or the guessed cell's centre) to the new point, leaving
+/// each cell through the face the segment exits first, so a step to the
+/// next cell along a ray costs one set of plane tests and one lookup.
+/// Long jumps are seeded from a uniform bucket index of the cells.
 class CellFinder3D : public CellFinder {
 public:
     CellFinder3D( size_t nvertices = 8 );
@@ -57,10 +71,48 @@ public:
     void test_cell( const FV_Cell * cell, const Vector3 &p, int *dc );
     
 private:
-    // NOTE: we have a vectors here to allow for multiple threads
-    std::vector< std::vector<Vector3> > vp_;
-    std::vector< std::vector<double> > a_;
-    std::vector< int* > dc_;
+    void build_cell_table();
+    
+    void build_spatial_index();
+    
+    void connect_blocks();
+    
+    int get_cell_index( size_t ib, size_t ic, size_t jc, size_t kc ) const;
+    
+    void get_cell_indices( int c, size_t &ib, size_t &ic, size_t &jc, size_t &kc ) const;
+    
+    int get_bucket( const Vector3 &p ) const;
+    
+    bool contains( int c, const Vector3 &p ) const;
+    
+    int locate( const Vector3 &p ) const;
+    
+private:
+    // Local blocks: first table index (-1 if not local) and extents
+    std::vector<int> block_offset_;
+    std::vector<size_t> block_ni_, block_nj_;
+    
+    // The cell table
+    size_t ncells_;
+    std::vector<double> faces_;		// [cell][face][nx, ny, nz, d]
+    std::vector<int> nbr_;		// [cell][face], -1 at the edge of the grid
+    std::vector<Vector3> centre_;
+    std::vector<double> size_;		// largest centre to face distance (x2)
+    std::vector<size_t> ijk_;		// [cell][ib, ic, jc, kc]
+    
+    // Uniform bucket index of the cell bounding boxes
+    Vector3 bb_min_;
+    double bucket_size_;
+    int nbucket_[3];
+    std::vector<size_t> bucket_start_;
+    std::vector<int> bucket_cells_;
+    
+    // NOTE: one march state per thread
+    struct MarchState {
+	int cell;	// table index of the cell holding p, -1 if none
+	Vector3 p;
+    };
+    std::vector<MarchState> state_;
 };
 
 #endif
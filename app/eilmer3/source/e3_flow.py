@@ -24,6 +24,8 @@ from copy import copy
 import struct
 import base64
 import textwrap
+import zlib
+from cStringIO import StringIO
 
 #----------------------------------------------------------------------------
 # Utility functions to help set up gas models and flow states in the
@@ -703,6 +705,55 @@ class StructuredGridFlow(object):
 
 # end of class StructuredGridFlow
 
+def flow_collection_file_name(rootName, tindx_str):
+    """
+    The single file holding all blocks of a flow solution (single_flow_file_flag).
+    """
+    return os.path.join("flow", "t%04s" % tindx_str, rootName+".flow.all.t%04s" % tindx_str)
+
+def read_flow_collection_index(fileName):
+    """
+    Returns (compressed, index) from the header of a flow collection file,
+    where index maps the block id to the (offset, length) of its data.
+    """
+    fp = open(fileName, "rb")
+    if fp.readline() != "eilmer3 flow collection 1\n":
+        raise RuntimeError("Not an Eilmer3 flow collection file: " + fileName)
+    compressed = (fp.readline().split()[1] == "gzip")
+    nblock = int(fp.readline().split()[1])
+    index = {}
+    for ib in range(nblock):
+        tokens = fp.readline().split()
+        index[int(tokens[1])] = (int(tokens[2]), int(tokens[3]))
+    if fp.readline().strip() != "end_header":
+        raise RuntimeError("Flow collection header is incomplete: " + fileName)
+    fp.close()
+    return compressed, index
+
+def open_flow_file(rootName, jb, tindx_str, zipFiles=False):
+    """
+    Returns a file object from which the flow data of block jb may be read.
+
+    As for the restart in Eilmer3 itself, the flow collection file for this
+    tindx is used if it is present, otherwise the per-block flow file.
+    """
+    collectionName = flow_collection_file_name(rootName, tindx_str)
+    if os.path.exists(collectionName):
+        compressed, index = read_flow_collection_index(collectionName)
+        offset, length = index[jb]
+        fp = open(collectionName, "rb")
+        fp.seek(offset)
+        data = fp.read(length)
+        fp.close()
+        if compressed:
+            data = zlib.decompress(data, 16+zlib.MAX_WBITS)
+        return StringIO(data)
+    fileName = rootName+".flow"+(".b%04d.t%04s" % (jb, tindx_str))
+    fileName = os.path.join("flow", "t%04s" % tindx_str, fileName)
+    if zipFiles and (os.path.exists(fileName+".gz") or not os.path.exists(fileName)):
+        return GzipFile(fileName+".gz", "rb")
+    return open(fileName, "r")
+
 def read_time_from_flow_file(rootName, tindx, zipFiles=False):
     """
     We'll find the simulation time on the first line of the flow file.
@@ -714,13 +765,8 @@ def read_time_from_flow_file(rootName, tindx, zipFiles=False):
         tindx_str = tindx
     else:
         raise RuntimeError("WTF: tindx is neither an int nor string.")
-    fileName = rootName+".flow"+(".b0000.t%04s" % tindx_str)
-    fileName = os.path.join("flow", "t%04s" % tindx_str, fileName)
-    print "Read simulation time from", fileName
-    if zipFiles: 
-        fp = GzipFile(fileName+".gz", "rb")
-    else:
-        fp = open(fileName, "r")
+    print "Read simulation time from flow data for block 0, tindx", tindx_str
+    fp = open_flow_file(rootName, 0, tindx_str, zipFiles)
     line = fp.readline().strip().strip("\0")
     t = float(line)
     fp.close()
@@ -759,10 +805,7 @@ def read_all_blocks(rootName, nblock, tindx, zipFiles=False, movingGrid=False,
         fileName = rootName+".flow"+(".b%04d.t%04s" % (jb, tindx_str))
         fileName = os.path.join("flow", "t%04s" % tindx_str, fileName)
         if verbosity_level > 0: print "Read cell-centre flow data from", fileName
-        if zipFiles: 
-            fp = GzipFile(fileName+".gz", "rb")
-        else:
-            fp = open(fileName, "r")
+        fp = open_flow_file(rootName, jb, tindx_str, zipFiles)
         flow.append(StructuredGridFlow())
         flow[-1].read(fp)
         fp.close()
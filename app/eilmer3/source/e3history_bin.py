@@ -0,0 +1,130 @@
+#! /usr/bin/env python
+"""
+e3history_bin.py -- Convert binary history files to the text history format.
+
+With history_buffered_flag set, Eilmer3 writes the history-cell samples
+for all blocks on each process to hist/<job>.hist.rankNNNN.bin.
+This program splits those files into the usual per-block text files,
+hist/<job>.hist.bNNNN, so that e3history.py and other tools can read them.
+
+.. Versions:
+   18-Oct-2026
+"""
+
+# ----------------------------------------------------------------------
+#
+import sys
+import os
+from array import array
+from getopt import getopt
+
+shortOptions = ""
+longOptions = ["help", "output-dir="]
+
+def printUsage():
+    print ""
+    print "Usage: e3history_bin.py" + \
+          " [--help]" + \
+          " [--output-dir=<directory>]" + \
+          " <binary-history-file> [<binary-history-file> ...]"
+    print ""
+    print "Notes:"
+    print "  Each text file is written to the output directory (default: that of"
+    print "  the binary file) with the name <job>.hist.bNNNN, replacing any existing file."
+    print "  Only the variables selected with history_variables are present."
+    print ""
+    print "Example:"
+    print "  $ e3history_bin.py hist/m4cone.hist.rank0000.bin hist/m4cone.hist.rank0001.bin"
+    return
+
+def read_header(fp):
+    """
+    Returns the variable names, a list of (block id, list of (i,j,k)) and
+    the number of doubles per record.
+    """
+    line = fp.readline()
+    if not line.startswith("eilmer3 binary history"):
+        raise RuntimeError("Not an Eilmer3 binary history file.")
+    var_names = []
+    blocks = []
+    record_size = 0
+    while True:
+        line = fp.readline()
+        if line == "":
+            raise RuntimeError("Binary history file ends within its header.")
+        tokens = line.split()
+        if len(tokens) == 0: continue
+        if tokens[0] == "end_header":
+            break
+        elif tokens[0] == "variables:":
+            var_names = [t.strip('"') for t in tokens[1:]]
+        elif tokens[0] == "block":
+            ncell = int(tokens[2])
+            ijk = [tuple(int(t) for t in tokens[3+3*ih:6+3*ih]) for ih in range(ncell)]
+            blocks.append((int(tokens[1]), ijk))
+        elif tokens[0] == "record_size":
+            record_size = int(tokens[1])
+    nvar = len(var_names)
+    if record_size != 1 + nvar * sum([len(ijk) for (jb, ijk) in blocks]):
+        raise RuntimeError("Inconsistent record size in binary history header.")
+    return var_names, blocks, record_size
+
+def convert_file(filename, output_dir):
+    fp = open(filename, "rb")
+    var_names, blocks, record_size = read_header(fp)
+    nvar = len(var_names)
+    # The shock-detector flag S is an integer in the text format.
+    formats = ["%d" if name == "S" else "%.16e" for name in var_names]
+    job = os.path.basename(filename).split(".hist.")[0]
+    if output_dir == None:
+        output_dir = os.path.dirname(filename)
+    # One output text file per block, with the same header as Block::write_history.
+    outfiles = []
+    for (jb, ijk) in blocks:
+        outname = os.path.join(output_dir, "%s.hist.b%04d" % (job, jb))
+        fout = open(outname, "w")
+        fout.write('# "time" "i" "j" "k" ')
+        fout.write(" ".join(['"%s"' % name for name in var_names]) + "\n")
+        outfiles.append(fout)
+    nrecords = 0
+    chunk_records = 1000
+    while True:
+        data = array('d')
+        try:
+            data.fromfile(fp, chunk_records * record_size)
+        except EOFError:
+            pass # array keeps whatever was read
+        nread = len(data) // record_size
+        for ir in range(nread):
+            rec = data[ir*record_size:(ir+1)*record_size]
+            t = rec[0]
+            pos = 1
+            for ib, (jb, ijk) in enumerate(blocks):
+                fout = outfiles[ib]
+                for (i, j, k) in ijk:
+                    fout.write("%e %d %d %d " % (t, i, j, k))
+                    fout.write(" ".join([f % v for (f, v) in zip(formats, rec[pos:pos+nvar])]) + "\n")
+                    pos += nvar
+        nrecords += nread
+        if nread < chunk_records:
+            break
+    fp.close()
+    for fout in outfiles: fout.close()
+    print "%s: %d records for blocks %s" % (filename, nrecords, [jb for (jb, ijk) in blocks])
+    return
+
+def main(uoDict, args):
+    if uoDict.has_key("--help") or len(args) == 0:
+        printUsage()
+        return
+    output_dir = uoDict.get("--output-dir", None)
+    for filename in args:
+        convert_file(filename, output_dir)
+    return
+
+# ----------------------------------------------------------------------
+
+if __name__ == '__main__':
+    userOptions = getopt(sys.argv[1:], shortOptions, longOptions)
+    uoDict = dict(userOptions[0])
+    main(uoDict, userOptions[1])
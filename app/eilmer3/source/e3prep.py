@@ -390,6 +390,12 @@ class GlobalData(object):
       to the console.
     * cfl_count: (int) The number of time steps between checking the CFL number.
     * fixed_time_step: (boolean) Flag to indicate fixed time-stepping
+    * local_time_stepping: (boolean) For steady-state runs, let each cell advance
+      at its own CFL-limited time step, rather than all cells taking the time step
+      of the most restrictive cell.  Only the converged solution is meaningful and
+      the simulation time becomes a pseudo-time, so watch the residuals instead.
+      Not available with moving grids, implicit updates, fixed time steps or
+      the separate chemistry, thermal energy exchange and k-omega source updates.
     * max_invalid_cells: (int) Number of cells that will be tolerated without too
       much complaint.
     * dt_reduction_factor: (float) If a time step fails because of any bad cells,
@@ -433,6 +439,29 @@ class GlobalData(object):
       of that file to see the map between time index and actual simulation time.
     * dt_history: (float) Period (in seconds) between writing the data for the
       selected cells to the history files.
+    * history_buffered_flag: (0/1) Set to 1 to hold the history-cell samples in memory
+      and write them in binary chunks to one file per process (hist/*.hist.rankNNNN.bin).
+      Use e3history_bin.py to convert these to the usual text history files.
+    * history_step_interval: (int) With buffered history, sample every this many steps.
+      Leave as 0 (the default) to sample at dt_history intervals.
+    * history_buffer_records: (int) With buffered history, the number of samples held
+      in memory before they are handed to the writer thread.
+    * history_variables: (list of strings) With buffered history, the names of the
+      cell variables to record, for example ["p", "T[0]"].  Empty (the default) means all.
+    * async_write_flag: (0/1) Set to 1 to copy the flow solution into memory at each dt_plot
+      and let a background thread write the flow files while the time stepping continues.
+      At most one solution is held in memory at a time.
+    * single_flow_file_flag: (0/1) Set to 1 to write each flow solution as a single file,
+      flow/tNNNN/<job>.flow.all.tNNNN, holding all blocks behind an index.
+      The MPI processes write it together with MPI-IO.  e3post and restarts read either form.
+    * grid_sequence_levels: (int) For steady-state runs, the number of coarse grid levels
+      on which to converge the flow before continuing on the full grid.  Each level takes
+      every other vertex of the one above, so the block cell counts must be divisible by
+      2**grid_sequence_levels.  Used only when starting from tindx 0.  Default 0, for none.
+    * grid_sequence_steps: (int) The maximum number of steps on each coarse grid level.
+    * grid_sequence_tolerance: (float) A coarse grid level is finished early when the
+      global mass residual falls below this value.  Leave as 0.0 to always take
+      grid_sequence_steps steps.
     * write_at_step: (int) Update step at which flow field data will be written.
       To distinguish this data set from the regularly written with dt_plot, the index tag
       for this solution is "xxxx".  Leave as the default value 0 to not write such a solution. 
@@ -484,10 +513,14 @@ class GlobalData(object):
                 'interpolation_type', 'interpolate_in_local_frame', 'sequence_blocks', \
                 'print_count', 'cfl_count', 'max_invalid_cells', 'dt_reduction_factor', \
                 'max_time', 'max_step', 'dt_plot', 'dt_history', "write_at_step", \
+                'history_buffered_flag', 'history_step_interval', \
+                'history_buffer_records', 'history_variables', \
+                'async_write_flag', 'single_flow_file_flag', \
+                'grid_sequence_levels', 'grid_sequence_steps', 'grid_sequence_tolerance', \
                 'halt_on_large_flow_change', 'tolerance_in_T', \
                 'displacement_thickness', 'time_average_flag', 'perturb_flag', \
                 'perturb_frac', 'tav_0', 'tav_f', 'dt_av', \
-                'fixed_time_step', 'apply_limiter_flag', \
+                'fixed_time_step', 'local_time_stepping', 'apply_limiter_flag', \
                 'extrema_clipping_flag', 'overshoot_factor', \
                 'energy_exchange_flag', 'energy_exchange_update', 'T_frozen_energy', \
                 'udf_file', 'udf_source_vector_flag', \
@@ -571,6 +604,7 @@ class GlobalData(object):
         self.viscous_signal_factor = 1.0
         self.stringent_cfl = 0
         self.fixed_time_step = False
+        self.local_time_stepping = False
         self.dt_reduction_factor = 0.2
         self.t0 = 0.0 
         # may be useful to change t0 if we are restarting from another job
@@ -603,6 +637,15 @@ class GlobalData(object):
         self.dt_moving = 0.0
         self.dt_plot = 1.0e-3
         self.dt_history = 1.0e-3
+        self.history_buffered_flag = 0
+        self.history_step_interval = 0
+        self.history_buffer_records = 1000
+        self.history_variables = []
+        self.async_write_flag = 0
+        self.single_flow_file_flag = 0
+        self.grid_sequence_levels = 0
+        self.grid_sequence_steps = 1000
+        self.grid_sequence_tolerance = 0.0
         self.write_at_step = 0
         self.conjugate_ht_flag = 0
         self.conjugate_ht_file = "dummy_ht_file"
@@ -661,6 +704,7 @@ class GlobalData(object):
         fp.write("dt = %e\n" % self.dt)
         fp.write("dt_max = %e\n" % self.dt_max)
         fp.write("fixed_time_step = %s\n" % self.fixed_time_step)
+        fp.write("local_time_stepping = %s\n" % self.local_time_stepping)
         fp.write("dt_reduction_factor = %e\n" % self.dt_reduction_factor)
         fp.write("cfl = %e\n" % self.cfl)
         fp.write("viscous_signal_factor = %e\n" % self.viscous_signal_factor)
@@ -762,6 +806,16 @@ class GlobalData(object):
         fp.write("artificial_diffusion_flag = %d\n" % self.artificial_diffusion_flag)                            
         fp.write("artificial_kappa_2 = %e\n"% self.artificial_kappa_2)
         fp.write("artificial_kappa_4 = %e\n"% self.artificial_kappa_4)                       
+        fp.write("history_buffered_flag = %d\n" % self.history_buffered_flag)
+        fp.write("history_step_interval = %d\n" % self.history_step_interval)
+        fp.write("history_buffer_records = %d\n" % self.history_buffer_records)
+        if len(self.history_variables) > 0:
+            fp.write("history_variables = %s\n" % " ".join(self.history_variables))
+        fp.write("async_write_flag = %d\n" % self.async_write_flag)
+        fp.write("single_flow_file_flag = %d\n" % self.single_flow_file_flag)
+        fp.write("grid_sequence_levels = %d\n" % self.grid_sequence_levels)
+        fp.write("grid_sequence_steps = %d\n" % self.grid_sequence_steps)
+        fp.write("grid_sequence_tolerance = %e\n" % self.grid_sequence_tolerance)
         #
         if self.velocity_buckets > 0:
             tstr_x = "vcoords_x ="
@@ -9,6 +9,8 @@
  *            Actually delegated the copying to the helper function 
  *            copy_cell_to_cell().
  * \version 02-Mar-08 Elmer3 port
+ * \version 18-Oct-2026 Ordinary exchanges go through the cell lists
+ *            built by Block::build_exchange_maps().
  *
  */
 
@@ -60,7 +62,7 @@ int copy_boundary_data_2D(int jb, int type_of_copy, size_t gtl)
     other_bdp = get_block_data_ptr(other_block);
     if (other_block >= 0) {
         other_bndry = bdp->bcp[NORTH]->neighbour_face;
-        copy_to_north_boundary_2D(bdp, other_bdp, other_bndry, type_of_copy, gtl);   
+        copy_to_boundary_2D(bdp, NORTH, other_bdp, other_bndry, type_of_copy, gtl);   
     }
     /* note: the variable "diaphragm_block" defaults to -1 and so will never refer
      *       to an actual block, unless the case id for a diaphragm rupture simulation
@@ -80,7 +82,7 @@ int copy_boundary_data_2D(int jb, int type_of_copy, size_t gtl)
 					       G->diaphragm_rupture_diameter, G->sim_time,
 					       gtl);
         } else {
-            copy_to_east_boundary_2D(bdp, other_bdp, other_bndry, type_of_copy, gtl);
+            copy_to_boundary_2D(bdp, EAST, other_bdp, other_bndry, type_of_copy, gtl);
         }
     }
 
@@ -88,7 +90,7 @@ int copy_boundary_data_2D(int jb, int type_of_copy, size_t gtl)
     other_bdp = get_block_data_ptr(other_block);
     if (other_block >= 0) {
         other_bndry = bdp->bcp[SOUTH]->neighbour_face;
-        copy_to_south_boundary_2D(bdp, other_bdp, other_bndry, type_of_copy, gtl);
+        copy_to_boundary_2D(bdp, SOUTH, other_bdp, other_bndry, type_of_copy, gtl);
     }
 
     /* if you are the block at the downstream side of the diaphragm
@@ -104,7 +106,7 @@ int copy_boundary_data_2D(int jb, int type_of_copy, size_t gtl)
 					       G->diaphragm_rupture_diameter, G->sim_time,
 					       gtl);
         } else {
-            copy_to_west_boundary_2D(bdp, other_bdp, other_bndry, type_of_copy, gtl);
+            copy_to_boundary_2D(bdp, WEST, other_bdp, other_bndry, type_of_copy, gtl);
         }
     }
 
@@ -299,489 +301,44 @@ int copy_to_west_boundary_diaphragm_2D(Block *A,
 
 
 /** \brief Copy data from the B_bndry (NORTH, EAST, SOUTH, WEST)
- *         of (source) block B to the NORTH boundary of (target) block A.
+ *         of (source) block B to the A_bndry of (target) block A.
  *
- *  \param  A       : pointer to the target block
- *  \param  B       : pointer to the source block
- *  \param B_bndry  : value specifying the source block boundary
- *
- */
-int copy_to_north_boundary_2D(Block *A, Block *B, int B_bndry,
-			      int type_of_copy, size_t gtl)
-{
-    int i_A, j_A, i_B, j_B;
-    int ifirst, ilast;
-    FV_Cell *src, *dest;
-    if (B_bndry == SOUTH) {
-        /*
-         * Copy data from cells adjacent to the SOUTH boundary of
-         * block B to the NORTH boundary ghost cells of block A.
-         */
-        j_A = A->jmax + 1;
-        j_B = B->jmin;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            i_B = B->imin + (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A+1);
-            src = B->get_cell(i_B,j_B+1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == EAST) {
-        /*
-         * Copy data from cells adjacent to the EAST boundary of
-         * block B to the NORTH boundary ghost cells of block A.
-         */
-        j_A = A->jmax + 1;
-        i_B = B->imax;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            j_B = B->jmin + (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A+1);
-            src = B->get_cell(i_B-1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == NORTH) {
-        /*
-         * Copy data from cells adjacent to the NORTH boundary of
-         * block B to the NORTH boundary ghost cells of block A.
-         */
-        j_A = A->jmax + 1;
-        j_B = B->jmax;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            i_B = B->imax - (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A+1);
-            src = B->get_cell(i_B,j_B-1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == WEST) {
-        /*
-         * Copy data from cells adjacent to the WEST boundary of
-         * block B to the NORTH boundary ghost cells of block A.
-         */
-        j_A = A->jmax + 1;
-        i_B = B->imin;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            j_B = B->jmax - (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A+1);
-            src = B->get_cell(i_B+1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else {
-        printf("\ncopy_to_north_boundary: invalid boundary\n");
-        exit(VALUE_ERROR);
-    }   /* end if */
-
-    return SUCCESS;
-}   /* end copy_to_north_boundary_2D() */
-
-
-/** \brief Copy data from the B_bndry (NORTH, EAST, SOUTH, WEST)
- *         of (source) block B to the EAST boundary of (target) block A.
+ * The ghost-cell list of A_bndry is in the same order as the
+ * send list of B_bndry, so this is a straight copy along the lists.
  *
  *  \param  A       : pointer to the target block
+ *  \param A_bndry  : value specifying the target block boundary
  *  \param  B       : pointer to the source block
  *  \param B_bndry  : value specifying the source block boundary
  */
-int copy_to_east_boundary_2D(Block *A, Block *B, int B_bndry,
-			     int type_of_copy, size_t gtl)
+int copy_to_boundary_2D(Block *A, int A_bndry, Block *B, int B_bndry,
+			int type_of_copy, size_t gtl)
 {
-    int i_A, j_A, i_B, j_B;
-    int jfirst, jlast;
-    FV_Cell *src, *dest;
-
-    if (B_bndry == SOUTH) {
-        /*
-         * Copy data from cells adjacent to the SOUTH boundary of
-         * block B to the EAST boundary ghost cells of block A.
-         */
-        i_A = A->imax + 1;
-        j_B = B->jmin;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            i_B = B->imax - (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A+1,j_A);
-            src = B->get_cell(i_B,j_B+1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == EAST) {
-        /*
-         * Copy data from cells adjacent to the EAST boundary of
-         * block B to the EAST boundary ghost cells of block A.
-         */
-        i_A = A->imax + 1;
-        i_B = B->imax;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            j_B = B->jmax - (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A+1,j_A);
-            src = B->get_cell(i_B-1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == NORTH) {
-        /*
-         * Copy data from cells adjacent to the NORTH boundary of
-         * block B to the EAST boundary ghost cells of block A.
-         */
-        i_A = A->imax + 1;
-        j_B = B->jmax;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            i_B = B->imin + (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A+1,j_A);
-            src = B->get_cell(i_B,j_B-1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == WEST) {
-        /*
-         * Copy data from cells adjacent to the WEST boundary of
-         * block B to the EAST boundary ghost cells of block A.
-         */
-        i_A = A->imax + 1;
-        i_B = B->imin;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            j_B = B->jmin + (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A+1,j_A);
-            src = B->get_cell(i_B+1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else {
-        printf("\ncopy_to_east_boundary: invalid boundary\n");
+    std::vector<FV_Cell *> &dest = A->exchange_ghost_cells[A_bndry];
+    std::vector<FV_Cell *> &src = B->exchange_send_cells[B_bndry];
+    if ( dest.empty() || dest.size() != src.size() ) {
+        printf("\ncopy_to_boundary_2D: block %d boundary %d has no exchange map",
+	       static_cast<int>(A->id), A_bndry);
+	printf(" to match neighbour boundary %d.\n", B_bndry);
         exit(VALUE_ERROR);
-    }   /* end if */
-
-    return SUCCESS;
-}   /* end copy_to_east_boundary_2D() */
-
-
-/** \brief Copy data from the B_bndry (NORTH, EAST, SOUTH, WEST)
- *         of (source) block B to the SOUTH boundary of (target) block A.
- *
- *  \param  A       : pointer to the target block
- *  \param  B       : pointer to the source block
- *  \param B_bndry  : value specifying the source block boundary
- */
-int copy_to_south_boundary_2D(Block *A, Block *B, int B_bndry,
-			      int type_of_copy, size_t gtl)
-{
-    int i_A, j_A, i_B, j_B;
-    int ifirst, ilast;
-    FV_Cell *src, *dest;
-
-    if (B_bndry == SOUTH) {
-        /*
-         * Copy data from cells adjacent to the SOUTH boundary of
-         * block B to the SOUTH boundary ghost cells of block A.
-         */
-        j_A = A->jmin - 1;
-        j_B = B->jmin;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            i_B = B->imax - (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A-1);
-            src = B->get_cell(i_B,j_B+1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == EAST) {
-        /*
-         * Copy data from cells adjacent to the EAST boundary of
-         * block B to the SOUTH boundary ghost cells of block A.
-         */
-        j_A = A->jmin - 1;
-        i_B = B->imax;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            j_B = B->jmax - (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A-1);
-            src = B->get_cell(i_B-1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == NORTH) {
-        /*
-         * Copy data from cells adjacent to the NORTH boundary of
-         * block B to the SOUTH boundary ghost cells of block A.
-         */
-        j_A = A->jmin - 1;
-        j_B = B->jmax;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            i_B = B->imin + (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A-1);
-            src = B->get_cell(i_B,j_B-1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == WEST) {
-        /*
-         * Copy data from cells adjacent to the WEST boundary of
-         * block B to the SOUTH boundary ghost cells of block A.
-         */
-        j_A = A->jmin - 1;
-        i_B = B->imin;
-
-        ifirst = A->imin;
-        ilast = A->imax;
-        for (i_A = ifirst; i_A <= ilast; ++i_A) {
-            j_B = B->jmin + (i_A - A->imin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A,j_A - 1);
-            src = B->get_cell(i_B+1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else {
-        printf("\ncopy_to_south_boundary: invalid boundary\n");
-        exit(VALUE_ERROR);
-    }   /* end if */
-
-    return SUCCESS;
-}   /* end copy_to_south_boundary_2D() */
-
-
-/** \brief Copy data from the B_bndry (NORTH, EAST, SOUTH, WEST)
- *         of (source) block B to the WEST boundary of (target) block A.
- *
- *  \param  A       : pointer to the target block
- *  \param  B       : pointer to the source block
- *  \param B_bndry  : value specifying the source block boundary
- */
-int copy_to_west_boundary_2D(Block *A, Block *B, int B_bndry,
-			     int type_of_copy, size_t gtl)
-{
-    int i_A, j_A, i_B, j_B;
-    int jfirst, jlast;
-    FV_Cell *src, *dest;
-
-    if (B_bndry == SOUTH) {
-        /*
-         * Copy data from cells adjacent to the SOUTH boundary of
-         * block B to the WEST boundary ghost cells of block A.
-         */
-        i_A = A->imin - 1;
-        j_B = B->jmin;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            i_B = B->imin + (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A-1,j_A);
-            src = B->get_cell(i_B,j_B+1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == EAST) {
-        /*
-         * Copy data from cells adjacent to the EAST boundary of
-         * block B to the WEST boundary ghost cells of block A.
-         */
-        i_A = A->imin - 1;
-        i_B = B->imax;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            j_B = B->jmin + (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A-1,j_A);
-            src = B->get_cell(i_B-1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == NORTH) {
-        /*
-         * Copy data from cells adjacent to the NORTH boundary of
-         * block B to the WEST boundary ghost cells of block A.
-         */
-        i_A = A->imin - 1;
-        j_B = B->jmax;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            i_B = B->imax - (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A-1,j_A);
-            src = B->get_cell(i_B,j_B-1);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else if (B_bndry == WEST) {
-        /*
-         * Copy data from cells adjacent to the WEST boundary of
-         * block B to the WEST boundary ghost cells of block A.
-         */
-        i_A = A->imin - 1;
-        i_B = B->imin;
-
-        jfirst = A->jmin;
-        jlast = A->jmax;
-        for (j_A = jfirst; j_A <= jlast; ++j_A) {
-            j_B = B->jmax - (j_A - A->jmin);
-
-            /* Fill the first line of ghost cells. */
-            dest = A->get_cell(i_A,j_A);
-            src = B->get_cell(i_B,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-
-            /* Fill the second line of ghost cells. */
-            dest = A->get_cell(i_A-1,j_A);
-            src = B->get_cell(i_B+1,j_B);
-            dest->copy_values_from(*src, type_of_copy, gtl);
-        }   /* end for */
-
-    } else {
-        printf("\ncopy_to_west_boundary: invalid boundary\n");
-        exit(VALUE_ERROR);
-    }   /* end if */
-
+    }
+    for ( size_t n = 0; n < dest.size(); ++n ) {
+	dest[n]->copy_values_from(*(src[n]), type_of_copy, gtl);
+    }
     return SUCCESS;
-}   /* end copy_to_west_boundary_2D() */
+}   /* end copy_to_boundary_2D() */
 
 
 /*--------------------------------------------------------------------*/
 /*                  Copy-via-buffer exchange functions.               */ 
 /*--------------------------------------------------------------------*/
 
+
 /** \brief Copy data into the send buffer from the appropriate
  *         boundary of the current block.
  *
- * See workbook page 33, 18-Jun-02 for details of order.
+ * The cells go in the order of the send list of the boundary;
+ * the receiving block has its ghost cells listed in that order.
  *
  * \param bd           : pointer to the target block
  * \param bndry        : value specifying the source block boundary
@@ -791,174 +348,40 @@ int copy_to_west_boundary_2D(Block *A, Block *B, int B_bndry,
 int copy_into_send_buffer_2D(Block *bd, int bndry, int type_of_copy,
 			     double *send_buffer, size_t gtl)
 {
-    int i, j, ib, ii, nx, ny, nv;
-    FV_Cell *cell;
-    double *bufp;
-    nv = number_of_values_in_cell_copy(type_of_copy);
-
-    if (bndry == NORTH) {
-        j = bd->jmax;
-        nx = bd->nni;
-        for (ii = 0; ii < nx; ++ii) {
-            /* copy counter-clockwise */
-            i = bd->imax - ii;
-            /* copy the outer-most line of active cells. */
-            ib = ii;
-            cell = bd->get_cell(i,j);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-            /* copy the second line of active cells. */
-            ib = ii + nx;
-            cell = bd->get_cell(i,j-1);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-        }
-    } else if (bndry == EAST) {
-        i = bd->imax;
-        ny = bd->nnj;
-        for (ii = 0; ii < ny; ++ii) {
-            /* copy counter-clockwise */
-            j = bd->jmin + ii;
-            /* copy the outer-most line of active cells. */
-            ib = ii;
-            cell = bd->get_cell(i,j);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-            /* copy the second line of active cells. */
-            ib = ii + ny;
-            cell = bd->get_cell(i-1,j);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-	}
-    } else if (bndry == SOUTH) {
-        j = bd->jmin;
-        nx = bd->nni;
-        for (ii = 0; ii < nx; ++ii) {
-            /* copy counter-clockwise */
-            i = bd->imin + ii;
-            /* copy the outer-most line of active cells. */
-            ib = ii;
-            cell = bd->get_cell(i,j);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-            /* copy the second line of active cells. */
-            i = bd->imin + ii;
-            ib = ii + nx;
-            cell = bd->get_cell(i,j+1);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-        }
-    } else if (bndry == WEST) {
-        i = bd->imin;
-        ny = bd->nnj;
-        for (ii = 0; ii < ny; ++ii) {
-            /* copy counter-clockwise */
-            j = bd->jmax - ii;
-            /* copy the outer-most line of active cells. */
-            ib = ii;
-            cell = bd->get_cell(i,j);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-            /* copy the second line of active cells. */
-            ib = ii + ny;
-            cell = bd->get_cell(i+1,j);
-            bufp = &(send_buffer[ib * nv]);
-            cell->copy_values_to_buffer(bufp, type_of_copy, gtl);
-	}
-    } else {
+    size_t nv = number_of_values_in_cell_copy(type_of_copy);
+    if ( bndry < NORTH || bndry > WEST ) {
         printf("\ncopy_into_send_buffer_2D(): invalid boundary\n");
         return VALUE_ERROR;
-    } // end if
-
+    }
+    std::vector<FV_Cell *> &cells = bd->exchange_send_cells[bndry];
+    for ( size_t ib = 0; ib < cells.size(); ++ib ) {
+	cells[ib]->copy_values_to_buffer(&(send_buffer[ib * nv]), type_of_copy, gtl);
+    }
     return SUCCESS;
 } // end copy_into_send_buffer_2D()
 
 
 /** \brief Copy data from the receive buffer into the appropriate
  *         boundary of the current block.
- *
- * See workbook page 33, 18-Jun-02 for details of order.
  */
 int copy_from_receive_buffer_2D(Block *bd, int bndry, int type_of_copy,
 				double *receive_buffer, size_t gtl)
 {
-    int i, j, ib, ii, nx, ny, nv;
-    FV_Cell *cell;
-    double *bufp;
-    nv = number_of_values_in_cell_copy(type_of_copy);
-    if (bndry == NORTH) {
-        j = bd->jmax;
-        nx = bd->nni;
-        for (ii = 0; ii < nx; ++ii) {
-            /* Fill clockwise */
-            i = bd->imin + ii;
-            /* Fill the first line of ghost cells. */
-            ib = ii;
-            cell = bd->get_cell(i,j+1);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-            /* Fill the second line of ghost cells. */
-            ib = ii + nx;
-            cell = bd->get_cell(i,j+2);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-        }
-    } else if (bndry == EAST) {
-        i = bd->imax;
-        ny = bd->nnj;
-        for (ii = 0; ii < ny; ++ii) {
-            /* Fill clockwise */
-            j = bd->jmax - ii;
-            /* Fill the first line of ghost cells. */
-            ib = ii;
-            cell = bd->get_cell(i+1,j);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-            /* Fill the second line of ghost cells. */
-            ib = ii + ny;
-            cell = bd->get_cell(i+2,j);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-	}
-    } else if (bndry == SOUTH) {
-        j = bd->jmin;
-        nx = bd->nni;
-        for (ii = 0; ii < nx; ++ii) {
-            /* Fill clockwise */
-            i = bd->imax - ii;
-            /* Fill the first line of ghost cells. */
-            ib = ii;
-            cell = bd->get_cell(i,j-1);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-            /* Fill the second line of ghost cells. */
-            ib = ii + nx;
-            cell = bd->get_cell(i,j-2);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-        }
-    } else if (bndry == WEST) {
-        i = bd->imin;
-        ny = bd->nnj;
-        for (ii = 0; ii < ny; ++ii) {
-            /* Fill clockwise */
-            j = bd->jmin + ii;
-            /* Fill the first line of ghost cells. */
-            ib = ii;
-            cell = bd->get_cell(i-1,j);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-            /* Fill the second line of ghost cells. */
-            ib = ii + ny;
-            cell = bd->get_cell(i-2,j);
-            bufp = &(receive_buffer[ib * nv]);
-            cell->copy_values_from_buffer(bufp, type_of_copy, gtl);
-	}
-    } else {
+    size_t nv = number_of_values_in_cell_copy(type_of_copy);
+    if ( bndry < NORTH || bndry > WEST ) {
         printf("\ncopy_from_receive_buffer: invalid boundary\n");
         return VALUE_ERROR;
-    } // end if
-
+    }
+    if ( bd->bcp[bndry]->neighbour_block < 0 ) return SUCCESS;
+    std::vector<FV_Cell *> &cells = bd->exchange_ghost_cells[bndry];
+    if ( cells.empty() ) {
+        printf("\ncopy_from_receive_buffer_2D(): block %d boundary %d has no exchange map.\n",
+	       static_cast<int>(bd->id), bndry);
+        exit(VALUE_ERROR);
+    }
+    for ( size_t ib = 0; ib < cells.size(); ++ib ) {
+	cells[ib]->copy_values_from_buffer(&(receive_buffer[ib * nv]), type_of_copy, gtl);
+    }
     return SUCCESS;
 } // end copy_from_receive_buffer_2D()
 
@@ -9,10 +9,8 @@
 int exchange_shared_boundary_data(int jb, int type_of_copy, size_t gtl);
 
 int copy_boundary_data_2D(int jb, int type_of_copy, size_t gtl);
-int copy_to_north_boundary_2D(Block *A, Block *B, int B_bndry, int type_of_copy, size_t gtl);
-int copy_to_east_boundary_2D(Block *A, Block *B, int B_bndry, int type_of_copy, size_t gtl);
-int copy_to_south_boundary_2D(Block *A, Block *B, int B_bndry, int type_of_copy, size_t gtl);
-int copy_to_west_boundary_2D(Block *A, Block *B, int B_bndry, int type_of_copy, size_t gtl);
+int copy_to_boundary_2D(Block *A, int A_bndry, Block *B, int B_bndry,
+			int type_of_copy, size_t gtl);
 int copy_to_east_boundary_diaphragm_2D(Block *A, Block *B, 
 				       int B_bndry, int type_of_copy,
 				       double diaphragm_time_fraction,
@@ -5,6 +5,7 @@
  * \author PJ
  * \version August 2004.
  * \version July 2008 Elmer3 port.
+ * \version 18-Oct-2026, one exchange function for all faces and orientations.
  */
 
 #ifndef EXCH3D_HH
@@ -16,12 +17,7 @@
 
 int copy_boundary_data_3D( size_t jb, int type_of_copy, size_t gtl);
 
-int copy_into_east_boundary_3D(Block *bp, Block *bp_src, int type_of_copy, size_t gtl);
-int copy_into_west_boundary_3D(Block *bp, Block *bp_src, int type_of_copy, size_t gtl);
-int copy_into_north_boundary_3D(Block *bp, Block *bp_src, int type_of_copy, size_t gtl);
-int copy_into_south_boundary_3D(Block *bp, Block *bp_src, int type_of_copy, size_t gtl);
-int copy_into_top_boundary_3D(Block *bp, Block *bp_src, int type_of_copy, size_t gtl);
-int copy_into_bottom_boundary_3D(Block *bp, Block *bp_src, int type_of_copy, size_t gtl);
+int copy_into_boundary_3D(Block *bp, int bndry, Block *bp_src, int type_of_copy, size_t gtl);
 
 /* Copy-via-buffer exchange functions */
 
@@ -29,17 +25,5 @@ int copy_into_send_buffer_3D(Block *bp, int bndry, int type_of_copy,
 			     double *send_buffer, size_t gtl);
 int copy_from_receive_buffer_3D(Block *bp, int bndry, int type_of_copy,
 				double *receive_buffer, size_t gtl);
-int copy_from_receive_buffer_to_north(Block *bp, int type_of_copy,
-				      double *receive_buffer, size_t gtl);
-int copy_from_receive_buffer_to_south(Block *bp, int type_of_copy,
-				      double *receive_buffer, size_t gtl);
-int copy_from_receive_buffer_to_east(Block *bp, int type_of_copy,
-				     double *receive_buffer, size_t gtl);
-int copy_from_receive_buffer_to_west(Block *bp, int type_of_copy,
-				     double *receive_buffer, size_t gtl);
-int copy_from_receive_buffer_to_top(Block *bp, int type_of_copy,
-				    double *receive_buffer, size_t gtl);
-int copy_from_receive_buffer_to_bottom(Block *bp, int type_of_copy,
-				       double *receive_buffer, size_t gtl);
 
 #endif
@@ -1,30 +1,184 @@
 // exch_mapped_cell_mpi.cxx
 // Copy mapped-cell data in a distributed-memory context.
-// 
+//
 // PJ, 08-Mar-2014
+// 18-Oct-2026: The mapped ghost cells are resolved once, at start-up, to the
+//   process that owns each source cell.  Each exchange then sends one message
+//   between each pair of processes that share mapped cells, holding just
+//   those cells, and copies directly between the cells that are local.
 
+// Intel MPI requires mpi.h included BEFORE stdio.h
+#include <mpi.h>
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
 #include "cell.hh"
 #include "block.hh"
 #include "kernel.hh"
 #include "bc.hh"
+#include "bc_mapped_cell.hh"
+#include "exch_mapped_cell_mpi.hh"
 
-int copy_mapped_cell_data_via_mpi(int type_of_copy, size_t gtl)
+namespace {
+    // Cells going to, or coming from, one other process.
+    // On the sending side, cells are the source cells in our blocks;
+    // on the receiving side, they are our ghost cells, in the same order.
+    struct MappedCellPeer {
+	int rank;
+	std::vector<FV_Cell *> cells;
+	std::vector<Block *> blocks; // receiving side: block of each ghost cell
+	std::vector<double> buffer;
+    };
+
+    bool schedule_ready = false;
+    std::vector<FV_Cell *> local_src;
+    std::vector<FV_Cell *> local_dest;
+    std::vector<Block *> local_dest_blocks;
+    std::vector<MappedCellPeer> send_peers;
+    std::vector<MappedCellPeer> recv_peers;
+    std::vector<MPI_Request> mapped_cell_requests;
+    int mapped_cell_tag;
+}
+
+/// \brief Build the communication schedule for the mapped-cell exchange.
+///
+/// Collective: every process must call this, after the blocks have been
+/// allocated, whether or not it has any mapped-cell boundaries.
+int setup_mapped_cell_exchange_via_mpi()
 {
     global_data &G = *get_global_data_ptr();
-    // [TODO] -- PJ 2014-03-08 -- mapped-cell BCs are a work in progress.
-    // Need to do something sensible to copy the flow data.
-    bool found_mapped_cell_bc = false;
+    int nproc = G.num_mpi_proc;
+    int my_rank = G.my_mpi_rank;
+    // Requests for source cells, as (block, i, j, k), grouped by owning process,
+    // along with our ghost cells that are to receive them.
+    std::vector<std::vector<int>> wanted(nproc);
+    std::vector<MappedCellPeer> incoming(nproc);
+    local_src.clear();
+    local_dest.clear();
+    local_dest_blocks.clear();
+    int number_faces = (G.dimensions == 3 ? 6: 4);
     for ( Block *bdp : G.my_blocks ) {
-	int number_faces = (G.dimensions == 3 ? 6: 4);
 	for ( int iface = 0; iface < number_faces; ++iface ) {
-	    if ( bdp->bcp[iface]->type_code == MAPPED_CELL ) found_mapped_cell_bc = true;
+	    if ( bdp->bcp[iface]->type_code != MAPPED_CELL ) continue;
+	    std::vector<std::vector<int>> &mapped_cells = bdp->bcp[iface]->mapped_cells;
+	    for ( size_t ghost_cell_index = 0; ghost_cell_index < mapped_cells.size(); ++ghost_cell_index ) {
+		std::vector<int> &m = mapped_cells[ghost_cell_index];
+		if ( m.size() != 4 || m[0] < 0 || m[0] >= static_cast<int>(G.nblock) ) {
+		    cerr << "setup_mapped_cell_exchange_via_mpi(): block " << bdp->id
+			 << " face " << iface << " mapped cell " << ghost_cell_index
+			 << " refers to a nonexistent block." << endl;
+		    return VALUE_ERROR;
+		}
+		FV_Cell *dest = mapped_ghost_cell(*bdp, iface, ghost_cell_index);
+		int owner = G.mpi_rank_for_block[m[0]];
+		if ( owner == my_rank ) {
+		    local_src.push_back(get_block_data_ptr(m[0])->get_cell(m[1], m[2], m[3]));
+		    local_dest.push_back(dest);
+		    local_dest_blocks.push_back(bdp);
+		} else {
+		    wanted[owner].insert(wanted[owner].end(), m.begin(), m.end());
+		    incoming[owner].cells.push_back(dest);
+		    incoming[owner].blocks.push_back(bdp);
+		}
+	    }
+	} // end for iface
+    } // end for bdp
+
+    // Tell each process which of its cells we want.
+    std::vector<int> nwanted(nproc), nasked(nproc);
+    for ( int r = 0; r < nproc; ++r ) nwanted[r] = wanted[r].size();
+    MPI_Alltoall(&nwanted[0], 1, MPI_INT, &nasked[0], 1, MPI_INT, MPI_COMM_WORLD);
+    std::vector<int> wanted_displ(nproc, 0), asked_displ(nproc, 0);
+    for ( int r = 1; r < nproc; ++r ) {
+	wanted_displ[r] = wanted_displ[r-1] + nwanted[r-1];
+	asked_displ[r] = asked_displ[r-1] + nasked[r-1];
+    }
+    std::vector<int> wanted_flat(wanted_displ[nproc-1] + nwanted[nproc-1] + 1);
+    std::vector<int> asked_flat(asked_displ[nproc-1] + nasked[nproc-1] + 1);
+    for ( int r = 0; r < nproc; ++r ) {
+	std::copy(wanted[r].begin(), wanted[r].end(), wanted_flat.begin() + wanted_displ[r]);
+    }
+    MPI_Alltoallv(&wanted_flat[0], &nwanted[0], &wanted_displ[0], MPI_INT,
+		  &asked_flat[0], &nasked[0], &asked_displ[0], MPI_INT, MPI_COMM_WORLD);
+
+    // Resolve the cells asked of us.
+    send_peers.clear();
+    recv_peers.clear();
+    int flag = SUCCESS;
+    for ( int r = 0; r < nproc; ++r ) {
+	if ( nasked[r] == 0 ) continue;
+	MappedCellPeer peer;
+	peer.rank = r;
+	for ( int n = asked_displ[r]; n < asked_displ[r] + nasked[r]; n += 4 ) {
+	    int blk = asked_flat[n];
+	    size_t i = asked_flat[n+1], j = asked_flat[n+2], k = asked_flat[n+3];
+	    Block *bdp = get_block_data_ptr(blk);
+	    if ( G.mpi_rank_for_block[blk] != my_rank ||
+		 i >= bdp->nidim || j >= bdp->njdim || k >= bdp->nkdim ) {
+		cerr << "setup_mapped_cell_exchange_via_mpi(): process " << r
+		     << " asked for cell (" << i << "," << j << "," << k << ") of block "
+		     << blk << ", which process " << my_rank << " does not have." << endl;
+		flag = VALUE_ERROR;
+		break;
+	    }
+	    peer.cells.push_back(bdp->get_cell(i, j, k));
 	}
+	send_peers.push_back(peer);
+    }
+    for ( int r = 0; r < nproc; ++r ) {
+	if ( incoming[r].cells.empty() ) continue;
+	incoming[r].rank = r;
+	recv_peers.push_back(incoming[r]);
     }
-    if ( found_mapped_cell_bc ) {
-	throw std::runtime_error("Have not yet implemented mapped-cell exchange for MPI.");
+    mapped_cell_requests.resize(send_peers.size() + recv_peers.size());
+    // Beyond the range of tags used by mpi_exchange_boundary_data().
+    mapped_cell_tag = 10 * G.nblock + 6;
+    if ( G.verbosity_level >= 2 ) {
+	printf("Process %d: mapped-cell exchange with %d local cells, %d processes to send to, "
+	       "%d processes to receive from.\n", my_rank, static_cast<int>(local_src.size()),
+	       static_cast<int>(send_peers.size()), static_cast<int>(recv_peers.size()));
+    }
+    schedule_ready = (flag == SUCCESS);
+    return flag;
+} // end setup_mapped_cell_exchange_via_mpi()
+
+int copy_mapped_cell_data_via_mpi(int type_of_copy, size_t gtl)
+{
+    global_data &G = *get_global_data_ptr();
+    bool with_k_omega = (G.turbulence_model == TM_K_OMEGA);
+    if ( !schedule_ready ) {
+	throw std::runtime_error("copy_mapped_cell_data_via_mpi(): "
+				 "setup_mapped_cell_exchange_via_mpi() has not been called.");
+    }
+    size_t nv = number_of_values_in_cell_copy(type_of_copy);
+    size_t nreq = 0;
+    for ( MappedCellPeer &peer : recv_peers ) {
+	peer.buffer.resize(peer.cells.size() * nv);
+	MPI_Irecv(&(peer.buffer[0]), peer.buffer.size(), MPI_DOUBLE, peer.rank,
+		  mapped_cell_tag, MPI_COMM_WORLD, &(mapped_cell_requests[nreq++]));
+    }
+    for ( MappedCellPeer &peer : send_peers ) {
+	peer.buffer.resize(peer.cells.size() * nv);
+	for ( size_t n = 0; n < peer.cells.size(); ++n ) {
+	    peer.cells[n]->copy_values_to_buffer(&(peer.buffer[n * nv]), type_of_copy, gtl);
+	}
+	MPI_Isend(&(peer.buffer[0]), peer.buffer.size(), MPI_DOUBLE, peer.rank,
+		  mapped_cell_tag, MPI_COMM_WORLD, &(mapped_cell_requests[nreq++]));
+    }
+    // The cells mapped within this process can be copied while the messages are in flight.
+    for ( size_t n = 0; n < local_dest.size(); ++n ) {
+	local_dest[n]->copy_values_from(*(local_src[n]), type_of_copy, gtl);
+	local_dest[n]->encode_conserved(gtl, 0, local_dest_blocks[n]->omegaz, with_k_omega);
+    }
+    if ( nreq > 0 ) MPI_Waitall(nreq, &(mapped_cell_requests[0]), MPI_STATUSES_IGNORE);
+    for ( MappedCellPeer &peer : recv_peers ) {
+	for ( size_t n = 0; n < peer.cells.size(); ++n ) {
+	    peer.cells[n]->copy_values_from_buffer(&(peer.buffer[n * nv]), type_of_copy, gtl);
+	    peer.cells[n]->encode_conserved(gtl, 0, peer.blocks[n]->omegaz, with_k_omega);
+	}
     }
     return SUCCESS;
-}
+} // end copy_mapped_cell_data_via_mpi()
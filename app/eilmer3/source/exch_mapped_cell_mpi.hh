@@ -6,6 +6,7 @@
 #ifndef EXCH_MAPPED_CELL_MPI_HH
 #define EXCH_MAPPED_CELL_MPI_HH
 
+int setup_mapped_cell_exchange_via_mpi();
 int copy_mapped_cell_data_via_mpi(int type_of_copy, size_t gtl);
 
 #endif
@@ -0,0 +1,83 @@
+/// \file file_broadcast.cxx
+/// \ingroup eilmer3
+/// \brief Read small input files on one process and share the text.
+///
+/// Compiled twice: with _MPI for e3mpi and without it for the
+/// shared-memory programs.
+///
+/// \version 18-Oct-2026
+
+#ifdef _MPI
+#   include <mpi.h>
+#endif
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+#include "kernel.hh"
+#include "file_broadcast.hh"
+
+using namespace std;
+
+namespace {
+
+int read_whole_file(const string filename, string &text)
+{
+    ifstream infile(filename.c_str(), ios::in | ios::binary);
+    // As for ConfigParser, allow for a slow network file system.
+    size_t retries = 10;
+    for ( size_t i = 0; i < retries && infile.fail(); ++i ) {
+	sleep(2);
+	infile.clear();
+	infile.open(filename.c_str(), ios::in | ios::binary);
+    }
+    if ( infile.fail() ) return FILE_ERROR;
+    ostringstream ss;
+    ss << infile.rdbuf();
+    text = ss.str();
+    return SUCCESS;
+}
+
+} // end anonymous namespace
+
+
+/// \brief Get the full text of a file, reading it on rank 0 only.
+int read_file_on_master(const string filename, string &text)
+{
+#   ifdef _MPI
+    global_data &G = *get_global_data_ptr();
+    long long nchar = -1;
+    if ( G.my_mpi_rank == 0 ) {
+	if ( read_whole_file(filename, text) == SUCCESS ) nchar = text.size();
+    }
+    MPI_Bcast(&nchar, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+    if ( nchar < 0 ) return FILE_ERROR;
+    if ( G.my_mpi_rank != 0 ) text.assign(nchar, '\0');
+    if ( nchar > 0 ) {
+	MPI_Bcast(&text[0], static_cast<int>(nchar), MPI_CHAR, 0, MPI_COMM_WORLD);
+    }
+    return SUCCESS;
+#   else
+    return read_whole_file(filename, text);
+#   endif
+} // end read_file_on_master()
+
+
+/// \brief Parse an INI file that has been read on rank 0 only.
+///
+/// Fails in the same way as the ConfigParser constructor if the
+/// file cannot be read.
+ConfigParser read_ini_file_on_master(const string filename)
+{
+    string text;
+    if ( read_file_on_master(filename, text) != SUCCESS ) {
+	if ( get_global_data_ptr()->my_mpi_rank == 0 ) {
+	    cout << "ConfigParser - unable to open file: " << filename << endl
+		 << "No configuration information has been read!" << endl;
+	}
+	throw runtime_error("File not found.");
+    }
+    return ConfigParser(filename, text);
+} // end read_ini_file_on_master()
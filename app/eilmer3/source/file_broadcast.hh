@@ -0,0 +1,23 @@
+/// \file file_broadcast.hh
+/// \ingroup eilmer3
+/// \brief Read small input files on one process and share the text.
+///
+/// With thousands of MPI processes, having every process open and parse
+/// the same .config, .control and .mpimap files puts a heavy load on the
+/// file-system metadata servers.  In the MPI build, these functions
+/// read the file on rank 0 only and broadcast its text to the other
+/// ranks, which parse it from memory.  They are collective over
+/// MPI_COMM_WORLD.  In the shared-memory build they just read the file.
+///
+/// \version 18-Oct-2026
+
+#ifndef FILE_BROADCAST_HH
+#define FILE_BROADCAST_HH
+
+#include <string>
+#include "../../../lib/util/source/config_parser.hh"
+
+int read_file_on_master(const std::string filename, std::string &text);
+ConfigParser read_ini_file_on_master(const std::string filename);
+
+#endif
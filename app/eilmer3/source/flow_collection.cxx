@@ -0,0 +1,466 @@
+/// \file flow_collection.cxx
+/// \ingroup eilmer3
+/// \brief A single file holding the flow solution of all blocks for one tindx.
+///
+/// Compiled twice: with _MPI for the collective MPI-IO writer and
+/// without it for the shared-memory programs, which write the same file
+/// with plain stdio.
+///
+/// \version 18-Oct-2026
+
+#ifdef _MPI
+#   include <mpi.h>
+#endif
+#include <string>
+#include <cstring>
+#include <climits>
+#include <iostream>
+#include <stdio.h>
+#include <unistd.h>
+#include <zlib.h>
+#include "kernel.hh"
+#include "block.hh"
+#include "flow_collection.hh"
+
+using namespace std;
+
+namespace {
+
+const char *FC_TITLE = "eilmer3 flow collection 1\n";
+
+string header_block_line(size_t id, unsigned long long offset, unsigned long long length)
+{
+    char line[80];
+    snprintf(line, sizeof(line), "block %8d %20llu %20llu\n", static_cast<int>(id),
+	     offset, length);
+    return string(line);
+}
+
+/// Size of the header in bytes; fixed by the number of blocks.
+size_t header_size(size_t nblock)
+{
+    char line[40];
+    snprintf(line, sizeof(line), "nblock %8d\n", static_cast<int>(nblock));
+    return strlen(FC_TITLE) + strlen("compression none\n") + strlen(line)
+	+ nblock * header_block_line(0, 0, 0).size() + strlen("end_header\n");
+}
+
+string make_header(size_t nblock, bool zip_blocks, const vector<unsigned long long> &offset,
+		   const vector<unsigned long long> &length)
+{
+    char line[40];
+    string header = FC_TITLE;
+    header += zip_blocks ? "compression gzip\n" : "compression none\n";
+    snprintf(line, sizeof(line), "nblock %8d\n", static_cast<int>(nblock));
+    header += line;
+    for ( size_t id = 0; id < nblock; ++id ) {
+	header += header_block_line(id, offset[id], length[id]);
+    }
+    header += "end_header\n";
+    return header;
+}
+
+/// Compress text into a single gzip stream.
+int gzip_text(const string &text, string &zipped)
+{
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    // windowBits 15+16 asks for the gzip wrapper, as written by gzopen().
+    if ( deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15+16, 8,
+		      Z_DEFAULT_STRATEGY) != Z_OK ) return MEMORY_ERROR;
+    zipped.resize(deflateBound(&zs, text.size()) + 32);
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(text.data()));
+    zs.avail_in = text.size();
+    zs.next_out = reinterpret_cast<Bytef *>(&zipped[0]);
+    zs.avail_out = zipped.size();
+    int status = deflate(&zs, Z_FINISH);
+    zipped.resize(zs.total_out);
+    deflateEnd(&zs);
+    return (status == Z_STREAM_END) ? SUCCESS : FAILURE;
+}
+
+int gunzip_text(const string &zipped, string &text)
+{
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if ( inflateInit2(&zs, 15+16) != Z_OK ) return MEMORY_ERROR;
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(zipped.data()));
+    zs.avail_in = zipped.size();
+    text.clear();
+    char buf[65536];
+    int status = Z_OK;
+    while ( status == Z_OK ) {
+	zs.next_out = reinterpret_cast<Bytef *>(buf);
+	zs.avail_out = sizeof(buf);
+	status = inflate(&zs, Z_NO_FLUSH);
+	text.append(buf, sizeof(buf) - zs.avail_out);
+    }
+    inflateEnd(&zs);
+    return (status == Z_STREAM_END) ? SUCCESS : BAD_INPUT_ERROR;
+}
+
+} // end anonymous namespace
+
+
+/// \brief The collection lives beside the per-block files, in flow/tNNNN/.
+string flow_collection_filename(const string base_file_name, const string tindxstring)
+{
+    return "flow/" + tindxstring + "/" + base_file_name + ".flow.all." + tindxstring;
+}
+
+
+/// \brief Write the local blocks into the collection file.
+///
+/// In the MPI build, this is collective over MPI_COMM_WORLD and
+/// every rank must call it, even one with no blocks.
+/// nblock is the total number of blocks over all ranks.
+int write_flow_collection(const string filename, const vector<Block *> &blocks,
+			  size_t nblock, double sim_time, bool zip_blocks)
+{
+    global_data &G = *get_global_data_ptr();
+    if ( G.verbosity_level >= 1 && G.my_mpi_rank == 0 ) {
+	printf("write_flow_collection(): At t = %e, file %s.\n", sim_time, filename.c_str());
+    }
+    // 1. Format (and compress) each local block into one contiguous buffer.
+    string local_data, text, zipped;
+    vector<unsigned long long> local_id, local_offset, local_length;
+    int flag = SUCCESS;
+    for ( Block *bdp : blocks ) {
+	if ( bdp->write_solution_to_string(text, sim_time) != SUCCESS ) flag = FAILURE;
+	if ( zip_blocks ) {
+	    if ( gzip_text(text, zipped) != SUCCESS ) flag = FAILURE;
+	    text.swap(zipped);
+	}
+	local_id.push_back(bdp->id);
+	local_offset.push_back(local_data.size());
+	local_length.push_back(text.size());
+	local_data += text;
+    }
+    size_t hsize = header_size(nblock);
+    vector<unsigned long long> offset(nblock, 0), length(nblock, 0);
+
+#   ifdef _MPI
+    int global_flag;
+    MPI_Allreduce(&flag, &global_flag, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if ( global_flag != SUCCESS ) {
+	cerr << "write_flow_collection(): could not format the blocks for " << filename << endl;
+	return FAILURE;
+    }
+    // 2. This rank's data starts after those of the lower ranks.
+    unsigned long long my_bytes = local_data.size();
+    unsigned long long my_start = 0;
+    MPI_Exscan(&my_bytes, &my_start, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    if ( G.my_mpi_rank == 0 ) my_start = 0; // MPI_Exscan leaves rank 0 undefined
+    my_start += hsize;
+    // 3. Rank 0 collects the (id, offset, length) triples for the index.
+    vector<unsigned long long> triples;
+    for ( size_t ib = 0; ib < local_id.size(); ++ib ) {
+	triples.push_back(local_id[ib]);
+	triples.push_back(my_start + local_offset[ib]);
+	triples.push_back(local_length[ib]);
+    }
+    int my_count = static_cast<int>(triples.size());
+    vector<int> counts(G.num_mpi_proc, 0), displs(G.num_mpi_proc, 0);
+    MPI_Gather(&my_count, 1, MPI_INT, &counts[0], 1, MPI_INT, 0, MPI_COMM_WORLD);
+    vector<unsigned long long> all_triples;
+    if ( G.my_mpi_rank == 0 ) {
+	int total = 0;
+	for ( int r = 0; r < G.num_mpi_proc; ++r ) {
+	    displs[r] = total;
+	    total += counts[r];
+	}
+	all_triples.resize(total > 0 ? total : 1);
+    }
+    MPI_Gatherv(triples.empty() ? 0 : &triples[0], my_count, MPI_UNSIGNED_LONG_LONG,
+		G.my_mpi_rank == 0 ? &all_triples[0] : 0, &counts[0], &displs[0],
+		MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+    string wbuf;
+    unsigned long long wstart = my_start;
+    if ( G.my_mpi_rank == 0 ) {
+	for ( size_t it = 0; it + 2 < all_triples.size(); it += 3 ) {
+	    size_t id = all_triples[it];
+	    if ( id < nblock ) {
+		offset[id] = all_triples[it+1];
+		length[id] = all_triples[it+2];
+	    }
+	}
+	// Rank 0 writes the header in front of its own blocks.
+	wbuf = make_header(nblock, zip_blocks, offset, length);
+	wstart = 0;
+    }
+    wbuf += local_data;
+    local_data.clear();
+    // 4. Collective write.  MPI counts are ints, so big buffers go in pieces
+    //    and every rank makes the same number of calls.
+    const unsigned long long max_piece = INT_MAX / 2;
+    unsigned long long my_pieces = (wbuf.size() + max_piece - 1) / max_piece;
+    unsigned long long npieces = 0;
+    MPI_Allreduce(&my_pieces, &npieces, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+    MPI_File fh;
+    MPI_Status status;
+    int rc = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(filename.c_str()),
+			   MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+    if ( rc != MPI_SUCCESS ) {
+	cerr << "write_flow_collection(): could not open " << filename << endl;
+	return FILE_ERROR;
+    }
+    MPI_File_set_size(fh, 0); // discard any older, longer, file
+    for ( unsigned long long ip = 0; ip < npieces; ++ip ) {
+	unsigned long long pos = ip * max_piece;
+	int count = 0;
+	if ( pos < wbuf.size() ) {
+	    count = static_cast<int>(min(max_piece, static_cast<unsigned long long>(wbuf.size()) - pos));
+	}
+	rc = MPI_File_write_at_all(fh, static_cast<MPI_Offset>(wstart + pos),
+				   count > 0 ? &wbuf[pos] : 0, count, MPI_BYTE, &status);
+	if ( rc != MPI_SUCCESS ) flag = FILE_ERROR;
+    }
+    MPI_File_close(&fh);
+    MPI_Allreduce(&flag, &global_flag, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if ( global_flag != SUCCESS ) {
+	cerr << "write_flow_collection(): failed writing " << filename << endl;
+	return FILE_ERROR;
+    }
+#   else
+    if ( flag != SUCCESS ) {
+	cerr << "write_flow_collection(): could not format the blocks for " << filename << endl;
+	return FAILURE;
+    }
+    for ( size_t ib = 0; ib < local_id.size(); ++ib ) {
+	if ( local_id[ib] < nblock ) {
+	    offset[local_id[ib]] = hsize + local_offset[ib];
+	    length[local_id[ib]] = local_length[ib];
+	}
+    }
+    string header = make_header(nblock, zip_blocks, offset, length);
+    FILE *fp = fopen(filename.c_str(), "wb");
+    if ( fp == NULL ) {
+	cerr << "write_flow_collection(): could not open " << filename << endl;
+	return FILE_ERROR;
+    }
+    if ( fwrite(header.data(), 1, header.size(), fp) != header.size() ||
+	 fwrite(local_data.data(), 1, local_data.size(), fp) != local_data.size() ) {
+	flag = FILE_ERROR;
+    }
+    if ( fclose(fp) != 0 ) flag = FILE_ERROR;
+    if ( flag != SUCCESS ) {
+	cerr << "write_flow_collection(): failed writing " << filename << endl;
+	return FILE_ERROR;
+    }
+#   endif
+    return SUCCESS;
+} // end write_flow_collection()
+
+
+/// \brief Read the index of a collection file.
+///
+/// Not collective; in the MPI build, read_flow_collection_blocks()
+/// calls this on rank 0 only.
+int read_flow_collection_index(const string filename, FlowCollectionIndex &index)
+{
+#   define NCHAR 256
+    char line[NCHAR];
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if ( fp == NULL ) {
+	cerr << "read_flow_collection_index(): could not open " << filename << endl;
+	return FILE_ERROR;
+    }
+    int flag = SUCCESS;
+    char word[32];
+    int nblock = 0;
+    if ( fgets(line, NCHAR, fp) == NULL || strcmp(line, FC_TITLE) != 0 ) {
+	flag = BAD_INPUT_ERROR;
+    } else if ( fgets(line, NCHAR, fp) == NULL || sscanf(line, "compression %31s", word) != 1 ) {
+	flag = BAD_INPUT_ERROR;
+    } else {
+	index.compressed = (strcmp(word, "gzip") == 0);
+	if ( fgets(line, NCHAR, fp) == NULL || sscanf(line, "nblock %d", &nblock) != 1 ||
+	     nblock < 0 ) flag = BAD_INPUT_ERROR;
+    }
+    if ( flag == SUCCESS ) {
+	index.offset.assign(nblock, 0);
+	index.length.assign(nblock, 0);
+	for ( int ib = 0; ib < nblock && flag == SUCCESS; ++ib ) {
+	    int id;
+	    unsigned long long off, len;
+	    if ( fgets(line, NCHAR, fp) == NULL ||
+		 sscanf(line, "block %d %llu %llu", &id, &off, &len) != 3 ||
+		 id < 0 || id >= nblock ) {
+		flag = BAD_INPUT_ERROR;
+	    } else {
+		index.offset[id] = off;
+		index.length[id] = len;
+	    }
+	}
+	if ( flag == SUCCESS && (fgets(line, NCHAR, fp) == NULL ||
+				 strcmp(line, "end_header\n") != 0) ) flag = BAD_INPUT_ERROR;
+    }
+    fclose(fp);
+    if ( flag != SUCCESS ) {
+	cerr << "read_flow_collection_index(): " << filename
+	     << " does not have a valid flow collection header." << endl;
+    }
+    return flag;
+#   undef NCHAR
+} // end read_flow_collection_index()
+
+
+/// \brief Read the text of one block's flow file from the collection.
+int read_flow_collection_block(const string filename, const FlowCollectionIndex &index,
+			       size_t block_id, string &text)
+{
+    if ( block_id >= index.offset.size() || index.length[block_id] == 0 ) {
+	cerr << "read_flow_collection_block(): no data for block " << block_id
+	     << " in " << filename << endl;
+	return BAD_INPUT_ERROR;
+    }
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if ( fp == NULL ) {
+	cerr << "read_flow_collection_block(): could not open " << filename << endl;
+	return FILE_ERROR;
+    }
+    string data(index.length[block_id], '\0');
+    int flag = SUCCESS;
+    if ( fseeko(fp, static_cast<off_t>(index.offset[block_id]), SEEK_SET) != 0 ||
+	 fread(&data[0], 1, data.size(), fp) != data.size() ) {
+	cerr << "read_flow_collection_block(): could not read block " << block_id
+	     << " from " << filename << endl;
+	flag = FILE_ERROR;
+    }
+    fclose(fp);
+    if ( flag != SUCCESS ) return flag;
+    if ( index.compressed ) {
+	flag = gunzip_text(data, text);
+	if ( flag != SUCCESS ) {
+	    cerr << "read_flow_collection_block(): bad gzip data for block " << block_id
+		 << " in " << filename << endl;
+	}
+    } else {
+	text.swap(data);
+    }
+    return flag;
+} // end read_flow_collection_block()
+
+
+/// \brief True if the collection file exists.
+///
+/// In the MPI build, only rank 0 looks; the answer is broadcast.
+bool flow_collection_exists(const string filename)
+{
+#   ifdef _MPI
+    global_data &G = *get_global_data_ptr();
+    int found = 0;
+    if ( G.my_mpi_rank == 0 ) found = (access(filename.c_str(), F_OK) == 0) ? 1 : 0;
+    MPI_Bcast(&found, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return found == 1;
+#   else
+    return access(filename.c_str(), F_OK) == 0;
+#   endif
+} // end flow_collection_exists()
+
+
+/// \brief Read the text of the flow files of the local blocks from the collection.
+///
+/// texts[ib] is for blocks[ib].  In the MPI build, this is collective
+/// over MPI_COMM_WORLD and every rank must call it, even one with no blocks.
+int read_flow_collection_blocks(const string filename, const vector<Block *> &blocks,
+				vector<string> &texts)
+{
+    FlowCollectionIndex index;
+    texts.assign(blocks.size(), string());
+#   ifdef _MPI
+    global_data &G = *get_global_data_ptr();
+    // 1. Rank 0 reads the header and broadcasts the index.
+    int flag = SUCCESS;
+    if ( G.my_mpi_rank == 0 ) flag = read_flow_collection_index(filename, index);
+    MPI_Bcast(&flag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if ( flag != SUCCESS ) return flag;
+    int hdr[2] = { index.compressed ? 1 : 0, static_cast<int>(index.offset.size()) };
+    MPI_Bcast(hdr, 2, MPI_INT, 0, MPI_COMM_WORLD);
+    index.compressed = (hdr[0] == 1);
+    index.offset.resize(hdr[1]);
+    index.length.resize(hdr[1]);
+    if ( hdr[1] > 0 ) {
+	MPI_Bcast(&index.offset[0], hdr[1], MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+	MPI_Bcast(&index.length[0], hdr[1], MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+    }
+    for ( Block *bdp : blocks ) {
+	if ( bdp->id >= index.offset.size() || index.length[bdp->id] == 0 ) {
+	    cerr << "read_flow_collection_blocks(): no data for block " << bdp->id
+		 << " in " << filename << endl;
+	    flag = BAD_INPUT_ERROR;
+	}
+    }
+    // 2. Collective reads, in pieces as for the writer, so that every rank
+    //    makes the same number of calls.
+    const unsigned long long max_piece = INT_MAX / 2;
+    unsigned long long my_pieces = 0;
+    if ( flag == SUCCESS ) {
+	for ( Block *bdp : blocks ) {
+	    my_pieces += (index.length[bdp->id] + max_piece - 1) / max_piece;
+	}
+    }
+    unsigned long long npieces = 0;
+    MPI_Allreduce(&my_pieces, &npieces, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+    MPI_File fh;
+    MPI_Status status;
+    int rc = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(filename.c_str()),
+			   MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+    if ( rc != MPI_SUCCESS ) {
+	cerr << "read_flow_collection_blocks(): could not open " << filename << endl;
+	return FILE_ERROR;
+    }
+    vector<string> data(blocks.size());
+    size_t ib = 0;
+    unsigned long long pos = 0; // within the section of block ib
+    for ( unsigned long long ip = 0; ip < npieces; ++ip ) {
+	int count = 0;
+	MPI_Offset where = 0;
+	char *buf = 0;
+	if ( ip < my_pieces ) {
+	    size_t id = blocks[ib]->id;
+	    if ( pos == 0 ) data[ib].resize(index.length[id]);
+	    count = static_cast<int>(min(max_piece, index.length[id] - pos));
+	    where = static_cast<MPI_Offset>(index.offset[id] + pos);
+	    buf = &data[ib][pos];
+	}
+	rc = MPI_File_read_at_all(fh, where, buf, count, MPI_BYTE, &status);
+	if ( rc != MPI_SUCCESS ) flag = FILE_ERROR;
+	if ( ip < my_pieces ) {
+	    pos += count;
+	    if ( pos == index.length[blocks[ib]->id] ) {
+		++ib;
+		pos = 0;
+	    }
+	}
+    }
+    MPI_File_close(&fh);
+    int global_flag;
+    MPI_Allreduce(&flag, &global_flag, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if ( global_flag != SUCCESS ) {
+	cerr << "read_flow_collection_blocks(): failed reading " << filename << endl;
+	return FILE_ERROR;
+    }
+    // 3. Each section is a separate gzip stream, or plain text.
+    for ( ib = 0; ib < blocks.size(); ++ib ) {
+	if ( index.compressed ) {
+	    if ( gunzip_text(data[ib], texts[ib]) != SUCCESS ) {
+		cerr << "read_flow_collection_blocks(): bad gzip data for block "
+		     << blocks[ib]->id << " in " << filename << endl;
+		return BAD_INPUT_ERROR;
+	    }
+	} else {
+	    texts[ib].swap(data[ib]);
+	}
+    }
+    return SUCCESS;
+#   else
+    int flag = read_flow_collection_index(filename, index);
+    if ( flag != SUCCESS ) return flag;
+    for ( size_t ib = 0; ib < blocks.size(); ++ib ) {
+	flag = read_flow_collection_block(filename, index, blocks[ib]->id, texts[ib]);
+	if ( flag != SUCCESS ) return flag;
+    }
+    return SUCCESS;
+#   endif
+} // end read_flow_collection_blocks()
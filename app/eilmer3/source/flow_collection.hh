@@ -0,0 +1,50 @@
+/// \file flow_collection.hh
+/// \ingroup eilmer3
+/// \brief A single file holding the flow solution of all blocks for one tindx.
+///
+/// With many blocks, the usual one-file-per-block-per-snapshot output
+/// makes a very large number of small files.  A flow collection holds
+/// the same text as the individual flow files, one section per block,
+/// behind an index so that any block can be read without scanning the rest:
+///     eilmer3 flow collection 1
+///     compression gzip|none
+///     nblock <n>
+///     block <id> <offset> <length>     (one line per block, in id order)
+///     end_header
+/// Offsets are in bytes from the start of the file.  With compression,
+/// each block section is a separate gzip stream.  The header lines are
+/// of fixed width so that its size is known before the offsets are.
+///
+/// In the MPI build, all ranks write their blocks to the one file
+/// with collective MPI-IO writes; the offsets come from a prefix sum
+/// of the section sizes over the ranks.  For reading, rank 0 parses the
+/// index and broadcasts it, then all ranks read their own blocks with
+/// collective MPI-IO reads, so the file is opened once by the job.
+///
+/// \version 18-Oct-2026
+
+#ifndef FLOW_COLLECTION_HH
+#define FLOW_COLLECTION_HH
+
+#include <string>
+#include <vector>
+#include "block.hh"
+
+struct FlowCollectionIndex {
+    bool compressed;
+    std::vector<unsigned long long> offset; // indexed by block id
+    std::vector<unsigned long long> length;
+};
+
+std::string flow_collection_filename(const std::string base_file_name,
+				     const std::string tindxstring);
+int write_flow_collection(const std::string filename, const std::vector<Block *> &blocks,
+			  size_t nblock, double sim_time, bool zip_blocks);
+bool flow_collection_exists(const std::string filename);
+int read_flow_collection_index(const std::string filename, FlowCollectionIndex &index);
+int read_flow_collection_block(const std::string filename, const FlowCollectionIndex &index,
+			       size_t block_id, std::string &text);
+int read_flow_collection_blocks(const std::string filename, const std::vector<Block *> &blocks,
+				std::vector<std::string> &texts);
+
+#endif
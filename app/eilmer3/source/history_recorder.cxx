@@ -0,0 +1,204 @@
+/// \file history_recorder.cxx
+/// \ingroup eilmer3
+/// \brief Buffered binary recording of the history cells.
+///
+/// \version 18-Oct-2026
+
+#include <string>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "cell.hh"
+#include "kernel.hh"
+#include "block.hh"
+#include "history_recorder.hh"
+
+using namespace std;
+
+HistoryRecorder::HistoryRecorder(const string filename, const vector<Block *> &blocks,
+				 const vector<string> &variables, size_t buffer_records)
+    : filename_(filename), blocks_(blocks), ncells_(0), record_size_(0),
+      buffer_records_(buffer_records), nfill_(0), nwrite_(0), fp_(0),
+      write_pending_(false), closing_(false), write_failed_(false)
+{
+    // The full list of cell variables, in the order of write_values_to_vector.
+    vector<string> all_names;
+    istringstream iss(variable_list_for_cell());
+    string token;
+    while ( iss >> token ) {
+	if ( token.size() >= 2 && token[0] == '"' ) token = token.substr(1, token.size()-2);
+	all_names.push_back(token);
+    }
+    if ( variables.size() == 0 ) {
+	var_names_ = all_names;
+	for ( size_t iv = 0; iv < all_names.size(); ++iv ) var_index_.push_back(iv);
+    } else {
+	for ( const string &name : variables ) {
+	    size_t iv = 0;
+	    while ( iv < all_names.size() && all_names[iv] != name ) ++iv;
+	    if ( iv == all_names.size() ) {
+		throw runtime_error("HistoryRecorder: unknown history variable: " + name);
+	    }
+	    var_names_.push_back(name);
+	    var_index_.push_back(iv);
+	}
+    }
+    for ( Block *bdp : blocks_ ) ncells_ += bdp->hncell;
+    record_size_ = 1 + ncells_ * var_index_.size();
+    if ( buffer_records_ < 1 ) buffer_records_ = 1;
+    fill_buf_.resize(buffer_records_ * record_size_);
+    write_buf_.resize(buffer_records_ * record_size_);
+
+    // On a restart, append to an existing file but only if it was
+    // written for the same set of cells and variables.
+    string header = make_header();
+    if ( access(filename_.c_str(), F_OK) == 0 ) {
+	FILE *fp = fopen(filename_.c_str(), "rb");
+	if ( fp == NULL ) {
+	    throw runtime_error("HistoryRecorder: could not read " + filename_);
+	}
+	vector<char> old_header(header.size());
+	size_t nread = fread(&old_header[0], 1, header.size(), fp);
+	fclose(fp);
+	if ( nread != header.size() || memcmp(&old_header[0], header.c_str(), header.size()) != 0 ) {
+	    throw runtime_error("HistoryRecorder: existing " + filename_ +
+				" has a different layout of cells or variables.");
+	}
+	// A run that was killed may have left a partly-written record
+	// at the end; cut the file back to the last complete record
+	// so that the appended records stay aligned.
+	struct stat st;
+	if ( stat(filename_.c_str(), &st) != 0 ) {
+	    throw runtime_error("HistoryRecorder: could not stat " + filename_);
+	}
+	size_t record_bytes = record_size_ * sizeof(double);
+	size_t nrecords = (static_cast<size_t>(st.st_size) - header.size()) / record_bytes;
+	off_t complete_size = static_cast<off_t>(header.size() + nrecords * record_bytes);
+	if ( complete_size != st.st_size ) {
+	    cout << "HistoryRecorder: dropping a partial record at the end of "
+		 << filename_ << endl;
+	    if ( truncate(filename_.c_str(), complete_size) != 0 ) {
+		throw runtime_error("HistoryRecorder: could not truncate " + filename_);
+	    }
+	}
+	fp_ = fopen(filename_.c_str(), "ab");
+    } else {
+	fp_ = fopen(filename_.c_str(), "wb");
+	if ( fp_ != NULL ) fputs(header.c_str(), fp_);
+    }
+    if ( fp_ == NULL ) {
+	throw runtime_error("HistoryRecorder: could not open " + filename_);
+    }
+    writer_ = thread(&HistoryRecorder::writer_loop, this);
+} // end HistoryRecorder constructor
+
+HistoryRecorder::~HistoryRecorder()
+{
+    close();
+}
+
+string HistoryRecorder::make_header() const
+{
+    ostringstream ost;
+    ost << "eilmer3 binary history 1\n";
+    ost << "variables:";
+    for ( const string &name : var_names_ ) ost << " \"" << name << "\"";
+    ost << "\n";
+    ost << "nblock " << blocks_.size() << "\n";
+    for ( Block *bdp : blocks_ ) {
+	ost << "block " << bdp->id << " " << bdp->hncell;
+	for ( size_t ih = 0; ih < bdp->hncell; ++ih ) {
+	    ost << " " << bdp->hicell[ih] << " " << bdp->hjcell[ih] << " " << bdp->hkcell[ih];
+	}
+	ost << "\n";
+    }
+    ost << "record_size " << record_size_ << "\n";
+    ost << "end_header\n";
+    return ost.str();
+}
+
+/// \brief Sample the history cells into the fill buffer, handing it
+///        to the writer thread when it is full.
+int HistoryRecorder::record(double sim_time)
+{
+    double *rec = &fill_buf_[nfill_ * record_size_];
+    *rec++ = sim_time;
+    for ( Block *bdp : blocks_ ) {
+	for ( size_t ih = 0; ih < bdp->hncell; ++ih ) {
+	    FV_Cell *cellp = bdp->get_cell(bdp->hicell[ih] + bdp->imin,
+					   bdp->hjcell[ih] + bdp->jmin,
+					   bdp->hkcell[ih] + bdp->kmin);
+	    cellp->write_values_to_vector(cell_values_);
+	    for ( size_t iv : var_index_ ) *rec++ = cell_values_[iv];
+	}
+    }
+    ++nfill_;
+    if ( nfill_ == buffer_records_ ) return flush();
+    return SUCCESS;
+}
+
+/// \brief Swap buffers and let the writer thread append the filled one.
+///
+/// Only waits if the writer has not yet finished with the previous buffer.
+int HistoryRecorder::flush()
+{
+    if ( fp_ == NULL ) return FAILURE;
+    unique_lock<mutex> lock(mtx_);
+    cv_.wait(lock, [this]{ return !write_pending_; });
+    if ( write_failed_ ) {
+	cerr << "HistoryRecorder: write to " << filename_ << " failed." << endl;
+	return FILE_ERROR;
+    }
+    if ( nfill_ == 0 ) return SUCCESS;
+    fill_buf_.swap(write_buf_);
+    nwrite_ = nfill_;
+    nfill_ = 0;
+    write_pending_ = true;
+    cv_.notify_all();
+    return SUCCESS;
+}
+
+/// \brief Write out anything buffered, wait for the writer and close the file.
+int HistoryRecorder::close()
+{
+    if ( fp_ == NULL ) return SUCCESS;
+    int flag = flush();
+    {
+	unique_lock<mutex> lock(mtx_);
+	cv_.wait(lock, [this]{ return !write_pending_; });
+	closing_ = true;
+	cv_.notify_all();
+    }
+    writer_.join();
+    if ( write_failed_ ) flag = FILE_ERROR;
+    fclose(fp_);
+    fp_ = NULL;
+    return flag;
+}
+
+void HistoryRecorder::writer_loop()
+{
+    unique_lock<mutex> lock(mtx_);
+    while ( true ) {
+	cv_.wait(lock, [this]{ return write_pending_ || closing_; });
+	if ( write_pending_ ) {
+	    size_t n = nwrite_ * record_size_;
+	    // The solver only touches the fill buffer, so the lock
+	    // need not be held while writing.
+	    lock.unlock();
+	    size_t nwritten = fwrite(&write_buf_[0], sizeof(double), n, fp_);
+	    fflush(fp_);
+	    lock.lock();
+	    if ( nwritten != n ) write_failed_ = true;
+	    write_pending_ = false;
+	    cv_.notify_all();
+	} else if ( closing_ ) {
+	    break;
+	}
+    }
+}
@@ -0,0 +1,72 @@
+/// \file history_recorder.hh
+/// \ingroup eilmer3
+/// \brief Buffered binary recording of the history cells.
+///
+/// The text history files (Block::write_history) open, append and close
+/// a file for every sample, which is too slow when sampling at the rate
+/// of a pressure transducer.  This recorder keeps the selected variables
+/// for all history cells of the blocks on this process in memory and
+/// hands full buffers to a writer thread that appends them to a single
+/// binary file per MPI rank.  The script e3history_bin.py converts
+/// these files back to the usual per-block text history files.
+///
+/// The file starts with a text header, ended by the line "end_header":
+///     eilmer3 binary history 1
+///     variables: "p" "T[0]" ...
+///     nblock <n>
+///     block <id> <nhcell> <i> <j> <k> <i> <j> <k> ...
+///     record_size <number of doubles per record>
+///     end_header
+/// followed by records of native-endian doubles:
+/// time, then the selected variables for each history cell of each block.
+///
+/// \version 18-Oct-2026
+
+#ifndef HISTORY_RECORDER_HH
+#define HISTORY_RECORDER_HH
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "block.hh"
+
+class HistoryRecorder {
+public:
+    HistoryRecorder(const std::string filename, const std::vector<Block *> &blocks,
+		    const std::vector<std::string> &variables, size_t buffer_records);
+    ~HistoryRecorder();
+    int record(double sim_time);
+    int flush();
+    int close();
+    size_t get_number_of_cells() const { return ncells_; }
+
+private:
+    std::string make_header() const;
+    void writer_loop();
+
+    std::string filename_;
+    std::vector<Block *> blocks_;
+    std::vector<std::string> var_names_;
+    std::vector<size_t> var_index_; // positions in FV_Cell::write_values_to_vector
+    std::vector<double> cell_values_;
+    size_t ncells_;
+    size_t record_size_; // doubles per record
+    size_t buffer_records_;
+    // The solver fills one buffer while the writer thread empties the other.
+    std::vector<double> fill_buf_;
+    std::vector<double> write_buf_;
+    size_t nfill_;
+    size_t nwrite_;
+    FILE *fp_;
+    std::thread writer_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool write_pending_;
+    bool closing_;
+    bool write_failed_;
+};
+
+#endif
@@ -4,6 +4,7 @@
  *
  * \version 02-Mar-08 Elmer3 port from mbcns2
  * \version 30-Jun-08 Conversion to use of C++ strings and Rowan's ConfigParser.
+ * \version 18-Oct-26 INI files are read by rank 0 only and broadcast in the MPI build.
  */
 
 //-----------------------------------------------------------------
@@ -34,6 +35,7 @@
 #include "flux_calc.hh"
 #include "one_d_interp.hh"
 #include "conj-ht-interface.hh"
+#include "file_broadcast.hh"
 
 using namespace std;
 
@@ -277,6 +279,7 @@ int read_config_parameters(const string filename, bool master, int start_tindx)
     G.drummond_progressive = 0;
 
     G.fixed_time_step = false; // Set to false as a default
+    G.local_time_stepping = false;
     G.cfl_count = 10;
     G.print_count = 20;
     G.control_count = 10;
@@ -324,7 +327,7 @@ int read_config_parameters(const string filename, bool master, int start_tindx)
     
 
     // Most configuration comes from the previously-generated INI file.
-    ConfigParser dict = ConfigParser(filename);
+    ConfigParser dict = read_ini_file_on_master(filename);
     int i_value;
     bool b_value;
     string s_value, s_value2;
@@ -556,6 +559,14 @@ int read_config_parameters(const string filename, bool master, int start_tindx)
     if ( G.verbosity_level >= 2 ) {
 	cout << "sequence_blocks = " << G.sequence_blocks << endl;
     }
+    dict.parse_size_t("global_data", "grid_sequence_levels", G.grid_sequence_levels, 0);
+    dict.parse_size_t("global_data", "grid_sequence_steps", G.grid_sequence_steps, 1000);
+    dict.parse_double("global_data", "grid_sequence_tolerance", G.grid_sequence_tolerance, 0.0);
+    if ( G.verbosity_level >= 2 ) {
+	cout << "grid_sequence_levels = " << G.grid_sequence_levels << endl;
+	cout << "grid_sequence_steps = " << G.grid_sequence_steps << endl;
+	cout << "grid_sequence_tolerance = " << G.grid_sequence_tolerance << endl;
+    }
 
     // Read a number of gas-states.
     dict.parse_size_t("global_data", "nflow", G.n_gas_state, 0);
@@ -760,6 +771,25 @@ int read_config_parameters(const string filename, bool master, int start_tindx)
 	cout << "conjugate_ht_coupling = " << G.cht_coupling << endl;
 	cout << "conjugate_ht_file = " << s_value << endl;
     }
+    dict.parse_boolean("global_data", "history_buffered_flag", G.history_buffered, false);
+    dict.parse_size_t("global_data", "history_step_interval", G.history_step_interval, 0);
+    dict.parse_size_t("global_data", "history_buffer_records", G.history_buffer_records, 1000);
+    vector<string> vs_default;
+    dict.parse_vector_of_strings("global_data", "history_variables", G.history_variables, vs_default);
+    if ( G.verbosity_level >= 2 ) {
+	cout << "history_buffered_flag = " << G.history_buffered << endl;
+	cout << "history_step_interval = " << G.history_step_interval << endl;
+	cout << "history_buffer_records = " << G.history_buffer_records << endl;
+	cout << "history_variables =";
+	for ( const string &name : G.history_variables ) cout << " " << name;
+	cout << endl;
+    }
+    dict.parse_boolean("global_data", "async_write_flag", G.async_solution_write, false);
+    dict.parse_boolean("global_data", "single_flow_file_flag", G.single_flow_file, false);
+    if ( G.verbosity_level >= 2 ) {
+	cout << "async_write_flag = " << G.async_solution_write << endl;
+	cout << "single_flow_file_flag = " << G.single_flow_file << endl;
+    }
     // Now, for the individual block configuration.
     for ( jb = 0; jb < G.nblock; ++jb ) {
         set_block_parameters( jb, dict, master );
@@ -778,7 +808,7 @@ int read_control_parameters( const string filename, bool master, bool first_time
     std::string s_value;
     global_data &G = *get_global_data_ptr();
     // Parse the previously-generated INI file.
-    ConfigParser dict = ConfigParser(filename);
+    ConfigParser dict = read_ini_file_on_master(filename);
 
     dict.parse_int("control_data", "x_order", G.Xorder, 2); // default high-order
     // 2013-03-31 change to use an explicitly-named update scheme.
@@ -814,6 +844,7 @@ int read_control_parameters( const string filename, bool master, bool first_time
     if ( first_time ) G.dt_global = G.dt_init;
     dict.parse_double("control_data", "dt_max", G.dt_max, 1.0e-3);
     dict.parse_boolean("control_data", "fixed_time_step", G.fixed_time_step, 0);
+    dict.parse_boolean("control_data", "local_time_stepping", G.local_time_stepping, false);
     dict.parse_double("control_data", "dt_reduction_factor",
 		      G.dt_reduction_factor, 0.2);
     dict.parse_double("control_data", "cfl", G.cfl_target, 0.5);
@@ -839,6 +870,24 @@ int read_control_parameters( const string filename, bool master, bool first_time
     }
     dict.parse_double("control_data", "tolerance_in_T", G.tolerance_in_T, 100.0);
     dict.parse_boolean("control_data", "halt_on_large_flow_change", G.halt_on_large_flow_change, false);   
+    if ( G.local_time_stepping ) {
+	// Each cell is given its own time step in the explicit gas-dynamic update only.
+	// The other updates use the global time step so their steady state would be wrong.
+	if ( G.fixed_time_step || G.moving_grid || G.implicit_mode != 0 ) {
+	    throw runtime_error("ERROR: local_time_stepping needs explicit updates with "
+				"the CFL-selected time step, on a fixed grid.");
+	}
+	if ( G.reacting || G.thermal_energy_exchange ||
+	     (G.turbulence_model == TM_K_OMEGA && G.separate_update_for_k_omega_source) ) {
+	    throw runtime_error("ERROR: local_time_stepping cannot be used with separate updates "
+				"for chemistry, thermal energy exchange or k-omega source terms.");
+	}
+	if ( G.BGK > 0 ) {
+	    // The BGK collision-time limit only enters the global dt_allow,
+	    // not the per-cell time steps.
+	    throw runtime_error("ERROR: local_time_stepping cannot be used with BGK.");
+	}
+    }
     if ( first_time && G.verbosity_level >= 2 ) {
 	cout << "Time-step control parameters:" << endl;
 	cout << "    x_order = " << G.Xorder << endl;
@@ -850,6 +899,7 @@ int read_control_parameters( const string filename, bool master, bool first_time
 	cout << "    dt = " << G.dt_init << endl;
 	cout << "    dt_max = " << G.dt_max << endl;
 	cout << "    fixed_time_step = " << G.fixed_time_step << endl;
+	cout << "    local_time_stepping = " << G.local_time_stepping << endl;
 	cout << "    dt_reduction_factor = " 
 	     << G.dt_reduction_factor << endl;
 	cout << "    cfl = " << G.cfl_target << endl;
@@ -905,7 +955,7 @@ int assign_blocks_to_mpi_rank(const string filename, bool master)
 	    }
 	    G.mpi_rank_for_block.resize(G.nblock);
 	    // The mapping comes from the previously-generated INI file.
-	    ConfigParser dict = ConfigParser(filename);
+	    ConfigParser dict = read_ini_file_on_master(filename);
 	    size_t nrank = 0;
 	    size_t nblock;
 	    size_t nblock_total = 0;
@@ -44,7 +44,12 @@ Gas_model *get_gas_model_ptr()
 }
 
 // The managed reaction update model lives here.
-Reaction_update *rupdate;
+// The update keeps its working storage (ODE solver, Q_save_ and the
+// concentration vectors) inside the object, sized when it is made, so a
+// cell update allocates nothing.  There is only the one instance because
+// the chemistry and thermal cell loops in main.cxx run serially; they
+// also share the Gas_model, whose mixing rules keep scratch storage.
+Reaction_update *rupdate = 0;
 
 int set_reaction_update(std::string file_name)
 {
@@ -61,7 +66,7 @@ Reaction_update *get_reaction_update_ptr()
 }
 
 // The managed energy exchange update model lives here.
-Energy_exchange_update *eeupdate;
+Energy_exchange_update *eeupdate = 0;
 
 int set_energy_exchange_update(std::string file_name)
 {
@@ -124,6 +129,10 @@ void eilmer_finalize( void )
     gd.turbulent_zone.clear();
     gd.my_blocks.clear();
     gd.mpi_rank_for_block.clear();
+    delete rupdate;
+    rupdate = 0;
+    delete eeupdate;
+    eeupdate = 0;
     delete gmodel;
     if ( gd.radiation ) delete rtm;
     if ( gd.conjugate_ht_active ) {
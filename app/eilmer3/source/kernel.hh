@@ -114,6 +114,8 @@ struct global_data
     bool stringent_cfl;     // If true, assume the worst with respect to cell geometry and wave speed.
     double dt_max;          // Maximum allowable time-step, after all other considerations.
     bool fixed_time_step;   /* flag for fixed time-stepping */
+    bool local_time_stepping; // If true, each cell advances at its own CFL-limited time step.
+                              // Only the steady state is meaningful; sim_time is a pseudo-time.
     int Xorder; // Low order reconstruction (1) uses just the cell-centre data as left- and right-
                 // flow properties in the flux calculation.
                 // High-order reconstruction (2) adds a correction term to the cell-centre values
@@ -121,6 +123,9 @@ struct global_data
                 // cell centres.
 
     bool sequence_blocks;   // if true, iterate blocks sequentially (like space-marching)
+    size_t grid_sequence_levels; // number of coarse grid levels to run first, 0 for none
+    size_t grid_sequence_steps;  // maximum number of steps on each coarse level
+    double grid_sequence_tolerance; // a coarse level is done when the mass residual is below this
     size_t max_invalid_cells;  // the maximum number of bad cells (per block) 
                             // which will be tolerated without too much complaint.
     double dt_reduction_factor; 
@@ -213,6 +218,12 @@ struct global_data
     double t_fstc;          /* time to write next fluid-structure exchange data*/  
     double dt_plot;         /* interval for writing soln  */
     double dt_his;          /* interval for writing sample */
+    bool history_buffered;  /* record history cells to binary files via HistoryRecorder */
+    size_t history_step_interval; /* buffered: sample every n steps, 0=use dt_his */
+    size_t history_buffer_records; /* buffered: samples held in memory before writing */
+    std::vector<std::string> history_variables; /* buffered: names to record, empty=all */
+    bool async_solution_write; /* write flow snapshots from a background thread */
+    bool single_flow_file;  /* write each flow solution as one collection file */
     double dt_fstc;         /* interval for writing next f-s exchange data*/
 
     double cfl_target;      /* target CFL (worst case)    */
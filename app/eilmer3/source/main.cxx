@@ -73,6 +73,10 @@ extern "C" {
 #include "piston.hh"
 #include "implicit.hh"
 #include "conj-ht-interface.hh"
+#include "history_recorder.hh"
+#include "solution_writer.hh"
+#include "flow_collection.hh"
+#include "file_broadcast.hh"
 #ifdef GPU_CHEM
 #    include "gpu-chem-update.hh"
 #endif
@@ -83,6 +87,7 @@ extern "C" {
 //
 bool history_just_written, output_just_written, av_output_just_written;
 bool write_at_step_has_been_done = false;
+size_t grid_sequence_level = 0; // coarse grid level being integrated, 0 for the full grid
 int program_return_flag = 0;
 size_t output_counter = 0; // counts the number of flow-solutions written
 bool zip_files = true; // flag to indicate if flow and grid files are to be gzipped
@@ -94,6 +99,8 @@ int max_wall_clock = 0; // seconds
 time_t start, now; // wall-clock timer
 
 lua_State *L; // for the uder-defined procedures
+HistoryRecorder *history_recorder = 0; // only when G.history_buffered
+SolutionWriter *solution_writer = 0; // only when G.async_solution_write
 
 #ifdef GPU_CHEM
 gpu_chem *gchem = 0;
@@ -355,6 +362,18 @@ int main(int argc, char **argv)
 		run_status = integrate_blocks_in_sequence();
 		if (run_status != SUCCESS) goto Quit;
 	    } else {
+		if ( G.grid_sequence_levels > 0 ) {
+		    if ( start_tindx == 0 ) {
+			run_status = integrate_on_coarse_grids();
+			if (run_status != SUCCESS) goto Quit;
+		    } else if ( master ) {
+			// A restart is not an error: the flow already read in
+			// stands in for the coarse-grid start, so the coarse
+			// levels are just left out.
+			printf("Grid sequencing is skipped when restarting from tindx %d.\n",
+			       static_cast<int>(start_tindx));
+		    }
+		}
 		run_status = integrate_in_time(-1.0);
 		if (run_status != SUCCESS) goto Quit;
 	    }
@@ -375,6 +394,12 @@ int main(int argc, char **argv)
     // Finalization.
     //
     Quit: /* nop */;
+    if ( solution_writer ) {
+	// Failed run; still let the writer thread finish the snapshot in flight.
+	solution_writer->close();
+	delete solution_writer;
+	solution_writer = 0;
+    }
     fclose(G.logfile);
     eilmer_finalize();
     if ( G.verbosity_level >= 1 ) {
@@ -456,11 +481,13 @@ int prepare_to_integrate(size_t start_tindx)
     for ( Block *bdp : G.my_blocks ) {
         if ( bdp->array_alloc(G.dimensions) != SUCCESS ) exit( MEMORY_ERROR );
 	bdp->bind_interfaces_to_cells(G.dimensions);
+	if ( bdp->build_exchange_maps(G.dimensions) != SUCCESS ) exit( VALUE_ERROR );
     }
 #   ifdef _MPI
     fflush(stdout);
     MPI_Barrier(MPI_COMM_WORLD); // just to reduce the jumble in stdout
     if ( allocate_send_and_receive_buffers() != 0 ) exit( MEMORY_ERROR );
+    if ( setup_mapped_cell_exchange_via_mpi() != SUCCESS ) exit( VALUE_ERROR );
 #   endif
     // Read block grid and flow data; write history-file headers.
     // Note that the global simulation time is set by the last flow data read.
@@ -470,7 +497,17 @@ int prepare_to_integrate(size_t start_tindx)
 #   endif
     sprintf( tindxcstr, "t%04d", static_cast<int>(start_tindx));
     tindxstring = tindxcstr;
-    for ( Block *bdp : G.my_blocks ) {
+    // The flow data may be in a single collection file rather than per-block files.
+    std::string collection_name = flow_collection_filename(G.base_file_name, tindxstring);
+    bool use_collection = flow_collection_exists(collection_name);
+    std::vector<std::string> collection_texts;
+    if ( use_collection ) {
+	if ( read_flow_collection_blocks(collection_name, G.my_blocks, collection_texts) != SUCCESS ) {
+	    return FAILURE;
+	}
+    }
+    for ( size_t ib = 0; ib < G.my_blocks.size(); ++ib ) {
+	Block *bdp = G.my_blocks[ib];
         if ( G.verbosity_level >= 2 ) printf( "----------------------------------\n" );
 	sprintf( jbcstr, ".b%04d", static_cast<int>(bdp->id) );
 	jbstring = jbcstr;
@@ -485,17 +522,31 @@ int prepare_to_integrate(size_t start_tindx)
 	    return FAILURE;
 	}
 	// Read flow data from the specified tindx files.
-	filename = "flow/"+tindxstring+"/"+G.base_file_name+".flow"+jbstring+"."+tindxstring;
-        if (bdp->read_solution(filename, &(G.sim_time), G.dimensions, zip_files) != SUCCESS) {
+	if ( use_collection ) {
+	    if ( bdp->read_solution_from_string(collection_texts[ib], &(G.sim_time),
+						 G.dimensions) != SUCCESS ) {
+		return FAILURE;
+	    }
+	    std::string().swap(collection_texts[ib]); // release the memory
+	} else {
+	    filename = "flow/"+tindxstring+"/"+G.base_file_name+".flow"+jbstring+"."+tindxstring;
+	    if (bdp->read_solution(filename, &(G.sim_time), G.dimensions, zip_files) != SUCCESS) {
+		return FAILURE;
+	    }
+	}
+	if ( G.BGK > 0 && bdp->allocate_BGK_storage(G.dimensions) != SUCCESS ) {
 	    return FAILURE;
 	}
 	if ( G.BGK == 2 ) {
 	    filename = "flow/"+tindxstring+"/"+G.base_file_name+".BGK"+jbstring+"."+tindxstring;
-	    if ( access(filename.c_str(), F_OK) != 0 ) {
+	    std::string bgk_file = zip_files ? filename+".gz" : filename;
+	    if ( access(bgk_file.c_str(), F_OK) == 0 ) {
 		// previous BGK velocity distributions do exist, try to read them in
 		if (bdp->read_BGK(filename, &(G.sim_time), G.dimensions, zip_files) != SUCCESS) {
 		    return FAILURE;
 		}
+	    } else if (bdp->initialise_BGK_equilibrium() != SUCCESS) {
+		return FAILURE;
 	    }
 	} else if ( G.BGK == 1) {
 	    // assume equilibrium velocity distribution, generate from conserved props
@@ -505,17 +556,41 @@ int prepare_to_integrate(size_t start_tindx)
 	    filename = "flow/"+tindxstring+"/"+G.base_file_name+".BGK"+jbstring+"."+tindxstring;
 	    bdp->write_BGK(filename, G.sim_time, G.dimensions, zip_files);
 	}
+	if ( G.BGK > 0 ) bdp->copy_BGK_from_cells();
     } // end for *bdp
 
+    if ( G.async_solution_write ) {
+	if ( G.single_flow_file ) {
+	    // The collection is written with collective MPI-IO calls
+	    // that must come from the main thread of every rank.
+	    if ( master ) printf("async_write_flag ignored because single_flow_file_flag is set.\n");
+	} else {
+	    solution_writer = new SolutionWriter();
+	}
+    }
+
     // History file header is only written for a fresh start.
     ensure_directory_is_present("hist"); // includes Barrier
 
+    if ( G.history_buffered ) {
+	// One binary file for all of the history cells on this process.
+	size_t nhcell = 0;
+	for ( Block *bdp : G.my_blocks ) nhcell += bdp->hncell;
+	if ( nhcell > 0 ) {
+	    char rankcstr[32];
+	    sprintf( rankcstr, ".rank%04d", G.my_mpi_rank );
+	    filename = "hist/" + G.base_file_name + ".hist" + rankcstr + ".bin";
+	    history_recorder = new HistoryRecorder(filename, G.my_blocks, G.history_variables,
+						   G.history_buffer_records);
+	}
+    }
+
     for ( Block *bdp : G.my_blocks ) {
         if ( G.verbosity_level >= 2 ) printf( "----------------------------------\n" );
 	sprintf( jbcstr, ".b%04d", static_cast<int>(bdp->id) );
 	jbstring = jbcstr;
 	filename = "hist/" + G.base_file_name + ".hist"+jbstring;
-	if ( access(filename.c_str(), F_OK) != 0 ) {
+	if ( !G.history_buffered && access(filename.c_str(), F_OK) != 0 ) {
 	    // History file does not yet exist; write header.
 	    bdp->write_history(filename, G.sim_time, true);
 	}
@@ -579,6 +654,7 @@ int prepare_to_integrate(size_t start_tindx)
 	bdp->compute_primary_cell_geometric_data(G.dimensions, 0);
 	bdp->compute_distance_to_nearest_wall_for_all_cells(G.dimensions, 0);
 	bdp->compute_secondary_cell_geometric_data(G.dimensions, 0);
+	if ( G.BGK > 0 && bdp->set_up_BGK_walls() != SUCCESS ) return FAILURE;
 	bdp->set_base_qdot(G, 0);  // this need be done only once per block
 	bdp->identify_reaction_zones(G, 0);
 	bdp->identify_turbulent_zones(G, 0);
@@ -1239,6 +1315,163 @@ int integrate_blocks_in_sequence(void)
 
 //---------------------------------------------------------------------------
 
+namespace {
+
+// Release a grid level that has been swapped out of a block.
+void discard_grid_level(Block &level)
+{
+    global_data &G = *get_global_data_ptr();
+    level.array_cleanup(G.dimensions);
+    for ( BoundaryCondition *&bc : level.bcp ) {
+	delete bc;
+	bc = NULL;
+    }
+}
+
+// Geometry, boundary conditions and exchange lists for a freshly coarsened block.
+int set_up_coarse_level(Block &bd, Block &fine, size_t stride, ConfigParser &dict)
+{
+    global_data &G = *get_global_data_ptr();
+    int flag = bd.coarsen_grid_from(fine, stride, G.dimensions);
+    if ( flag != SUCCESS ) return flag;
+    for ( int iface = NORTH; iface <= ((G.dimensions == 3)? BOTTOM : WEST); ++iface ) {
+	std::string section = "block/" + tostring(bd.id) + "/face/" + get_face_name(iface);
+	bd.bcp[iface] = create_BC(&bd, iface, fine.bcp[iface]->type_code, dict, section);
+    }
+    flag = bd.build_exchange_maps(G.dimensions);
+    if ( flag != SUCCESS ) return flag;
+    bd.compute_primary_cell_geometric_data(G.dimensions, 0);
+    bd.compute_distance_to_nearest_wall_for_all_cells(G.dimensions, 0);
+    bd.compute_secondary_cell_geometric_data(G.dimensions, 0);
+    return SUCCESS;
+}
+
+} // end anonymous namespace
+
+int integrate_on_coarse_grids(void)
+// Grid sequencing for steady-state calculations.
+//
+// Starting from the initial flow on the full grid, we run the time-stepper
+// on a sequence of coarser grids, coarsest first, each level taking every
+// other vertex of the level above.  The initial flow is restricted onto the
+// coarsest level and each converged coarse solution is prolongated onto
+// the next finer level, finally landing on the full grid, where the normal
+// integration continues.  Most of the transient (the shock layer moving
+// out from the body) is thus spent on the cheap grids.
+//
+// Each coarse level stands in for the full grid within the same Block
+// objects, so the exchange functions, boundary conditions and MPI
+// communication all work as usual.  No solutions or history data are
+// written while on the coarse levels, and the simulation time is set back
+// to its starting value before the full-grid integration.
+{
+    global_data &G = *get_global_data_ptr();
+    int status_flag = SUCCESS;
+    size_t nlevel = G.grid_sequence_levels;
+    size_t stride = static_cast<size_t>(1) << nlevel;
+    //---------------------------------------------------------------------------------------
+    // Check compatability...
+    // The coarse levels are built only from the grid and the block configuration,
+    // so they cannot support models that keep data sized for the full grid.
+    if ( G.moving_grid || G.flow_induced_moving || G.BGK > 0 || G.radiation ||
+	 G.conjugate_ht_active || G.sequence_blocks ) {
+	throw std::runtime_error("Grid sequencing not implemented with moving grids, BGK, "
+				 "radiation, conjugate heat transfer or block sequencing.");
+    }
+    for ( Block *bdp : G.my_blocks ) {
+	for ( int iface = NORTH; iface <= ((G.dimensions == 3)? BOTTOM : WEST); ++iface ) {
+	    switch ( bdp->bcp[iface]->type_code ) {
+	    case MAPPED_CELL:
+	    case STATIC_PROF:
+	    case TRANSIENT_PROF:
+	    case FSTC:
+	    case NONUNIFORM_T:
+	    case CONJUGATE_HT:
+	    case SHOCK_FITTING_IN:
+		throw std::runtime_error("Grid sequencing not implemented with boundary condition " +
+					 get_bc_name(bdp->bcp[iface]->type_code) + " on block " +
+					 tostring(bdp->id) + ".");
+	    default:
+		break;
+	    }
+	}
+	if ( bdp->nni % stride != 0 || bdp->nnj % stride != 0 ||
+	     (G.dimensions == 3 && bdp->nnk % stride != 0) ||
+	     bdp->nni / stride < 2 || bdp->nnj / stride < 2 ||
+	     (G.dimensions == 3 && bdp->nnk / stride < 2) ) {
+	    throw std::runtime_error("Grid sequencing needs at least 2 cells on the coarsest level and "
+				     "cell counts divisible by " + tostring(stride) + " on block " +
+				     tostring(bdp->id) + ".");
+	}
+    }
+    //--------------------------------------------------------------------------------------
+
+    // The coarse levels need their own boundary-condition objects.
+    ConfigParser dict = read_ini_file_on_master(G.base_file_name + ".config");
+    bool with_k_omega = (G.turbulence_model == TM_K_OMEGA);
+    double start_time = G.sim_time;
+    size_t nb = G.my_blocks.size();
+    std::vector<Block> fine(nb), finer(nb);
+    for ( size_t ib = 0; ib < nb; ++ib ) {
+	fine[ib].swap_grid_level(*(G.my_blocks[ib]));
+    }
+    for ( size_t level = nlevel; level >= 1; --level ) {
+	stride = static_cast<size_t>(1) << level;
+	if ( G.verbosity_level >= 1 && master ) {
+	    printf("Grid sequencing: start level %d (every %d-th vertex).\n",
+		   static_cast<int>(level), static_cast<int>(stride));
+	}
+	for ( size_t ib = 0; ib < nb; ++ib ) {
+	    Block *bdp = G.my_blocks[ib];
+	    // The level just finished (if any) is moved aside to be prolongated.
+	    finer[ib].swap_grid_level(*bdp);
+	    if ( set_up_coarse_level(*bdp, fine[ib], stride, dict) != SUCCESS ) exit( VALUE_ERROR );
+	    if ( level == nlevel ) {
+		bdp->restrict_flow_from(fine[ib], stride, G.dimensions);
+	    } else {
+		for ( FV_Cell *cp: finer[ib].active_cells ) cp->encode_conserved(0, 0, bdp->omegaz, with_k_omega);
+		bdp->prolong_flow_from(finer[ib], G.dimensions);
+		discard_grid_level(finer[ib]);
+	    }
+	    bdp->set_base_qdot(G, 0);
+	    bdp->identify_reaction_zones(G, 0);
+	    bdp->identify_turbulent_zones(G, 0);
+	    for ( FV_Cell *cp: bdp->active_cells ) cp->encode_conserved(0, 0, bdp->omegaz, with_k_omega);
+	}
+#       ifdef _MPI
+	MPI_Barrier( MPI_COMM_WORLD );
+	mpi_exchange_boundary_data(COPY_CELL_LENGTHS, 0);
+#       else
+	for ( Block *bdp : G.my_blocks ) {
+	    exchange_shared_boundary_data(bdp->id, COPY_CELL_LENGTHS, 0);
+	}
+#       endif
+	G.sim_time = start_time;
+	grid_sequence_level = level;
+	status_flag = integrate_in_time(-1.0);
+	grid_sequence_level = 0;
+	if ( status_flag != SUCCESS ) return status_flag;
+    } // end for level
+
+    // Back onto the full grid.
+    for ( size_t ib = 0; ib < nb; ++ib ) {
+	Block *bdp = G.my_blocks[ib];
+	finer[ib].swap_grid_level(*bdp);
+	bdp->swap_grid_level(fine[ib]);
+	for ( FV_Cell *cp: finer[ib].active_cells ) cp->encode_conserved(0, 0, bdp->omegaz, with_k_omega);
+	bdp->prolong_flow_from(finer[ib], G.dimensions);
+	discard_grid_level(finer[ib]);
+	for ( FV_Cell *cp: bdp->active_cells ) cp->encode_conserved(0, 0, bdp->omegaz, with_k_omega);
+    }
+    G.sim_time = start_time;
+    if ( G.verbosity_level >= 1 && master ) {
+	printf("Grid sequencing: continue on the full grid.\n");
+    }
+    return status_flag;
+} // end integrate_on_coarse_grids()
+
+//---------------------------------------------------------------------------
+
 int write_solution_data(std::string tindxstring)
 // This function only for use below, in the main time-stepping loop.
 {
@@ -1248,10 +1481,38 @@ int write_solution_data(std::string tindxstring)
     std::string foldername = "flow/"+tindxstring;
     std::string jsstring, jbstring, filename;
     ensure_directory_is_present(foldername); // includes Barrier
-    for ( Block *bdp : G.my_blocks ) {
-	sprintf( jbcstr, ".b%04d", static_cast<int>(bdp->id) ); jbstring = jbcstr; 
-	filename = foldername+"/"+ G.base_file_name+".flow"+jbstring+"."+tindxstring;
-	bdp->write_solution(filename, G.sim_time, G.dimensions, zip_files);
+    if ( G.single_flow_file ) {
+	// One file for all blocks; collective over the MPI processes.
+	filename = flow_collection_filename(G.base_file_name, tindxstring);
+	if ( write_flow_collection(filename, G.my_blocks, G.nblock, G.sim_time,
+				   zip_files) != SUCCESS ) {
+	    exit( FILE_ERROR );
+	}
+    } else if ( solution_writer ) {
+	// Copy the flow state and let the writer thread produce the files.
+	std::vector<std::string> filenames;
+	for ( Block *bdp : G.my_blocks ) {
+	    sprintf( jbcstr, ".b%04d", static_cast<int>(bdp->id) ); jbstring = jbcstr; 
+	    filenames.push_back(foldername+"/"+ G.base_file_name+".flow"+jbstring+"."+tindxstring);
+	}
+	if ( solution_writer->capture(G.my_blocks, filenames, G.sim_time, zip_files) != SUCCESS ) {
+	    exit( FILE_ERROR );
+	}
+    } else {
+	for ( Block *bdp : G.my_blocks ) {
+	    sprintf( jbcstr, ".b%04d", static_cast<int>(bdp->id) ); jbstring = jbcstr; 
+	    filename = foldername+"/"+ G.base_file_name+".flow"+jbstring+"."+tindxstring;
+	    bdp->write_solution(filename, G.sim_time, G.dimensions, zip_files);
+	}
+    }
+
+    if ( G.BGK > 0 ) {
+	for ( Block *bdp : G.my_blocks ) {
+	    sprintf( jbcstr, ".b%04d", static_cast<int>(bdp->id) ); jbstring = jbcstr; 
+	    filename = foldername+"/"+ G.base_file_name+".BGK"+jbstring+"."+tindxstring;
+	    bdp->copy_BGK_to_cells();
+	    bdp->write_BGK(filename, G.sim_time, G.dimensions, zip_files);
+	}
     }
 
     if ( G.moving_grid || G.flow_induced_moving ) {
@@ -1380,7 +1641,11 @@ int integrate_in_time(double target_time)
     dt_record.resize(G.my_blocks.size()); // Just the blocks local to this process.
 
     if ( G.verbosity_level >= 1 && master ) {
-	printf( "Integrate in time\n" );
+	if ( grid_sequence_level > 0 ) {
+	    printf( "Integrate in time on coarse grid level %d\n", static_cast<int>(grid_sequence_level) );
+	} else {
+	    printf( "Integrate in time\n" );
+	}
 	fflush(stdout);
     }
     if ( target_time <= 0.0 ) {
@@ -1605,7 +1870,8 @@ int integrate_in_time(double target_time)
 	if ( G.step == 0 ) {
 	    // When starting a new calculation,
 	    // set the global time step to the initial value.
-	    do_cfl_check_now = false;
+	    // Local time stepping needs the time steps for the cells straight away.
+	    do_cfl_check_now = G.local_time_stepping;
 		// if we are using sequence_blocks we don't want to reset the dt_global for each block
 		if ( G.sequence_blocks && G.dt_global != 0 ) {
 		    /* do nothing i.e. keep dt_global from previous block */ ;
@@ -1631,6 +1897,9 @@ int integrate_in_time(double target_time)
 			status_flag = FAILURE;
 			goto conclusion;
 		    }
+		    // The fastest discrete velocity may exceed the flow's wave speeds.
+		    if ( G.BGK > 0 )
+			bdp->dt_allow = min(bdp->dt_allow, bdp->BGK_allowable_dt(G.cfl_target));
 		}
 	    } // end for jb loop
 	    // If we arrive here, cfl_result will be zero, indicating that all local blocks 
@@ -1874,7 +2143,10 @@ int integrate_in_time(double target_time)
 		
 	// explicit or implicit update of the inviscid terms.
 	int break_loop2 = 0;
-	switch ( G.implicit_mode ) {
+	if ( G.BGK > 0 ) {
+	    // The velocity distributions carry the flow; see bgk_explicit_increment().
+	    break_loop2 = bgk_explicit_increment(G.dt_global);
+	} else switch ( G.implicit_mode ) {
 	case 0: // explicit update of convective terms and, maybe, the viscous terms
 	    if ( G.moving_grid )
 		break_loop2 = gasdynamic_increment_with_moving_grid(G.dt_global);            
@@ -2039,8 +2311,9 @@ int integrate_in_time(double target_time)
         } // end if
 
 
-        // 4. (Occasionally) Write out an intermediate solution
-        if ( (G.sim_time >= G.t_plot) && !output_just_written ) {
+        // 4. (Occasionally) Write out an intermediate solution,
+	//    but nothing from the coarse levels of grid sequencing.
+        if ( (G.sim_time >= G.t_plot) && !output_just_written && grid_sequence_level == 0 ) {
 	    ++output_counter;
 	    if ( master ) {
 	        fprintf( G.timestampfile, "%04d %e %e\n", static_cast<int>(output_counter),
@@ -2055,16 +2328,24 @@ int integrate_in_time(double target_time)
 	    output_just_written = true;
             G.t_plot += G.dt_plot;
         }
-	if ( (G.write_at_step > 0) && (G.step == G.write_at_step) && !write_at_step_has_been_done ) {
+	if ( (G.write_at_step > 0) && (G.step == G.write_at_step) && !write_at_step_has_been_done &&
+	     grid_sequence_level == 0 ) {
 	    // Write the solution once-off, most likely for debug.
 	    write_solution_data("txxxx");
 	    write_at_step_has_been_done = true;
 	}
-        if ( (G.sim_time >= G.t_his) && !history_just_written ) {
+	if ( history_recorder && G.history_step_interval > 0 && grid_sequence_level == 0 &&
+	     (G.step % G.history_step_interval) == 0 ) {
+	    if ( history_recorder->record(G.sim_time) != SUCCESS ) exit( FILE_ERROR );
+	}
+        if ( (G.sim_time >= G.t_his) && !history_just_written && grid_sequence_level == 0 ) {
+	    if ( history_recorder && G.history_step_interval == 0 ) {
+		if ( history_recorder->record(G.sim_time) != SUCCESS ) exit( FILE_ERROR );
+	    }
 	    for ( Block *bdp : G.my_blocks ) {
 		sprintf(jbcstr, ".b%04d", static_cast<int>(bdp->id)); jbstring = jbcstr;
 		filename = "hist/"+G.base_file_name+".hist"+jbstring;
-                bdp->write_history(filename, G.sim_time);
+                if ( !G.history_buffered ) bdp->write_history(filename, G.sim_time);
 		bdp->print_forces(G.logfile, G.sim_time, G.dimensions);
 		bdp->print_pressure_forces(G.logfile, G.sim_time, G.dimensions);		
 		for ( int iface: bdp->transient_profile_faces ) {
@@ -2106,6 +2387,11 @@ int integrate_in_time(double target_time)
 		     G.mass_residual, static_cast<int>(G.step), G.sim_time );
             fprintf( G.logfile, "RESIDUAL energy global max: %e step %d time %g\n",
 		     G.energy_residual, static_cast<int>(G.step), G.sim_time );
+	    if ( G.local_time_stepping && master && G.verbosity_level >= 1 ) {
+		// With local time stepping, the residuals are the only useful measure of progress.
+		printf("    mass residual=%10.3e energy residual=%10.3e\n",
+		       G.mass_residual, G.energy_residual);
+	    }
 	    for ( Block *bdp : G.my_blocks ) {
 		bdp->print_pressure_forces(G.logfile, G.sim_time, G.dimensions);
 	    }		     
@@ -2180,6 +2466,9 @@ int integrate_in_time(double target_time)
 	//        This is mainly for the radiation-coupled simulations.
 	//    (-) Exceeding an allowable delta(f_rad) / f_rad_org factor
 	//
+	//    (6) On a coarse level of grid sequencing, reaching the step limit
+	//        for the level or having the mass residual fall below tolerance.
+	//
 	//    Note that the max_time and max_step control parameters can also
 	//    be found in the control-parameter file (which may be edited
 	//    while the code is running).
@@ -2198,6 +2487,22 @@ int integrate_in_time(double target_time)
             if ( G.verbosity_level >= 1 && master )
 		printf( "Integration stopped: Halt set in control file.\n" );
         }
+	if ( grid_sequence_level > 0 ) {
+	    if ( G.step >= G.grid_sequence_steps ) {
+		finished_time_stepping = true;
+		if ( G.verbosity_level >= 1 && master )
+		    printf( "Integration stopped: reached step limit for coarse grid level.\n" );
+	    }
+	    // The global mass residual is fresh only on the steps that it is computed.
+	    if ( G.grid_sequence_tolerance > 0.0 && 
+		 (G.step / G.print_count) * G.print_count == G.step &&
+		 G.mass_residual < G.grid_sequence_tolerance ) {
+		finished_time_stepping = true;
+		if ( G.verbosity_level >= 1 && master )
+		    printf( "Integration stopped: coarse grid level converged, mass residual %e.\n",
+			    G.mass_residual );
+	    }
+	}
 	now = time(NULL);
 	if ( max_wall_clock > 0 && ( static_cast<int>(now - start) > max_wall_clock ) ) {
             finished_time_stepping = true;
@@ -2293,10 +2598,11 @@ int finalize_simulation( void )
     }
     // For the history files, we don't want to double-up on solution data.
     if ( !history_just_written ) {
+	if ( history_recorder ) history_recorder->record(G.sim_time);
 	for ( Block *bdp : G.my_blocks ) {
 	    sprintf( jbcstr, ".b%04d", static_cast<int>(bdp->id) ); jbstring = jbcstr;
 	    filename = "hist/"+G.base_file_name+".hist"+jbstring;
-            bdp->write_history( filename, G.sim_time );
+            if ( !G.history_buffered ) bdp->write_history( filename, G.sim_time );
 	    for ( int iface: bdp->transient_profile_faces ) {
 		filename = "./" + G.base_file_name + ".blk"+jbstring+"."+get_face_name(iface)+".profile";
 		bdp->write_profile(filename, iface, G.sim_time, false);
@@ -2304,6 +2610,18 @@ int finalize_simulation( void )
 	}
         history_just_written = true;
     }
+    if ( solution_writer ) {
+	// Wait for the last snapshot to reach the disk.
+	if ( solution_writer->close() != SUCCESS ) program_return_flag = FILE_ERROR;
+	delete solution_writer;
+	solution_writer = 0;
+    }
+    if ( history_recorder ) {
+	// Wait for the writer thread to append everything still buffered.
+	if ( history_recorder->close() != SUCCESS ) program_return_flag = FILE_ERROR;
+	delete history_recorder;
+	history_recorder = 0;
+    }
     if ( G.verbosity_level >= 1 && master )
 	printf( "\nTotal number of steps = %d\n", static_cast<int>(G.step) );
 
@@ -2327,6 +2645,20 @@ int finalize_simulation( void )
 
 //------------------------------------------------------------------------
 
+namespace {
+
+// The time step for the explicit update of one cell.
+// With local time stepping, every cell runs at the CFL number of the
+// most restrictive cell, so that the gentle increase of G.dt_global and
+// its reduction after a failed attempt apply to all of the cells.
+inline double cell_time_step(const FV_Cell *cp, const global_data &G)
+{
+    if ( !G.local_time_stepping ) return G.dt_global;
+    return min(cp->dt_local * G.dt_global / G.dt_allow, G.dt_max);
+}
+
+} // end anonymous namespace
+
 int gasdynamic_explicit_increment_with_fixed_grid(double dt)
 // Time level of grid stays at 0.
 // 2013-04-07 also updated G.sim_time
@@ -2351,6 +2683,14 @@ int gasdynamic_explicit_increment_with_fixed_grid(double dt)
 	throw std::runtime_error("gasdynamic_inviscid_increment_with_fixed_grid(): "
 				 "unknown update scheme.");
     }
+    // Unless bad cells are to be patched up in place, a failed attempt
+    // restores the flow state from this snapshot of the start of the step.
+    bool may_need_rollback = !G.adjust_invalid_cell_data;
+    if ( may_need_rollback ) {
+	for ( Block *bdp : G.my_blocks ) {
+	    if ( bdp->active ) bdp->save_flow_state_snapshot();
+	}
+    }
     int attempt_number = 0;
     do {
 	//  Preparation for the predictor-stage of inviscid gas-dynamic flow update.
@@ -2415,9 +2755,10 @@ int gasdynamic_explicit_increment_with_fixed_grid(double dt)
 		}
 		cp->time_derivatives(0, 0, G.dimensions, with_k_omega);
 		bool force_euler = false;
-		cp->stage_1_update_for_flow_on_fixed_grid(G.dt_global, force_euler, with_k_omega);
-		cp->decode_conserved(0, 1, bdp->omegaz, with_k_omega);
+		cp->stage_1_update_for_flow_on_fixed_grid(cell_time_step(cp, G), force_euler, with_k_omega);
+		cp->decode_conserved_deferred(0, 1, bdp->omegaz, with_k_omega);
 	    } // end for *cp
+	    bdp->eval_gas_state_of_active_cells();
 	    if ( G.viscous && !G.separate_update_for_viscous_terms &&
 	         G.turbulence_model == TM_K_OMEGA && G.wall_function ) {
 	        wall_function_correction(*bdp, 1);
@@ -2473,9 +2814,10 @@ int gasdynamic_explicit_increment_with_fixed_grid(double dt)
 			cp->add_viscous_source_vector(with_k_omega && !G.separate_update_for_k_omega_source);
 		    }
 		    cp->time_derivatives(0, 1, G.dimensions, with_k_omega);
-		    cp->stage_2_update_for_flow_on_fixed_grid(G.dt_global, with_k_omega);
-		    cp->decode_conserved(0, 2, bdp->omegaz, with_k_omega);
+		    cp->stage_2_update_for_flow_on_fixed_grid(cell_time_step(cp, G), with_k_omega);
+		    cp->decode_conserved_deferred(0, 2, bdp->omegaz, with_k_omega);
 		} // end for ( *cp
+		bdp->eval_gas_state_of_active_cells();
 	        if ( G.viscous && !G.separate_update_for_viscous_terms &&
 	             G.turbulence_model == TM_K_OMEGA && G.wall_function ) {
 	            wall_function_correction(*bdp, 1);
@@ -2531,9 +2873,10 @@ int gasdynamic_explicit_increment_with_fixed_grid(double dt)
 			cp->add_viscous_source_vector(with_k_omega && !G.separate_update_for_k_omega_source);
 		    }
 		    cp->time_derivatives(0, 2, G.dimensions, with_k_omega);
-		    cp->stage_3_update_for_flow_on_fixed_grid(G.dt_global, with_k_omega);
-		    cp->decode_conserved(0, 3, bdp->omegaz, with_k_omega);
+		    cp->stage_3_update_for_flow_on_fixed_grid(cell_time_step(cp, G), with_k_omega);
+		    cp->decode_conserved_deferred(0, 3, bdp->omegaz, with_k_omega);
 		} // for *cp
+		bdp->eval_gas_state_of_active_cells();
 	        if ( G.viscous && !G.separate_update_for_viscous_terms &&
 	             G.turbulence_model == TM_K_OMEGA && G.wall_function ) {
 	            wall_function_correction(*bdp, 2);
@@ -2547,22 +2890,20 @@ int gasdynamic_explicit_increment_with_fixed_grid(double dt)
 	//     fail this attempt at taking a step,
 	//     set everything back to the initial state and
 	//     reduce the time step for the next attempt
+	//     The count is already reduced over all processes.
 	int most_bad_cells = do_bad_cell_count(0);
-	if ( !G.adjust_invalid_cell_data && most_bad_cells > 0 ) {
+	if ( may_need_rollback && most_bad_cells > 0 ) {
 	    step_status_flag = 1;
 	}
-#       ifdef _MPI
-	MPI_Allreduce(MPI_IN_PLACE, &(step_status_flag), 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-#       endif
 	if ( step_status_flag != 0 ) {
 	    G.dt_global = G.dt_reduction_factor * G.dt_global;
+	    dt = G.dt_global;
+	    G.sim_time = t0;
 	    printf("Attempt %d failed: reducing dt to %e.\n", attempt_number, G.dt_global);
+	    // U[0] is untouched by the stages, so only the flow state needs restoring.
 	    for ( Block *bdp : G.my_blocks ) {
-		if ( !bdp->active ) continue;
-		for ( FV_Cell *cp: bdp->active_cells ) {
-		    cp->decode_conserved(0, 0, bdp->omegaz, with_k_omega);
-		}
-	    } // end for *bdp
+		if ( bdp->active ) bdp->restore_flow_state_snapshot();
+	    }
 	} // end if step_status_flag
 
     } while (attempt_number < 3 && step_status_flag == 1);
@@ -2591,6 +2932,42 @@ int gasdynamic_explicit_increment_with_fixed_grid(double dt)
 } // end gasdynamic_inviscid_increment_with_fixed_grid()
 
 
+int bgk_explicit_increment(double dt)
+// Discrete-velocity BGK/Shakhov update of the velocity distributions.
+// The flow state of each cell is recovered from the distributions,
+// so the macroscopic boundary conditions fill the ghost cells as usual
+// and the distributions cross block connections with the flow state.
+{
+    global_data &G = *get_global_data_ptr();
+    double t0 = G.sim_time;
+    for ( Block *bdp : G.my_blocks ) {
+	if ( bdp->active ) bdp->copy_BGK_to_cells();
+    }
+#   ifdef _MPI
+    MPI_Barrier( MPI_COMM_WORLD );
+    mpi_exchange_boundary_data(COPY_FLOW_STATE, 0);
+    copy_mapped_cell_data_via_mpi(COPY_FLOW_STATE, 0);
+#   else
+    for ( Block *bdp : G.my_blocks ) {
+	if ( bdp->active ) exchange_shared_boundary_data(bdp->id, COPY_FLOW_STATE, 0);
+    }
+    copy_mapped_cell_data_via_shmem(COPY_FLOW_STATE, 0);
+#   endif
+    int step_status_flag = 0;
+    for ( Block *bdp : G.my_blocks ) {
+	if ( !bdp->active ) continue;
+	apply_convective_bc( *bdp, G.sim_time, G.dimensions );
+	bdp->fill_BGK_ghost_cells();
+	if ( bdp->BGK_update(dt) != SUCCESS ) step_status_flag = 1;
+    }
+#   ifdef _MPI
+    MPI_Allreduce(MPI_IN_PLACE, &step_status_flag, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#   endif
+    G.sim_time = t0 + dt;
+    return step_status_flag;
+} // end bgk_explicit_increment()
+
+
 int gasdynamic_increment_with_moving_grid(double dt)
 // We have implemented only the simplest consistent two-stage update scheme. 
 {
@@ -2690,8 +3067,9 @@ int gasdynamic_increment_with_moving_grid(double dt)
 		}		
 		cp->time_derivatives(1, 0, G.dimensions, with_k_omega);
 		cp->stage_1_update_for_flow_on_moving_grid(G.dt_global, with_k_omega);
-		cp->decode_conserved(1, 1, bdp->omegaz, with_k_omega);
+		cp->decode_conserved_deferred(1, 1, bdp->omegaz, with_k_omega);
 	    } // end for *cp
+	    bdp->eval_gas_state_of_active_cells();
 	    if ( G.viscous && !G.separate_update_for_viscous_terms &&
 	         G.turbulence_model == TM_K_OMEGA && G.wall_function ) {
 	        wall_function_correction(*bdp, 0);
@@ -2761,8 +3139,9 @@ int gasdynamic_increment_with_moving_grid(double dt)
 		}		
 		cp->time_derivatives(2, 1, G.dimensions, with_k_omega);
 		cp->stage_2_update_for_flow_on_moving_grid(G.dt_global, with_k_omega);
-		cp->decode_conserved(2, 2, bdp->omegaz, with_k_omega);
+		cp->decode_conserved_deferred(2, 2, bdp->omegaz, with_k_omega);
 	    } // end for *cp
+	    bdp->eval_gas_state_of_active_cells();
 	    if ( G.viscous && !G.separate_update_for_viscous_terms &&
 	         G.turbulence_model == TM_K_OMEGA && G.wall_function ) {
 	        wall_function_correction(*bdp, 1);
@@ -2830,7 +3209,7 @@ int gasdynamic_separate_explicit_viscous_increment()
 	for ( FV_Cell *cp: bdp->active_cells ) {
 	    cp->add_viscous_source_vector(with_k_omega);
 	    cp->time_derivatives(0, 0, G.dimensions, with_k_omega);
-	    cp->stage_1_update_for_flow_on_fixed_grid(G.dt_global, force_euler, with_k_omega);
+	    cp->stage_1_update_for_flow_on_fixed_grid(cell_time_step(cp, G), force_euler, with_k_omega);
 	    swap(cp->U[0], cp->U[1]);
 	    cp->decode_conserved(0, 0, bdp->omegaz, with_k_omega);
 	} // end for *cp
@@ -3,14 +3,21 @@
  *  \brief Definitions for the radiation transport model class and functions.
  **/
 
+#ifdef _MPI
+// Intel MPI requires mpi.h included BEFORE stdio.h
+#include <mpi.h>
+#endif
 #include <math.h>
 #include <iostream>
+#include <algorithm>
+#include <map>
 
 #ifdef _OPENMP
 #include <omp.h>
 #else
 #define omp_get_thread_num() 0
 #define omp_get_max_threads() 1
+#define omp_get_wtime() 0.0
 #endif
 
 extern "C" {
@@ -23,6 +30,7 @@ extern "C" {
 #include "../../../lib/radiation/source/LOS_pieces.hh"
 #include "../../../lib/util/source/useful.h"
 #include "../../../lib/nm/source/exponential_integrals.hh"
+#include "../../../lib/gas/models/physical_constants.hh"
 
 #include "radiation_transport.hh"
 #include "cell.hh"
@@ -30,12 +38,16 @@ extern "C" {
 #include "bc.hh"
 
 #define PRECOMPUTED_PARADE_SPECTRA 0
+#define LEVEL_POPULATION_CHUNK 64	// gas-states whose level populations are prepared together
 
 const int NO_CLUSTERING = 0;
 const int CLUSTERING_BY_VOLUME = 1;
 const int CLUSTERING_BY_AREA = 2;
 const int STANDARD_ABSORPTION = 0;
 const int PARTITIONED_ENERGY_ABSORPTION = 1;
+const double LN_EPS_FLOOR = -700.0;        // ln of an emission that is effectively zero
+const double SURROGATE_RHO_REF = 1.0e-3;   // kg/m**3, density for the tabulated states
+const size_t SURROGATE_CHECK_CELLS = 8;
 
 
 using namespace std;
@@ -95,6 +107,28 @@ OpticallyThin::OpticallyThin( lua_State *L )
 {
     // Why aren't we using get_int()? Booleans makes the input file more neat
     spectrally_resolved_ = static_cast<int>(get_boolean(L,-1,"spectrally_resolved"));
+    
+    // The emission surrogate settings are optional so that older
+    // input files remain valid.
+    lua_getfield(L, -1, "emission_surrogate");
+    use_surrogate_ = lua_isboolean(L, -1) ? lua_toboolean(L, -1) : false;
+    lua_pop(L, 1);
+    lua_getfield(L, -1, "surrogate_T_points");
+    surrogate_T_points_ = lua_isnumber(L, -1) ? lua_tointeger(L, -1) : 100;
+    lua_pop(L, 1);
+    lua_getfield(L, -1, "surrogate_tolerance");
+    surrogate_tolerance_ = lua_isnumber(L, -1) ? lua_tonumber(L, -1) : 0.05;
+    lua_pop(L, 1);
+    if ( use_surrogate_ && surrogate_T_points_ < 2 ) {
+	cout << "OpticallyThin::OpticallyThin()" << endl
+	     << "surrogate_T_points = " << surrogate_T_points_ << " is too small; at least 2 are needed." << endl
+	     << "Exiting program." << endl;
+	exit( BAD_INPUT_ERROR );
+    }
+    surrogate_built_ = false;
+    nT_ = 0; nTv_ = 0;
+    T_lo_ = 0.0; T_hi_ = 0.0; dT_ = 0.0;
+    Tv_lo_ = 0.0; Tv_hi_ = 0.0; dTv_ = 0.0;
 }
 
 OpticallyThin::~OpticallyThin() {}
@@ -115,23 +149,243 @@ OpticallyThin::initialise()
 
 void OpticallyThin::compute_Q_rad_for_flowfield()
 {
-    Block * bdp;
     global_data &G = *get_global_data_ptr();  // set up a reference
 
-    size_t jb;
-#   ifdef _OPENMP
-#   pragma omp barrier
-#   pragma omp parallel for private(jb) schedule(runtime)
-#   endif
-    for ( jb = 0; jb < G.my_blocks.size(); ++jb ) {
-	bdp = G.my_blocks[jb];
+    // 1. Gather the active cells of all blocks into one list.
+    //    Cells usually cost about the same as at the last update, so the
+    //    most expensive ones are handed out first and the cheap ones fill
+    //    in at the end.
+    cells_.clear();
+    for ( Block *bdp : G.my_blocks ) {
 	if ( !bdp->active ) continue;
-	this->compute_Q_rad_for_block(bdp);
+	for ( FV_Cell *cp : bdp->active_cells ) cells_.push_back(cp);
+    }
+    size_t ncells = cells_.size();
+    cell_order_.resize(ncells);
+    for ( size_t ic = 0; ic < ncells; ++ic ) cell_order_[ic] = ic;
+    if ( cell_cost_.size() != ncells ) {
+	cell_cost_.assign(ncells, 0.0);
+    } else {
+	stable_sort( cell_order_.begin(), cell_order_.end(),
+		     [this](size_t a, size_t b) { return cell_cost_[a] > cell_cost_[b]; } );
+    }
+    
+    // 2. Make sure that the emission surrogate, if used, covers the flowfield.
+    if ( use_surrogate_ && ncells > 0 ) {
+	double T_lo = 1.0e30, T_hi = 0.0, Tv_lo = 1.0e30, Tv_hi = 0.0;
+	for ( FV_Cell *cp : cells_ ) {
+	    const Gas_data &Q = *(cp->fs->gas);
+	    T_lo = min(T_lo, Q.T[0]); T_hi = max(T_hi, Q.T[0]);
+	    Tv_lo = min(Tv_lo, Q.T.back()); Tv_hi = max(Tv_hi, Q.T.back());
+	}
+	if ( !surrogate_covers(T_lo, T_hi, Tv_lo, Tv_hi) ) {
+	    // Leave some room so that a slowly changing flowfield
+	    // does not need a new table at every update.
+	    T_lo = 0.9 * T_lo; T_hi = 1.1 * T_hi;
+	    Tv_lo = 0.9 * Tv_lo; Tv_hi = 1.1 * Tv_hi;
+	    if ( surrogate_built_ ) {
+		T_lo = min(T_lo, T_lo_); T_hi = max(T_hi, T_hi_);
+		Tv_lo = min(Tv_lo, Tv_lo_); Tv_hi = max(Tv_hi, Tv_hi_);
+	    }
+	    if ( build_emission_surrogate(T_lo, T_hi, Tv_lo, Tv_hi) != SUCCESS ) {
+		cout << "OpticallyThin: could not build the emission surrogate;" << endl
+		     << "the spectral model will be used directly from now on." << endl;
+		use_surrogate_ = false;
+	    }
+	}
+	if ( use_surrogate_ && check_emission_surrogate() != SUCCESS ) {
+	    cout << "OpticallyThin: the emission surrogate does not represent this gas well enough;" << endl
+		 << "the spectral model will be used directly from now on." << endl;
+	    use_surrogate_ = false;
+	}
+    }
+    
+    // 3. The emission for every cell, with no flowfield reabsorption.
+    if ( use_surrogate_ ) {
+#       ifdef _OPENMP
+#       pragma omp parallel for schedule(static)
+#       endif
+	for ( size_t ic = 0; ic < ncells; ++ic ) {
+	    cells_[ic]->Q_rE_rad = ( - 4.0 * M_PI ) * surrogate_emission(*cells_[ic]->fs->gas);
+	}
+    } else {
+	// The cells are handed out in chunks, in the order above, and the
+	// level populations for a chunk are solved together first.
+	size_t nchunks = ( ncells + LEVEL_POPULATION_CHUNK - 1 ) / LEVEL_POPULATION_CHUNK;
+#       ifdef _OPENMP
+#       pragma omp parallel for schedule(dynamic,1)
+#       endif
+	for ( size_t ichunk = 0; ichunk < nchunks; ++ichunk ) {
+	    size_t n0 = ichunk * LEVEL_POPULATION_CHUNK;
+	    size_t n1 = min( ncells, n0 + LEVEL_POPULATION_CHUNK );
+	    double t0 = omp_get_wtime();
+	    vector<Gas_data*> Q;
+	    for ( size_t n = n0; n < n1; ++n ) Q.push_back( cells_[cell_order_[n]]->fs->gas );
+	    rsm_[omp_get_thread_num()]->prepare_level_populations( Q );
+	    double t_prep = ( omp_get_wtime() - t0 ) / ( n1 - n0 );
+	    for ( size_t n = n0; n < n1; ++n ) {
+		size_t ic = cell_order_[n];
+		t0 = omp_get_wtime();
+		cells_[ic]->Q_rE_rad = ( - 4.0 * M_PI ) * emission_for_gas_state(*cells_[ic]->fs->gas);
+		cell_cost_[ic] = omp_get_wtime() - t0 + t_prep;
+	    }
+	}
     }
     
     return;
 }
 
+double OpticallyThin::emission_for_gas_state( Gas_data &Q )
+{
+    return rsm_[omp_get_thread_num()]->radiative_integrated_emission_for_gas_state(Q, spectrally_resolved_);
+}
+
+int OpticallyThin::build_emission_surrogate( double T_lo, double T_hi, double Tv_lo, double Tv_hi )
+{
+    // Each species is evaluated on its own at a fixed density, so the
+    // table assumes that a species' emission is proportional to its
+    // partial density.  That holds for bound-bound emission from
+    // Boltzmann populations; check_emission_surrogate() catches gases
+    // for which it does not (continuum, QSS populations).
+    Gas_model *gmodel = get_gas_model_ptr();
+    int nsp = gmodel->get_number_of_species();
+    int nmodes = gmodel->get_number_of_modes();
+    
+    nT_ = surrogate_T_points_;
+    nTv_ = ( nmodes > 1 ) ? surrogate_T_points_ : 1;
+    T_lo_ = T_lo; T_hi_ = T_hi;
+    dT_ = ( T_hi_ - T_lo_ ) / ( nT_ - 1 );
+    Tv_lo_ = Tv_lo; Tv_hi_ = Tv_hi;
+    dTv_ = ( nTv_ > 1 ) ? ( Tv_hi_ - Tv_lo_ ) / ( nTv_ - 1 ) : 0.0;
+    int npoints = nT_ * nTv_;
+    ln_eps_.assign(nsp, vector<double>(npoints, LN_EPS_FLOOR));
+    
+    int flag = SUCCESS;
+#   ifdef _OPENMP
+#   pragma omp parallel
+#   endif
+    {
+	Gas_data Q(gmodel);
+#       ifdef _OPENMP
+#       pragma omp for schedule(dynamic)
+#       endif
+	for ( int n = 0; n < nsp * npoints; ++n ) {
+	    int isp = n / npoints;
+	    int m = n % npoints;
+	    double T = T_lo_ + ( m / nTv_ ) * dT_;
+	    double Tv = ( nTv_ > 1 ) ? Tv_lo_ + ( m % nTv_ ) * dTv_ : T;
+	    for ( int jsp = 0; jsp < nsp; ++jsp ) Q.massf[jsp] = 0.0;
+	    Q.massf[isp] = 1.0;
+	    Q.rho = SURROGATE_RHO_REF;
+	    Q.T[0] = T;
+	    for ( int itm = 1; itm < nmodes; ++itm ) Q.T[itm] = Tv;
+	    double R = PC_R_u / gmodel->molecular_weight(isp);
+	    Q.p = Q.rho * R * T;
+	    Q.p_e = ( gmodel->charge(isp) < 0 ) ? Q.rho * R * Tv : 0.0;
+	    double j = emission_for_gas_state(Q);
+	    if ( !isfinite(j) ) {
+#               ifdef _OPENMP
+#               pragma omp critical
+#               endif
+		flag = FAILURE;
+		continue;
+	    }
+	    if ( j > 0.0 ) ln_eps_[isp][m] = max( log( j / SURROGATE_RHO_REF ), LN_EPS_FLOOR );
+	}
+    }
+    if ( flag != SUCCESS ) {
+	surrogate_built_ = false;
+	return flag;
+    }
+    
+    emitters_.clear();
+    for ( int isp = 0; isp < nsp; ++isp ) {
+	if ( *max_element( ln_eps_[isp].begin(), ln_eps_[isp].end() ) > LN_EPS_FLOOR )
+	    emitters_.push_back(isp);
+    }
+    surrogate_built_ = true;
+    
+#   if VERBOSE_RADIATION_TRANSPORT
+    cout << "OpticallyThin: emission surrogate built for T = [" << T_lo_ << ", " << T_hi_ << "] K";
+    if ( nTv_ > 1 ) cout << ", Tv = [" << Tv_lo_ << ", " << Tv_hi_ << "] K";
+    cout << " with " << emitters_.size() << " emitting species." << endl;
+#   endif
+    
+    return SUCCESS;
+}
+
+bool OpticallyThin::surrogate_covers( double T_lo, double T_hi, double Tv_lo, double Tv_hi ) const
+{
+    if ( !surrogate_built_ ) return false;
+    if ( T_lo < T_lo_ || T_hi > T_hi_ ) return false;
+    if ( nTv_ > 1 && ( Tv_lo < Tv_lo_ || Tv_hi > Tv_hi_ ) ) return false;
+    return true;
+}
+
+double OpticallyThin::surrogate_emission( const Gas_data &Q ) const
+{
+    // Bilinear interpolation of ln(eps) in (T, Tv).
+    double x = ( Q.T[0] - T_lo_ ) / dT_;
+    int iT = max( 0, min( static_cast<int>(x), nT_ - 2 ) );
+    double fT = x - iT;
+    int iTv = 0;
+    double fTv = 0.0;
+    if ( nTv_ > 1 ) {
+	double y = ( Q.T.back() - Tv_lo_ ) / dTv_;
+	iTv = max( 0, min( static_cast<int>(y), nTv_ - 2 ) );
+	fTv = y - iTv;
+    }
+    
+    double j = 0.0;
+    for ( int isp : emitters_ ) {
+	if ( Q.massf[isp] <= 0.0 ) continue;
+	const vector<double> &t = ln_eps_[isp];
+	int m = iT * nTv_ + iTv;
+	double ln_eps;
+	if ( nTv_ > 1 ) {
+	    ln_eps = ( 1.0 - fT ) * ( ( 1.0 - fTv ) * t[m] + fTv * t[m+1] ) +
+		fT * ( ( 1.0 - fTv ) * t[m+nTv_] + fTv * t[m+nTv_+1] );
+	} else {
+	    ln_eps = ( 1.0 - fT ) * t[m] + fT * t[m+1];
+	}
+	j += Q.rho * Q.massf[isp] * exp(ln_eps);
+    }
+    
+    return j;
+}
+
+int OpticallyThin::check_emission_surrogate()
+{
+    // Compare against the spectral model at a few cells spread through
+    // the flowfield.  The error is taken relative to the largest emission
+    // found, so that weakly emitting cells do not dominate.
+    size_t ncells = cells_.size();
+    size_t nsample = min( ncells, SURROGATE_CHECK_CELLS );
+    vector<double> j_direct(nsample), j_surrogate(nsample);
+    int isample;
+#   ifdef _OPENMP
+#   pragma omp parallel for private(isample) schedule(dynamic,1)
+#   endif
+    for ( isample = 0; isample < static_cast<int>(nsample); ++isample ) {
+	FV_Cell *cp = cells_[ ( isample * ncells ) / nsample ];
+	j_direct[isample] = emission_for_gas_state(*cp->fs->gas);
+	j_surrogate[isample] = surrogate_emission(*cp->fs->gas);
+    }
+    double j_max = 0.0;
+    for ( size_t i = 0; i < nsample; ++i ) j_max = max( j_max, fabs(j_direct[i]) );
+    if ( j_max <= 0.0 ) return SUCCESS;
+    double error = 0.0;
+    for ( size_t i = 0; i < nsample; ++i )
+	error = max( error, fabs( j_surrogate[i] - j_direct[i] ) / j_max );
+    if ( error > surrogate_tolerance_ ) {
+	cout << "OpticallyThin::check_emission_surrogate(): relative error " << error
+	     << " exceeds the tolerance " << surrogate_tolerance_ << endl;
+	return FAILURE;
+    }
+    
+    return SUCCESS;
+}
+
 void OpticallyThin::compute_Q_rad_for_block( Block * A )
 {
     // No flowfield reabsorption, 100% emission
@@ -184,87 +438,328 @@ TangentSlab::str() const
 int
 TangentSlab::initialise()
 {
-    // Do nothing
+    assemble_block_chains();
     
     return SUCCESS;
 }
 
-void TangentSlab::compute_Q_rad_for_flowfield()
+namespace {
+    // True if a line of sight can pass from the east face of block A
+    // straight into the west face of its neighbour.
+    bool joins_west_to_east( Block &A, global_data &G )
+    {
+	BoundaryCondition *bc = A.bcp[EAST];
+	if ( bc->type_code != ADJACENT && bc->type_code != ADJACENT_PLUS_UDF ) return false;
+	if ( bc->neighbour_block < 0 ) return false;
+	Block &B = G.bd[bc->neighbour_block];
+	return bc->neighbour_face == WEST && bc->neighbour_orientation == 0 &&
+	    B.nnj == A.nnj && B.nnk == A.nnk && B.active;
+    }
+}
+
+void TangentSlab::assemble_block_chains()
 {
-    // FIXME: eventually want to be able to do calculation across blocks
+    // Every process holds the configuration of all blocks,
+    // so all processes arrive at the same chains.
+    global_data &G = *get_global_data_ptr();
     
-    Block * bdp;
-    global_data &G = *get_global_data_ptr();  // set up a reference
+    chains_.clear();
+    vector<bool> has_upstream(G.nblock, false);
+    for ( size_t jb = 0; jb < G.nblock; ++jb ) {
+	if ( G.bd[jb].active && joins_west_to_east(G.bd[jb], G) )
+	    has_upstream[G.bd[jb].bcp[EAST]->neighbour_block] = true;
+    }
+    vector<bool> in_chain(G.nblock, false);
+    for ( size_t jb = 0; jb < G.nblock; ++jb ) {
+	if ( !G.bd[jb].active || has_upstream[jb] ) continue;
+	vector<size_t> chain(1, jb);
+	in_chain[jb] = true;
+	while ( joins_west_to_east(G.bd[chain.back()], G) ) {
+	    size_t next = G.bd[chain.back()].bcp[EAST]->neighbour_block;
+	    if ( in_chain[next] ) break;
+	    chain.push_back(next);
+	    in_chain[next] = true;
+	}
+	chains_.push_back(chain);
+    }
+    // Blocks joined in a closed loop have no start; treat each on its own.
+    for ( size_t jb = 0; jb < G.nblock; ++jb ) {
+	if ( G.bd[jb].active && !in_chain[jb] ) chains_.push_back(vector<size_t>(1, jb));
+    }
     
-    size_t jb;
-#   ifdef _OPENMP
-#   pragma omp barrier
-#   pragma omp parallel for private(jb) schedule(runtime)
-#   endif
-    for ( jb = 0; jb < G.my_blocks.size(); ++jb ) {
-	bdp = G.my_blocks[jb];
-	if ( !bdp->active ) continue;
-	this->compute_Q_rad_for_block(bdp);
+#   if VERBOSE_RADIATION_TRANSPORT
+    if ( G.my_mpi_rank == 0 ) {
+	cout << "TangentSlab: " << chains_.size() << " chain(s) of blocks:" << endl;
+	for ( size_t ic = 0; ic < chains_.size(); ++ic ) {
+	    cout << "   ";
+	    for ( size_t jb : chains_[ic] ) cout << " " << jb;
+	    cout << endl;
+	}
     }
+#   endif
     
     return;
 }
 
-void TangentSlab::compute_Q_rad_for_block( Block * A )
+void TangentSlab::compute_Q_rad_for_flowfield()
 {
-#   if VERBOSE_RADIATION_TRANSPORT
-    cout << "TangentSlab::calculate_source_term_for_block()" << endl;
+    global_data &G = *get_global_data_ptr();  // set up a reference
+    Gas_model *gmodel = get_gas_model_ptr();
+    int my_rank = G.my_mpi_rank;
+    
+    // Per-cell data for cells held by another process: the gas state,
+    // the cell centre and the cell length.  The first block of a chain
+    // also sends the west-face position and temperature for each line.
+    Gas_data Q_tmp(gmodel);
+    vector<double> tmp_buf( 16 + 4 * ( Q_tmp.T.size() + Q_tmp.massf.size() ) +
+			    Q_tmp.massf.size() * Q_tmp.massf.size() );
+    size_t nv = ( Q_tmp.copy_values_to_buffer(&tmp_buf[0]) - &tmp_buf[0] ) + 4;
+    map<size_t, vector<double> > incoming;
+    map<size_t, vector<double> > returned;
+    vector<Gas_data*> remote_gas;
+    
+#   ifdef _MPI
+    // 1. Send the flow data of blocks on this process to the processes
+    //    that own the lines of sight (those holding the wall blocks).
+    map<size_t, vector<double> > outgoing;
+    vector<MPI_Request> requests;
+    for ( vector<size_t> &chain : chains_ ) {
+	int owner = G.mpi_rank_for_block[chain.back()];
+	for ( size_t n = 0; n < chain.size(); ++n ) {
+	    size_t jb = chain[n];
+	    int rank = G.mpi_rank_for_block[jb];
+	    if ( rank == owner || ( my_rank != owner && my_rank != rank ) ) continue;
+	    Block &B = G.bd[jb];
+	    size_t nline = B.nni * nv + ( n == 0 ? 4 : 0 );
+	    size_t count = B.nnk * B.nnj * nline;
+	    requests.push_back(MPI_Request());
+	    if ( my_rank == owner ) {
+		incoming[jb].resize(count);
+		MPI_Irecv(&(incoming[jb][0]), count, MPI_DOUBLE, rank, jb, MPI_COMM_WORLD, &(requests.back()));
+	    } else {
+		outgoing[jb].resize(count);
+		double *buf = &(outgoing[jb][0]);
+		for ( size_t k = B.kmin; k <= B.kmax; ++k ) {
+		    for ( size_t j = B.jmin; j <= B.jmax; ++j ) {
+			if ( n == 0 ) {
+			    FV_Interface *west = B.get_cell(B.imin,j,k)->iface[WEST];
+			    *buf++ = west->pos.x; *buf++ = west->pos.y; *buf++ = west->pos.z;
+			    *buf++ = west->fs->gas->T[0];
+			}
+			for ( size_t i = B.imin; i <= B.imax; ++i ) {
+			    FV_Cell *cellp = B.get_cell(i,j,k);
+			    buf = cellp->fs->gas->copy_values_to_buffer(buf);
+			    *buf++ = cellp->pos[0].x; *buf++ = cellp->pos[0].y; *buf++ = cellp->pos[0].z;
+			    *buf++ = cellp->iLength;
+			}
+		    }
+		}
+		MPI_Isend(&(outgoing[jb][0]), count, MPI_DOUBLE, owner, jb, MPI_COMM_WORLD, &(requests.back()));
+	    }
+	}
+    }
+    if ( requests.size() > 0 )
+	MPI_Waitall(requests.size(), &(requests[0]), MPI_STATUSES_IGNORE);
 #   endif
-    FV_Cell * cellp;
-    Vector3 * coords_im1;
-    Vector3 * coords_i;
-    double s = 0.0;
-    size_t index;
-    double j_total;
     
-    // Perform TS calc for lines of cells in i space
+    // 2. Assemble the lines of sight that end at walls on this process.
+    vector<TS_line> lines;
+    for ( vector<size_t> &chain : chains_ ) {
+	if ( G.mpi_rank_for_block[chain.back()] != my_rank ) continue;
+	Block &W = G.bd[chain.back()];
+	for ( size_t k = 0; k < W.nnk; ++k ) {
+	    for ( size_t j = 0; j < W.nnj; ++j ) {
+		TS_line line;
+		line.wall_block = &W;
+		line.index = W.nnj * k + j;
+		for ( size_t n = 0; n < chain.size(); ++n ) {
+		    size_t jb = chain[n];
+		    Block &B = G.bd[jb];
+		    if ( G.mpi_rank_for_block[jb] == my_rank ) {
+			append_local_segment(line, B, B.jmin + j, B.kmin + k, n == 0);
+			continue;
+		    }
+		    size_t nline = B.nni * nv + ( n == 0 ? 4 : 0 );
+		    double *buf = &(incoming[jb][( k * B.nnj + j ) * nline]);
+		    if ( n == 0 ) {
+			line.start = Vector3(buf[0], buf[1], buf[2]);
+			line.T_i = buf[3];
+			buf += 4;
+		    }
+		    vector<double> &ret = returned[jb];
+		    if ( ret.size() == 0 ) ret.resize(B.nnk * B.nnj * B.nni, 0.0);
+		    for ( size_t i = 0; i < B.nni; ++i ) {
+			Gas_data *Q = new Gas_data(gmodel);
+			buf = Q->copy_values_from_buffer(buf);
+			remote_gas.push_back(Q);
+			line.Q.push_back(Q);
+			line.Q_rE_rad.push_back(&(ret[( k * B.nnj + j ) * B.nni + i]));
+			line.pos.push_back(Vector3(buf[0], buf[1], buf[2]));
+			line.ds.push_back(buf[3]);
+			buf += 4;
+		    }
+		}
+		line.T_f = W.get_cell(W.imax, W.jmin + j, W.kmin + k)->iface[EAST]->fs->gas->T[0];
+		lines.push_back(line);
+	    }
+	}
+    }
+    
+    // 3. Solve the lines.  With plenty of lines, each thread takes whole
+    //    lines; with only a few (e.g. a stagnation-line grid) the threads
+    //    share the spectra of each line instead.
+    size_t nthreads = rsm_.size();
+    if ( lines.size() >= nthreads ) {
+	int il;
+#       ifdef _OPENMP
+#       pragma omp parallel for private(il) schedule(dynamic,1)
+#       endif
+	for ( il = 0; il < static_cast<int>(lines.size()); ++il ) {
+	    TS_line &line = lines[il];
+	    line.wall_block->bcp[EAST]->q_rad[line.index] =
+		solve_line(line, rsm_[omp_get_thread_num()], false);
+	}
+    } else {
+	for ( TS_line &line : lines ) {
+	    line.wall_block->bcp[EAST]->q_rad[line.index] = solve_line(line, rsm_[0], true);
+	}
+    }
+    
+#   ifdef _MPI
+    // 4. Return the source terms for cells held by other processes.
+    requests.clear();
+    map<size_t, vector<double> > from_owner;
+    for ( vector<size_t> &chain : chains_ ) {
+	int owner = G.mpi_rank_for_block[chain.back()];
+	for ( size_t jb : chain ) {
+	    int rank = G.mpi_rank_for_block[jb];
+	    if ( rank == owner || ( my_rank != owner && my_rank != rank ) ) continue;
+	    Block &B = G.bd[jb];
+	    size_t count = B.nnk * B.nnj * B.nni;
+	    requests.push_back(MPI_Request());
+	    if ( my_rank == owner ) {
+		MPI_Isend(&(returned[jb][0]), count, MPI_DOUBLE, rank, G.nblock + jb,
+			  MPI_COMM_WORLD, &(requests.back()));
+	    } else {
+		from_owner[jb].resize(count);
+		MPI_Irecv(&(from_owner[jb][0]), count, MPI_DOUBLE, owner, G.nblock + jb,
+			  MPI_COMM_WORLD, &(requests.back()));
+	    }
+	}
+    }
+    if ( requests.size() > 0 )
+	MPI_Waitall(requests.size(), &(requests[0]), MPI_STATUSES_IGNORE);
+    for ( auto &item : from_owner ) {
+	Block &B = G.bd[item.first];
+	double *buf = &(item.second[0]);
+	for ( size_t k = B.kmin; k <= B.kmax; ++k )
+	    for ( size_t j = B.jmin; j <= B.jmax; ++j )
+		for ( size_t i = B.imin; i <= B.imax; ++i )
+		    B.get_cell(i,j,k)->Q_rE_rad = *buf++;
+    }
+#   endif
+    
+    for ( Gas_data *Q : remote_gas ) delete Q;
+    
+    return;
+}
+
+void TangentSlab::compute_Q_rad_for_block( Block * A )
+{
+    // Lines of cells in i space, within this block only.
     // NOTE: assuming left to right flow
     for ( size_t k = A->kmin; k <= A->kmax; ++k ) {
     	for ( size_t j = A->jmin; j <= A->jmax; ++j ) {
-#           if VERBOSE_RADIATION_TRANSPORT
-    	    cout << "performing TS calc for j = " << j << endl;
-#           endif
-            // Initialise TS_data with the number of points to be used
-    	    TS_data TS = TS_data( rsm_[omp_get_thread_num()], A->nni );
-    	    // west IFace of first cell is s=0.0
-    	    coords_im1 = &(A->get_cell(A->imin,j,k)->iface[WEST]->pos);
-    	    TS.T_i_ = A->get_cell(A->imin,j,k)->iface[WEST]->fs->gas->T[0];
-    	    for ( size_t i = A->imin; i <= A->imax; ++i ) {
-    	    	cellp = A->get_cell(i,j,k);
-    	    	coords_i = &(cellp->pos[0]);
-    	    	s += vabs( *coords_i - *coords_im1 );
-    	    	j_total = TS.set_rad_point( i - A->imin, cellp->fs->gas, &(cellp->Q_rE_rad), s, cellp->iLength );
-#               if VERBOSE_RADIATION_TRANSPORT
-                cout << "i = %d, j_total = " << j_total << " W/m3-sr" << endl;
-#               else
-                UNUSED_VARIABLE(j_total);
-#               endif
-    	    	coords_im1 = coords_i;
-    	    }
-    	    // use east IFace of last cell for s_f and T_f
-    	    TS.T_f_ = A->get_cell(A->imax,j,k)->iface[EAST]->fs->gas->T[0];
+	    TS_line line;
+	    line.wall_block = A;
 	    // index into 1D heat-flux vectors (i parts are omitted as we assume this is always the easterly face)
-	    index = (A->jmax-A->jmin+1)*(k-A->kmin) + (j-A->jmin);
-	    // perform tangent-slab integration
-            if ( exact_ ) {
-	        // Exact but slow version
-	        A->bcp[EAST]->q_rad[index] = TS.exact_solve_for_divq();
-            }
-            else {
-	        // Approximate but speedy version
-    	        A->bcp[EAST]->q_rad[index] = TS.quick_solve_for_divq();
-            }
-        }
+	    line.index = (A->jmax-A->jmin+1)*(k-A->kmin) + (j-A->jmin);
+	    append_local_segment(line, *A, j, k, true);
+	    line.T_f = A->get_cell(A->imax,j,k)->iface[EAST]->fs->gas->T[0];
+	    A->bcp[EAST]->q_rad[line.index] = solve_line(line, rsm_[omp_get_thread_num()], false);
+	}
     }
     
     return;
 }
 
+void TangentSlab::append_local_segment( TS_line &line, Block &B, size_t j, size_t k, bool first )
+{
+    if ( first ) {
+	// west IFace of first cell is s=0.0
+	FV_Interface *west = B.get_cell(B.imin,j,k)->iface[WEST];
+	line.start = west->pos;
+	line.T_i = west->fs->gas->T[0];
+    }
+    for ( size_t i = B.imin; i <= B.imax; ++i ) {
+	FV_Cell *cellp = B.get_cell(i,j,k);
+	line.Q.push_back(cellp->fs->gas);
+	line.Q_rE_rad.push_back(&(cellp->Q_rE_rad));
+	line.pos.push_back(cellp->pos[0]);
+	line.ds.push_back(cellp->iLength);
+    }
+    
+    return;
+}
+
+double TangentSlab::solve_line( TS_line &line, RadiationSpectralModel * rsm, bool parallel_spectra )
+{
+    int nrps = static_cast<int>(line.Q.size());
+    TS_data TS = TS_data( rsm, nrps );
+    TS.T_i_ = line.T_i;
+    TS.T_f_ = line.T_f;
+    double s = 0.0;
+    Vector3 previous = line.start;
+    for ( int irp = 0; irp < nrps; ++irp ) {
+	s += vabs( line.pos[irp] - previous );
+	previous = line.pos[irp];
+	TS.get_rpoint_pointer(irp)->redefine( line.Q[irp], line.Q_rE_rad[irp], s, line.ds[irp] );
+    }
+    
+    // The level populations for a chunk of points are solved together
+    // ahead of their spectra.
+    int nchunks = ( nrps + LEVEL_POPULATION_CHUNK - 1 ) / LEVEL_POPULATION_CHUNK;
+    int ichunk;
+    if ( parallel_spectra ) {
+#       ifdef _OPENMP
+#       pragma omp parallel for private(ichunk) schedule(dynamic,1)
+#       endif
+	for ( ichunk = 0; ichunk < nchunks; ++ichunk ) {
+	    int irp0 = ichunk * LEVEL_POPULATION_CHUNK;
+	    int irp1 = min( nrps, irp0 + LEVEL_POPULATION_CHUNK );
+	    vector<Gas_data*> Q;
+	    for ( int irp = irp0; irp < irp1; ++irp ) Q.push_back( TS.get_rpoint_pointer(irp)->Q_ );
+	    rsm_[omp_get_thread_num()]->prepare_level_populations( Q );
+	    for ( int irp = irp0; irp < irp1; ++irp ) {
+		RadiatingPoint *rp = TS.get_rpoint_pointer(irp);
+		rsm_[omp_get_thread_num()]->radiative_spectra_for_gas_state( *(rp->Q_), *(rp->X_) );
+	    }
+	}
+    } else {
+	for ( ichunk = 0; ichunk < nchunks; ++ichunk ) {
+	    int irp0 = ichunk * LEVEL_POPULATION_CHUNK;
+	    int irp1 = min( nrps, irp0 + LEVEL_POPULATION_CHUNK );
+	    vector<Gas_data*> Q;
+	    for ( int irp = irp0; irp < irp1; ++irp ) Q.push_back( TS.get_rpoint_pointer(irp)->Q_ );
+	    rsm->prepare_level_populations( Q );
+	    for ( int irp = irp0; irp < irp1; ++irp ) {
+		RadiatingPoint *rp = TS.get_rpoint_pointer(irp);
+		rsm->radiative_spectra_for_gas_state( *(rp->Q_), *(rp->X_) );
+	    }
+	}
+    }
+    
+    // perform tangent-slab integration
+    if ( exact_ ) {
+	// Exact but slow version
+	return TS.exact_solve_for_divq();
+    }
+    else {
+	// Approximate but speedy version
+	return TS.quick_solve_for_divq();
+    }
+}
+
 /* --------- Model: "DiscreteTransfer" --------- */
 
 DiscreteTransfer::DiscreteTransfer( lua_State *L )
@@ -427,38 +922,51 @@ void DiscreteTransfer::compute_Q_rad_for_flowfield()
     
 	// 1b. Set all source terms to zero and store all spectra
 	for ( size_t ib=0; ib<cells_.size(); ++ib ) {
-	    size_t ic;
+	    size_t nc = cells_[ib].size();
+	    size_t nchunks = ( nc + LEVEL_POPULATION_CHUNK - 1 ) / LEVEL_POPULATION_CHUNK;
+	    size_t ichunk;
 #	    ifdef _OPENMP
-#	    pragma omp parallel for private(ic) schedule(runtime)
+#	    pragma omp parallel for private(ichunk) schedule(runtime)
 #	    endif
-	    for ( ic=0; ic<cells_[ib].size(); ++ic ) {
-	    	RayTracingCell * cell = cells_[ib][ic];
-		*(cell->Q_rE_rad_) = 0.0;
-		// Also make sure thread vector is zero
-		for ( size_t iQ=0; iQ<cell->Q_rE_rad_temp_.size(); ++ iQ ) {
-		    cell->Q_rE_rad_temp_[iQ] = 0.0;
-		}
+	    for ( ichunk=0; ichunk<nchunks; ++ichunk ) {
+		// The level populations for a chunk of cells are solved together
+		// ahead of their spectra.
+		size_t ic0 = ichunk*LEVEL_POPULATION_CHUNK;
+		size_t ic1 = min( nc, ic0 + LEVEL_POPULATION_CHUNK );
+#               if !PRECOMPUTED_PARADE_SPECTRA
+		vector<Gas_data*> Q;
+		for ( size_t ic=ic0; ic<ic1; ++ic ) Q.push_back( cells_[ib][ic]->Q_ );
+		rsm_[omp_get_thread_num()]->prepare_level_populations( Q );
+#               endif
+		for ( size_t ic=ic0; ic<ic1; ++ic ) {
+		    RayTracingCell * cell = cells_[ib][ic];
+		    *(cell->Q_rE_rad_) = 0.0;
+		    // Also make sure thread vector is zero
+		    for ( size_t iQ=0; iQ<cell->Q_rE_rad_temp_.size(); ++ iQ ) {
+			cell->Q_rE_rad_temp_[iQ] = 0.0;
+		    }
 #               if VERBOSE_RADIATION_TRANSPORT
-		cout << "Thread " << omp_get_thread_num()
-		     << ": Recomputing spectra for cell: " << ic
-		     << " in block: " << ib << endl;
+		    cout << "Thread " << omp_get_thread_num()
+			 << ": Recomputing spectra for cell: " << ic
+			 << " in block: " << ib << endl;
 #               endif
 #               if PRECOMPUTED_PARADE_SPECTRA
-		cell->read_precomputed_parade_spectra( ib, ic );
+		    cell->read_precomputed_parade_spectra( ib, ic );
 #               else
-		cell->recompute_spectra( rsm_[omp_get_thread_num()] );
+		    cell->recompute_spectra( rsm_[omp_get_thread_num()] );
 #               endif
-		double j_total = 0.0;
-		if ( rsm_[omp_get_thread_num()]->get_spectral_points()==1 )
-		    j_total = cell->X_->j_int[0];
-		else
-		    j_total = cell->X_->integrate_emission_spectra();
-		cout << " - j_total = " << j_total << endl;
-		if ( isnan(j_total) ) {
-		    cout << "DiscreteTransfer::compute_Q_rad_for_flowfield()" << endl
-		         << "Optically thin emission is NaN for:" << endl;
-			    cell->Q_->print_values();
-		    exit(NUMERICAL_ERROR);
+		    double j_total = 0.0;
+		    if ( rsm_[omp_get_thread_num()]->get_spectral_points()==1 )
+			j_total = cell->X_->j_int[0];
+		    else
+			j_total = cell->X_->integrate_emission_spectra();
+		    cout << " - j_total = " << j_total << endl;
+		    if ( isnan(j_total) ) {
+			cout << "DiscreteTransfer::compute_Q_rad_for_flowfield()" << endl
+			     << "Optically thin emission is NaN for:" << endl;
+				cell->Q_->print_values();
+			exit(NUMERICAL_ERROR);
+		    }
 		}
 	    }
 	    size_t iface;
@@ -1174,38 +1682,51 @@ void MonteCarlo::compute_Q_rad_for_flowfield()
 
 	// 1b. Set all source terms to zero, store all spectra
 	for ( size_t ib=0; ib<cells_.size(); ++ib ) {
-	    size_t ic;
+	    size_t nc = cells_[ib].size();
+	    size_t nchunks = ( nc + LEVEL_POPULATION_CHUNK - 1 ) / LEVEL_POPULATION_CHUNK;
+	    size_t ichunk;
 #	    ifdef _OPENMP
-#	    pragma omp parallel for private(ic) schedule(runtime)
+#	    pragma omp parallel for private(ichunk) schedule(runtime)
 #	    endif
-	    for ( ic=0; ic<cells_[ib].size(); ++ic ) {
-	    	RayTracingCell * cell = cells_[ib][ic];
-		*(cell->Q_rE_rad_) = 0.0;
-		// Also make sure thread vector is zero
-		for ( size_t iQ=0; iQ<cell->Q_rE_rad_temp_.size(); ++ iQ ) {
-		    cell->Q_rE_rad_temp_[iQ] = 0.0;
-		}
+	    for ( ichunk=0; ichunk<nchunks; ++ichunk ) {
+		// The level populations for a chunk of cells are solved together
+		// ahead of their spectra.
+		size_t ic0 = ichunk*LEVEL_POPULATION_CHUNK;
+		size_t ic1 = min( nc, ic0 + LEVEL_POPULATION_CHUNK );
+#               if !PRECOMPUTED_PARADE_SPECTRA
+		vector<Gas_data*> Q;
+		for ( size_t ic=ic0; ic<ic1; ++ic ) Q.push_back( cells_[ib][ic]->Q_ );
+		rsm_[omp_get_thread_num()]->prepare_level_populations( Q );
+#               endif
+		for ( size_t ic=ic0; ic<ic1; ++ic ) {
+		    RayTracingCell * cell = cells_[ib][ic];
+		    *(cell->Q_rE_rad_) = 0.0;
+		    // Also make sure thread vector is zero
+		    for ( size_t iQ=0; iQ<cell->Q_rE_rad_temp_.size(); ++ iQ ) {
+			cell->Q_rE_rad_temp_[iQ] = 0.0;
+		    }
 #               if VERBOSE_RADIATION_TRANSPORT
-		cout << "Thread " << omp_get_thread_num()
-		     << ": Recomputing spectra for cell: " << ic
-		     << " in block: " << ib;
+		    cout << "Thread " << omp_get_thread_num()
+			 << ": Recomputing spectra for cell: " << ic
+			 << " in block: " << ib;
 #               endif
 #               if PRECOMPUTED_PARADE_SPECTRA
-		cell->read_precomputed_parade_spectra( ib, ic );
+		    cell->read_precomputed_parade_spectra( ib, ic );
 #               else
-		cell->recompute_spectra( rsm_[omp_get_thread_num()] );
+		    cell->recompute_spectra( rsm_[omp_get_thread_num()] );
 #               endif
-		double j_total = 0.0;
-		if ( rsm_[omp_get_thread_num()]->get_spectral_points()==1 )
-		    j_total = cell->X_->j_int[0];
-		else
-		    j_total = cell->X_->integrate_emission_spectra();
-		cout << " - j_total = " << j_total << endl;
-		if ( isnan(j_total) ) {
-		    cout << "MonteCarlo::compute_Q_rad_for_flowfield()" << endl
-		         << "Optically thin emission is NaN for:" << endl;
-		    cell->Q_->print_values();
-		    exit(NUMERICAL_ERROR);
+		    double j_total = 0.0;
+		    if ( rsm_[omp_get_thread_num()]->get_spectral_points()==1 )
+			j_total = cell->X_->j_int[0];
+		    else
+			j_total = cell->X_->integrate_emission_spectra();
+		    cout << " - j_total = " << j_total << endl;
+		    if ( isnan(j_total) ) {
+			cout << "MonteCarlo::compute_Q_rad_for_flowfield()" << endl
+			     << "Optically thin emission is NaN for:" << endl;
+			cell->Q_->print_values();
+			exit(NUMERICAL_ERROR);
+		    }
 		}
 	    }
 	    size_t iface;
@@ -68,8 +68,41 @@ public:
 
     void compute_Q_rad_for_block( Block * A );
 
+private:
+    double emission_for_gas_state( Gas_data &Q );
+
+    int build_emission_surrogate( double T_lo, double T_hi, double Tv_lo, double Tv_hi );
+
+    double surrogate_emission( const Gas_data &Q ) const;
+
+    bool surrogate_covers( double T_lo, double T_hi, double Tv_lo, double Tv_hi ) const;
+
+    int check_emission_surrogate();
+
 private:
     int spectrally_resolved_;
+    
+    // All active cells of this process, flattened so that the work can be
+    // shared over threads irrespective of block sizes, with the time that
+    // each took at the last update (used to order the next one).
+    std::vector<FV_Cell*> cells_;
+    std::vector<double> cell_cost_;
+    std::vector<size_t> cell_order_;
+    
+    // Optional surrogate for the integrated emission, tabulated on a
+    // (T, Tv) grid as emission per unit partial density for each species:
+    //     j = sum_isp rho_isp * exp( ln_eps_[isp](T,Tv) )
+    // The table is kept across radiation updates and rebuilt when the
+    // flowfield temperatures leave its bounds.
+    bool use_surrogate_;
+    bool surrogate_built_;
+    int surrogate_T_points_;
+    double surrogate_tolerance_;
+    int nT_, nTv_;
+    double T_lo_, T_hi_, dT_;
+    double Tv_lo_, Tv_hi_, dTv_;
+    std::vector<int> emitters_;
+    std::vector< std::vector<double> > ln_eps_;
 };
 
 class TangentSlab : public RadiationTransportModel {
@@ -86,8 +119,33 @@ public:
     
     void compute_Q_rad_for_block( Block * A );
 
+private:
+    // A line of sight running in the i-direction from the shock side (west)
+    // to the wall (east), possibly through several blocks.  The gas data and
+    // source-term pointers refer to the cells themselves or, for cells of
+    // blocks held by another MPI process, to local copies.
+    struct TS_line {
+	Block * wall_block;
+	size_t index;           // into wall_block->bcp[EAST]->q_rad
+	double T_i, T_f;
+	Vector3 start;          // west face of the first cell
+	std::vector<Gas_data*> Q;
+	std::vector<double*> Q_rE_rad;
+	std::vector<Vector3> pos;
+	std::vector<double> ds;
+    };
+    
+    void assemble_block_chains();
+    
+    void append_local_segment( TS_line &line, Block &B, size_t j, size_t k, bool first );
+    
+    double solve_line( TS_line &line, RadiationSpectralModel * rsm, bool parallel_spectra );
+
 private:
     bool exact_;
+    // Blocks joined west-to-east, listed from the shock side to the wall.
+    // Each chain carries nnj*nnk lines of sight.
+    std::vector< std::vector<size_t> > chains_;
 };
 
 class DiscreteTransfer : public RadiationTransportModel {
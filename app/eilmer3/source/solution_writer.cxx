@@ -0,0 +1,200 @@
+/// \file solution_writer.cxx
+/// \ingroup eilmer3
+/// \brief Background writing of the flow-solution snapshots.
+///
+/// \version 18-Oct-2026
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <zlib.h>
+#include "cell.hh"
+#include "kernel.hh"
+#include "block.hh"
+#include "solution_writer.hh"
+
+using namespace std;
+
+SolutionWriter::SolutionWriter()
+    : nvalues_(0), iv_shock_(0), nstaged_(0), sim_time_(0.0), zip_files_(false),
+      write_pending_(false), closing_(false), closed_(false), write_failed_(false)
+{
+    // The header line and the layout of the values are fixed for the run.
+    var_list_ = variable_list_for_cell();
+    istringstream iss(var_list_);
+    string token;
+    bool found = false;
+    while ( iss >> token ) {
+	if ( token == "\"S\"" ) {
+	    iv_shock_ = nvalues_;
+	    found = true;
+	}
+	++nvalues_;
+    }
+    if ( !found ) {
+	throw runtime_error("SolutionWriter: no shock flag in the cell variable list.");
+    }
+    writer_ = thread(&SolutionWriter::writer_loop, this);
+} // end SolutionWriter constructor
+
+SolutionWriter::~SolutionWriter()
+{
+    close();
+}
+
+/// \brief Copy the active cells of the blocks into the staging buffer
+///        and hand it to the writer thread.
+///
+/// Waits only if the previous snapshot is still being written.
+/// filenames[jb] is the flow file for blocks[jb], without any ".gz".
+int SolutionWriter::capture(const vector<Block *> &blocks, const vector<string> &filenames,
+			    double sim_time, bool zip_files)
+{
+    if ( closed_ ) return FAILURE;
+    int flag = drain();
+    if ( flag != SUCCESS ) return flag;
+    global_data &G = *get_global_data_ptr();
+    if ( G.verbosity_level >= 1 && G.flow_induced_moving == 0 ) {
+	printf("write_solution(): At t = %e, capture %d blocks for the writer thread.\n",
+	       sim_time, static_cast<int>(blocks.size()));
+    }
+    // The writer is idle, so the staging buffer is ours to refill.
+    // Keeping the BlockSnapshot objects avoids reallocating every time.
+    if ( staging_.size() < blocks.size() ) staging_.resize(blocks.size());
+    for ( size_t jb = 0; jb < blocks.size(); ++jb ) {
+	Block &bd = *(blocks[jb]);
+	BlockSnapshot &bs = staging_[jb];
+	bs.filename = filenames[jb];
+	bs.nni = bd.nni; bs.nnj = bd.nnj; bs.nnk = bd.nnk;
+	bs.values.resize(bd.nni * bd.nnj * bd.nnk * nvalues_);
+	double *v = bs.values.empty() ? 0 : &bs.values[0];
+	for ( size_t k = bd.kmin; k <= bd.kmax; ++k ) {
+	    for ( size_t j = bd.jmin; j <= bd.jmax; ++j ) {
+		for ( size_t i = bd.imin; i <= bd.imax; ++i ) {
+		    bd.get_cell(i,j,k)->write_values_to_vector(cell_values_);
+		    if ( cell_values_.size() != nvalues_ ) {
+			cerr << "SolutionWriter: cell value count changed during the run." << endl;
+			return FAILURE;
+		    }
+		    for ( size_t iv = 0; iv < nvalues_; ++iv ) *v++ = cell_values_[iv];
+		}
+	    }
+	}
+    }
+    {
+	unique_lock<mutex> lock(mtx_);
+	nstaged_ = blocks.size();
+	sim_time_ = sim_time;
+	zip_files_ = zip_files;
+	write_pending_ = true;
+    }
+    cv_.notify_all();
+    return SUCCESS;
+} // end SolutionWriter::capture()
+
+/// \brief Wait until the snapshot in flight, if any, is on disk.
+int SolutionWriter::drain()
+{
+    unique_lock<mutex> lock(mtx_);
+    cv_.wait(lock, [this]{ return !write_pending_; });
+    if ( write_failed_ ) {
+	cerr << "SolutionWriter: a flow solution file could not be written." << endl;
+	return FILE_ERROR;
+    }
+    return SUCCESS;
+}
+
+/// \brief Drain the snapshot in flight and stop the writer thread.
+int SolutionWriter::close()
+{
+    if ( closed_ ) return write_failed_ ? FILE_ERROR : SUCCESS;
+    int flag = drain();
+    {
+	unique_lock<mutex> lock(mtx_);
+	closing_ = true;
+    }
+    cv_.notify_all();
+    writer_.join();
+    closed_ = true;
+    return flag;
+}
+
+/// \brief Write one block in the format of Block::write_solution.
+int SolutionWriter::write_block(const BlockSnapshot &bs) const
+{
+    FILE *fp = NULL;
+    gzFile zfp = NULL;
+    string filename = bs.filename;
+    if ( zip_files_ ) {
+	filename += ".gz";
+	if ( (zfp = gzopen(filename.c_str(), "w")) == NULL ) {
+	    cerr << "SolutionWriter: Could not open " << filename << endl;
+	    return FILE_ERROR;
+	}
+    } else {
+	if ( (fp = fopen(filename.c_str(), "w")) == NULL ) {
+	    cerr << "SolutionWriter: Could not open " << filename << endl;
+	    return FILE_ERROR;
+	}
+    }
+    // Values are formatted as FV_Cell::write_values_to_string does:
+    // scientific with 16 digits, except for the integer shock flag.
+    string line;
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%20.16e\n", sim_time_);
+    line = buf; line += var_list_; line += "\n";
+    snprintf(buf, sizeof(buf), "%d %d %d\n", static_cast<int>(bs.nni),
+	     static_cast<int>(bs.nnj), static_cast<int>(bs.nnk));
+    line += buf;
+    int nput = zip_files_ ? gzputs(zfp, line.c_str()) : fputs(line.c_str(), fp);
+    int flag = (nput < 0) ? FILE_ERROR : SUCCESS;
+    size_t ncell = (nvalues_ > 0) ? bs.values.size() / nvalues_ : 0;
+    const double *v = ncell > 0 ? &bs.values[0] : 0;
+    for ( size_t icell = 0; icell < ncell && flag == SUCCESS; ++icell ) {
+	line.clear();
+	for ( size_t iv = 0; iv < nvalues_; ++iv, ++v ) {
+	    if ( iv == iv_shock_ ) {
+		snprintf(buf, sizeof(buf), "%d", static_cast<int>(*v));
+	    } else {
+		snprintf(buf, sizeof(buf), "%.16e", *v);
+	    }
+	    if ( iv > 0 ) line += " ";
+	    line += buf;
+	}
+	line += "\n";
+	nput = zip_files_ ? gzputs(zfp, line.c_str()) : fputs(line.c_str(), fp);
+	if ( nput < 0 ) flag = FILE_ERROR;
+    }
+    if ( zip_files_ ) {
+	if ( gzclose(zfp) != Z_OK ) flag = FILE_ERROR;
+    } else {
+	if ( fclose(fp) != 0 ) flag = FILE_ERROR;
+    }
+    if ( flag != SUCCESS ) cerr << "SolutionWriter: failed writing " << filename << endl;
+    return flag;
+} // end SolutionWriter::write_block()
+
+void SolutionWriter::writer_loop()
+{
+    unique_lock<mutex> lock(mtx_);
+    while ( true ) {
+	cv_.wait(lock, [this]{ return write_pending_ || closing_; });
+	if ( write_pending_ ) {
+	    // The solver does not touch the staging buffer until
+	    // write_pending_ is cleared, so write without the lock.
+	    lock.unlock();
+	    bool failed = false;
+	    for ( size_t jb = 0; jb < nstaged_; ++jb ) {
+		if ( write_block(staging_[jb]) != SUCCESS ) failed = true;
+	    }
+	    lock.lock();
+	    if ( failed ) write_failed_ = true;
+	    write_pending_ = false;
+	    cv_.notify_all();
+	} else if ( closing_ ) {
+	    break;
+	}
+    }
+}
@@ -0,0 +1,65 @@
+/// \file solution_writer.hh
+/// \ingroup eilmer3
+/// \brief Background writing of the flow-solution snapshots.
+///
+/// Block::write_solution formats every cell as text, and usually
+/// compresses it, while the time-stepping loop waits.  For large blocks
+/// that is a noticeable pause at every dt_plot.  With this writer, the
+/// cell values of the blocks on this process are copied into a staging
+/// buffer (the capture is a plain copy of doubles) and a writer thread
+/// does the formatting and compression while the solver carries on.
+///
+/// Only one snapshot is held at a time.  A capture that arrives while the
+/// previous snapshot is still being written waits for it to finish,
+/// so the memory needed is bounded by one copy of the local flow state.
+/// The files are the same as those written by Block::write_solution.
+///
+/// \version 18-Oct-2026
+
+#ifndef SOLUTION_WRITER_HH
+#define SOLUTION_WRITER_HH
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "block.hh"
+
+class SolutionWriter {
+public:
+    SolutionWriter();
+    ~SolutionWriter();
+    int capture(const std::vector<Block *> &blocks, const std::vector<std::string> &filenames,
+		double sim_time, bool zip_files);
+    int drain();
+    int close();
+
+private:
+    struct BlockSnapshot {
+	std::string filename;
+	size_t nni, nnj, nnk;
+	std::vector<double> values; // nvalues_ per cell, in write_solution order
+    };
+    int write_block(const BlockSnapshot &bs) const;
+    void writer_loop();
+
+    std::string var_list_;
+    size_t nvalues_;   // values per cell, from FV_Cell::write_values_to_vector
+    size_t iv_shock_;  // the shock flag S is an integer in the text files
+    std::vector<double> cell_values_;
+    // Owned by the writer thread while write_pending_ is true.
+    std::vector<BlockSnapshot> staging_;
+    size_t nstaged_;
+    double sim_time_;
+    bool zip_files_;
+    std::thread writer_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool write_pending_;
+    bool closing_;
+    bool closed_;
+    bool write_failed_;
+};
+
+#endif
@@ -54,6 +54,8 @@ extern int AddStreamNode( int node0, int node1, int node2, int node4,
                           int test_only );
 extern int StepStreamNode( int node0, int node4, double dL );
 extern int InterpolateNode( double x, double y, double R, int node4 );
+extern char *MarchAlongCMinus_C( int old_first, int new_first, char *direction, int iw );
+extern char *MarchAlongCPlus_C( int old_first, int new_first, char *direction, int iw );
 
 extern int InitWall( void );
 extern int WallIsPresent( int iw );
@@ -1310,6 +1310,8 @@ int CMinusFreeBndyNode(int,int,int);
 int AddStreamNode(int,int,int,int,int);
 int StepStreamNode(int,int,double);
 int InterpolateNode(double,double,double,int);
+char *MarchAlongCMinus_C(int,int,char *,int);
+char *MarchAlongCPlus_C(int,int,char *,int);
 int InitWall(void);
 int WallIsPresent(int);
 int WallGetNumberOfPoints(int);
@@ -1817,6 +1819,42 @@ _wrap_InterpolateNode(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_O
 }
 
 
+static int
+_wrap_MarchAlongCMinus_C(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *CONST objv[]) {
+    int arg1 ;
+    int arg2 ;
+    char *arg3 = (char *) 0 ;
+    int arg4 ;
+    char *result;
+    
+    if (SWIG_GetArgs(interp, objc, objv,"iisi:MarchAlongCMinus_C old_first new_first direction iw ",&arg1,&arg2,&arg3,&arg4) == TCL_ERROR) SWIG_fail;
+    result = (char *)MarchAlongCMinus_C(arg1,arg2,arg3,arg4);
+    
+    Tcl_SetObjResult(interp,Tcl_NewStringObj(result,-1));
+    return TCL_OK;
+    fail:
+    return TCL_ERROR;
+}
+
+
+static int
+_wrap_MarchAlongCPlus_C(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *CONST objv[]) {
+    int arg1 ;
+    int arg2 ;
+    char *arg3 = (char *) 0 ;
+    int arg4 ;
+    char *result;
+    
+    if (SWIG_GetArgs(interp, objc, objv,"iisi:MarchAlongCPlus_C old_first new_first direction iw ",&arg1,&arg2,&arg3,&arg4) == TCL_ERROR) SWIG_fail;
+    result = (char *)MarchAlongCPlus_C(arg1,arg2,arg3,arg4);
+    
+    Tcl_SetObjResult(interp,Tcl_NewStringObj(result,-1));
+    return TCL_OK;
+    fail:
+    return TCL_ERROR;
+}
+
+
 static int
 _wrap_InitWall(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *CONST objv[]) {
     int result;
@@ -2057,6 +2095,8 @@ static swig_command_info swig_commands[] = {
     { SWIG_prefix "AddStreamNode", (swig_wrapper_func) _wrap_AddStreamNode, NULL},
     { SWIG_prefix "StepStreamNode", (swig_wrapper_func) _wrap_StepStreamNode, NULL},
     { SWIG_prefix "InterpolateNode", (swig_wrapper_func) _wrap_InterpolateNode, NULL},
+    { SWIG_prefix "MarchAlongCMinus_C", (swig_wrapper_func) _wrap_MarchAlongCMinus_C, NULL},
+    { SWIG_prefix "MarchAlongCPlus_C", (swig_wrapper_func) _wrap_MarchAlongCPlus_C, NULL},
     { SWIG_prefix "InitWall", (swig_wrapper_func) _wrap_InitWall, NULL},
     { SWIG_prefix "WallIsPresent", (swig_wrapper_func) _wrap_WallIsPresent, NULL},
     { SWIG_prefix "WallGetNumberOfPoints", (swig_wrapper_func) _wrap_WallGetNumberOfPoints, NULL},
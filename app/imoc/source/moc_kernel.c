@@ -22,6 +22,8 @@
  * \version 17-Jan-2000 : Split ListNodesNear into two parts (the new one 
  *               is FindNodesNear().
  * \version 17-Sep-2000 : Rename SetGamma, SetDebugLevel, SetAxiFlag (add _C)
+ * \version 18-Oct-2026 : Nodes are kept in a growable store, with a free list
+ *               of ids, and binned in a spatial hash for FindNodesNear().
  *
  */
 
@@ -37,12 +39,42 @@
 /*-----------------------------------------------------*/
 
 /*
- * We shall store the flow-field data in 
- * an array of NodeData structures.
+ * We shall store the flow-field data in NodeData structures
+ * that are allocated in chunks, so that their addresses stay put
+ * as the store grows.  Node[id] points to the data for node id
+ * or is NULL if the id is not in use.
+ * The unused ids below NodeHighWater are kept in a min-heap so that
+ * CreateNode(-1) hands out the lowest available id, as it always has.
  */
-#define MAX_NODES 1000
-struct NodeData *Node[MAX_NODES];  /* Just an array of pointers */
-int NumberOfNodes;              /* Keep a count of filled nodes */
+#define NODE_CHUNK_SIZE 1024
+struct NodeData **Node = NULL;  /* Node[id] points into one of the chunks */
+int NumberOfNodes = 0;          /* Keep a count of filled nodes */
+static struct NodeData **NodeChunk = NULL;
+static int NumberOfNodeChunks = 0;
+static int NodeCapacity = 0;           /* ids below this have storage */
+static int NodeHighWater = 0;          /* ids at or above this have never been used */
+static int *FreeId = NULL;             /* min-heap of unused ids */
+static int NumberOfFreeIds = 0;
+static int FreeIdCapacity = 0;
+
+/*
+ * For the proximity searches, the nodes are binned on a uniform grid
+ * of square cells and the cells are hashed into buckets.
+ * The nodes in each bucket form a doubly-linked list through
+ * HashNext and HashPrev.  Each node remembers the cell that it was
+ * binned in, so that nodes from other cells in the same bucket
+ * can be skipped.  Positions must be changed via SetNodePosition()
+ * (or SetNodeData_C) for the node to be found in its new place.
+ */
+static int *HashHead = NULL;
+static int NumberOfBuckets = 0;        /* a power of 2 */
+static int *HashNext = NULL;
+static int *HashPrev = NULL;
+static long *HashCellI = NULL;
+static long *HashCellJ = NULL;
+static double HashCellSize = 1.0;
+static int *NearList = NULL;           /* scratch space for FindNodesNear */
+static int NearListCapacity = 0;
 
 int MOCDebugLevel;
 double RatioOfSpecificHeats;
@@ -139,7 +171,7 @@ int ValidNode( int id ) {
     and the pointer is valid, 0 otherwise. <BR>
     (Available from the Tcl interpreter.) 
     */
-   if ( id >= MAX_NODES ) return NO; 
+   if ( id < 0 || id >= NodeCapacity ) return NO; 
    if ( Node[id] != NULL ) {
       return YES;
    } else {
@@ -149,6 +181,253 @@ int ValidNode( int id ) {
 
 /*-----------------------------------------------------*/
 
+/*
+ * Storage for the nodes and the spatial hash.
+ * These functions are for use within this file.
+ */
+
+static int GrowNodeStore( int id ) {
+   /*
+    Add chunks to the store until there is space for node id.
+    Returns MOC_OK or MOC_ERROR if memory allocation failed.
+    */
+   struct NodeData *chunk;
+   void *p;
+   int i, newCapacity;
+
+   while ( NodeCapacity <= id ) {
+      newCapacity = NodeCapacity + NODE_CHUNK_SIZE;
+      chunk = calloc(NODE_CHUNK_SIZE, sizeof(struct NodeData));
+      if ( chunk == NULL ) return MOC_ERROR;
+      p = realloc(NodeChunk, (NumberOfNodeChunks + 1) * sizeof(struct NodeData *));
+      if ( p == NULL ) { free(chunk); return MOC_ERROR; }
+      NodeChunk = p;
+      p = realloc(Node, newCapacity * sizeof(struct NodeData *));
+      if ( p == NULL ) { free(chunk); return MOC_ERROR; }
+      Node = p;
+      p = realloc(HashNext, newCapacity * sizeof(int));
+      if ( p == NULL ) { free(chunk); return MOC_ERROR; }
+      HashNext = p;
+      p = realloc(HashPrev, newCapacity * sizeof(int));
+      if ( p == NULL ) { free(chunk); return MOC_ERROR; }
+      HashPrev = p;
+      p = realloc(HashCellI, newCapacity * sizeof(long));
+      if ( p == NULL ) { free(chunk); return MOC_ERROR; }
+      HashCellI = p;
+      p = realloc(HashCellJ, newCapacity * sizeof(long));
+      if ( p == NULL ) { free(chunk); return MOC_ERROR; }
+      HashCellJ = p;
+      for ( i = NodeCapacity; i < newCapacity; ++i ) {
+         Node[i] = (struct NodeData *) NULL;
+         HashNext[i] = NO_NODE;
+         HashPrev[i] = NO_NODE;
+         HashCellI[i] = 0;
+         HashCellJ[i] = 0;
+      } /* end for */
+      NodeChunk[NumberOfNodeChunks] = chunk;
+      ++NumberOfNodeChunks;
+      NodeCapacity = newCapacity;
+   } /* end while */
+   return MOC_OK;
+} /* end function GrowNodeStore */
+
+
+static void ReleaseNodeStore( void ) {
+   /*
+    Free all of the node storage, leaving an empty store.
+    */
+   int i;
+   for ( i = 0; i < NumberOfNodeChunks; ++i ) free( NodeChunk[i] );
+   free( NodeChunk ); NodeChunk = NULL; NumberOfNodeChunks = 0;
+   free( Node ); Node = NULL;
+   free( HashNext ); HashNext = NULL;
+   free( HashPrev ); HashPrev = NULL;
+   free( HashCellI ); HashCellI = NULL;
+   free( HashCellJ ); HashCellJ = NULL;
+   free( HashHead ); HashHead = NULL; NumberOfBuckets = 0;
+   free( FreeId ); FreeId = NULL; NumberOfFreeIds = 0; FreeIdCapacity = 0;
+   free( NearList ); NearList = NULL; NearListCapacity = 0;
+   NodeCapacity = 0;
+   NodeHighWater = 0;
+   NumberOfNodes = 0;
+   HashCellSize = 1.0;
+} /* end function ReleaseNodeStore */
+
+
+static int PushFreeId( int id ) {
+   /*
+    Add an unused id to the min-heap.
+    */
+   int i, parent, newCapacity;
+   int *p;
+
+   if ( NumberOfFreeIds >= FreeIdCapacity ) {
+      newCapacity = (FreeIdCapacity > 0) ? 2 * FreeIdCapacity : NODE_CHUNK_SIZE;
+      p = realloc(FreeId, newCapacity * sizeof(int));
+      if ( p == NULL ) return MOC_ERROR;
+      FreeId = p;
+      FreeIdCapacity = newCapacity;
+   } /* end if */
+   i = NumberOfFreeIds;
+   ++NumberOfFreeIds;
+   while ( i > 0 ) {
+      parent = (i - 1) / 2;
+      if ( FreeId[parent] <= id ) break;
+      FreeId[i] = FreeId[parent];
+      i = parent;
+   } /* end while */
+   FreeId[i] = id;
+   return MOC_OK;
+} /* end function PushFreeId */
+
+
+static int PopFreeId( void ) {
+   /*
+    Remove the lowest id from the min-heap and return it,
+    or return NO_NODE if the heap is empty.
+    The heap may still hold ids that have since been taken by
+    CreateNode(id) so the caller has to check.
+    */
+   int id, last, i, child;
+
+   if ( NumberOfFreeIds == 0 ) return NO_NODE;
+   id = FreeId[0];
+   --NumberOfFreeIds;
+   last = FreeId[NumberOfFreeIds];
+   i = 0;
+   while ( (child = 2 * i + 1) < NumberOfFreeIds ) {
+      if ( child + 1 < NumberOfFreeIds && FreeId[child + 1] < FreeId[child] ) ++child;
+      if ( last <= FreeId[child] ) break;
+      FreeId[i] = FreeId[child];
+      i = child;
+   } /* end while */
+   FreeId[i] = last;
+   return id;
+} /* end function PopFreeId */
+
+
+static long HashCellIndex( double v ) {
+   /*
+    Index of the hash-grid cell containing coordinate v,
+    clipped so that far-away points do not overflow.
+    */
+   double c;
+   c = floor( v / HashCellSize );
+   if ( c > 1.0e9 ) c = 1.0e9;
+   if ( c < -1.0e9 ) c = -1.0e9;
+   return (long) c;
+} /* end function HashCellIndex */
+
+
+static int HashBucket( long i, long j ) {
+   unsigned long h;
+   h = ((unsigned long) i * 73856093UL) ^ ((unsigned long) j * 19349663UL);
+   return (int) (h & (unsigned long) (NumberOfBuckets - 1));
+} /* end function HashBucket */
+
+
+static void HashInsert( int id ) {
+   int b;
+   HashCellI[id] = HashCellIndex( Node[id]->X );
+   HashCellJ[id] = HashCellIndex( Node[id]->Y );
+   b = HashBucket( HashCellI[id], HashCellJ[id] );
+   HashPrev[id] = NO_NODE;
+   HashNext[id] = HashHead[b];
+   if ( HashHead[b] != NO_NODE ) HashPrev[HashHead[b]] = id;
+   HashHead[b] = id;
+} /* end function HashInsert */
+
+
+static void HashRemove( int id ) {
+   if ( HashPrev[id] != NO_NODE ) {
+      HashNext[HashPrev[id]] = HashNext[id];
+   } else {
+      HashHead[HashBucket(HashCellI[id], HashCellJ[id])] = HashNext[id];
+   } /* end if */
+   if ( HashNext[id] != NO_NODE ) HashPrev[HashNext[id]] = HashPrev[id];
+   HashNext[id] = NO_NODE;
+   HashPrev[id] = NO_NODE;
+} /* end function HashRemove */
+
+
+static int RebuildHash( int nbuckets ) {
+   /*
+    Set up nbuckets (a power of 2) buckets and rebin all of the nodes.
+    The cell size is chosen from the extent of the present nodes,
+    aiming for about one node per cell.
+    */
+   double xmin, xmax, ymin, ymax, extent;
+   int id, b, first;
+   int *p;
+
+   p = realloc(HashHead, nbuckets * sizeof(int));
+   if ( p == NULL ) return MOC_ERROR;
+   HashHead = p;
+   NumberOfBuckets = nbuckets;
+   for ( b = 0; b < NumberOfBuckets; ++b ) HashHead[b] = NO_NODE;
+
+   first = YES;
+   xmin = xmax = ymin = ymax = 0.0;
+   for ( id = 0; id < NodeHighWater; ++id ) {
+      if ( Node[id] == NULL ) continue;
+      if ( first == YES || Node[id]->X < xmin ) xmin = Node[id]->X;
+      if ( first == YES || Node[id]->X > xmax ) xmax = Node[id]->X;
+      if ( first == YES || Node[id]->Y < ymin ) ymin = Node[id]->Y;
+      if ( first == YES || Node[id]->Y > ymax ) ymax = Node[id]->Y;
+      first = NO;
+   } /* end for */
+   extent = ( xmax - xmin > ymax - ymin ) ? xmax - xmin : ymax - ymin;
+   if ( extent > 0.0 && NumberOfNodes > 1 ) {
+      HashCellSize = extent / sqrt( (double) NumberOfNodes );
+   } /* end if */
+
+   for ( id = 0; id < NodeHighWater; ++id ) {
+      if ( Node[id] != NULL ) HashInsert( id );
+   } /* end for */
+   return MOC_OK;
+} /* end function RebuildHash */
+
+
+static int UpdateNodeHash( int id ) {
+   /*
+    Rebin a node after its position has changed.
+    */
+   if ( HashCellIndex(Node[id]->X) == HashCellI[id] &&
+        HashCellIndex(Node[id]->Y) == HashCellJ[id] ) return MOC_OK;
+   HashRemove( id );
+   HashInsert( id );
+   return MOC_OK;
+} /* end function UpdateNodeHash */
+
+
+static int CheckNodeNear( int id, double x, double y, double tol, int count ) {
+   /*
+    Append id to NearList if the node is within tol of (x,y).
+    Returns the new count.
+    */
+   double dx, dy;
+   int *p;
+
+   dx = x - Node[id]->X;
+   dy = y - Node[id]->Y;
+   if ( sqrt(dx * dx + dy * dy) >= tol ) return count;
+   if ( count >= NearListCapacity ) {
+      p = realloc(NearList, 2 * (NearListCapacity + 32) * sizeof(int));
+      if ( p == NULL ) return count;
+      NearList = p;
+      NearListCapacity = 2 * (NearListCapacity + 32);
+   } /* end if */
+   NearList[count] = id;
+   return count + 1;
+} /* end function CheckNodeNear */
+
+
+static int CompareIds( const void *a, const void *b ) {
+   return *(const int *)a - *(const int *)b;
+} /* end function CompareIds */
+
+/*-----------------------------------------------------*/
+
 /*
  * Initialisation function
  */
@@ -161,14 +440,10 @@ int InitMOC( void ) {
     variables. <BR>
     (Available from the Tcl interpreter.) 
    */
-   int i;
-
    MOCDebugLevel = 0;
 
-   NumberOfNodes = 0;
-   for ( i = 0; i < MAX_NODES; ++i ) {
-      Node[i] = (struct NodeData *) NULL;
-   } /* end for */
+   /* Start with an empty node store; it grows as nodes are created. */
+   ReleaseNodeStore();
 
    RatioOfSpecificHeats = 1.4;
    AxiSymmetric = NO;
@@ -193,34 +468,23 @@ int CreateNode( int id ) {
     A value of -1 is returned on failure.<BR>
     (Available from the Tcl interpreter.) 
     */
-   int foundSpace;
-
-   if ( id > MAX_NODES ) return MOC_ERROR;
+   struct NodeData *np;
 
    if ( id < 0 ) {
       /* 
-       * Search for first available space in the pointer array
-       * and put the new node there. 
+       * Take the lowest unused id, skipping any that have been
+       * taken by name since they were put on the free list.
+       * If there are none, use a fresh id at the top of the store.
        */
-      foundSpace = NO;
-      for ( id = 0; id < MAX_NODES; ++id ) {
-         if ( Node[id] == NULL ) {
-            foundSpace = YES;
-            break;
-         } /* end if */
-      } /* end for */
-
-      if ( foundSpace == NO ) {
-         if ( MOCDebugLevel >= 1 ) {
-            printf( "Node pointer array is already full.\n" );
-         } /* end if */
-         return -2;
-      } /* end if */ 
+      do {
+         id = PopFreeId();
+      } while ( id != NO_NODE && Node[id] != NULL );
+      if ( id == NO_NODE ) id = NodeHighWater;
       /*
        * At this point we have selected a new value
        * for id to store the new node's address.
        */
-   } else {
+   } else if ( id < NodeHighWater ) {
       /* 
        * We have been given a specific location to
        * store the new node's address.
@@ -229,31 +493,55 @@ int CreateNode( int id ) {
       if ( Node[id] != NULL ) DeleteNode( id );
    } /* end if */  
 
-   Node[id] = calloc(1, sizeof(struct NodeData));
-   if (Node[id] != NULL) {
-      /* Memory allocation was successful. */
-      ++NumberOfNodes;
-      Node[id]->X          = 0.0;
-      Node[id]->Y          = 0.0;
-      Node[id]->Nu         = 0.0;
-      Node[id]->Theta      = 0.0;
-      Node[id]->Mach       = 0.0;
-      Node[id]->P0         = 1.0;  /* nondimensional to start */
-      Node[id]->T0         = 1.0;  /* nondimensional to start */
-      Node[id]->CPlusUp    = NO_NODE;
-      Node[id]->CMinusUp   = NO_NODE;
-      Node[id]->CZeroUp    = NO_NODE;
-      Node[id]->CPlusDown  = NO_NODE;
-      Node[id]->CMinusDown = NO_NODE;
-      Node[id]->CZeroDown  = NO_NODE;
-      return id;
-   } else {
-      /* CreateNode failed, memory allocation failed. */
-      if ( MOCDebugLevel >= 1 ) {
-         printf( "Memory allocation failed.\n" );
+   if ( id >= NodeHighWater ) {
+      if ( GrowNodeStore( id ) != MOC_OK ) {
+         /* CreateNode failed, memory allocation failed. */
+         if ( MOCDebugLevel >= 1 ) {
+            printf( "Memory allocation failed.\n" );
+         } /* end if */
+         return -1;
       } /* end if */
-      return -1;
+      /* Any ids skipped over are available for later. */
+      while ( NodeHighWater < id ) {
+         if ( PushFreeId( NodeHighWater ) != MOC_OK ) return -1;
+         ++NodeHighWater;
+      } /* end while */
+      NodeHighWater = id + 1;
    } /* end if */
+
+   np = &(NodeChunk[id / NODE_CHUNK_SIZE][id % NODE_CHUNK_SIZE]);
+   memset( np, 0, sizeof(struct NodeData) );
+   Node[id] = np;
+   ++NumberOfNodes;
+   Node[id]->X          = 0.0;
+   Node[id]->Y          = 0.0;
+   Node[id]->Nu         = 0.0;
+   Node[id]->Theta      = 0.0;
+   Node[id]->Mach       = 0.0;
+   Node[id]->P0         = 1.0;  /* nondimensional to start */
+   Node[id]->T0         = 1.0;  /* nondimensional to start */
+   Node[id]->CPlusUp    = NO_NODE;
+   Node[id]->CMinusUp   = NO_NODE;
+   Node[id]->CZeroUp    = NO_NODE;
+   Node[id]->CPlusDown  = NO_NODE;
+   Node[id]->CMinusDown = NO_NODE;
+   Node[id]->CZeroDown  = NO_NODE;
+
+   /* Keep about two nodes per bucket, on average. */
+   if ( NumberOfNodes > 2 * NumberOfBuckets ) {
+      if ( RebuildHash( (NumberOfBuckets > 0) ? 2 * NumberOfBuckets : 256 ) != MOC_OK ) {
+         Node[id] = NULL;
+         --NumberOfNodes;
+         PushFreeId( id );
+         if ( MOCDebugLevel >= 1 ) {
+            printf( "Memory allocation failed.\n" );
+         } /* end if */
+         return -1;
+      } /* end if */
+   } else {
+      HashInsert( id );
+   } /* end if */
+   return id;
 } /* end function CreateNode */
 
 
@@ -269,7 +557,7 @@ int DeleteNode( int id ) {
    int idCZeroUp, idCZeroDown;
    int idCMinusUp, idCMinusDown;
 
-   if ( id >= MAX_NODES || id < 0 ) return MOC_ERROR;
+   if ( id >= NodeCapacity || id < 0 ) return MOC_ERROR;
 
    if (Node[id] != NULL) {
       /* 
@@ -305,10 +593,12 @@ int DeleteNode( int id ) {
 
       /* 
        * Now destroy the node itself.
+       * Its storage stays in the chunk, for reuse.
        */
-      free( Node[id] );
+      HashRemove( id );
       Node[id] = NULL; 
       --NumberOfNodes;
+      PushFreeId( id );
       return MOC_OK;
    } else {
       return MOC_ERROR;
@@ -324,13 +614,29 @@ struct NodeData * GetNodePtr( int id ) {
     or the index was out of range.<BR>
     For use within the C functions.
     */
-   if ( id < 0 || id >= MAX_NODES ) {
+   if ( id < 0 || id >= NodeCapacity ) {
       return (struct NodeData *)NULL;
    } else { 
       return (struct NodeData *)Node[id];
    } /* end if */
 } /* end function GetNodePtr */
 
+
+/* @function */
+int SetNodePosition( int id, double x, double y ) {
+   /**
+    Move a node, keeping the spatial hash up to date.
+    Code that changes a node's X or Y should do so via this function
+    so that FindNodesNear() will find the node in its new location. <BR>
+    Returns 0 if successful, -1 on error. <BR>
+    For use within the C functions.
+    */
+   if ( id < 0 || id >= NodeCapacity || Node[id] == NULL ) return MOC_ERROR;
+   Node[id]->X = x;
+   Node[id]->Y = y;
+   return UpdateNodeHash( id );
+} /* end function SetNodePosition */
+
 /* @function */
 int SetNodeData_C( int id, char *parameter, char *valueString ) {
    /**
@@ -346,7 +652,7 @@ int SetNodeData_C( int id, char *parameter, char *valueString ) {
    double dvalue;
    int    ivalue;
 
-   if ( id >= MAX_NODES || id < 0 ) return MOC_ERROR;
+   if ( id >= NodeCapacity || id < 0 ) return MOC_ERROR;
    if ( Node[id] == NULL ) return MOC_ERROR;
 
    if ( strcmp(parameter, "Mach") == 0 ) {
@@ -362,10 +668,10 @@ int SetNodeData_C( int id, char *parameter, char *valueString ) {
       Node[id]->Theta = dvalue;
    } else if ( strcmp(parameter, "X") == 0 ) {
       dvalue = atof(valueString);
-      Node[id]->X = dvalue;
+      SetNodePosition( id, dvalue, Node[id]->Y );
    } else if ( strcmp(parameter, "Y") == 0 ) {
       dvalue = atof(valueString);
-      Node[id]->Y = dvalue;
+      SetNodePosition( id, Node[id]->X, dvalue );
    } else if ( strcmp(parameter, "P0") == 0 ) {
       dvalue = atof(valueString);
       Node[id]->P0 = dvalue;
@@ -411,7 +717,7 @@ char *GetNodeData_C( int id, char *parameter ) {
     */
    static char valueString[132];
 
-   if ( id >= MAX_NODES || id < 0 ) {
+   if ( id >= NodeCapacity || id < 0 ) {
       strcpy( valueString, "MOC_ERROR_Invalid_Node_Index" );
       return valueString;
    } /* end if */
@@ -469,10 +775,10 @@ int GetNextNodeId( int idStart ) {
    int id, foundNode;
 
    if ( idStart < -1 ) idStart = -1;
-   if ( idStart >= (MAX_NODES - 1) ) return -1; /* already at end */ 
+   if ( idStart >= (NodeHighWater - 1) ) return -1; /* already at end */ 
 
    foundNode = NO;
-   for ( id = idStart + 1; id < MAX_NODES; ++id ) {
+   for ( id = idStart + 1; id < NodeHighWater; ++id ) {
       if ( Node[id] != NULL ) {
          foundNode = YES;
          break;
@@ -550,24 +856,58 @@ int FindNodesNear( double x, double y, double tol,
     */
    double dx, dy, distance, distanceNear;
    int    id, idNear, nodeCount;
+   long   ci, cj, i, j, r, ilo, ihi, jlo, jhi;
+   double cellsToScan;
 
    nodeCount = 0;
+   if ( NumberOfNodes == 0 ) return 0;
 
    if ( tol <= 0.0 ) {
       /*
        * Find Nearest.
+       * Search the hash cells in rings of increasing size around
+       * the query point until no closer node can be in the next ring.
+       * If the ring gets too big, just look at every node.
        */
       idNear = -1;
       distanceNear = 10.0e6; /* something large */
-      for ( id = 0; id < MAX_NODES; ++id ) {
-         if ( Node[id] == NULL ) continue;
-         dx = x - Node[id]->X;
-         dy = y - Node[id]->Y;
-         distance = sqrt(dx * dx + dy * dy);
-         if ( distance < distanceNear ) {
-            distanceNear = distance;
-            idNear = id;
+      ci = HashCellIndex( x );
+      cj = HashCellIndex( y );
+      for ( r = 0; ; ++r ) {
+         cellsToScan = (2.0 * r + 1.0) * (2.0 * r + 1.0);
+         if ( cellsToScan > 4.0 * NumberOfNodes + 16.0 ) {
+            for ( id = 0; id < NodeHighWater; ++id ) {
+               if ( Node[id] == NULL ) continue;
+               dx = x - Node[id]->X;
+               dy = y - Node[id]->Y;
+               distance = sqrt(dx * dx + dy * dy);
+               if ( distance < distanceNear || 
+                    (distance == distanceNear && id < idNear) ) {
+                  distanceNear = distance;
+                  idNear = id;
+               } /* end if */
+            } /* end for */
+            break;
          } /* end if */
+         for ( i = ci - r; i <= ci + r; ++i ) {
+            for ( j = cj - r; j <= cj + r; ++j ) {
+               /* Only the cells on the ring itself. */
+               if ( i != ci - r && i != ci + r && j != cj - r && j != cj + r ) continue;
+               for ( id = HashHead[HashBucket(i, j)]; id != NO_NODE; id = HashNext[id] ) {
+                  if ( HashCellI[id] != i || HashCellJ[id] != j ) continue;
+                  dx = x - Node[id]->X;
+                  dy = y - Node[id]->Y;
+                  distance = sqrt(dx * dx + dy * dy);
+                  if ( distance < distanceNear || 
+                       (distance == distanceNear && id < idNear) ) {
+                     distanceNear = distance;
+                     idNear = id;
+                  } /* end if */
+               } /* end for */
+            } /* end for */
+         } /* end for */
+         /* Nodes beyond this ring are at least r cells away. */
+         if ( idNear >= 0 && distanceNear < r * HashCellSize ) break;
       } /* end for */
 
       if ( idNear >= 0 ) {
@@ -577,19 +917,33 @@ int FindNodesNear( double x, double y, double tol,
 
    } else {
       /*
-       * Build up a list of nodes within the specified range.
+       * Build up a list of nodes within the specified range,
+       * from the hash cells that overlap the circle of interest
+       * (or from all nodes, if that would be fewer to look at).
+       * The list is sorted so that, as before, the lowest ids
+       * are returned when there are more than maxCount nodes in range.
        */
-      for ( id = 0; id < MAX_NODES; ++id ) {
-         if ( Node[id] == NULL ) continue;
-         dx = x - Node[id]->X;
-         dy = y - Node[id]->Y;
-         distance = sqrt(dx * dx + dy * dy);
-         if ( distance < tol ) {
-            id_near_array[nodeCount] = id;
-            ++nodeCount;
-            if ( nodeCount >= maxCount ) break;
-         } /* end if */
-      } /* end for */
+      ilo = HashCellIndex( x - tol ); ihi = HashCellIndex( x + tol );
+      jlo = HashCellIndex( y - tol ); jhi = HashCellIndex( y + tol );
+      cellsToScan = (double) (ihi - ilo + 1) * (double) (jhi - jlo + 1);
+      if ( cellsToScan > NumberOfNodes ) {
+         for ( id = 0; id < NodeHighWater; ++id ) {
+            if ( Node[id] == NULL ) continue;
+            nodeCount = CheckNodeNear( id, x, y, tol, nodeCount );
+         } /* end for */
+      } else {
+         for ( i = ilo; i <= ihi; ++i ) {
+            for ( j = jlo; j <= jhi; ++j ) {
+               for ( id = HashHead[HashBucket(i, j)]; id != NO_NODE; id = HashNext[id] ) {
+                  if ( HashCellI[id] != i || HashCellJ[id] != j ) continue;
+                  nodeCount = CheckNodeNear( id, x, y, tol, nodeCount );
+               } /* end for */
+            } /* end for */
+         } /* end for */
+         qsort( NearList, nodeCount, sizeof(int), CompareIds );
+      } /* end if */
+      if ( nodeCount > maxCount ) nodeCount = maxCount;
+      for ( i = 0; i < nodeCount; ++i ) id_near_array[i] = NearList[i];
 
    } /* end if */
 
@@ -619,7 +973,7 @@ int SaveNodes( char *FileName ) {
    fprintf( fp, "# Id   X   Y  Mach   Nu  Theta    P0   T0  ");
    fprintf( fp, "CPlusUp  CMinusUp  CZeroUp  ");
    fprintf( fp, "CPlusDown  CMinusDown  CZeroDown\n");
-   for (id = 0; id < MAX_NODES; ++id) {
+   for (id = 0; id < NodeHighWater; ++id) {
       np = Node[id];
       if ( np == NULL ) continue;
       fprintf( fp, "%d %e %e %e %e %e %e %e %d %d %d %d %d %d\n",
@@ -645,7 +999,7 @@ int LoadNodes( char *FileName ) {
     (Available from the Tcl interpreter.) 
     */
    FILE *fp;
-   int id, i, nodeCount;
+   int id, nodeCount;
    struct NodeData *np;
    char buffer[256], *buffer_ptr;
 
@@ -667,27 +1021,26 @@ int LoadNodes( char *FileName ) {
    } /* end if */
 
    nodeCount = 0;
-   for (i = 0; i < MAX_NODES; ++i) {
-      /*
-       * Read a whole line from the file and extract its data.
-       */
-      buffer_ptr = fgets( buffer, sizeof(buffer), fp);
-      if ( buffer_ptr != NULL ) {
-         sscanf( buffer, "%d", &id);
-         if ( Node[id] != NULL ) {
-            DeleteNode( id );
-         } /* end if */
-         CreateNode( id );
-         np = Node[id];
-         sscanf( buffer, "%d %lf %lf %lf %lf %lf %lf %lf %d %d %d %d %d %d",
-            &id, &(np->X), &(np->Y), 
-            &(np->Mach), &(np->Nu), &(np->Theta),
-            &(np->P0), &(np->T0), 
-            &(np->CPlusUp), &(np->CMinusUp), &(np->CZeroUp),
-            &(np->CPlusDown), &(np->CMinusDown), &(np->CZeroDown) );
-         ++nodeCount;
+   /*
+    * Read a whole line from the file and extract its data.
+    * CreateNode destroys any node already at that id.
+    */
+   while ( fgets( buffer, sizeof(buffer), fp) != NULL ) {
+      if ( sscanf( buffer, "%d", &id) != 1 || id < 0 ) continue;
+      if ( CreateNode( id ) != id ) {
+         fclose( fp );
+         return MOC_ERROR;
       } /* end if */
-   } /* end for */
+      np = Node[id];
+      sscanf( buffer, "%d %lf %lf %lf %lf %lf %lf %lf %d %d %d %d %d %d",
+         &id, &(np->X), &(np->Y), 
+         &(np->Mach), &(np->Nu), &(np->Theta),
+         &(np->P0), &(np->T0), 
+         &(np->CPlusUp), &(np->CMinusUp), &(np->CZeroUp),
+         &(np->CPlusDown), &(np->CMinusDown), &(np->CZeroDown) );
+      UpdateNodeHash( id );
+      ++nodeCount;
+   } /* end while */
 
    if ( MOCDebugLevel >= 1 ) {
       printf( "%d nodes read.\n", nodeCount);
@@ -6,6 +6,7 @@
  *
  * \version 26-Sep-1998 : Initial hack
  * \version 09-Jan-2000 : Added CZeroUp, CZeroDown fields
+ * \version 18-Oct-2026 : Growable node store; SetNodePosition
  *
  */
 
@@ -64,6 +65,7 @@ int InitMOC( void );
 int CreateNode( int id );
 int DeleteNode( int id );
 struct NodeData * GetNodePtr( int id );
+int SetNodePosition( int id, double x, double y );
 int SetNodeData_C( int id, char *parameter, char *valueString );
 char *GetNodeData_C( int id, char *parameter );
 
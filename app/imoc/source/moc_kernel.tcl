@@ -226,6 +226,6 @@ proc DeleteAll {} {
     set nodeid [GetNextNodeId -1]
     while { $nodeid >= 0 } {
         DeleteNode $nodeid
-        set nodeid [GetNextNodeId -1]
+        set nodeid [GetNextNodeId $nodeid]
     }; # end while
 }; # end proc
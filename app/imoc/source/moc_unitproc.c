@@ -12,6 +12,8 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "moc_kernel.h"
 #include "moc_gasdynamic.h"
@@ -213,7 +215,7 @@ int InteriorNode( int node1, int node2, int node4 ) {
     * node into the characteristic mesh.
     */
    M4 = MFromNu( pm4, GetGamma() );
-   n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+   SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
    if ( x4 > x2 ) {
       n4->CPlusUp    = node2;
       n2->CPlusDown  = node4;
@@ -309,8 +311,8 @@ int InsertNode( int node1, int node2, int node4, double alpha ) {
    /*
     * Linearly Interpolate all node properties.
     */
-   n4->X     = (1.0 - alpha) * n1->X     + alpha * n2->X;
-   n4->Y     = (1.0 - alpha) * n1->Y     + alpha * n2->Y;
+   SetNodePosition( node4, (1.0 - alpha) * n1->X + alpha * n2->X,
+                    (1.0 - alpha) * n1->Y + alpha * n2->Y );
    n4->Nu    = (1.0 - alpha) * n1->Nu    + alpha * n2->Nu;
    n4->Theta = (1.0 - alpha) * n1->Theta + alpha * n2->Theta;
    n4->P0    = (1.0 - alpha) * n1->P0    + alpha * n2->P0;
@@ -508,7 +510,7 @@ int CMinusWallNode( int iw, int node1, int node4 ) {
     * node into the characteristic mesh.
     */
    M4 = MFromNu( pm4, GetGamma() );
-   n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+   SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
    if ( x4 > x1 ) {
       n4->CMinusUp   = node1;
       n1->CMinusDown = node4;
@@ -667,7 +669,7 @@ int CPlusWallNode( int iw, int node2, int node4 ) {
     * node into the characteristic mesh.
     */
    M4 = MFromNu( pm4, GetGamma() );
-   n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+   SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
    if ( x4 > x2 ) {
       n4->CPlusUp    = node2;
       n2->CPlusDown  = node4;
@@ -854,7 +856,7 @@ int CPlusFreeBndyNode( int node0, int node2, int node4 ) {
     * node into the characteristic mesh.
     */
    M4 = MFromNu( pm4, GetGamma() );
-   n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+   SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
    if ( x4 > x2 ) {
       n4->CPlusUp    = node2;
       n2->CPlusDown  = node4;
@@ -1050,7 +1052,7 @@ int CMinusFreeBndyNode( int node0, int node1, int node4 ) {
     * node into the characteristic mesh.
     */
    M4 = MFromNu( pm4, GetGamma() );
-   n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+   SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
    if ( x4 > x0 ) {
       n4->CZeroUp    = node0;
       n0->CZeroDown  = node4;
@@ -1228,7 +1230,7 @@ int AddStreamNode( int node0, int node1, int node2, int node4,
       } /* end if */
 
       M4 = MFromNu( pm4, GetGamma() );
-      n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+      SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
       if ( x4 > x0 ) {
          n4->CZeroUp    = node0;
          n0->CZeroDown  = node4;
@@ -1409,7 +1411,7 @@ int StepStreamNode( int node0, int node4, double dL ) {
     * node into the characteristic mesh.
     */
    M4 = MFromNu( pm4, GetGamma() );
-   n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+   SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
    if ( x4 > x0 ) {
       n4->CZeroUp    = node0;
       n0->CZeroDown  = node4;
@@ -1534,7 +1536,7 @@ int InterpolateNode( double x_point, double y_point, double R, int node4 ) {
     * Save the solution-point properties.
     */
    M4 = MFromNu( pm4, GetGamma() );
-   n4->X = x4; n4->Y = y4; n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
+   SetNodePosition( node4, x4, y4 ); n4->Nu = pm4; n4->Theta = th4; n4->Mach = M4;
 
    /*
     * Assuming a successful calculation, 
@@ -1544,3 +1546,177 @@ int InterpolateNode( double x_point, double y_point, double R, int node4 ) {
 } /* end function InterpolateNode */
 
 /*------------------------------------------------------------------*/
+
+/*
+ * Marching a whole characteristic line in C.
+ * These do the same job as the Tcl procedures MarchAlongCMinus
+ * and MarchAlongCPlus but without going back to the interpreter
+ * for each new node, which matters when there are many nodes.
+ */
+
+static int   *FrontNodes = NULL;      /* ids on the new line, in order generated */
+static int   FrontNodesCapacity = 0;
+static char  *FrontString = NULL;     /* the same, as a Tcl list */
+static size_t FrontStringCapacity = 0;
+
+static int AddFrontNode( int count, int id ) {
+   int *p;
+   if ( count >= FrontNodesCapacity ) {
+      p = realloc(FrontNodes, 2 * (FrontNodesCapacity + 64) * sizeof(int));
+      if ( p == NULL ) return -1;
+      FrontNodes = p;
+      FrontNodesCapacity = 2 * (FrontNodesCapacity + 64);
+   } /* end if */
+   FrontNodes[count] = id;
+   return count + 1;
+} /* end function AddFrontNode */
+
+
+static char *FrontNodesAsString( int count ) {
+   /* Write the list of node ids as a space-separated string. */
+   size_t length, needed;
+   char idString[16], *p;
+   int i;
+
+   needed = (count > 0) ? (size_t) count * 12 : 1;
+   if ( needed > FrontStringCapacity ) {
+      p = realloc(FrontString, needed);
+      if ( p == NULL ) return "";
+      FrontString = p;
+      FrontStringCapacity = needed;
+   } /* end if */
+   length = 0;
+   FrontString[0] = '\0';
+   for ( i = 0; i < count; ++i ) {
+      sprintf( idString, (i > 0) ? " %d" : "%d", FrontNodes[i] );
+      strcpy( FrontString + length, idString );
+      length += strlen( idString );
+   } /* end for */
+   return FrontString;
+} /* end function FrontNodesAsString */
+
+
+/* @function */
+int MarchAlongCMinus_C_array( int old_first, int new_first, int up, int iw ) {
+   /**
+    Purpose: Generate nodes along a new C- characteristic line. <BR>
+    Input  : <BR>
+    old_first : a starting point on an existing C- line <BR>
+    new_first : the starting point on the new C- line 
+                on which the new nodes are to be generated. <BR>
+    up        : 1 to march up the existing line, 0 to march down <BR>
+    iw        : if this is a valid wall index, the new line is
+                finished with a wall node on that wall. <BR>
+    Output : <BR>
+    Returns the number of nodes on the new line (including new_first)
+    and leaves their indices in FrontNodes, in the order generated,
+    or returns -1 if a unit process failed.
+    For use within the C functions.
+    */
+   int n1, n2, n4, count;
+   struct NodeData *np;
+
+   count = AddFrontNode( 0, new_first );
+   n1 = new_first;
+   n2 = old_first;
+   while ( n2 != NO_NODE ) {
+      n4 = InteriorNode( n1, n2, -1 );
+      if ( n4 < 0 ) return -1;
+      if ( GetDebugLevel() >= 1 ) {
+         printf( "Made node %d from nodes %d %d\n", n4, n1, n2 );
+      } /* end if */
+      count = AddFrontNode( count, n4 );
+      if ( count < 0 ) return -1;
+      n1 = n4;
+      np = GetNodePtr( n2 );
+      n2 = ( up ) ? np->CMinusUp : np->CMinusDown;
+   } /* end while */
+   if ( iw >= 0 && WallIsPresent(iw) == 1 ) {
+      n4 = CMinusWallNode( iw, n1, -1 );
+      if ( n4 < 0 ) return -1;
+      count = AddFrontNode( count, n4 );
+   } /* end if */
+   return count;
+} /* end function MarchAlongCMinus_C_array */
+
+
+/* @function */
+int MarchAlongCPlus_C_array( int old_first, int new_first, int up, int iw ) {
+   /**
+    Purpose: Generate nodes along a new C+ characteristic line. <BR>
+    Input and output are as for MarchAlongCMinus_C_array(),
+    with old_first on an existing C+ line and new_first the start
+    of the new C+ line. <BR>
+    For use within the C functions.
+    */
+   int n1, n2, n4, count;
+   struct NodeData *np;
+
+   count = AddFrontNode( 0, new_first );
+   n1 = old_first;
+   n2 = new_first;
+   while ( n1 != NO_NODE ) {
+      n4 = InteriorNode( n1, n2, -1 );
+      if ( n4 < 0 ) return -1;
+      if ( GetDebugLevel() >= 1 ) {
+         printf( "Made node %d from nodes %d %d\n", n4, n1, n2 );
+      } /* end if */
+      count = AddFrontNode( count, n4 );
+      if ( count < 0 ) return -1;
+      n2 = n4;
+      np = GetNodePtr( n1 );
+      n1 = ( up ) ? np->CPlusUp : np->CPlusDown;
+   } /* end while */
+   if ( iw >= 0 && WallIsPresent(iw) == 1 ) {
+      n4 = CPlusWallNode( iw, n2, -1 );
+      if ( n4 < 0 ) return -1;
+      count = AddFrontNode( count, n4 );
+   } /* end if */
+   return count;
+} /* end function MarchAlongCPlus_C_array */
+
+
+/* @function */
+char *MarchAlongCMinus_C( int old_first, int new_first, char *direction, int iw ) {
+   /**
+    Generate nodes along a new C- characteristic line,
+    as for the Tcl procedure MarchAlongCMinus. <BR>
+    direction : "up" or "down" the existing C- line <BR>
+    iw        : wall index for a final wall node, or -1 for none <BR>
+    Returns a string listing the indices of the nodes on the new line,
+    or an empty string if a unit process failed. <BR>
+    (Available from the Tcl interpreter.) 
+    */
+   int count;
+   count = MarchAlongCMinus_C_array( old_first, new_first,
+                                     strcmp(direction, "up") == 0, iw );
+   if ( count < 0 ) {
+      printf( "MarchAlongCMinus_C: failed to complete the new C- line.\n" );
+      return "";
+   } /* end if */
+   return FrontNodesAsString( count );
+} /* end function MarchAlongCMinus_C */
+
+
+/* @function */
+char *MarchAlongCPlus_C( int old_first, int new_first, char *direction, int iw ) {
+   /**
+    Generate nodes along a new C+ characteristic line,
+    as for the Tcl procedure MarchAlongCPlus. <BR>
+    direction : "up" or "down" the existing C+ line <BR>
+    iw        : wall index for a final wall node, or -1 for none <BR>
+    Returns a string listing the indices of the nodes on the new line,
+    or an empty string if a unit process failed. <BR>
+    (Available from the Tcl interpreter.) 
+    */
+   int count;
+   count = MarchAlongCPlus_C_array( old_first, new_first,
+                                    strcmp(direction, "up") == 0, iw );
+   if ( count < 0 ) {
+      printf( "MarchAlongCPlus_C: failed to complete the new C+ line.\n" );
+      return "";
+   } /* end if */
+   return FrontNodesAsString( count );
+} /* end function MarchAlongCPlus_C */
+
+/*------------------------------------------------------------------*/
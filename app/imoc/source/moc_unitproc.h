@@ -19,3 +19,8 @@ int StepStreamNode( int node0, int node4, double dL );
 
 int InterpolateNode( double x, double y, double R, int node4 );
 
+
+int MarchAlongCMinus_C_array( int old_first, int new_first, int up, int iw );
+int MarchAlongCPlus_C_array( int old_first, int new_first, int up, int iw );
+char *MarchAlongCMinus_C( int old_first, int new_first, char *direction, int iw );
+char *MarchAlongCPlus_C( int old_first, int new_first, char *direction, int iw );
@@ -12,7 +12,7 @@ package provide imoc 0.1
 # Some composite processes, built up of sequences of unit processes.
 #
 
-proc MarchAlongCMinus { old_first new_first direction } {
+proc MarchAlongCMinus { old_first new_first direction {iw -1} } {
     #@proc
     #@doc
     # Purpose: Generate nodes along a new C- characteristic line. <BR>
@@ -21,41 +21,23 @@ proc MarchAlongCMinus { old_first new_first direction } {
     # new_first : the starting point on the new C- line 
     #             on which the new nodes are to be generated. <BR>
     # direction : up or down <BR>
+    # iw        : (optional) index of a wall on which to finish
+    #             the new line with a wall node <BR>
     # Output : <BR>
     # Returns a list of node indices on the new C- curve.
     # in the order that they are generated.
+    # The work is done by MarchAlongCMinus_C, in one call.
     #@end
     global gd
-    set nodelist [list $new_first]
-    set n1 $new_first
-    set n2 $old_first
-    set more_to_do 1
-    while {$more_to_do == 1} {
-        if { $gd(echoCommands) == 1 } {
-            puts "SubCommand: InteriorNode $n1 $n2 -1"
-        }; # end if
-        set n4 [InteriorNode $n1 $n2 -1]
-        if {[GetDebugLevel] >= 1} {
-            puts "Made node $n4 from nodes $n1 $n2"
-        }; # end if
-        lappend nodelist $n4
-        set n1 $n4
-        if {[string compare $direction "up"] == 0} {
-            set n2 [GetNodeDataValue $n2 CMinusUp]
-        } else {
-            set n2 [GetNodeDataValue $n2 CMinusDown]
-        }; # end if
-        if {[GetDebugLevel] >= 1} {
-            puts "Puts next pair $n1 $n2"
-        }; # end if
-        if {$n2 == -1} { set more_to_do 0 }
-    }; # end while
-    return $nodelist
+    if { $gd(echoCommands) == 1 } {
+        puts "SubCommand: MarchAlongCMinus_C $old_first $new_first $direction $iw"
+    }; # end if
+    return [MarchAlongCMinus_C $old_first $new_first $direction $iw]
 }; # end proc MarchAlongCMinus
 
 #---------------------------------------------------------------------
 
-proc MarchAlongCPlus { old_first new_first direction } {
+proc MarchAlongCPlus { old_first new_first direction {iw -1} } {
     #@proc
     #@doc
     # Purpose: Generate nodes along a new C+ characteristic line. <BR>
@@ -64,36 +46,18 @@ proc MarchAlongCPlus { old_first new_first direction } {
     # new_first : the starting point on the new C+ line
     #             on which the new nodes are to be generated. <BR>
     # direction : up or down <BR>
+    # iw        : (optional) index of a wall on which to finish
+    #             the new line with a wall node <BR>
     # Output : <BR>
     # Returns a list of node indices on the new C+ curve.
     # in the order that they are generated.
+    # The work is done by MarchAlongCPlus_C, in one call.
     #@end
     global gd
-    set nodelist [list $new_first]
-    set n1 $old_first
-    set n2 $new_first
-    set more_to_do 1
-    while {$more_to_do == 1} {
-        if { $gd(echoCommands) == 1 } {
-            puts "SubCommand: InteriorNode $n1 $n2 -1"
-        }; # end if
-        set n4 [InteriorNode $n1 $n2 -1]
-        if {[GetDebugLevel] >= 1} {
-            puts "Made node $n4 from nodes $n1 $n2"
-        }; # end if
-        lappend nodelist $n4
-        set n2 $n4
-        if {[string compare $direction "up"] == 0} {
-            set n1 [GetNodeDataValue $n1 CPlusUp]
-        } else {
-            set n1 [GetNodeDataValue $n1 CPlusDown]
-        }; # end if
-        if {[GetDebugLevel] >= 1} {
-            puts "Puts next pair $n1 $n2"
-        }; # end if
-        if {$n1 == -1} { set more_to_do 0 }
-    }; # end while
-    return $nodelist
+    if { $gd(echoCommands) == 1 } {
+        puts "SubCommand: MarchAlongCPlus_C $old_first $new_first $direction $iw"
+    }; # end if
+    return [MarchAlongCPlus_C $old_first $new_first $direction $iw]
 }; # end proc MarchAlongCPlus
 
 #---------------------------------------------------------------------
@@ -37,6 +37,7 @@
 #include "ov_setgeom.h"
 #include "ov_recon.h"
 #include "ov_thermo.h"
+#include "ov_lists.h"
 #include "time_keeper.h"
 
 #define NOTINCLUDE 0
@@ -72,6 +73,9 @@ extern List_leaf * Leaf_heads;
 extern List_leaf * Leaf_tails;
 extern double * min_dt;
 extern int * num_cells_per_thread;
+extern List_leaf Leaf_pool;
+extern int num_pooled_leaves;
+extern short int leaf_pool_current;
 extern List_vtx_glob Vtxlist;
 extern short int only_get_boundary_cells_flow;
 extern short int want_to_adapt;
@@ -316,13 +320,18 @@ short int march_soln(void)
 
 /*------------------------------------------------------------------*/
 
-/**\brief Helper function to count and/or flag the no. cells for different threads (in serial as very quick)*/
+/**\brief Helper function to count and/or flag the no. cells for different threads (in serial as very quick).  As
+   this is called whenever the leaf list may have changed, the list is also compacted into Morton order here, so the
+   sublists handed to each thread are contiguous both in memory and in space*/
 
 int count_cells(void)
 {
   int num_cells = 0;
   List_leaf L;
 
+  if(compact_leaf_list() == ERROR)
+    printf("count_cells(): Continuing with uncompacted leaf list\n");
+
   L = Leaves;
   while(L != NULL)
     {
@@ -334,7 +343,44 @@ int count_cells(void)
       L = L -> next;
     }
   
-  if(number_of_threads > 1)
+  if((number_of_threads > 1) && (leaf_pool_current == TRUE) && (num_pooled_leaves >= number_of_threads))
+    {
+      /*Leaf list is the contiguous pool, so each thread's sublist is just a range of pool indices.  Split it so each
+	thread gets about the same no. cells to update, and at least one node*/
+
+      int k;
+      int k_start = 0; /*First pool index of current thread's range*/
+      int cells = 0; /*No. cells counted so far*/
+      int cells_start = 0; /*No. cells counted before current thread's range*/
+      int thread_num = 0;
+
+      for(k = 0; k < num_pooled_leaves; k++)
+	{
+	  if((thread_num < (number_of_threads-1)) && (k > k_start) &&
+	     ((cells >= ((thread_num+1)*num_cells)/number_of_threads) || 
+	      ((num_pooled_leaves-k) == (number_of_threads-1-thread_num))))
+	    {
+	      Leaf_heads[thread_num] = &Leaf_pool[k_start];
+	      Leaf_tails[thread_num] = &Leaf_pool[k-1];
+	      num_cells_per_thread[thread_num] = cells - cells_start;
+
+	      thread_num++;
+	      k_start = k;
+	      cells_start = cells;
+	    }
+
+	  Leaf_pool[k].thread_num = thread_num;
+#if DETON
+	  if(Leaf_pool[k].cell_loc -> un_det != TRUE)
+#endif
+	    cells++;
+	}
+
+      Leaf_heads[thread_num] = &Leaf_pool[k_start];
+      Leaf_tails[thread_num] = &Leaf_pool[num_pooled_leaves-1];
+      num_cells_per_thread[thread_num] = cells - cells_start;
+    }
+  else if(number_of_threads > 1)
     { 
       /*Get no. of threads for each cell (except last thread, which may have more/less than others)*/
 
@@ -413,11 +459,23 @@ int count_cells(void)
 
 /*------------------------------------------------------------------*/
 
+/**\brief Get the range of Leaf_pool indices making up a thread's sublist (only valid while leaf_pool_current is TRUE
+   and count_cells() has been called since the last compaction).  Returns the last index and sets *first*/
+
+static int pool_sublist_range(int thread_num, int *first)
+{
+  *first = (int) (Leaf_heads[thread_num] - Leaf_pool);
+  return((int) (Leaf_tails[thread_num] - Leaf_pool));
+}
+
+/*------------------------------------------------------------------*/
+
 /**\brief Traverse list of leaf cells to get minimum timestep*/
 
 void get_global_timestep(void)
 {
   short int i;
+  int k, k_end;
   double mint;
   List_leaf node, Head, Tail;
   Cart_cell C;
@@ -429,7 +487,36 @@ void get_global_timestep(void)
   Head = Leaves;
   Tail = Leaves_tail;
   
-  if(number_of_threads > 1)
+  if((number_of_threads > 1) && (leaf_pool_current == TRUE))
+    {
+      /*Leaf list is the contiguous pool, so walk each thread's range of pool indices (as set in count_cells())*/
+      #pragma omp parallel private(mint, C, k, k_end, thread_num)
+      {
+        #ifdef _OPENMP
+	thread_num = omp_get_thread_num();
+        #endif
+
+	k_end = pool_sublist_range(thread_num, &k);
+
+	for(; k <= k_end; k++)
+	  {
+	    C = Leaf_pool[k].cell_loc;
+
+	    if(
+#if DETON
+	       (C -> un_det != TRUE) &&
+#endif
+	       (C -> is_small_cell == FALSE))
+	      {
+		mint = min_local_cell_timestep(C);
+
+		if(mint < min_dt[thread_num])
+		  min_dt[thread_num] = mint;
+	      }
+	  }
+      }
+    }
+  else if(number_of_threads > 1)
     {
       #pragma omp parallel private(mint, node, Head, Tail, C, thread_num) 
       {	
@@ -507,6 +594,7 @@ void get_global_timestep(void)
 short int get_flow_soln(double *time)
 {  
   List_leaf Head, Tail; /*Head and tail of sublists processed by each thread*/
+  int k, k_end; /*Pool index range of each thread's sublist*/
   int thread_num = 0;
   short int error_found = FALSE; /*Can't return in parallel construct*/  
   int i;
@@ -542,15 +630,24 @@ short int get_flow_soln(double *time)
         
   if(number_of_threads > 1)
     {
-      #pragma omp parallel private(Head, Tail, thread_num) 
+      #pragma omp parallel private(Head, Tail, k, k_end, thread_num) 
       { 		
         #ifdef _OPENMP
 	thread_num = omp_get_thread_num();
         #endif
 
-	/*Now get sublists to work on*/
-	Head = Leaf_heads[thread_num];
-	Tail = Leaf_tails[thread_num];	
+	/*Now get sublists to work on - if the leaf list is the pool, these are contiguous ranges of pool indices*/
+	if(leaf_pool_current == TRUE)
+	  {
+	    k_end = pool_sublist_range(thread_num, &k);
+	    Head = &Leaf_pool[k];
+	    Tail = &Leaf_pool[k_end];
+	  }
+	else
+	  {
+	    Head = Leaf_heads[thread_num];
+	    Tail = Leaf_tails[thread_num];	
+	  }
 	RK = 1;
 
 	/*Exchange fluxes and compute global time step*/
@@ -47,6 +47,9 @@ List_vtx_glob *Vtx_heads;
 List_vtx_glob *Vtx_tails;
 double * min_dt; /**< Array of minimum timesteps*/
 int *num_cells_per_thread; /**< No. of cells for each thread*/
+List_leaf Leaf_pool = NULL; /**< Contiguous array of leaf list nodes in Morton order (rebuilt by compact_leaf_list())*/
+int num_pooled_leaves = 0; /**< No. nodes in Leaf_pool*/
+short int leaf_pool_current = FALSE; /**< TRUE if the leaf list is exactly Leaf_pool[0 .. num_pooled_leaves-1] in order*/
 
 short int output_grid = FALSE; /**< If we want to output the whole grid and solution to continue it at a later time*/
 short int output_grid_last = FALSE; /**< If we only want to output the whole grid at the very last timestep*/
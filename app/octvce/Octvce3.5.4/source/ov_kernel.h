@@ -116,6 +116,8 @@ typedef struct vertex * Vertex;
 #define UPR 4
 #define LWR 5
 
+#define MORTON_MAX_LEVEL 21 /**< Deepest refinement level whose Morton key fits in 63 bits (3 bits per level)*/
+
 #define CALC_CELL_EDGE_LENGTH(C) (C -> cell_length)
 #define CALC_CELL_FLUID_VOL(C) (CUBE(CALC_CELL_EDGE_LENGTH(C)))
 #define CALC_CELL_FLUID_AREA(C) (SQR(CALC_CELL_EDGE_LENGTH(C))) /**< Calculating basis edge length/area/volumes of cartesian cells*/
@@ -494,6 +496,7 @@ struct list_leaf /**< \b Leaf nodes of octree - purely to avoid expensive octree
   Cart_cell cell_loc; /**< Address of leaf cell*/
   short int pure_fluid; /**< Helper variable during mesh and flow soln writing - identifies FLUID cells next to wall*/
   int thread_num; /**< Denotes which thread is processing this list node*/
+  short int pooled; /**< TRUE if node lives in the contiguous leaf pool (so mustn't be freed individually)*/
   
   struct list_leaf *prev; struct list_leaf *next; 
 };
@@ -26,6 +26,17 @@
 
 extern int number_of_threads;
 extern int stepnow;
+extern List_leaf Leaves;
+extern List_leaf Leaves_tail;
+extern List_leaf Leaf_pool;
+extern int num_pooled_leaves;
+extern short int leaf_pool_current;
+
+typedef struct leaf_key /**< Leaf list node and its Morton key, for sorting*/
+{
+  unsigned long long key;
+  List_leaf node;
+} Leaf_key;
 
 /*------------------------------------------------------------------*/
 
@@ -41,6 +52,9 @@ short int add_to_leaf_list_front(Cart_cell C, List_leaf *L, List_leaf *Head, Lis
 
       node -> thread_num = 0; /*Default thread no. (in serial)*/
 
+      node -> pooled = FALSE; /*Individually allocated until the next compaction*/
+      leaf_pool_current = FALSE;
+
       C -> Leaf_list_loc = node; /*Let cell store node's address*/
       
       node -> next = *L; 
@@ -107,6 +121,8 @@ void delete_from_leaf_list(Cart_cell C, List_leaf *Head, List_leaf *Tail)
 {                                      
   List_leaf node = C -> Leaf_list_loc;
 
+  leaf_pool_current = FALSE; /*Pooled nodes are just abandoned until the next compaction*/
+
   if(node -> prev == NULL) /*At beginning of list*/
     {
       if(node -> next == NULL) /*Only item on list*/
@@ -114,14 +130,14 @@ void delete_from_leaf_list(Cart_cell C, List_leaf *Head, List_leaf *Tail)
 	  (*Head) = NULL; /*So now Head becomes empty list*/
 	  (*Tail) = NULL;
 
-	  free(node);
+	  if(node -> pooled == FALSE) free(node);
 	}
       else 
 	{
 	  node -> next -> prev = NULL;
 	  (*Head) = node -> next; /*Update pointer to beginning of list*/
 	  
-	  free(node);
+	  if(node -> pooled == FALSE) free(node);
 	}
     }  
   else if (node -> next == NULL) /*At end of list*/
@@ -129,14 +145,14 @@ void delete_from_leaf_list(Cart_cell C, List_leaf *Head, List_leaf *Tail)
       node -> prev -> next = NULL;
       (*Tail) = node -> prev;
 
-      free(node);
+      if(node -> pooled == FALSE) free(node);
     }
   else /*In the middle of the list*/
     {
       node -> prev -> next = node -> next;
       node -> next -> prev = node -> prev;
 
-      free(node);
+      if(node -> pooled == FALSE) free(node);
     }
 
   C -> Leaf_list_loc = NULL; /*Let deleted cell's pointer to list of leaf nodes be NULL*/
@@ -181,6 +197,107 @@ void delete_from_merge_list(Cart_cell C, List_merge *L)
 
 /*------------------------------------------------------------------*/
 
+/**\brief Morton (Z-order) key of a cell built from the child numbers on its path from the root.  Child numbers
+   already interleave the y, x and z bits of the child's position, so ordering by this key is the octree's depth-first order*/
+
+static unsigned long long leaf_morton_key(Cart_cell C)
+{
+  unsigned long long key = 0;
+
+  while(C -> parent != NULL)
+    {
+      key |= ((unsigned long long) (C -> child_num)) << (3*(MORTON_MAX_LEVEL - (C -> cell_level)));
+      C = C -> parent;
+    }
+
+  return(key);
+}
+
+static int compare_leaf_keys(const void *a, const void *b)
+{
+  unsigned long long ka = ((const Leaf_key *) a) -> key;
+  unsigned long long kb = ((const Leaf_key *) b) -> key;
+
+  if(ka < kb)
+    return(-1);
+  else if(ka > kb)
+    return(1);
+  else return(0);
+}
+
+/*------------------------------------------------------------------*/
+
+/**\brief Copy the list of leaf nodes into one contiguous array sorted by Morton key, so that walking the list (or
+   indexing Leaf_pool) runs through memory in order and neighbouring cells are near each other on the list.  Nodes 
+   added by adaptation since the last compaction are freed; nothing is done if the list hasn't changed*/
+
+short int compact_leaf_list(void)
+{
+  int i, n;
+  List_leaf L, new_pool;
+  Leaf_key *keys;
+
+  if(leaf_pool_current == TRUE)
+    return(NOERROR);
+
+  n = 0;
+  for(L = Leaves; L != NULL; L = L -> next)
+    {
+      if(L -> cell_loc -> cell_level > MORTON_MAX_LEVEL)
+	return(NOERROR); /*Key would overflow - just leave the list as it is*/
+      n++;
+    }
+
+  if(n == 0)
+    return(NOERROR);
+
+  keys = malloc(n*sizeof(Leaf_key));
+  new_pool = malloc(n*sizeof(struct list_leaf));
+
+  if((keys == NULL) || (new_pool == NULL))
+    {
+      printf("compact_leaf_list(): Can't allocate leaf pool of %d nodes\n", n);
+      free(keys);
+      free(new_pool);
+      return(ERROR);
+    }
+
+  i = 0;
+  for(L = Leaves; L != NULL; L = L -> next)
+    {
+      keys[i].key = leaf_morton_key(L -> cell_loc);
+      keys[i].node = L;
+      i++;
+    }
+
+  qsort(keys, n, sizeof(Leaf_key), compare_leaf_keys);
+
+  for(i = 0; i < n; i++)
+    {
+      new_pool[i] = *(keys[i].node);
+      new_pool[i].pooled = TRUE;
+      new_pool[i].prev = (i > 0) ? &new_pool[i-1] : NULL;
+      new_pool[i].next = (i < (n-1)) ? &new_pool[i+1] : NULL;
+      new_pool[i].cell_loc -> Leaf_list_loc = &new_pool[i];
+
+      if(keys[i].node -> pooled == FALSE)
+	free(keys[i].node);
+    }
+
+  free(keys);
+  free(Leaf_pool); /*Also takes any pooled nodes deleted since the last compaction*/
+
+  Leaf_pool = new_pool;
+  num_pooled_leaves = n;
+  Leaves = &new_pool[0];
+  Leaves_tail = &new_pool[n-1];
+  leaf_pool_current = TRUE;
+
+  return(NOERROR);
+}
+
+/*------------------------------------------------------------------*/
+
 /**\brief Add a vertex to global list of verticies*/
 
 short int add_to_Vtxlist(Vertex V, List_vtx_glob *L, List_vtx_glob *Tail)
@@ -26,6 +26,8 @@ void delete_from_leaf_list(Cart_cell, List_leaf *, List_leaf *);
 
 void delete_from_merge_list(Cart_cell, List_merge *);
 
+short int compact_leaf_list(void);
+
 short int add_to_Vtxlist(Vertex, List_vtx_glob *, List_vtx_glob *);
 
 void delete_from_Vtxlist(Vertex, List_vtx_glob *, List_vtx_glob *);
@@ -24,6 +24,7 @@
 
 #include "post_shock_flow.hh"
 #include "poshax_radiation_transport.hh"
+#include "poshax_batch.hh"
 
 using namespace std;
 
@@ -33,6 +34,8 @@ void print_usage()
     cout << "Usage poshax.x:\n";
     cout << " > poshax.x input.cfg\n";
     cout << " where input.cfg is a configuration file specifying the problem.\n";
+    cout << " If a [batch] section names a conditions_file, every condition\n";
+    cout << " in that table is computed and written to a single output file.\n";
 }
 
 int main(int argc, char *argv[])
@@ -214,6 +217,28 @@ int main(int argc, char *argv[])
         exit(BAD_INPUT_ERROR);
     }
 
+    // Batch mode: march every condition in the [batch] conditions_file
+    // instead of the single condition in [initial-conditions]
+    string conditions_file;
+    cfg.parse_string("batch", "conditions_file", conditions_file, "");
+    if ( conditions_file != "" ) {
+    	int flag = run_poshax_batch( cfg, input, gmodel, rupdate, eeupdate,
+    	                             rtmodel, coupling_str, dx, adaptive_dx,
+    	                             final_x, plot_dx, dx_max,
+    	                             species_output_type, apply_udpedx );
+    	delete gmodel;
+    	if ( rupdate ) delete rupdate;
+    	if ( eeupdate ) delete eeupdate;
+    	if ( rtmodel ) delete rtmodel;
+    	if ( flag != SUCCESS ) {
+    	    cout << "Batch mode failed." << endl
+    	         << "Bailing out!" << endl;
+    	    exit(flag);
+    	}
+    	cout << "Done.\n";
+    	return 0;
+    }
+
     // Parse the radiation output options
     double rad_dx;
     cfg.parse_double("radiation", "rad_dx", rad_dx, 0.0);
@@ -229,6 +254,22 @@ int main(int argc, char *argv[])
     	               write_rad_emissions, false );
     bool write_spectra;
     cfg.parse_boolean("radiation", "write_spectra", write_spectra, false );
+    bool TS_streaming;
+    cfg.parse_boolean("radiation", "TS_streaming", TS_streaming, false );
+    string TS_binning;
+    cfg.parse_string("radiation", "TS_binning", TS_binning, "none" );
+    int TS_binning_type = NO_BINNING;
+    if ( TS_binning=="none" ) TS_binning_type = NO_BINNING;
+    else if ( TS_binning=="frequency" ) TS_binning_type = FREQUENCY_BINNING;
+    else if ( TS_binning=="opacity" ) TS_binning_type = OPACITY_BINNING;
+    else {
+    	cout << "TS_binning: " << TS_binning << " not recognised." << endl
+    	     << "The available options are 'none', 'frequency' or 'opacity'" << endl
+    	     << "Bailing out!" << endl;
+    	exit(BAD_INPUT_ERROR);
+    }
+    int TS_N_bins;
+    cfg.parse_int("radiation", "TS_N_bins", TS_N_bins, 100 );
     vector<double> vdnf;
     vector<double> lambda_min;
     cfg.parse_vector_of_doubles("radiation", "lambda_min", lambda_min, vdnf);
@@ -444,11 +485,20 @@ int main(int argc, char *argv[])
     vector<double> rad_x;
     RadiationSpectralModel * rsm = 0;
     TS_data * TS = 0;
+    StreamingTS_data * STS = 0;
     vector<double> divq_rad;
     if ( rad_dx > 0.0 || TS_dx > 0.0 ) {
     	rsm = rtmodel->get_rsm_pointer();
     }
-    if ( TS_dx > 0.0 ) {
+    if ( TS_dx > 0.0 && TS_streaming ) {
+    	if ( TS_binning_type==NO_BINNING )
+    	    cout << "init StreamingTS_data without binning" << endl;
+    	else
+    	    cout << "init StreamingTS_data with " << TS_N_bins << " " << TS_binning
+    	         << " bins" << endl;
+    	STS = new StreamingTS_data( rsm, 0.0, 0.0, TS_binning_type, TS_N_bins );
+    }
+    else if ( TS_dx > 0.0 ) {
     	int nTS = int(final_x/TS_dx)+1;
     	cout << "init TS_data with nn = " << nTS << endl;
     	TS = new TS_data( rsm, nTS );
@@ -490,8 +540,12 @@ int main(int argc, char *argv[])
     if ( TS_dx > 0 ) {
 	// tangent slab problem - create first shock point 
 	cout << "creating TS point " << TS_count << " at x = " << 0;
-	double j_total = TS->set_rad_point( TS_count, psr->psflow.Q,
-	                                    &(divq_rad[TS_count]), 0.0, TS_dx );
+	double j_total = 0.0;
+	if ( STS )
+	    j_total = STS->add_slab( psr->psflow.Q, 0.0, TS_dx );
+	else
+	    j_total = TS->set_rad_point( TS_count, psr->psflow.Q,
+	                                 &(divq_rad[TS_count]), 0.0, TS_dx );
 	cout << ", j_total = " << j_total << " W/m3-sr" << endl;
 	TS_count += 1;
     }
@@ -566,8 +620,12 @@ int main(int argc, char *argv[])
 	if ( next_TS_x > 0.0 && x > next_TS_x ) {
 	    // tangent slab problem
 	    cout << "creating TS point " << TS_count << " at x = " << x;
-	    double j_total = TS->set_rad_point( TS_count, psr->psflow.Q,
-	                                      &(divq_rad[TS_count]), x, TS_dx );
+	    double j_total = 0.0;
+	    if ( STS )
+	    	j_total = STS->add_slab( psr->psflow.Q, x, TS_dx );
+	    else
+	    	j_total = TS->set_rad_point( TS_count, psr->psflow.Q,
+	                                     &(divq_rad[TS_count]), x, TS_dx );
 	    cout << ", j_total = " << j_total << " W/m3-sr" << endl;
 	    next_TS_x += TS_dx;
 	    TS_count += 1;
@@ -613,7 +671,26 @@ int main(int argc, char *argv[])
     	}
 
     }
-    if ( TS_dx > 0.0 ) {
+    if ( STS ) {
+    	double q_rad = STS->finalise();
+    	cout << "Tangent slab flux q_rad = " << q_rad*1.0e-4 << " W/cm**2\n";
+    	cout << "Tangent slab flux escaping through the shock = "
+    	     << STS->q_shock_*1.0e-4 << " W/cm**2\n";
+    	ofstream TS_outfile;
+    	TS_outfile.open( "TS_divq.txt" );
+    	TS_outfile << "# Column 1: x location (m)" << endl;
+    	TS_outfile << "# Column 2: divq_rad (W/m**3)" << endl;
+    	TS_outfile << "# Column 3: - 4pi * j_total (W/m**3)" << endl;
+	TS_outfile << setprecision(6) << showpoint;
+	for ( int iTS=0; iTS<STS->get_nslabs(); ++iTS ) {
+	    TS_outfile << setw(20) << STS->s_[iTS] << setw(20)
+	               << STS->divq_[iTS] << setw(20)
+	               << - 4.0 * M_PI * STS->j_total_[iTS] << endl;
+	}
+	TS_outfile.close();
+	STS->F_->write_to_file( "TS_wall_flux_spectra.txt" );
+    }
+    else if ( TS_dx > 0.0 ) {
     	double q_rad = TS->quick_solve_for_divq();
     	cout << "Tangent slab flux q_rad = " << q_rad*1.0e-4 << " W/cm**2\n";
     	ofstream TS_outfile;
@@ -643,6 +720,7 @@ int main(int argc, char *argv[])
     	emissions_outfile.close();
     }
     if ( TS ) delete TS;
+    if ( STS ) delete STS;
 
     if ( write_reaction_rates )
         reaction_rates_outfile.close();
@@ -0,0 +1,274 @@
+/** \file poshax_batch.cxx
+ *
+ *  \brief Definitions for running poshax over a table of freestream conditions.
+ *
+ *  The gas, reaction, energy-exchange and radiation models are constructed
+ *  once for each worker thread (they carry their own working storage)
+ *  and then reused for every condition that the thread marches.
+ *
+ **/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_thread_num() 0
+#define omp_get_max_threads() 1
+#endif
+
+#include "../../../lib/util/source/useful.h"
+
+#include "post_shock_flow.hh"
+#include "poshax_batch.hh"
+
+using namespace std;
+
+Shock_condition::
+Shock_condition()
+ : u_inf( 0.0 ), p_inf( 0.0 ) {}
+
+Shock_condition::
+~Shock_condition() {}
+
+int read_shock_conditions( const string fname, Gas_model * gmodel,
+			   const string composition_type,
+			   vector<Shock_condition> &conditions )
+{
+    ifstream infile( fname.c_str() );
+    if ( infile.fail() ) {
+	cout << "read_shock_conditions():" << endl
+	     << "Error opening file: " << fname << endl;
+	return FILE_ERROR;
+    }
+
+    int nsp = gmodel->get_number_of_species();
+    int ntm = gmodel->get_number_of_modes();
+
+    // Each non-comment line has the columns:
+    // u_inf p_inf T_inf[0] ... T_inf[ntm-1] f[0] ... f[nsp-1]
+    // where f is either the mass or mole fractions.
+    string line;
+    int line_no = 0;
+    while ( getline( infile, line ) ) {
+	++line_no;
+	size_t first = line.find_first_not_of( " \t\r" );
+	if ( first == string::npos || line[first] == '#' ) continue;
+	istringstream iss( line );
+	Shock_condition c;
+	c.T_inf.resize( ntm );
+	vector<double> f( nsp );
+	iss >> c.u_inf >> c.p_inf;
+	for ( int itm=0; itm<ntm; ++itm ) iss >> c.T_inf[itm];
+	for ( int isp=0; isp<nsp; ++isp ) iss >> f[isp];
+	if ( iss.fail() ) {
+	    cout << "read_shock_conditions():" << endl
+		 << "Line " << line_no << " of " << fname << " should have "
+		 << 2 + ntm + nsp << " columns: u_inf p_inf T_inf[" << ntm
+		 << "] " << composition_type << "[" << nsp << "]" << endl;
+	    return BAD_INPUT_ERROR;
+	}
+	if ( composition_type == "molef" ) {
+	    // convert mole fractions to mass fractions
+	    double MW = 0.0;
+	    for ( int isp=0; isp<nsp; ++isp )
+		MW += f[isp] * gmodel->molecular_weight(isp);
+	    for ( int isp=0; isp<nsp; ++isp )
+		f[isp] *= gmodel->molecular_weight(isp) / MW;
+	}
+	scale_mass_fractions( f );
+	c.massf_inf = f;
+	conditions.push_back( c );
+    }
+    infile.close();
+
+    return SUCCESS;
+}
+
+int run_poshax_batch( ConfigParser &cfg, const string input,
+		      Gas_model * gmodel, Reaction_update * rupdate,
+		      Energy_exchange_update * eeupdate,
+		      PoshaxRadiationTransportModel * rtmodel,
+		      const string coupling_str, double dx, bool adaptive_dx,
+		      double final_x, double plot_dx, double dx_max,
+		      const string species_output_type, bool apply_udpedx )
+{
+    string conditions_file;
+    cfg.parse_string( "batch", "conditions_file", conditions_file, "" );
+
+    string composition_type;
+    cfg.parse_string( "batch", "composition", composition_type, "massf" );
+    if ( composition_type != "massf" && composition_type != "molef" ) {
+	cout << "Error reading composition in [batch] section of " << input
+	     << endl
+	     << "The available options are 'massf' or 'molef'" << endl;
+	return BAD_INPUT_ERROR;
+    }
+
+    string output_file_name;
+    cfg.parse_string( "batch", "output_file", output_file_name,
+		      "poshax_batch.data" );
+
+    int nthreads;
+    cfg.parse_int( "batch", "nthreads", nthreads, 0 );
+    if ( nthreads < 1 ) nthreads = omp_get_max_threads();
+
+    if ( coupling_str != "loose" && coupling_str != "full" ) {
+	cout << "Source term coupling model: " << coupling_str
+	     << " not recognised." << endl
+	     << "The available options are 'full' or 'loose' coupling\n";
+	return BAD_INPUT_ERROR;
+    }
+
+    vector<Shock_condition> conditions;
+    int flag = read_shock_conditions( conditions_file, gmodel,
+				      composition_type, conditions );
+    if ( flag != SUCCESS ) return flag;
+    int nconds = (int) conditions.size();
+    if ( nthreads > nconds ) nthreads = nconds > 0 ? nconds : 1;
+    cout << "Batch mode: " << nconds << " conditions from " << conditions_file
+	 << " using " << nthreads << " thread(s)." << endl;
+
+    // 1. One set of models per thread.  The models passed in are used
+    //    by the first thread, the remainder are created from the same files.
+    string gas_model_file, reaction_file, energy_exchange_file, radiation_file;
+    cfg.parse_string( "models", "gas_model_file", gas_model_file, "no-gas-model" );
+    cfg.parse_string( "models", "reaction_file", reaction_file, "no-reactions" );
+    cfg.parse_string( "models", "energy_exchange_file", energy_exchange_file,
+		      "no-energy-exchange" );
+    cfg.parse_string( "models", "radiation_file", radiation_file, "no-radiation" );
+
+    vector<Gas_model*> gm( nthreads, gmodel );
+    vector<Reaction_update*> ru( nthreads, rupdate );
+    vector<Energy_exchange_update*> eeu( nthreads, eeupdate );
+    vector<PoshaxRadiationTransportModel*> rtm( nthreads, rtmodel );
+    for ( int ithread=1; ithread<nthreads; ++ithread ) {
+	gm[ithread] = create_gas_model( gas_model_file );
+	if ( rupdate )
+	    ru[ithread] = create_Reaction_update( reaction_file, *gm[ithread] );
+	if ( eeupdate )
+	    eeu[ithread] = create_Energy_exchange_update( energy_exchange_file,
+							  *gm[ithread] );
+	if ( rtmodel )
+	    rtm[ithread] = create_poshax_radiation_transport_model( radiation_file );
+    }
+
+    // 2. Prepare the single columnar output file
+    ofstream outfile;
+    outfile.open( output_file_name.c_str() );
+    if ( outfile.fail() ) {
+	cout << "Error opening file: " << output_file_name << endl;
+	return FILE_ERROR;
+    }
+    int nsp = gmodel->get_number_of_species();
+    int ntm = gmodel->get_number_of_modes();
+    outfile << "# " << output_file_name << endl;
+    outfile << "# Columns:\n";
+    int col = 1;
+    outfile << "# " << col << ": condition index (row in " << conditions_file << ")\n";
+    ++col;
+    outfile << "# " << col << ": x (m)\n";
+    ++col;
+    for ( int itm=0; itm<ntm; ++itm ) {
+	outfile << "# " << col << ": T[" << itm << "] (K)\n";
+	++col;
+    }
+    outfile << "# " << col << ": p (Pa)\n";
+    ++col;
+    outfile << "# " << col << ": rho (kg/m^3)\n";
+    ++col;
+    outfile << "# " << col << ": u (m/s)\n";
+    ++col;
+    string species_label = "massf";
+    if ( species_output_type == "molef" || species_output_type == "moles" )
+	species_label = species_output_type;
+    for ( int isp=0; isp<nsp; ++isp ) {
+	outfile << "# " << col << ": " << species_label << "[" << isp << "]-"
+		<< gmodel->species_name(isp) << "\n";
+	++col;
+    }
+    if ( rtmodel ) {
+	outfile << "# " << col << ": Q_rad (W/m**3)\n";
+	++col;
+    }
+
+    // 3. March each condition.  The rows for one condition are buffered
+    //    and written in one go so that the file lock is taken once per condition.
+    int icond;
+#   ifdef _OPENMP
+#   pragma omp parallel for private(icond) schedule(dynamic) num_threads(nthreads)
+#   endif
+    for ( icond=0; icond<nconds; ++icond ) {
+	int ithread = omp_get_thread_num();
+	Gas_model * g = gm[ithread];
+	Shock_condition &c = conditions[icond];
+
+	Gas_data Q(g);
+	Q.T = c.T_inf;
+	Q.massf = c.massf_inf;
+	Q.p = c.p_inf;
+	g->eval_thermo_state_pT(Q);
+	Flow_state initial_condition( Q, c.u_inf );
+
+	Post_shock_flow * psr = 0;
+	if ( coupling_str=="loose" )
+	    psr = new Loosely_coupled_post_shock_flow( initial_condition, g,
+						       ru[ithread], eeu[ithread],
+						       rtm[ithread], apply_udpedx );
+	else
+	    psr = new Fully_coupled_post_shock_flow( initial_condition, g,
+						     ru[ithread], eeu[ithread],
+						     rtm[ithread], apply_udpedx );
+
+	ostringstream rows;
+	rows << setprecision(12) << showpoint;
+	double x = 0.0, new_dx, next_plot_x = 0.0;
+	double dx_c = dx;
+	int count = 0;
+	rows << setw(8) << icond << setw(20) << x
+	     << psr->psflow.str(bool(rtmodel), species_output_type, g->M()) << endl;
+	while( x < final_x ) {
+	    new_dx = psr->increment_in_space(x, dx_c);
+	    x = x + dx_c;
+	    if ( adaptive_dx ) dx_c = min( new_dx, dx_max );
+	    count++;
+	    if( x > next_plot_x ) {
+		rows << setw(8) << icond << setw(20) << x
+		     << psr->psflow.str(bool(rtmodel), species_output_type, g->M()) << endl;
+		next_plot_x += plot_dx;
+	    }
+	}
+
+#       ifdef _OPENMP
+#       pragma omp critical
+#       endif
+	{
+	    outfile << rows.str();
+	    cout << "condition " << setw(6) << icond << " :: "
+		 << "u_inf = " << setw(12) << c.u_inf << ' '
+		 << "p_inf = " << setw(12) << c.p_inf << ' '
+		 << "steps = " << setw(8) << count << ' '
+		 << "T_f[0] = " << setw(12) << psr->psflow.Q->T[0] << endl;
+	}
+	delete psr;
+    }
+
+    outfile.close();
+
+    for ( int ithread=1; ithread<nthreads; ++ithread ) {
+	if ( rtm[ithread] ) delete rtm[ithread];
+	if ( eeu[ithread] ) delete eeu[ithread];
+	if ( ru[ithread] ) delete ru[ithread];
+	delete gm[ithread];
+    }
+
+    cout << "Data created in: " << output_file_name << endl;
+
+    return SUCCESS;
+}
@@ -0,0 +1,44 @@
+/** \file poshax_batch.hh
+ *
+ *  \brief Declarations for running poshax over a table of freestream conditions.
+ *
+ **/
+
+#ifndef POSHAX_BATCH_HH
+#define POSHAX_BATCH_HH
+
+#include <string>
+#include <vector>
+
+#include "../../../lib/util/source/config_parser.hh"
+#include "../../../lib/gas/models/gas-model.hh"
+#include "../../../lib/gas/kinetics/reaction-update.hh"
+#include "../../../lib/gas/kinetics/energy-exchange-update.hh"
+
+#include "poshax_radiation_transport.hh"
+
+class Shock_condition {
+public:
+    Shock_condition();
+    ~Shock_condition();
+
+public:
+    double u_inf;
+    double p_inf;
+    std::vector<double> T_inf;
+    std::vector<double> massf_inf;
+};
+
+int read_shock_conditions( const std::string fname, Gas_model * gmodel,
+			   const std::string composition_type,
+			   std::vector<Shock_condition> &conditions );
+
+int run_poshax_batch( ConfigParser &cfg, const std::string input,
+		      Gas_model * gmodel, Reaction_update * rupdate,
+		      Energy_exchange_update * eeupdate,
+		      PoshaxRadiationTransportModel * rtmodel,
+		      const std::string coupling_str, double dx, bool adaptive_dx,
+		      double final_x, double plot_dx, double dx_max,
+		      const std::string species_output_type, bool apply_udpedx );
+
+#endif
@@ -445,6 +445,24 @@ SolidBlock* initialise_block(std::string fname){
 
 		
 		
+		//Implicit update controls
+		if (line[0] == "implicit_flag"){
+		    if ( !(line[1] == "1") && !(line[1]== "0" ) ){
+			std::cout << "wallcon: Set \"implicit_flag 0\" or \"implicit_flag 1\"."<<std::endl;
+			exit(1);
+		    }
+		    block->implicit_flag = atoi( line[1].c_str() );
+		}
+		if (line[0] == "implicit_max_iterations"){
+		    block->implicit_max_iterations = atoi( line[1].c_str() );
+		}
+		if (line[0] == "implicit_line_sweeps"){
+		    block->implicit_line_sweeps = atoi( line[1].c_str() );
+		}
+		if (line[0] == "implicit_tolerance"){
+		    block->implicit_tolerance = atof( line[1].c_str() );
+		}
+
 		//Get materials
 		if (line[0] == "k"){
 		    block->k = atof( line[1].c_str() );
@@ -818,6 +836,10 @@ int initialise_stand_alone(Wall_model &wall, std::string fname){
 			wall.update_scheme = 1;
 			continue;
 		    }
+		    else if (line[1] == "implicit" || line[1] == "backward_euler" || line[1] == "backward-euler"){
+			wall.update_scheme = 2;
+			continue;
+		    }
 		    else{
 			std::cout << "Wallcon: unrecognised update scheme" << std::endl;
 			exit(1);
@@ -8,7 +8,8 @@ using namespace std;
 
 SolidBlock::SolidBlock()
     :anisotropic_flag(0), time_varying_terms_flag(0),time_varying_iteration(0),
-     e3connection_type_flag(4,0)
+     implicit_flag(0), implicit_max_iterations(20), implicit_line_sweeps(2),
+     implicit_tolerance(1.0e-8), e3connection_type_flag(4,0)
      
 {}
 
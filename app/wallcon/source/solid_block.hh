@@ -23,6 +23,12 @@ public: //public access permission
     std::string time_varying_terms_dir;
     int time_varying_iteration;
 
+    //Implicit (backward Euler) update controls
+    int implicit_flag; //1 forces the implicit update whatever scheme is requested
+    int implicit_max_iterations;
+    int implicit_line_sweeps;
+    double implicit_tolerance;
+
     std::vector< std::vector<Solid_FV_Cell> > block_cells; // cells in block
     std::vector< std::vector<Solid_FV_Interface> > block_iface_i; //ifaces with eastward normals
     std::vector< std::vector<Solid_FV_Interface> > block_iface_j; //ifaces with northward normals
@@ -52,7 +58,9 @@ public: //public access permission
     void OLD_update_boundary_conditions();
     void update_boundary_conditions();
     void update_cell_energy_derivative();
+    void evaluate_energy_derivative();
     void time_update(double &dt, int update_scheme);
+    int implicit_time_update(double &dt);
     
 };
 
@@ -4,6 +4,8 @@
 #include "solid_block.hh"
 #include "solid_bc.hh"
 #include <cstdlib>
+#include <cmath>
+#include <iostream>
 
 
 //Use boundary conditions and cell temps to get fluxes
@@ -260,9 +262,23 @@ void SolidBlock::update_cell_energy_derivative(){
     }
 }
 
+void SolidBlock::evaluate_energy_derivative(){
+    //Full spatial update from the current cell temperatures
+    this->update_boundary_conditions();
+    this->update_boundary_secondary_interface_temperatures();
+    this->update_internal_secondary_interface_temperatures();
+    this->update_vertex_derivatives();
+    this->update_interface_fluxes();
+    this->update_cell_energy_derivative();
+}
+
 void SolidBlock::time_update(double &dt, int update_scheme){
     //dondt e = sum fluxes . n * dS
     //flux in is positive => if  q.n < 0 inwards if q.n>0 outwards
+
+    //An implicit update requested in the block definition takes precedence
+    //over the scheme passed in (Eilmer sets it from the gas-dynamic scheme).
+    if (implicit_flag == 1) update_scheme = 2;
     
     if (update_scheme == 0){ //Euler
 	// std::cout << "Wallcon update is Euler" << std::endl;
@@ -282,12 +298,7 @@ void SolidBlock::time_update(double &dt, int update_scheme){
 		block_cells[i][j].one_stage_update(dt); 
 	    }
         }
-	this->update_boundary_conditions();
-        this->update_boundary_secondary_interface_temperatures();
-        this->update_internal_secondary_interface_temperatures();
-        this->update_vertex_derivatives();
-        this->update_interface_fluxes();
-        this->update_cell_energy_derivative();
+	this->evaluate_energy_derivative();
 	for (int j=0; j<(nnj-1); j++){
 	    for (int i=0; i<(nni-1); i++){	
 		block_cells[i][j].two_stage_update(dt); 
@@ -295,9 +306,161 @@ void SolidBlock::time_update(double &dt, int update_scheme){
         }
 
 	
+    }
+    else if (update_scheme == 2){ //Backward Euler
+	this->implicit_time_update(dt);
     }
     else{
 	std::cout<<"Something went wrong in SolidBlock::time_update()" << std::endl;
     }
 }
 
+//Thomas algorithm for a[n]*x[n-1] + b[n]*x[n] + c[n]*x[n+1] = d[n]
+//b and d are overwritten.
+static void solve_tridiagonal(const std::vector<double> &a, std::vector<double> &b,
+			      const std::vector<double> &c, std::vector<double> &d,
+			      std::vector<double> &x, int n){
+    for (int m=1; m<n; m++){
+	double w = a[m]/b[m-1];
+	b[m] -= w*c[m-1];
+	d[m] -= w*d[m-1];
+    }
+    x[n-1] = d[n-1]/b[n-1];
+    for (int m=n-2; m>=0; m--){
+	x[m] = (d[m] - c[m]*x[m+1])/b[m];
+    }
+}
+
+//Backward Euler update  rho*cp*(T - T0)/dt = deondt(T)
+//The full spatial operator, with whatever boundary conditions are set, is kept on
+//the right hand side and Newton corrections are solved with its Jacobian.
+//The operator couples each cell to its 3x3 neighbourhood (vertex gradients), so the
+//Jacobian is found by perturbing the cells in nine interleaved groups; this also
+//picks up the sensitivity of each boundary condition without knowing its type.
+//The correction equations are relaxed by alternating tridiagonal sweeps along
+//i lines and j lines, with the diagonal neighbours lagged.
+//Expects deondt to have been evaluated at the current temperatures (as for the
+//explicit schemes). Returns the number of Newton iterations used.
+int SolidBlock::implicit_time_update(double &dt){
+    int nci = nni-1;
+    int ncj = nnj-1;
+
+    //1. Jacobian  J[i][j][3*(di+1)+(dj+1)] = d(deondt[i][j])/dT[i+di][j+dj]
+    std::vector< std::vector<double> > T0(nci, std::vector<double>(ncj, 0.0));
+    std::vector< std::vector<double> > R0(nci, std::vector<double>(ncj, 0.0));
+    std::vector< std::vector< std::vector<double> > > J(nci,
+	std::vector< std::vector<double> >(ncj, std::vector<double>(9, 0.0)));
+    double T_max = 0.0;
+    for (int j=0; j<ncj; j++){
+	for (int i=0; i<nci; i++){
+	    T0[i][j] = block_cells[i][j].T;
+	    R0[i][j] = block_cells[i][j].deondt;
+	    if (fabs(T0[i][j]) > T_max) T_max = fabs(T0[i][j]);
+	}
+    }
+    double dT_pert = 1.0e-6 * T_max + 1.0e-8;
+    for (int ci=0; ci<3; ci++){
+	for (int cj=0; cj<3; cj++){
+	    for (int j=0; j<ncj; j++){
+		for (int i=0; i<nci; i++){
+		    if (i%3 == ci && j%3 == cj) block_cells[i][j].T = T0[i][j] + dT_pert;
+		}
+	    }
+	    this->evaluate_energy_derivative();
+	    for (int j=0; j<ncj; j++){
+		for (int i=0; i<nci; i++){
+		    //The one perturbed cell within the 3x3 neighbourhood of [i][j]
+		    int di = ((ci - i%3) + 4) % 3 - 1;
+		    int dj = ((cj - j%3) + 4) % 3 - 1;
+		    if (i+di < 0 || i+di >= nci || j+dj < 0 || j+dj >= ncj) continue;
+		    J[i][j][3*(di+1)+(dj+1)] = (block_cells[i][j].deondt - R0[i][j]) / dT_pert;
+		}
+	    }
+	    for (int j=0; j<ncj; j++){
+		for (int i=0; i<nci; i++){
+		    block_cells[i][j].T = T0[i][j];
+		}
+	    }
+	}
+    }
+    for (int j=0; j<ncj; j++){
+	for (int i=0; i<nci; i++){
+	    block_cells[i][j].deondt = R0[i][j];
+	}
+    }
+
+    //2. Newton iterations.
+    std::vector< std::vector<double> > res(nci, std::vector<double>(ncj, 0.0));
+    std::vector< std::vector<double> > dT(nci, std::vector<double>(ncj, 0.0));
+    int nmax = (nci > ncj) ? nci : ncj;
+    std::vector<double> ta(nmax), tb(nmax), tc(nmax), td(nmax), tx(nmax);
+    int iter;
+    double dT_max = 0.0;
+    for (iter=1; iter<=implicit_max_iterations; iter++){
+	for (int j=0; j<ncj; j++){
+	    for (int i=0; i<nci; i++){
+		Solid_FV_Cell &c = block_cells[i][j];
+		res[i][j] = c.deondt - c.rho * c.cp * (c.T - T0[i][j]) / dt;
+		dT[i][j] = 0.0;
+	    }
+	}
+	//(rho*cp/dt - J) dT = res
+	for (int sweep=0; sweep<implicit_line_sweeps; sweep++){
+	    //i lines
+	    for (int j=0; j<ncj; j++){
+		for (int i=0; i<nci; i++){
+		    std::vector<double> &Jc = J[i][j];
+		    ta[i] = -Jc[1];
+		    tb[i] = block_cells[i][j].rho * block_cells[i][j].cp / dt - Jc[4];
+		    tc[i] = -Jc[7];
+		    td[i] = res[i][j];
+		    for (int dj=-1; dj<=1; dj+=2){
+			if (j+dj < 0 || j+dj >= ncj) continue;
+			for (int di=-1; di<=1; di++){
+			    if (i+di < 0 || i+di >= nci) continue;
+			    td[i] += Jc[3*(di+1)+(dj+1)] * dT[i+di][j+dj];
+			}
+		    }
+		}
+		solve_tridiagonal(ta, tb, tc, td, tx, nci);
+		for (int i=0; i<nci; i++) dT[i][j] = tx[i];
+	    }
+	    //j lines
+	    for (int i=0; i<nci; i++){
+		for (int j=0; j<ncj; j++){
+		    std::vector<double> &Jc = J[i][j];
+		    ta[j] = -Jc[3];
+		    tb[j] = block_cells[i][j].rho * block_cells[i][j].cp / dt - Jc[4];
+		    tc[j] = -Jc[5];
+		    td[j] = res[i][j];
+		    for (int di=-1; di<=1; di+=2){
+			if (i+di < 0 || i+di >= nci) continue;
+			for (int dj=-1; dj<=1; dj++){
+			    if (j+dj < 0 || j+dj >= ncj) continue;
+			    td[j] += Jc[3*(di+1)+(dj+1)] * dT[i+di][j+dj];
+			}
+		    }
+		}
+		solve_tridiagonal(ta, tb, tc, td, tx, ncj);
+		for (int j=0; j<ncj; j++) dT[i][j] = tx[j];
+	    }
+	}
+	dT_max = 0.0;
+	for (int j=0; j<ncj; j++){
+	    for (int i=0; i<nci; i++){
+		Solid_FV_Cell &c = block_cells[i][j];
+		c.T += dT[i][j];
+		c.e = c.rho * c.cp * c.T;
+		if (fabs(dT[i][j]) > dT_max) dT_max = fabs(dT[i][j]);
+	    }
+	}
+	if (dT_max <= implicit_tolerance * T_max) break;
+	this->evaluate_energy_derivative();
+    }
+    if (iter > implicit_max_iterations){
+	std::cout << "Wallcon: implicit update did not converge in " << implicit_max_iterations
+		  << " iterations, max dT = " << dT_max << std::endl;
+	iter = implicit_max_iterations;
+    }
+    return iter;
+}
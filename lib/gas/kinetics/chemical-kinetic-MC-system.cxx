@@ -23,7 +23,7 @@ using namespace std;
 Chemical_kinetic_MC_system::
 Chemical_kinetic_MC_system(lua_State *L, Gas_model &g, int nreac, double error_tol,
 			   double T_upper, double T_lower)
-    : OdeSystem(2*nreac, true), err_tol_(error_tol)
+    : OdeSystem(2*nreac, true), rate_table_(0), err_tol_(error_tol)
 {
     lua_getglobal(L, "reactions");
     if ( !lua_istable(L, -1) ) {
@@ -85,11 +85,13 @@ Chemical_kinetic_MC_system(lua_State *L, Gas_model &g, int nreac, double error_t
     massf_.resize(nsp, 0.0);
     M_.resize(nsp, 0.0);
     for ( size_t isp = 0; isp < M_.size(); ++isp ) M_[isp] = g.molecular_weight(isp);
+
+    rate_table_ = create_Rate_coefficient_table(L, reaction_, g);
 }
 
 Chemical_kinetic_MC_system::
 Chemical_kinetic_MC_system(string cfile, Gas_model &g, int nreac)
-    : OdeSystem(2*nreac, true)
+    : OdeSystem(2*nreac, true), rate_table_(0)
 {
     // Do some pre-work on the cfile to massage
     // it into a state to be parsed for the
@@ -202,6 +204,8 @@ Chemical_kinetic_MC_system(string cfile, Gas_model &g, int nreac)
     massf_.resize(nsp, 0.0);
     M_.resize(nsp, 0.0);
     for ( size_t isp = 0; isp < M_.size(); ++isp ) M_[isp] = g.molecular_weight(isp);
+
+    rate_table_ = create_Rate_coefficient_table(L, reaction_, g);
     
     lua_close(L);
 }
@@ -212,6 +216,7 @@ Chemical_kinetic_MC_system::
     for ( size_t i = 0; i < reaction_.size(); ++i ) {
 	delete reaction_[i];
     }
+    delete rate_table_;
     
     for ( size_t i = 0; i < spec_.size(); ++i ) {
 	delete spec_[i];
@@ -228,14 +233,12 @@ eval(const vector<double> &y, vector<double> &ydot)
 {
     // Firstly compute the rate coefficients
     if ( ! called_at_least_once ) {
-	for ( size_t ir = 0; ir < reaction_.size(); ++ir ) {
-	    if ( reaction_[ir]->compute_kf_first() ) {
-		reaction_[ir]->compute_k_f(*Q_);
-		reaction_[ir]->compute_k_b(*Q_);
-	    }
-	    else {
-		reaction_[ir]->compute_k_b(*Q_);
-		reaction_[ir]->compute_k_f(*Q_);
+	if ( rate_table_ ) {
+	    rate_table_->compute_rate_coefficients(*Q_, reaction_);
+	}
+	else {
+	    for ( size_t ir = 0; ir < reaction_.size(); ++ir ) {
+		reaction_[ir]->compute_rate_coefficients(*Q_);
 	    }
 	}
 	called_at_least_once = true;
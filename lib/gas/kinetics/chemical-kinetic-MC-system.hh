@@ -17,6 +17,7 @@ extern "C" {
 #include "../models/gas_data.hh"
 #include "../models/gas-model.hh"
 #include "reaction.hh"
+#include "rate-coefficient-table.hh"
 #include "species-pieces.hh"
 #include "chemistry-energy-coupling.hh"
 
@@ -58,6 +59,8 @@ public:
 private:
     // A list of Reactions making up the reaction scheme
     std::vector<Reaction*> reaction_;
+    // Optional tables of the rate coefficients (0 if not used)
+    Rate_coefficient_table *rate_table_;
     double err_tol_;
     // A ragged array of integers. The list corresponds
     // to the number of species.  Each entry in the list
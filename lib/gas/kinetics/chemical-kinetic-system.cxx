@@ -13,7 +13,7 @@ using namespace std;
 
 Chemical_kinetic_system::
 Chemical_kinetic_system(lua_State *L, Gas_model &g, double error_tol, double T_upper, double T_lower)
-    : OdeSystem(g.get_number_of_species(), true), err_tol_(error_tol)
+    : OdeSystem(g.get_number_of_species(), true), rate_table_(0), err_tol_(error_tol)
 {
     lua_getglobal(L, "reactions");
     if ( !lua_istable(L, -1) ) {
@@ -46,11 +46,13 @@ Chemical_kinetic_system(lua_State *L, Gas_model &g, double error_tol, double T_u
     massf_.resize(nsp, 0.0);
     M_.resize(nsp, 0.0);
     for ( size_t isp = 0; isp < M_.size(); ++isp ) M_[isp] = g.molecular_weight(isp);
+
+    rate_table_ = create_Rate_coefficient_table(L, reaction_, g);
 }
 
 Chemical_kinetic_system::
 Chemical_kinetic_system(string cfile, Gas_model &g)
-    : OdeSystem(g.get_number_of_species(), true)
+    : OdeSystem(g.get_number_of_species(), true), rate_table_(0)
 {
     // Do some pre-work on the cfile to massage
     // it into a state to be parsed for the
@@ -143,6 +145,8 @@ Chemical_kinetic_system(string cfile, Gas_model &g)
     massf_.resize(nsp, 0.0);
     M_.resize(nsp, 0.0);
     for ( size_t isp = 0; isp < M_.size(); ++isp ) M_[isp] = g.molecular_weight(isp);
+
+    rate_table_ = create_Rate_coefficient_table(L, reaction_, g);
     
     lua_close(L);
 }
@@ -153,6 +157,7 @@ Chemical_kinetic_system::
     for ( size_t i = 0; i < reaction_.size(); ++i ) {
 	delete reaction_[i];
     }
+    delete rate_table_;
 }
 
 int
@@ -175,16 +180,14 @@ eval_split(const vector<double> &y,
 	   vector<double> &q, vector<double> &L)
 {
     if ( ! called_at_least_once ) {
-	for ( size_t ir = 0; ir < reaction_.size(); ++ir ) {
-	    if ( reaction_[ir]->compute_kf_first() ) {
-		reaction_[ir]->compute_k_f(*Q_);
-		reaction_[ir]->compute_k_b(*Q_);
-	    }
-	    else {
-		reaction_[ir]->compute_k_b(*Q_);
-		reaction_[ir]->compute_k_f(*Q_);
+	if ( rate_table_ ) {
+	    rate_table_->compute_rate_coefficients(*Q_, reaction_);
+	}
+	else {
+	    for ( size_t ir = 0; ir < reaction_.size(); ++ir ) {
+		reaction_[ir]->compute_rate_coefficients(*Q_);
+		//printf("rxn[%i]: kf=%16.15e, kb=%16.15e\n", ir, reaction_[ir]->k_f(), reaction_[ir]->k_b());
 	    }
-	    //printf("rxn[%i]: kf=%16.15e, kb=%16.15e\n", ir, reaction_[ir]->k_f(), reaction_[ir]->k_b());
 	}
 	called_at_least_once = true;
     }
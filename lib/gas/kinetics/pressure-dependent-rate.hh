@@ -32,6 +32,8 @@ public:
 
 private:
     int s_eval(const Gas_data &Q);
+    bool s_is_function_of_T_only()
+    { return false; }
     double compute_third_body_concentration(const Gas_data &Q) { return compute_third_body_value(Q, efficiencies_, M_); }
 
     std::vector<double> M_;
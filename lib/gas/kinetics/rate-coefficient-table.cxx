@@ -0,0 +1,262 @@
+// Date: 19-Oct-2026
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <limits>
+
+#include "../../util/source/useful.h"
+#include "../../util/source/lua_service.hh"
+#include "../models/physical_constants.hh"
+#include "rate-coefficient-table.hh"
+
+using namespace std;
+
+namespace {
+    // Two tabulated values are taken as the same if they agree to
+    // this relative tolerance when deciding on the temperature
+    // dependence of a reaction.
+    const double SAME_VALUE_TOL = 1.0e-12;
+
+    bool same_value(double a, double b)
+    {
+	return fabs(a - b) <= SAME_VALUE_TOL*max(fabs(a), fabs(b));
+    }
+}
+
+Rate_coefficient_table::
+Rate_coefficient_table(vector<Reaction*> &reactions, Gas_model &g,
+		       double T_min, double T_max, int n_points)
+    : nmodes_(g.get_number_of_modes()), n_(n_points),
+      ln_T_min_(log(T_min)), ln_T_max_(log(T_max)),
+      d_ln_T_((log(T_max) - log(T_min))/(n_points - 1))
+{
+    int nr = reactions.size();
+    // With two modes every reaction is first evaluated on the
+    // full (T, Tv) grid; node = ia*n_ + ib for T[0] at ia, T[1] at ib.
+    int n_nodes = ( nmodes_ == 2 ) ? n_*n_ : n_;
+
+    vector<int> tabulate(nr);
+    for ( int ir = 0; ir < nr; ++ir ) {
+	tabulate[ir] = reactions[ir]->rate_coefficients_depend_on_T_only();
+    }
+
+    vector<vector<double> > k_f(nr), k_b(nr);
+#   ifdef _OPENMP
+#   pragma omp parallel for schedule(dynamic)
+#   endif
+    for ( int ir = 0; ir < nr; ++ir ) {
+	if ( !tabulate[ir] )
+	    continue;
+	// Each thread works on its own gas-state and its own reactions.
+	Gas_data Q(&g);
+	Q.massf[0] = 1.0;
+	Q.p = PC_P_atm;
+	k_f[ir].resize(n_nodes);
+	k_b[ir].resize(n_nodes);
+	for ( int node = 0; node < n_nodes; ++node ) {
+	    int ia = ( nmodes_ == 2 ) ? node / n_ : node;
+	    int ib = ( nmodes_ == 2 ) ? node % n_ : node;
+	    for ( int itm = 0; itm < nmodes_; ++itm ) {
+		Q.T[itm] = exp(ln_T_min_ + ( (itm == 0) ? ia : ib )*d_ln_T_);
+	    }
+	    reactions[ir]->compute_rate_coefficients(Q);
+	    k_f[ir][node] = reactions[ir]->k_f();
+	    k_b[ir][node] = reactions[ir]->k_b();
+	}
+    }
+
+    // Sort the reactions into groups by the temperatures
+    // their tabulated values actually depend on.
+    groups_.resize(( nmodes_ == 2 ) ? 3 : 1);
+    groups_[0].iT_a = 0; groups_[0].iT_b = -1;
+    if ( nmodes_ == 2 ) {
+	groups_[1].iT_a = 1; groups_[1].iT_b = -1;
+	groups_[2].iT_a = 0; groups_[2].iT_b = 1;
+    }
+    for ( int ir = 0; ir < nr; ++ir ) {
+	if ( !tabulate[ir] ) {
+	    direct_.push_back(ir);
+	    continue;
+	}
+	int ig = 0;
+	if ( nmodes_ == 2 ) {
+	    bool on_T = false, on_Tv = false;
+	    for ( int ia = 0; ia < n_; ++ia ) {
+		for ( int ib = 0; ib < n_; ++ib ) {
+		    int node = ia*n_ + ib;
+		    if ( !same_value(k_f[ir][node], k_f[ir][ia*n_]) ||
+			 !same_value(k_b[ir][node], k_b[ir][ia*n_]) )
+			on_Tv = true;
+		    if ( !same_value(k_f[ir][node], k_f[ir][ib]) ||
+			 !same_value(k_b[ir][node], k_b[ir][ib]) )
+			on_T = true;
+		}
+	    }
+	    if ( on_Tv )
+		ig = ( on_T ) ? 2 : 1;
+	}
+	groups_[ig].reactions.push_back(ir);
+    }
+
+    // Pack the log values of each group node-major so that
+    // an interpolation stencil reads a few contiguous rows.
+    for ( size_t ig = 0; ig < groups_.size(); ++ig ) {
+	Group &grp = groups_[ig];
+	int nc = 2*grp.reactions.size();
+	int ng = ( grp.iT_b < 0 ) ? n_ : n_*n_;
+	grp.zero.assign(nc, 1);
+	grp.ln_k.assign(ng*nc, 0.0);
+	for ( int j = 0; j < nc/2; ++j ) {
+	    int ir = grp.reactions[j];
+	    for ( int i = 0; i < ng; ++i ) {
+		// Map the group node back to the full evaluation grid.
+		int node = i;
+		if ( nmodes_ == 2 && grp.iT_b < 0 )
+		    node = ( grp.iT_a == 0 ) ? i*n_ : i;
+		double k[2] = { k_f[ir][node], k_b[ir][node] };
+		for ( int d = 0; d < 2; ++d ) {
+		    if ( k[d] != 0.0 )
+			grp.zero[2*j+d] = 0;
+		    // A zero in a column that is not identically zero cannot
+		    // be interpolated in log space; the NaN sends any stencil
+		    // touching it to direct evaluation.
+		    grp.ln_k[i*nc + 2*j + d] = ( k[d] > 0.0 ) ? log(k[d]) :
+			numeric_limits<double>::quiet_NaN();
+		}
+	    }
+	}
+	for ( int c = 0; c < nc; ++c ) {
+	    if ( grp.zero[c] ) {
+		for ( int i = 0; i < ng; ++i ) grp.ln_k[i*nc + c] = 0.0;
+	    }
+	}
+	if ( nc > int(vals_.size()) )
+	    vals_.resize(nc);
+    }
+
+    cout << "Rate_coefficient_table: tabulated " << nr - direct_.size()
+	 << " of " << nr << " reactions on " << n_ << " points in ln T between "
+	 << T_min << " and " << T_max << " K";
+    if ( nmodes_ == 2 ) {
+	cout << " (" << groups_[0].reactions.size() << " in T[0], "
+	     << groups_[1].reactions.size() << " in T[1], "
+	     << groups_[2].reactions.size() << " in both)";
+    }
+    cout << endl;
+}
+
+Rate_coefficient_table::
+~Rate_coefficient_table() {}
+
+bool
+Rate_coefficient_table::
+stencil(double T, int &i0, double w[4]) const
+{
+    if ( !(T > 0.0) )
+	return false;
+    double x = (log(T) - ln_T_min_)/d_ln_T_;
+    if ( x < 0.0 || x > n_ - 1 )
+	return false;
+    // Cubic Lagrange interpolation on the four nodes around x
+    i0 = int(x) - 1;
+    if ( i0 < 0 ) i0 = 0;
+    if ( i0 > n_ - 4 ) i0 = n_ - 4;
+    double t = x - i0;
+    w[0] = -(t - 1.0)*(t - 2.0)*(t - 3.0)/6.0;
+    w[1] = t*(t - 2.0)*(t - 3.0)/2.0;
+    w[2] = -t*(t - 1.0)*(t - 3.0)/2.0;
+    w[3] = t*(t - 1.0)*(t - 2.0)/6.0;
+    return true;
+}
+
+void
+Rate_coefficient_table::
+evaluate_directly(const Gas_data &Q, vector<Reaction*> &reactions, const Group &grp)
+{
+    for ( size_t j = 0; j < grp.reactions.size(); ++j ) {
+	reactions[grp.reactions[j]]->compute_rate_coefficients(Q);
+    }
+}
+
+void
+Rate_coefficient_table::
+compute_rate_coefficients(const Gas_data &Q, vector<Reaction*> &reactions)
+{
+    for ( size_t ig = 0; ig < groups_.size(); ++ig ) {
+	const Group &grp = groups_[ig];
+	int nc = 2*grp.reactions.size();
+	if ( nc == 0 )
+	    continue;
+	int ia, ib = 0;
+	double wa[4], wb[4] = { 1.0, 0.0, 0.0, 0.0 };
+	if ( !stencil(Q.T[grp.iT_a], ia, wa) ||
+	     ( grp.iT_b >= 0 && !stencil(Q.T[grp.iT_b], ib, wb) ) ) {
+	    evaluate_directly(Q, reactions, grp);
+	    continue;
+	}
+	int nb = ( grp.iT_b < 0 ) ? 1 : 4;
+	int stride = ( grp.iT_b < 0 ) ? 1 : n_;
+
+	// One sweep over the stencil rows for all reactions in the group
+	double *v = &vals_[0];
+	for ( int c = 0; c < nc; ++c ) v[c] = 0.0;
+	for ( int sa = 0; sa < 4; ++sa ) {
+	    for ( int sb = 0; sb < nb; ++sb ) {
+		double w = wa[sa]*wb[sb];
+		const double *row = &grp.ln_k[((ia + sa)*stride + ib + sb)*nc];
+		for ( int c = 0; c < nc; ++c ) v[c] += w*row[c];
+	    }
+	}
+
+	for ( int j = 0; j < nc/2; ++j ) {
+	    Reaction *r = reactions[grp.reactions[j]];
+	    double k_f = ( grp.zero[2*j] ) ? 0.0 : exp(v[2*j]);
+	    double k_b = ( grp.zero[2*j+1] ) ? 0.0 : exp(v[2*j+1]);
+	    if ( isfinite(k_f) && isfinite(k_b) )
+		r->set_rate_coefficients(k_f, k_b);
+	    else
+		r->compute_rate_coefficients(Q);
+	}
+    }
+
+    for ( size_t j = 0; j < direct_.size(); ++j ) {
+	reactions[direct_[j]]->compute_rate_coefficients(Q);
+    }
+}
+
+Rate_coefficient_table* create_Rate_coefficient_table(lua_State *L, vector<Reaction*> &reactions,
+						      Gas_model &g)
+{
+    lua_getglobal(L, "scheme_t");
+    if ( !lua_istable(L, -1) ) {
+	lua_pop(L, 1);
+	return 0;
+    }
+    lua_getfield(L, -1, "rate_coefficient_tables");
+    if ( !lua_istable(L, -1) ) {
+	lua_pop(L, 2);
+	return 0;
+    }
+    double T_min = get_positive_number(L, -1, "lower");
+    double T_max = get_positive_number(L, -1, "upper");
+    int n_points = get_positive_int(L, -1, "points");
+    lua_pop(L, 2);
+
+    if ( T_max <= T_min || n_points < 4 ) {
+	ostringstream ost;
+	ost << "create_Rate_coefficient_table():\n";
+	ost << "The rate_coefficient_tables need upper > lower and at least 4 points.\n";
+	ost << "lower = " << T_min << ", upper = " << T_max << ", points = " << n_points << endl;
+	input_error(ost);
+    }
+
+    if ( g.get_number_of_modes() > 2 ) {
+	cout << "create_Rate_coefficient_table(): rate coefficient tables are only\n"
+	     << "available for gases with one or two temperatures; the "
+	     << g.get_number_of_modes() << " temperature gas will be evaluated directly." << endl;
+	return 0;
+    }
+
+    return new Rate_coefficient_table(reactions, g, T_min, T_max, n_points);
+}
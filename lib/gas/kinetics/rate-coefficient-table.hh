@@ -0,0 +1,62 @@
+// Date: 19-Oct-2026
+//
+// Tables of the forward and backward rate coefficients for
+// a whole reaction scheme, in log space on uniform grids
+// of ln T (and ln T, ln Tv for two-temperature gases).
+// Since k_b = k_f/K_eq, the equilibrium constant is folded
+// into the tabulated backward coefficients.
+
+#ifndef RATE_COEFFICIENT_TABLE_HH
+#define RATE_COEFFICIENT_TABLE_HH
+
+#include <vector>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+}
+
+#include "../models/gas_data.hh"
+#include "../models/gas-model.hh"
+#include "reaction.hh"
+
+class Rate_coefficient_table {
+public:
+    Rate_coefficient_table(std::vector<Reaction*> &reactions, Gas_model &g,
+			   double T_min, double T_max, int n_points);
+    ~Rate_coefficient_table();
+
+    // Set k_f and k_b for all reactions at the gas-state Q.
+    // Reactions that could not be tabulated, or states outside
+    // the table, are evaluated directly.
+    void compute_rate_coefficients(const Gas_data &Q, std::vector<Reaction*> &reactions);
+
+private:
+    // Reactions are grouped by the temperatures their coefficients
+    // depend on: T[0] only, T[1] only, or both.
+    struct Group {
+	int iT_a, iT_b;			// iT_b < 0 for a one-dimensional table
+	std::vector<int> reactions;
+	std::vector<char> zero;		// columns that are identically zero
+	std::vector<double> ln_k;	// [node][2*reaction + (0:k_f, 1:k_b)]
+    };
+
+    bool stencil(double T, int &i0, double w[4]) const;
+    void evaluate_directly(const Gas_data &Q, std::vector<Reaction*> &reactions,
+			   const Group &grp);
+
+private:
+    int nmodes_;
+    int n_;
+    double ln_T_min_, ln_T_max_, d_ln_T_;
+    std::vector<Group> groups_;
+    std::vector<int> direct_;		// reactions evaluated directly
+    std::vector<double> vals_;
+};
+
+// Returns 0 unless the scheme asks for rate_coefficient_tables.
+Rate_coefficient_table* create_Rate_coefficient_table(lua_State *L, std::vector<Reaction*> &reactions,
+						      Gas_model &g);
+
+#endif
@@ -31,6 +31,11 @@ public:
     std::string get_type()
     { return type_; }
 
+    // True if the coefficient depends on the gas-state
+    // only through the temperatures (so it can be tabulated)
+    bool is_function_of_T_only()
+    { return s_is_function_of_T_only(); }
+
 protected:
     double T_upper_; // Above this temperature,
                      // the rate coefficients are computed at T_upper_
@@ -40,6 +45,8 @@ protected:
     std::string type_;
     virtual int s_eval(const Gas_data &Q) = 0;
     virtual int s_eval_from_T(const double T);
+    virtual bool s_is_function_of_T_only()
+    { return true; }
 };
 
 #ifndef SWIG
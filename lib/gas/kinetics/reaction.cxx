@@ -149,6 +149,31 @@ get_nu(int isp)
 	return nu_[isp];
 }
 
+void
+Reaction::
+compute_rate_coefficients(const Gas_data &Q)
+{
+    if ( compute_kf_first_ ) {
+	compute_k_f(Q);
+	compute_k_b(Q);
+    }
+    else {
+	compute_k_b(Q);
+	compute_k_f(Q);
+    }
+}
+
+bool
+Reaction::
+rate_coefficients_depend_on_T_only()
+{
+    if ( frc_ != 0 && !frc_->is_function_of_T_only() )
+	return false;
+    if ( brc_ != 0 && !brc_->is_function_of_T_only() )
+	return false;
+    return true;
+}
+
 double
 Reaction::
 s_compute_k_f(const Gas_data &Q)
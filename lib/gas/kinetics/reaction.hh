@@ -35,6 +35,15 @@ public:
     double k_b()
     { return k_b_; }
 
+    // Compute both rate coefficients, in the order required
+    void compute_rate_coefficients(const Gas_data &Q);
+
+    // Set both rate coefficients from elsewhere (eg. a table)
+    void set_rate_coefficients(double k_f, double k_b)
+    { k_f_ = k_f; k_b_ = k_b; }
+
+    bool rate_coefficients_depend_on_T_only();
+
     void compute_forward_rate(const std::vector<double> &y)
     { w_f_ = s_compute_forward_rate(y); }
     double w_f()
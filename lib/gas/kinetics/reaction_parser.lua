@@ -153,6 +153,12 @@ local function check_scheme()
       {lower=300, upper=50000}
    scheme_t.temperature_limits.lower = scheme_t.temperature_limits.lower or 20
    scheme_t.temperature_limits.upper = scheme_t.temperature_limits.upper or 100000
+   if scheme_t.rate_coefficient_tables then
+      local t = scheme_t.rate_coefficient_tables
+      t.lower = t.lower or scheme_t.temperature_limits.lower
+      t.upper = t.upper or scheme_t.temperature_limits.upper
+      t.points = t.points or 128
+   end
 end
 
 local function check_ode()
@@ -39,6 +39,8 @@ private:
     double s_dedT_const_v(const Gas_data &Q, int &status);
     double s_dhdT_const_p(const Gas_data &Q, int &status);
     double s_gas_constant(const Gas_data &Q, int &status);
+    bool s_analytic_thermo_derivatives() const
+    { return true; }
 };
 
 Gas_model* create_LUT_plus_composite_gas_model(const std::string cfile);
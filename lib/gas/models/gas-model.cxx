@@ -153,21 +153,82 @@ atomic_constituents(int isp, map<string, int> &m)
 }
 
 #define MAX_STEPS 30
+#define MAX_WARM_STEPS 10
 #define MAX_RELATIVE_STEP 0.1
 
+// The inverse evaluations below are usually asked for a state that is
+// close to the one already held in Q (the same cell at the previous step,
+// or the previous point of an isentrope), so the density and energy found
+// in Q on entry are tried first as the starting point.  A Gas_data object
+// that has never been evaluated has rho = 0 and is given the generic
+// starting values straight away.  If the warm-started iteration fails,
+// for whatever reason, it is quietly abandoned in favour of the cold start.
+
+namespace {
+    bool usable_starting_state(const Gas_data &Q)
+    {
+	return Q.rho > 0.0 && isfinite(Q.rho) && Q.e[0] > 0.0 && isfinite(Q.e[0]);
+    }
+}
+
 int
 Gas_model::
 s_eval_thermo_state_pT(Gas_data &Q)
+{
+    double p_given = Q.p;
+    double T_given = Q.T[0];
+    if ( usable_starting_state(Q) ) {
+	if ( pT_iteration(Q, p_given, T_given, Q.rho, Q.e[0], true) == SUCCESS )
+	    return SUCCESS;
+	Q.p = p_given;
+	Q.T[0] = T_given;
+    }
+    // Get an idea of the gas properties by calling the original
+    // equation of state with some dummy values for density
+    // and internal energy.
+    return pT_iteration(Q, p_given, T_given, 1.0, 2.0e5, false);
+}
+
+double
+Gas_model::
+starting_Cv(Gas_data &Q, const char *caller, bool warm, int &status)
+{
+    // On entry, Q holds a consistent state.
+    // On exit, Q may hold a perturbed (but consistent) state.
+    status = SUCCESS;
+    if ( s_analytic_thermo_derivatives() ) {
+	int flag;
+	double Cv = dedT_const_v(Q, flag);
+	if ( flag == SUCCESS && Cv > 0.0 ) return Cv;
+    }
+    double T_old = Q.T[0];
+    double de = 0.01 * Q.e[0];
+    Q.e[0] += de;
+    if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	if ( !warm ) {
+	    cout << caller << ":\n";
+	    cout << "    Duff call to eval_thermo_state_rhoe, starting guess 0.\n";
+	    Q.print_values();
+	}
+	status = DUFF_EOS_ERROR;
+	return 0.0;
+    }
+    return de / (Q.T[0] - T_old);
+}
+
+int
+Gas_model::
+pT_iteration(Gas_data &Q, double p_given, double T_given,
+	     double rho_start, double e_start, bool warm)
 {
     double drho, rho_old, rho_new, e_old, e_new, de;
     double drho_sign, de_sign;
-    double Cv_eff, R_eff, T_old;
+    double Cv_eff, R_eff;
     double fp_old, fT_old, fp_new, fT_new;
     double dfp_drho, dfT_drho, dfp_de, dfT_de, det;
-    int converged, count;
+    int converged, count, status;
+    int max_steps = (warm ? MAX_WARM_STEPS : MAX_STEPS);
 
-    double p_given = Q.p;
-    double T_given = Q.T[0];
     // When using single-sided finite-differences on the
     // curve-fit EOS functions, we really cannot expect 
     // much more than 0.1% tolerance here.
@@ -178,25 +239,12 @@ s_eval_thermo_state_pT(Gas_data &Q)
     double fp_tol_fail = 0.02 * p_given;
     double fT_tol_fail = 0.02 * T_given;
 
-    // Get an idea of the gas properties by calling the original
-    // equation of state with some dummy values for density
-    // and internal energy.
-    Q.rho = 1.0; // kg/m**3 
-    Q.e[0] = 2.0e5; // J/kg 
-    eval_thermo_state_rhoe(Q);
-    
-    T_old = Q.T[0];
-    R_eff = Q.p / (Q.rho * T_old);
-    de = 0.01 * Q.e[0];
-    Q.e[0] += de;
-    if( eval_thermo_state_rhoe(Q) != SUCCESS ) {
-	cout << "eval_thermo_state_pT():\n";
-	cout << "    Duff call to eval_thermo_state_rhoe, starting guess 1.\n";
-	Q.print_values();
-	return DUFF_EOS_ERROR;
-    }
-
-    Cv_eff = de / (Q.T[0] - T_old);
+    Q.rho = rho_start; // kg/m**3 
+    Q.e[0] = e_start; // J/kg 
+    if ( eval_thermo_state_rhoe(Q) != SUCCESS && warm ) return DUFF_EOS_ERROR;
+    R_eff = Q.p / (Q.rho * Q.T[0]);
+    Cv_eff = starting_Cv(Q, "eval_thermo_state_pT()", warm, status);
+    if ( status != SUCCESS ) return status;
     // Now, get a better guess for the appropriate density and
     // internal energy.
     e_old = Q.e[0] + (T_given - Q.T[0]) * Cv_eff;
@@ -206,6 +254,7 @@ s_eval_thermo_state_pT(Gas_data &Q)
     Q.rho = rho_old;
     Q.e[0] = e_old;
     if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	if ( warm ) return DUFF_EOS_ERROR;
 	cout << "eval_thermo_state_pT:\n";
 	cout << "    Duff call to eval_thermo_state_rhoe, starting guess 2.\n";
 	Q.print_values();
@@ -218,13 +267,14 @@ s_eval_thermo_state_pT(Gas_data &Q)
     // via finite differences.
     converged = (fabs(fp_old) < fp_tol) && (fabs(fT_old) < fT_tol);
     count = 0;
-    while ( !converged && count < MAX_STEPS ) {
+    while ( !converged && count < max_steps ) {
 	// Perturb first dimension to get derivatives.
 	rho_new = rho_old * 1.001;
 	e_new = e_old;
 	Q.rho = rho_new;
 	Q.e[0] = e_new;
 	if( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
 	    cout << "eval_thermo_state_pT():\n";
 	    cout << "    Duff call to eval_thermo_state_rhoe, iteration " << count << ", call A\n";
 	    Q.print_values();
@@ -240,6 +290,7 @@ s_eval_thermo_state_pT(Gas_data &Q)
 	Q.rho = rho_new;
 	Q.e[0] = e_new;
 	if( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
 	    cout << "eval_thermo_state_pT():\n";
 	    cout << "    Duff call to eval_thermo_state_rhoe, iteration " << count << ", call B\n";
 	    Q.print_values();
@@ -253,6 +304,7 @@ s_eval_thermo_state_pT(Gas_data &Q)
 
 	det = dfp_drho * dfT_de - dfT_drho * dfp_de;
 	if( fabs(det) < 1.0e-12 ) {
+	    if ( warm ) return ZERO_DETERMINANT_ERROR;
 	    cout << "eval_thermo_state_pT():\n";
 	    cout << "    Nearly zero determinant, det = " << det << endl;
 	    return ZERO_DETERMINANT_ERROR;
@@ -275,6 +327,7 @@ s_eval_thermo_state_pT(Gas_data &Q)
 	Q.rho = rho_old;
 	Q.e[0] = e_old;
 	if( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
 	    cout << "eval_thermo_state_pT():\n";
 	    cout << "    Duff call to eval_thermo_state_rhoe, iteration " << count << ", call C\n";
 	    Q.print_values();
@@ -289,7 +342,8 @@ s_eval_thermo_state_pT(Gas_data &Q)
 	//      << " rho= " << Q.rho << " e= " << Q.e[0] << endl;
 	// cout << "    fp_old= " << fp_old << " fT_old= " << fT_old << endl;
     } // end while 
-    if( count >= MAX_STEPS ) {
+    if( count >= max_steps ) {
+	if ( warm ) return ITERATION_ERROR;
 	cout << "eval_thermo_state_pT():\n";
 	cout << "    Warning, iterations did not converge.\n";
 	cout << "    p_given = " << p_given << ", T_given = " << T_given << endl;
@@ -297,6 +351,7 @@ s_eval_thermo_state_pT(Gas_data &Q)
 	return ITERATION_ERROR;
     }
     if( (fabs(fp_old) > fp_tol_fail) || (fabs(fT_old) > fT_tol_fail) ) {
+	if ( warm ) return ITERATION_ERROR;
 	cout << "eval_thermo_state_pT():\n";
 	cout << "    iterations failed badly.\n";
 	cout << "    p_given = " << p_given << ", T_given = " << T_given << endl;
@@ -310,14 +365,30 @@ s_eval_thermo_state_pT(Gas_data &Q)
 int
 Gas_model::
 s_eval_thermo_state_rhoT(Gas_data &Q)
+{
+    double rho_given = Q.rho;
+    double T_given = Q.T[0];
+    if ( usable_starting_state(Q) ) {
+	if ( rhoT_iteration(Q, rho_given, T_given, Q.e[0], true) == SUCCESS )
+	    return SUCCESS;
+	Q.T[0] = T_given;
+    }
+    // Get an idea of the gas properties by calling the original
+    // equation of state with some dummy value for internal energy.
+    return rhoT_iteration(Q, rho_given, T_given, 2.0e5, false);
+}
+
+int
+Gas_model::
+rhoT_iteration(Gas_data &Q, double rho_given, double T_given,
+	       double e_start, bool warm)
 {
     double e_old, e_new, de, tmp, de_sign;
-    double Cv_eff, T_old;
+    double Cv_eff;
     double dfT_de, fT_old, fT_new;
-    int converged, count;
+    int converged, count, status;
+    int max_steps = (warm ? MAX_WARM_STEPS : MAX_STEPS);
 
-    double rho_given = Q.rho;
-    double T_given = Q.T[0];
     // When using single-sided finite-differences on the
     // curve-fit EOS functions, we really cannot expect 
     // much more than 0.1% tolerance here.
@@ -326,57 +397,54 @@ s_eval_thermo_state_rhoT(Gas_data &Q)
     double fT_tol = 1.0e-6 * T_given;
     double fT_tol_fail = 0.02 * T_given;
 
-    // Get an idea of the gas properties by calling the original
-    // equation of state with some dummy values for density
-    // and internal energy.
     Q.rho = rho_given; // kg/m**3 
-    Q.e[0] = 2.0e5; // J/kg 
-    eval_thermo_state_rhoe(Q);
-    T_old = Q.T[0];
-    de = 0.01 * Q.e[0];
-    Q.e[0] += de;
-    if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
-	cout << "eval_thermo_state_rhoT():\n";
-	cout << "    Duff call to eval_thermo_state_rhoe, starting guess 0.\n";
-	Q.print_values();
-	return DUFF_EOS_ERROR;
-    }
-    Cv_eff = de / (Q.T[0] - T_old);
+    Q.e[0] = e_start; // J/kg 
+    if ( eval_thermo_state_rhoe(Q) != SUCCESS && warm ) return DUFF_EOS_ERROR;
+    Cv_eff = starting_Cv(Q, "eval_thermo_state_rhoT()", warm, status);
+    if ( status != SUCCESS ) return status;
     // Now, get a better guess for the appropriate density and internal energy.
     e_old = Q.e[0] + (T_given - Q.T[0]) * Cv_eff;
     // Evaluate state variables using this guess.
     Q.rho = rho_given;
     Q.e[0] = e_old;
     if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	if ( warm ) return DUFF_EOS_ERROR;
 	cout << "eval_thermo_state_rhoT:\n";
 	cout << "    Duff call to eval_thermo_state_rhoT, starting guess 1.\n";
 	Q.print_values();
 	return DUFF_EOS_ERROR;
     }
     fT_old = T_given - Q.T[0];
-    // Perturb to get derivative.
-    e_new = e_old * 1.001;
-    Q.rho = rho_given;
-    Q.e[0] = e_new;
-    if ( eval_thermo_state_rhoe(Q) != 0 ) {
-	printf("EOS_rhoT(): Duff call to EOS, starting guess 2\n");
-	Q.print_values();
-	return DUFF_EOS_ERROR;
-    }
-    fT_new = T_given - Q.T[0];
-    dfT_de = (fT_new - fT_old) / (e_new - e_old);
+    if ( s_analytic_thermo_derivatives() &&
+	 (Cv_eff = dedT_const_v(Q, status), status == SUCCESS) && Cv_eff > 0.0 ) {
+	// The model gives us the derivative directly.
+	dfT_de = -1.0 / Cv_eff;
+    } else {
+	// Perturb to get derivative.
+	e_new = e_old * 1.001;
+	Q.rho = rho_given;
+	Q.e[0] = e_new;
+	if ( eval_thermo_state_rhoe(Q) != 0 ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
+	    printf("EOS_rhoT(): Duff call to EOS, starting guess 2\n");
+	    Q.print_values();
+	    return DUFF_EOS_ERROR;
+	}
+	fT_new = T_given - Q.T[0];
+	dfT_de = (fT_new - fT_old) / (e_new - e_old);
 
-    // At the start of iteration, we want *_old to be the best guess.
-    if ( fabs(fT_new) < fabs(fT_old) ) {
-	tmp = fT_new; fT_new = fT_old; fT_old = tmp;
-	tmp = e_new; e_new = e_old; e_old = tmp;
+	// At the start of iteration, we want *_old to be the best guess.
+	if ( fabs(fT_new) < fabs(fT_old) ) {
+	    tmp = fT_new; fT_new = fT_old; fT_old = tmp;
+	    tmp = e_new; e_new = e_old; e_old = tmp;
+	}
     }
     // Update the guess using Newton iterations
     // with the partial derivatives being estimated
     // via finite differences.
     converged = (fabs(fT_old) < fT_tol);
     count = 0;
-    while ( !converged && count < MAX_STEPS ) {
+    while ( !converged && count < max_steps ) {
 	de = -fT_old / dfT_de;
 	if ( fabs(de) > MAX_RELATIVE_STEP * e_old ) {
 	    // move a little toward the goal 
@@ -387,6 +455,7 @@ s_eval_thermo_state_rhoT(Gas_data &Q)
 	Q.rho = rho_given;
 	Q.e[0] = e_new;
 	if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
 	    cout << "eval_thermo_state_rhoT():\n";
 	    cout << "    Duff call to eval_thermo_state_rhoe, iteration " << count << endl;
 	    Q.print_values();
@@ -404,12 +473,14 @@ s_eval_thermo_state_rhoT(Gas_data &Q)
     Q.rho = rho_given;
     Q.e[0] = e_old;
     if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	if ( warm ) return DUFF_EOS_ERROR;
 	cout << "eval_thermo_state_rhoT()\n";
 	cout << "    Duff call to EOS, after finishing iteration\n";
 	Q.print_values();
 	return DUFF_EOS_ERROR;
     }
-    if ( count >= MAX_STEPS ) {
+    if ( count >= max_steps ) {
+	if ( warm ) return ITERATION_ERROR;
 	cout << "eval_thermo_state_rhoT():\n";
 	cout << "    Warning, iterations did not converge.\n";
 	cout << "    rho_given = " << rho_given << ", T_given = " << T_given << endl;
@@ -417,6 +488,7 @@ s_eval_thermo_state_rhoT(Gas_data &Q)
 	return ITERATION_ERROR;
     }
     if ( fabs(fT_old) > fT_tol_fail ) {
+	if ( warm ) return ITERATION_ERROR;
 	cout << "eval_thermo_state_rhoT():\n";
 	cout << "    iterations failed badly.\n";
 	cout << "    rho_given = " << rho_given << ", T_given = " << T_given << endl;
@@ -430,14 +502,31 @@ s_eval_thermo_state_rhoT(Gas_data &Q)
 int
 Gas_model::
 s_eval_thermo_state_rhop(Gas_data &Q)
+{
+    double rho_given = Q.rho;
+    double p_given = Q.p;
+    if ( usable_starting_state(Q) ) {
+	if ( rhop_iteration(Q, rho_given, p_given, Q.e[0], true) == SUCCESS )
+	    return SUCCESS;
+	Q.p = p_given;
+    }
+    // Get an idea of the gas properties by calling the original
+    // equation of state with some dummy value for internal energy.
+    return rhop_iteration(Q, rho_given, p_given, 2.0e5, false);
+}
+
+int
+Gas_model::
+rhop_iteration(Gas_data &Q, double rho_given, double p_given,
+	       double e_start, bool warm)
 {
     double e_old, e_new, de, dedp, tmp, de_sign;
-    double p_old;
+    double p_old, Cv, R;
     double dfp_de, fp_old, fp_new;
-    int converged, count;
+    int converged, count, status;
+    int max_steps = (warm ? MAX_WARM_STEPS : MAX_STEPS);
+    bool analytic = s_analytic_thermo_derivatives();
 
-    double rho_given = Q.rho;
-    double p_given = Q.p;
     // When using single-sided finite-differences on the
     // curve-fit EOS functions, we really cannot expect 
     // much more than 0.1% tolerance here.
@@ -446,22 +535,26 @@ s_eval_thermo_state_rhop(Gas_data &Q)
     double fp_tol = 1.0e-6 * p_given;
     double fp_tol_fail = 0.02 * p_given;
 
-    // Get an idea of the gas properties by calling the original
-    // equation of state with some dummy values for density
-    // and internal energy.
     Q.rho = rho_given; // kg/m**3
-    Q.e[0] = 2.0e5; // J/kg 
-    eval_thermo_state_rhoe(Q);
-    p_old = Q.p;
-    de = 0.01 * Q.e[0];
-    Q.e[0] += de;
-    if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
-	cout << "eval_thermo_state_rhop():\n";
-	cout << "    Duff call to eval_thermo_state_rhoe, starting guess 0.\n";
-	Q.print_values();
-	return DUFF_EOS_ERROR;
+    Q.e[0] = e_start; // J/kg 
+    if ( eval_thermo_state_rhoe(Q) != SUCCESS && warm ) return DUFF_EOS_ERROR;
+    // At fixed density, dp/de is close to rho*R/Cv.
+    if ( analytic && (Cv = dedT_const_v(Q, status), status == SUCCESS) && Cv > 0.0 &&
+	 (R = s_gas_constant(Q, status), status == SUCCESS) && R > 0.0 ) {
+	dedp = Cv / (rho_given * R);
+    } else {
+	p_old = Q.p;
+	de = 0.01 * Q.e[0];
+	Q.e[0] += de;
+	if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
+	    cout << "eval_thermo_state_rhop():\n";
+	    cout << "    Duff call to eval_thermo_state_rhoe, starting guess 0.\n";
+	    Q.print_values();
+	    return DUFF_EOS_ERROR;
+	}
+	dedp = de / (Q.p - p_old);
     }
-    dedp = de / (Q.p - p_old);
     // Now, get a better guess for the appropriate internal energy.
     e_old = Q.e[0] + (p_given - Q.p) * dedp;
 //     printf( "Initial guess e_old= %g dedp= %g\n", e_old, dedp );
@@ -469,36 +562,43 @@ s_eval_thermo_state_rhop(Gas_data &Q)
     Q.rho = rho_given;
     Q.e[0] = e_old;
     if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	if ( warm ) return DUFF_EOS_ERROR;
 	cout << "eval_thermo_state_rhop():\n";
 	cout << "    Duff call to eval_thermo_state_rhoe, starting guess 1.\n";
 	Q.print_values();
 	return DUFF_EOS_ERROR;
     }
     fp_old = p_given - Q.p;
-    // Perturb to get derivative.
-    e_new = e_old * 1.001;
-    Q.rho = rho_given;
-    Q.e[0] = e_new;
-    if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
-	cout << "eval_thermo_state_rhop():\n";
-	cout << "    Duff call to eval_thermo_state_rhoe, starting guess 2.\n";
-	Q.print_values();
-	return DUFF_EOS_ERROR;
-    }
-    fp_new = p_given - Q.p;
-    dfp_de = (fp_new - fp_old) / (e_new - e_old);
+    if ( analytic && (Cv = dedT_const_v(Q, status), status == SUCCESS) && Cv > 0.0 &&
+	 (R = s_gas_constant(Q, status), status == SUCCESS) && R > 0.0 ) {
+	dfp_de = -rho_given * R / Cv;
+    } else {
+	// Perturb to get derivative.
+	e_new = e_old * 1.001;
+	Q.rho = rho_given;
+	Q.e[0] = e_new;
+	if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
+	    cout << "eval_thermo_state_rhop():\n";
+	    cout << "    Duff call to eval_thermo_state_rhoe, starting guess 2.\n";
+	    Q.print_values();
+	    return DUFF_EOS_ERROR;
+	}
+	fp_new = p_given - Q.p;
+	dfp_de = (fp_new - fp_old) / (e_new - e_old);
 
-    // At the start of iteration, we want *_old to be the best guess.
-    if ( fabs(fp_new) < fabs(fp_old) ) {
-	tmp = fp_new; fp_new = fp_old; fp_old = tmp;
-	tmp = e_new; e_new = e_old; e_old = tmp;
+	// At the start of iteration, we want *_old to be the best guess.
+	if ( fabs(fp_new) < fabs(fp_old) ) {
+	    tmp = fp_new; fp_new = fp_old; fp_old = tmp;
+	    tmp = e_new; e_new = e_old; e_old = tmp;
+	}
     }
     // Update the guess using Newton iterations
     // with the partial derivatives being estimated
     // via finite differences.
     converged = (fabs(fp_old) < fp_tol);
     count = 0;
-    while ( !converged && count < MAX_STEPS ) {
+    while ( !converged && count < max_steps ) {
 	de = -fp_old / dfp_de;
 	if ( fabs(de) > MAX_RELATIVE_STEP * e_old ) {
 	    // move a little toward the goal
@@ -509,6 +609,7 @@ s_eval_thermo_state_rhop(Gas_data &Q)
 	Q.rho = rho_given;
 	Q.e[0] = e_new;
 	if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	    if ( warm ) return DUFF_EOS_ERROR;
 	    cout << "eval_thermo_state_rhop():\n";
 	    cout << "    Duff call to eval_thermo_state_rhoe, iteration " << count << endl;
 	    Q.print_values();
@@ -526,12 +627,14 @@ s_eval_thermo_state_rhop(Gas_data &Q)
     Q.rho = rho_given;
     Q.e[0] = e_old;
     if ( eval_thermo_state_rhoe(Q) != SUCCESS ) {
+	if ( warm ) return DUFF_EOS_ERROR;
 	cout << "eval_thermo_state_rhop():\n";
 	cout << "    Duff call to eval_thermo_state_rhoe, after finishing iteration\n";
 	Q.print_values();
 	return DUFF_EOS_ERROR;
     }
-    if ( count >= MAX_STEPS ) {
+    if ( count >= max_steps ) {
+	if ( warm ) return ITERATION_ERROR;
 	cout << "eval_thermo_state_rhop():\n";
 	cout << "    Warning, iterations did not converge.\n";
 	cout << "    rho_given = " << rho_given << ", p_given = " << p_given << endl;
@@ -539,6 +642,7 @@ s_eval_thermo_state_rhop(Gas_data &Q)
 	return ITERATION_ERROR;
     }   // end if 
     if ( fabs(fp_old) > fp_tol_fail ) {
+	if ( warm ) return ITERATION_ERROR;
 	cout << "eval_thermo_state_rhop():\n";
 	cout << "    iterations failed badly.\n";
 	cout << "    rho_given = " << rho_given << ", p_given = " << p_given << endl;
@@ -776,6 +880,34 @@ s_eval_thermo_state_hs(Gas_data &Q, double h, double s)
 }
 
 
+int
+Gas_model::
+s_eval_thermo_state_rhoe_batch(vector<Gas_data *> &Q)
+{
+    // Models without a specialised batch evaluation
+    // just work through the states one at a time.
+    int status = SUCCESS;
+    for ( size_t i = 0; i < Q.size(); ++i ) {
+	int flag = s_eval_thermo_state_rhoe(*(Q[i]));
+	if ( flag != SUCCESS && status == SUCCESS ) status = flag;
+    }
+    return status;
+}
+
+
+int
+Gas_model::
+s_eval_transport_coefficients_batch(vector<Gas_data *> &Q)
+{
+    int status = SUCCESS;
+    for ( size_t i = 0; i < Q.size(); ++i ) {
+	int flag = s_eval_transport_coefficients(*(Q[i]));
+	if ( flag != SUCCESS && status == SUCCESS ) status = flag;
+    }
+    return status;
+}
+
+
 int
 Gas_model::
 s_eval_sound_speed(Gas_data &Q)
@@ -111,6 +111,14 @@ public:
     int eval_diffusion_coefficients(Gas_data &Q)
     { return s_eval_diffusion_coefficients(Q); }
 
+    // Batched versions of the above, for many gas states per call.
+    // All states are evaluated; the first failure code (if any) is returned.
+    int eval_thermo_state_rhoe_batch(std::vector<Gas_data *> &Q)
+    { return s_eval_thermo_state_rhoe_batch(Q); }
+
+    int eval_transport_coefficients_batch(std::vector<Gas_data *> &Q)
+    { return s_eval_transport_coefficients_batch(Q); }
+
     // State derivatives
 
     double dTdp_const_rho(const Gas_data &Q, int &status)
@@ -261,6 +269,8 @@ protected:
     virtual int s_eval_sound_speed(Gas_data &Q);
     virtual int s_eval_transport_coefficients(Gas_data &Q) = 0;
     virtual int s_eval_diffusion_coefficients(Gas_data &Q) = 0;
+    virtual int s_eval_thermo_state_rhoe_batch(std::vector<Gas_data *> &Q);
+    virtual int s_eval_transport_coefficients_batch(std::vector<Gas_data *> &Q);
     virtual double s_dTdp_const_rho(const Gas_data &Q, int &status);
     virtual double s_dTdrho_const_p(const Gas_data &Q, int &status);
     virtual double s_dTdrho_const_s(const Gas_data &Q, int &status );
@@ -277,8 +287,24 @@ protected:
     virtual double s_entropy(const Gas_data &Q, int isp) = 0;
     virtual double s_modal_enthalpy(const Gas_data &Q, int isp, int itm);
     virtual double s_modal_Cv(Gas_data &Q, int itm);
+    // Models whose dedT_const_v and gas_constant are cheap and direct
+    // (rather than finite-difference estimates) may say so, and the
+    // generic inverse evaluations will use them to start their iterations.
+    virtual bool s_analytic_thermo_derivatives() const
+    { return false; }
 
 private:
+    // Worker functions for the generic inverse evaluations.
+    // When warm is true, the iteration starts from a previous state,
+    // takes fewer steps and fails quietly.
+    double starting_Cv(Gas_data &Q, const char *caller, bool warm, int &status);
+    int pT_iteration(Gas_data &Q, double p_given, double T_given,
+		     double rho_start, double e_start, bool warm);
+    int rhoT_iteration(Gas_data &Q, double rho_given, double T_given,
+		       double e_start, bool warm);
+    int rhop_iteration(Gas_data &Q, double rho_given, double p_given,
+		       double e_start, bool warm);
+
     // Local classes.
     class dTdp_functor : public Univariate_functor {
     public:
@@ -76,6 +76,9 @@
 %include "diatom-electronic-level.hh"
 %include "polyatom-electronic-level.hh"
 
+// Convert a look-up table file (Lua or binary) to the binary form.
+int write_look_up_table_as_binary(const std::string cfile, const std::string fname);
+
 %pythoncode %{
 initialise_gas_model = create_gas_model
 
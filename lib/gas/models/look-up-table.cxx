@@ -3,6 +3,8 @@
 //       14-Jun-2010 (PJ) small variable change to fix bug
 //                        and eliminate ambiguity
 //       12-Dec-2013 (PJ) Add entropy to interpolation data.
+//       18-Oct-2026 Interleaved records, binary table files,
+//                   non-uniform energy nodes and batched evaluation.
 // Place: Hampton, Virginia, USA
 //        Lisbon, Portugal
 // Note:
@@ -14,9 +16,14 @@
 //
 
 #include <iostream>
+#include <sstream>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
+#include <stdint.h>
 #include <math.h>
+#include <zlib.h>
 #include "../../util/source/useful.h"
 #include "../../util/source/lua_service.hh"
 #include "physical_constants.hh"
@@ -24,14 +31,65 @@
 
 using namespace std;
 
+namespace {
+    // Binary table files start with this tag, then the format version.
+    // They are written in the byte order of the machine that wrote them;
+    // a version number that reads back wrongly reveals a mismatch.
+    const char LUT_BINARY_TAG[8] = {'E','3','L','U','T','B','I','N'};
+    const int32_t LUT_BINARY_VERSION = 1;
+
+    bool is_binary_table_file(const string cfile)
+    {
+	gzFile fp = gzopen(cfile.c_str(), "rb");
+	if ( fp == 0 ) return false;
+	char tag[8];
+	bool found = (gzread(fp, tag, 8) == 8 && memcmp(tag, LUT_BINARY_TAG, 8) == 0);
+	gzclose(fp);
+	return found;
+    }
+}
+
 Look_up_table::Look_up_table(const string cfile)
-    : Gas_model()
+    : Gas_model(), table_(0)
 {
     set_number_of_species(1);
     set_number_of_modes(1);
     s_names_.resize(1);
     s_names_[0] = "LUT";
 
+    if ( is_binary_table_file(cfile) ) {
+	read_binary_table(cfile);
+    } else {
+	read_lua_table(cfile);
+    }
+    set_up_energy_index();
+} // end of constructor
+
+Look_up_table::~Look_up_table() 
+{
+    s_names_.clear();
+    storage_.clear();
+    table_ = 0;
+} // end of destructor
+
+void
+Look_up_table::
+allocate_table()
+{
+    // One spare record allows the start to be moved up to a 64-byte boundary.
+    size_t nrec = (iesteps_ + 1) * (irsteps_ + 1);
+    const size_t doubles_per_record = sizeof(LUT_record) / sizeof(double);
+    storage_.assign((nrec + 1) * doubles_per_record, 0.0);
+    uintptr_t addr = reinterpret_cast<uintptr_t>(&storage_[0]);
+    size_t offset = ((sizeof(LUT_record) - addr % sizeof(LUT_record)) % sizeof(LUT_record))
+	/ sizeof(double);
+    table_ = reinterpret_cast<LUT_record *>(&storage_[offset]);
+}
+
+void
+Look_up_table::
+read_lua_table(const string cfile)
+{
     // Read lua file and populate LUT
     lua_State *L = initialise_lua_State();
     
@@ -56,13 +114,49 @@ Look_up_table::Look_up_table(const string cfile)
     if ( !with_entropy ) cout << "Look_up_table(): No entropy data available." << endl;
     iesteps_ = get_positive_int(L, LUA_GLOBALSINDEX, "iesteps");
     irsteps_ = get_positive_int(L, LUA_GLOBALSINDEX, "irsteps");
-    emin_ = get_number(L, LUA_GLOBALSINDEX, "emin");
-    de_ = get_positive_number(L, LUA_GLOBALSINDEX, "de");
     lrmin_ = get_number(L, LUA_GLOBALSINDEX, "lrmin");
     dlr_ = get_positive_number(L, LUA_GLOBALSINDEX, "dlr");
-
-    emax_ = emin_ + de_ * iesteps_;
     lrmax_ = lrmin_ + dlr_ * irsteps_;
+
+    // The energy nodes are either listed explicitly, in e_values,
+    // or are uniformly spaced from emin in steps of de.
+    lua_getglobal(L, "e_values");
+    if ( lua_istable(L, -1) ) {
+	uniform_e_ = false;
+	int nev = lua_objlen(L, -1);
+	if ( nev != iesteps_ + 1 ) {
+	    ostringstream ost;
+	    ost << "Look_up_table():\n"
+		<< "    Error in look-up table input file: " << cfile << endl
+		<< "    Inconsistent numbers for energy values: "
+		<< "values=" << nev << " steps=" << iesteps_ << endl;
+	    input_error(ost);
+	}
+	e_nodes_.resize(nev);
+	for ( ie = 0; ie < nev; ++ie ) {
+	    lua_rawgeti(L, -1, ie+1);
+	    e_nodes_[ie] = luaL_checknumber(L, -1);
+	    lua_pop(L, 1);
+	    if ( ie > 0 && !(e_nodes_[ie] > e_nodes_[ie-1]) ) {
+		ostringstream ost;
+		ost << "Look_up_table():\n"
+		    << "    Error in look-up table input file: " << cfile << endl
+		    << "    The energy values must increase; see entry " << ie+1 << endl;
+		input_error(ost);
+	    }
+	}
+	emin_ = e_nodes_.front();
+	emax_ = e_nodes_.back();
+	de_ = (emax_ - emin_) / iesteps_;
+    } else {
+	uniform_e_ = true;
+	emin_ = get_number(L, LUA_GLOBALSINDEX, "emin");
+	de_ = get_positive_number(L, LUA_GLOBALSINDEX, "de");
+	emax_ = emin_ + de_ * iesteps_;
+	e_nodes_.resize(iesteps_ + 1);
+	for ( ie = 0; ie <= iesteps_; ++ie ) e_nodes_[ie] = emin_ + ie * de_;
+    }
+    lua_pop(L, 1); // pop e_values off.
     
     lua_getglobal(L, "data");
     if ( !lua_istable(L, -1) ) {
@@ -82,13 +176,6 @@ Look_up_table::Look_up_table(const string cfile)
 	    << "points=" << ne << " steps=" << iesteps_ << endl;
 	input_error(ost);
     }
-    Cv_hat_.resize(ne);
-    Cv_.resize(ne);
-    R_hat_.resize(ne);
-    g_hat_.resize(ne);
-    mu_hat_.resize(ne);
-    k_hat_.resize(ne);
-    if ( with_entropy ) Cp_hat_.resize(ne);
 
     lua_rawgeti(L, -1, 1);
     int nr = lua_objlen(L, -1);
@@ -101,51 +188,45 @@ Look_up_table::Look_up_table(const string cfile)
 	    << "points=" << nr << " steps=" << irsteps_ << endl;
 	input_error(ost);
     }
+    allocate_table();
 
     for ( ie = 0; ie < ne; ++ie ) {
-	Cv_hat_[ie].resize(nr);
-	Cv_[ie].resize(nr);
-	R_hat_[ie].resize(nr);
-	g_hat_[ie].resize(nr);
-	mu_hat_[ie].resize(nr);
-	k_hat_[ie].resize(nr);
-	if ( with_entropy ) Cp_hat_[ie].resize(nr);
-
 	lua_rawgeti(L, -1, ie+1);
 	for ( ir = 0; ir < nr; ++ir ) {
+	    LUT_record &r = node(ie, ir);
 	    lua_rawgeti(L, -1, ir+1);
 	    lua_rawgeti(L, -1, 1);
-	    Cv_hat_[ie][ir] = luaL_checknumber(L, -1);
+	    r.Cv_hat = luaL_checknumber(L, -1);
 	    lua_pop(L, 1);
 	    lua_rawgeti(L, -1, 2);
-	    Cv_[ie][ir] = luaL_checknumber(L, -1);
+	    r.Cv = luaL_checknumber(L, -1);
 	    lua_pop(L, 1);
 	    lua_rawgeti(L, -1, 3);
-	    R_hat_[ie][ir] = luaL_checknumber(L, -1);
+	    r.R_hat = luaL_checknumber(L, -1);
 	    lua_pop(L, 1);
 	    if ( with_entropy ) {
 		lua_rawgeti(L, -1, 4);
-		Cp_hat_[ie][ir] = luaL_checknumber(L, -1);
+		r.Cp_hat = luaL_checknumber(L, -1);
 		lua_pop(L, 1);
 		lua_rawgeti(L, -1, 5);
-		g_hat_[ie][ir] = luaL_checknumber(L, -1);
+		r.g_hat = luaL_checknumber(L, -1);
 		lua_pop(L, 1);
 		lua_rawgeti(L, -1, 6);
-		mu_hat_[ie][ir] = luaL_checknumber(L, -1);
+		r.mu_hat = luaL_checknumber(L, -1);
 		lua_pop(L, 1);
 		lua_rawgeti(L, -1, 7);
-		k_hat_[ie][ir] = luaL_checknumber(L, -1);
+		r.k_hat = luaL_checknumber(L, -1);
 		lua_pop(L, 1);
 	    } else {
 		// The old arrangement.
 		lua_rawgeti(L, -1, 4);
-		g_hat_[ie][ir] = luaL_checknumber(L, -1);
+		r.g_hat = luaL_checknumber(L, -1);
 		lua_pop(L, 1);
 		lua_rawgeti(L, -1, 5);
-		mu_hat_[ie][ir] = luaL_checknumber(L, -1);
+		r.mu_hat = luaL_checknumber(L, -1);
 		lua_pop(L, 1);
 		lua_rawgeti(L, -1, 6);
-		k_hat_[ie][ir] = luaL_checknumber(L, -1);
+		r.k_hat = luaL_checknumber(L, -1);
 		lua_pop(L, 1);
 	    }
 	    lua_pop(L, 1); // pop data[ie][ir] off.
@@ -156,50 +237,147 @@ Look_up_table::Look_up_table(const string cfile)
     lua_pop(L, 1); // pop data off.
 
     lua_close(L);
-} // end of constructor
+} // end read_lua_table()
 
-Look_up_table::~Look_up_table() 
+void
+Look_up_table::
+read_binary_table(const string cfile)
 {
-    s_names_.clear();
-    size_t ne = Cv_hat_[0].size();
-    for ( size_t ie = 0; ie < ne; ++ie ) {
-	Cv_hat_[ie].clear();
-	Cv_[ie].clear();
-	R_hat_[ie].clear();
-	g_hat_[ie].clear();
-	mu_hat_[ie].clear();
-	k_hat_[ie].clear();
-	if ( with_entropy ) Cp_hat_[ie].clear();
+    // The layout is that written by write_binary_table().
+    // The records are read straight into the table, without parsing.
+    gzFile fp = gzopen(cfile.c_str(), "rb");
+    char tag[8];
+    int32_t version, entropy_flag, uniform_flag, nie, nir;
+    double header[7];
+    bool ok = (fp != 0);
+    ok = ok && gzread(fp, tag, 8) == 8;
+    ok = ok && gzread(fp, &version, sizeof(version)) == sizeof(version);
+    if ( ok && version != LUT_BINARY_VERSION ) {
+	ostringstream ost;
+	ost << "Look_up_table():\n"
+	    << "    Binary look-up table file: " << cfile << endl
+	    << "    has format version " << version << " but " << LUT_BINARY_VERSION
+	    << " is expected.\n"
+	    << "    It may have been written on a machine of different byte order.\n";
+	gzclose(fp);
+	input_error(ost);
     }
-    Cv_hat_.clear();
-    Cv_.clear();
-    R_hat_.clear();
-    g_hat_.clear();
-    mu_hat_.clear();
-    k_hat_.clear();
-    if ( with_entropy ) Cp_hat_.clear();
-} // end of destructor
+    ok = ok && gzread(fp, &entropy_flag, sizeof(int32_t)) == sizeof(int32_t);
+    ok = ok && gzread(fp, &uniform_flag, sizeof(int32_t)) == sizeof(int32_t);
+    ok = ok && gzread(fp, &nie, sizeof(int32_t)) == sizeof(int32_t);
+    ok = ok && gzread(fp, &nir, sizeof(int32_t)) == sizeof(int32_t);
+    ok = ok && gzread(fp, header, sizeof(header)) == sizeof(header);
+    ok = ok && nie > 0 && nir > 0;
+    if ( ok ) {
+	with_entropy = (entropy_flag == 1);
+	uniform_e_ = (uniform_flag == 1);
+	iesteps_ = nie; irsteps_ = nir;
+	s1_ = header[0]; p1_ = header[1]; T1_ = header[2];
+	emin_ = header[3]; de_ = header[4];
+	lrmin_ = header[5]; dlr_ = header[6];
+	emax_ = emin_ + de_ * iesteps_;
+	lrmax_ = lrmin_ + dlr_ * irsteps_;
+	e_nodes_.resize(iesteps_ + 1);
+	unsigned int nbytes = e_nodes_.size() * sizeof(double);
+	ok = gzread(fp, &e_nodes_[0], nbytes) == static_cast<int>(nbytes);
+    }
+    if ( ok ) {
+	allocate_table();
+	unsigned int nbytes = (iesteps_ + 1) * (irsteps_ + 1) * sizeof(LUT_record);
+	ok = gzread(fp, table_, nbytes) == static_cast<int>(nbytes);
+    }
+    if ( fp != 0 ) gzclose(fp);
+    if ( !ok ) {
+	ostringstream ost;
+	ost << "Look_up_table():\n"
+	    << "    Could not read binary look-up table file: " << cfile << endl;
+	input_error(ost);
+    }
+    if ( !with_entropy ) cout << "Look_up_table(): No entropy data available." << endl;
+} // end read_binary_table()
 
 int
 Look_up_table::
-determine_interpolants(const Gas_data &Q, int &ir, int &ie, double &lrfrac, double &efrac)
+write_binary_table(const string fname) const
 {
-    if ( Q.rho <= 0.0 ) {
-	cout << "Look_up_table::determine_interpolants(): density= " << Q.rho 
-	     << " is zero or negative\n";
-	cout << "   Supplied Q:" << endl;
-	Q.print_values();
+    // Files with names ending in .gz are compressed.
+    bool compress = fname.size() > 3 && fname.compare(fname.size()-3, 3, ".gz") == 0;
+    int32_t header_ints[5] = { LUT_BINARY_VERSION, with_entropy ? 1 : 0,
+			       uniform_e_ ? 1 : 0, iesteps_, irsteps_ };
+    double header[7] = { s1_, p1_, T1_, emin_, de_, lrmin_, dlr_ };
+    size_t nrec = (iesteps_ + 1) * (irsteps_ + 1);
+    bool ok;
+    if ( compress ) {
+	gzFile fp = gzopen(fname.c_str(), "wb");
+	if ( fp == 0 ) return FILE_ERROR;
+	ok = gzwrite(fp, LUT_BINARY_TAG, 8) == 8;
+	ok = ok && gzwrite(fp, header_ints, sizeof(header_ints)) == sizeof(header_ints);
+	ok = ok && gzwrite(fp, header, sizeof(header)) == sizeof(header);
+	ok = ok && gzwrite(fp, &e_nodes_[0], e_nodes_.size()*sizeof(double)) ==
+	    static_cast<int>(e_nodes_.size()*sizeof(double));
+	ok = ok && gzwrite(fp, table_, nrec*sizeof(LUT_record)) ==
+	    static_cast<int>(nrec*sizeof(LUT_record));
+	ok = (gzclose(fp) == Z_OK) && ok;
+    } else {
+	FILE *fp = fopen(fname.c_str(), "wb");
+	if ( fp == 0 ) return FILE_ERROR;
+	ok = fwrite(LUT_BINARY_TAG, 1, 8, fp) == 8;
+	ok = ok && fwrite(header_ints, sizeof(header_ints), 1, fp) == 1;
+	ok = ok && fwrite(header, sizeof(header), 1, fp) == 1;
+	ok = ok && fwrite(&e_nodes_[0], sizeof(double), e_nodes_.size(), fp) == e_nodes_.size();
+	ok = ok && fwrite(table_, sizeof(LUT_record), nrec, fp) == nrec;
+	ok = (fclose(fp) == 0) && ok;
+    }
+    return ok ? SUCCESS : FILE_ERROR;
+} // end write_binary_table()
+
+void
+Look_up_table::
+set_up_energy_index()
+{
+    e_index_.clear();
+    de_index_ = de_;
+    if ( uniform_e_ ) return;
+    // Use bins a few times finer than the mean spacing, so that the
+    // forward search is short even where the nodes are clustered.
+    int nbins = 4 * iesteps_;
+    de_index_ = (emax_ - emin_) / nbins;
+    e_index_.resize(nbins + 1);
+    int ie = 0;
+    for ( int ib = 0; ib <= nbins; ++ib ) {
+	double e = emin_ + ib * de_index_;
+	while ( ie < iesteps_ - 1 && e_nodes_[ie+1] <= e ) ++ie;
+	e_index_[ib] = ie;
+    }
+} // end set_up_energy_index()
+
+int
+Look_up_table::
+determine_interpolants(const Gas_data &Q, int &ir, int &ie, double &lrfrac, double &efrac) const
+{
+    if ( !(Q.rho > 0.0) || !isfinite(Q.e[0]) ) {
+	// Leave the reporting to the caller; in a batch there may be many.
 	return VALUE_ERROR;
     }
+    locate(log10(Q.rho), Q.e[0], ir, ie, lrfrac, efrac);
+    return (SUCCESS);
+}
 
+void
+Look_up_table::
+locate(double logrho, double e, int &ir, int &ie, double &lrfrac, double &efrac) const
+{
     // Find the enclosing cell. 
-    double logrho = log10(Q.rho);
     ir = (int) ((logrho - lrmin_) / dlr_);
-    ie = (int) ((Q.e[0] - emin_) / de_);
-    // cout << "ir= " << ir << " ie= " << ie << endl;
-    // cout << "dlr= " << dlr_ << " de= " << de_ << endl;
-    // cout << "lrmin= " << lrmin_ << endl;
-    // cout << "emin= " << emin_ << endl;
+    if ( uniform_e_ ) {
+	ie = (int) ((e - emin_) / de_);
+    } else {
+	int ib = (int) ((e - emin_) / de_index_);
+	if ( ib < 0 ) ib = 0;
+	if ( ib > static_cast<int>(e_index_.size()) - 1 ) ib = e_index_.size() - 1;
+	ie = e_index_[ib];
+	while ( ie < iesteps_ - 1 && e_nodes_[ie+1] <= e ) ++ie;
+    }
     
     // Make sure that we don't try to access data outside the
     // actual arrays.
@@ -210,8 +388,11 @@ determine_interpolants(const Gas_data &Q, int &ir, int &ie, double &lrfrac, doub
 
     // Calculate bilinear interpolation(/extrapolation) fractions.
     lrfrac = (logrho - (lrmin_ + ir * dlr_)) / dlr_;
-    efrac  = (Q.e[0] - (emin_ + ie * de_)) / de_;
-    // cout << "desired lrfrac= " << lrfrac << " efrac= " << efrac << endl;
+    if ( uniform_e_ ) {
+	efrac  = (e - (emin_ + ie * de_)) / de_;
+    } else {
+	efrac  = (e - e_nodes_[ie]) / (e_nodes_[ie+1] - e_nodes_[ie]);
+    }
 
     // Limit the extrapolation to small distances.
     constexpr double EXTRAP_MARGIN = 0.2;
@@ -219,42 +400,74 @@ determine_interpolants(const Gas_data &Q, int &ir, int &ie, double &lrfrac, doub
     lrfrac = min(lrfrac, 1.0+EXTRAP_MARGIN);
     efrac = max(efrac, -EXTRAP_MARGIN);
     efrac = min(efrac, 1.0+EXTRAP_MARGIN);
-    // cout << "actual lrfrac= " << lrfrac << " efrac= " << efrac << endl;
+}
 
-    return (SUCCESS);
+int
+Look_up_table::
+locate_batch(const vector<Gas_data *> &Q, vector<int> &ir, vector<int> &ie,
+	     vector<double> &lrfrac, vector<double> &efrac) const
+{
+    // The log10 calls are taken in a pass of their own and the
+    // interpolants found in the next, before any table record is read.
+    // An invalid state is flagged with ir = -1 and VALUE_ERROR returned.
+    size_t n = Q.size();
+    ir.resize(n); ie.resize(n); lrfrac.resize(n); efrac.resize(n);
+    for ( size_t i = 0; i < n; ++i ) lrfrac[i] = Q[i]->rho;
+    for ( size_t i = 0; i < n; ++i ) lrfrac[i] = log10(lrfrac[i]);
+    int status = SUCCESS;
+    for ( size_t i = 0; i < n; ++i ) {
+	const Gas_data &Qi = *(Q[i]);
+	if ( !(Qi.rho > 0.0) || !isfinite(Qi.e[0]) ) {
+	    ir[i] = -1;
+	    status = VALUE_ERROR;
+	    continue;
+	}
+	locate(lrfrac[i], Qi.e[0], ir[i], ie[i], lrfrac[i], efrac[i]);
+    }
+    return status;
 }
 
 int
 Look_up_table::
-s_eval_thermo_state_rhoe(Gas_data &Q)
+interpolate(const Gas_data &Q, LUT_record &r) const
 {
-    double efrac, lrfrac, Cv_eff, R_eff, g_eff;
+    // Bilinear interpolation of all of the properties at once.
+    double efrac, lrfrac;
     int    ir, ie;
+    if ( determine_interpolants(Q, ir, ie, lrfrac, efrac) != SUCCESS ) return VALUE_ERROR;
+    const LUT_record &a = node(ie, ir);
+    const LUT_record &b = node(ie+1, ir);
+    const LUT_record &c = node(ie+1, ir+1);
+    const LUT_record &d = node(ie, ir+1);
+    double wa = (1.0 - efrac) * (1.0 - lrfrac);
+    double wb = efrac         * (1.0 - lrfrac);
+    double wc = efrac         * lrfrac;
+    double wd = (1.0 - efrac) * lrfrac;
+    r.Cv_hat = wa * a.Cv_hat + wb * b.Cv_hat + wc * c.Cv_hat + wd * d.Cv_hat;
+    r.Cv     = wa * a.Cv     + wb * b.Cv     + wc * c.Cv     + wd * d.Cv;
+    r.R_hat  = wa * a.R_hat  + wb * b.R_hat  + wc * c.R_hat  + wd * d.R_hat;
+    r.Cp_hat = wa * a.Cp_hat + wb * b.Cp_hat + wc * c.Cp_hat + wd * d.Cp_hat;
+    r.g_hat  = wa * a.g_hat  + wb * b.g_hat  + wc * c.g_hat  + wd * d.g_hat;
+    r.mu_hat = wa * a.mu_hat + wb * b.mu_hat + wc * c.mu_hat + wd * d.mu_hat;
+    r.k_hat  = wa * a.k_hat  + wb * b.k_hat  + wc * c.k_hat  + wd * d.k_hat;
+    return SUCCESS;
+}
 
-    if ( determine_interpolants(Q, ir, ie, lrfrac, efrac) != SUCCESS ) {
-	cout << "Bailing out!\n";
-	exit(1);
+int
+Look_up_table::
+s_eval_thermo_state_rhoe(Gas_data &Q)
+{
+    LUT_record r;
+    if ( interpolate(Q, r) != SUCCESS ) {
+	cout << "Look_up_table::eval_thermo_state_rhoe(): invalid state: rho= " << Q.rho
+	     << " e= " << Q.e[0] << endl;
+	return VALUE_ERROR;
     }
 
-    Cv_eff = (1.0 - efrac) * (1.0 - lrfrac) * Cv_hat_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * Cv_hat_[ie+1][ir] +
-	efrac         * lrfrac         * Cv_hat_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * Cv_hat_[ie][ir+1];
-   
-    R_eff  = (1.0 - efrac) * (1.0 - lrfrac) * R_hat_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * R_hat_[ie+1][ir] +
-	efrac         * lrfrac         * R_hat_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * R_hat_[ie][ir+1];
-
-    g_eff  = (1.0 - efrac) * (1.0 - lrfrac) * g_hat_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * g_hat_[ie+1][ir] +
-	efrac         * lrfrac         * g_hat_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * g_hat_[ie][ir+1];
-
     // Reconstruct the thermodynamic properties.
-    Q.T[0] = Q.e[0] / Cv_eff;
-    Q.p = Q.rho*R_eff*Q.T[0];
-    Q.a = sqrt(g_eff*R_eff*Q.T[0]);
+    Q.T[0] = Q.e[0] / r.Cv_hat;
+    Q.p = Q.rho*r.R_hat*Q.T[0];
+    Q.a = sqrt(r.g_hat*r.R_hat*Q.T[0]);
     if ( Q.T[0] < gas_Tmin() ) {
 	cout << "Look_up_table::eval_thermo_state_rhoe(): Low temperature: rho= " << Q.rho
 	    << " e= " << Q.e[0]
@@ -274,34 +487,90 @@ s_eval_thermo_state_rhoe(Gas_data &Q)
 
 int
 Look_up_table::
-s_eval_transport_coefficients(Gas_data &Q)
+s_eval_thermo_state_rhoe_batch(vector<Gas_data *> &Q)
 {
-    double efrac, lrfrac;
-    double mu_eff, k_eff;
-    int    ir, ie;
-
-    if ( determine_interpolants(Q, ir, ie, lrfrac, efrac) != SUCCESS ) {
-	cout << "Bailing out!\n";
-	exit(1);
+    vector<int> ir, ie;
+    vector<double> lrfrac, efrac;
+    locate_batch(Q, ir, ie, lrfrac, efrac);
+    int status = SUCCESS;
+    double T_min = gas_Tmin();
+    for ( size_t i = 0; i < Q.size(); ++i ) {
+	Gas_data &Qi = *(Q[i]);
+	double Cv_hat = 0.0, R_hat = 0.0, g_hat = 0.0;
+	if ( ir[i] >= 0 ) {
+	    const LUT_record &a = node(ie[i], ir[i]);
+	    const LUT_record &b = node(ie[i]+1, ir[i]);
+	    const LUT_record &c = node(ie[i]+1, ir[i]+1);
+	    const LUT_record &d = node(ie[i], ir[i]+1);
+	    double wa = (1.0 - efrac[i]) * (1.0 - lrfrac[i]);
+	    double wb = efrac[i]         * (1.0 - lrfrac[i]);
+	    double wc = efrac[i]         * lrfrac[i];
+	    double wd = (1.0 - efrac[i]) * lrfrac[i];
+	    Cv_hat = wa * a.Cv_hat + wb * b.Cv_hat + wc * c.Cv_hat + wd * d.Cv_hat;
+	    R_hat  = wa * a.R_hat  + wb * b.R_hat  + wc * c.R_hat  + wd * d.R_hat;
+	    g_hat  = wa * a.g_hat  + wb * b.g_hat  + wc * c.g_hat  + wd * d.g_hat;
+	}
+	if ( ir[i] < 0 || Qi.e[0] / Cv_hat < T_min ) {
+	    // The single-state evaluation does the reporting.
+	    int flag = Look_up_table::s_eval_thermo_state_rhoe(Qi);
+	    if ( flag != SUCCESS && status == SUCCESS ) status = flag;
+	    continue;
+	}
+	Qi.T[0] = Qi.e[0] / Cv_hat;
+	Qi.p = Qi.rho*R_hat*Qi.T[0];
+	Qi.a = sqrt(g_hat*R_hat*Qi.T[0]);
+	if ( Qi.p < 0.0 ) Qi.p = 0.0;
+	if ( Qi.a < 0.0 ) Qi.a = 0.0;
     }
+    return status;
+}
 
-    mu_eff = (1.0 - efrac) * (1.0 - lrfrac) * mu_hat_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * mu_hat_[ie+1][ir] +
-	efrac         * lrfrac         * mu_hat_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * mu_hat_[ie][ir+1];
-
-    k_eff = (1.0 - efrac) * (1.0 - lrfrac) * k_hat_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * k_hat_[ie+1][ir] +
-	efrac         * lrfrac         * k_hat_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * k_hat_[ie][ir+1];
-   
-
-    Q.mu = mu_eff;
-    Q.k[0] = k_eff;
+int
+Look_up_table::
+s_eval_transport_coefficients(Gas_data &Q)
+{
+    LUT_record r;
+    if ( interpolate(Q, r) != SUCCESS ) {
+	cout << "Look_up_table::eval_transport_coefficients(): invalid state: rho= " << Q.rho
+	     << " e= " << Q.e[0] << endl;
+	return VALUE_ERROR;
+    }
+    Q.mu = r.mu_hat;
+    Q.k[0] = r.k_hat;
 
     return (SUCCESS);
 }
 
+int
+Look_up_table::
+s_eval_transport_coefficients_batch(vector<Gas_data *> &Q)
+{
+    // Only the two transport properties are interpolated.
+    vector<int> ir, ie;
+    vector<double> lrfrac, efrac;
+    locate_batch(Q, ir, ie, lrfrac, efrac);
+    int status = SUCCESS;
+    for ( size_t i = 0; i < Q.size(); ++i ) {
+	Gas_data &Qi = *(Q[i]);
+	if ( ir[i] < 0 ) {
+	    int flag = Look_up_table::s_eval_transport_coefficients(Qi);
+	    if ( flag != SUCCESS && status == SUCCESS ) status = flag;
+	    continue;
+	}
+	const LUT_record &a = node(ie[i], ir[i]);
+	const LUT_record &b = node(ie[i]+1, ir[i]);
+	const LUT_record &c = node(ie[i]+1, ir[i]+1);
+	const LUT_record &d = node(ie[i], ir[i]+1);
+	double wa = (1.0 - efrac[i]) * (1.0 - lrfrac[i]);
+	double wb = efrac[i]         * (1.0 - lrfrac[i]);
+	double wc = efrac[i]         * lrfrac[i];
+	double wd = (1.0 - efrac[i]) * lrfrac[i];
+	Qi.mu   = wa * a.mu_hat + wb * b.mu_hat + wc * c.mu_hat + wd * d.mu_hat;
+	Qi.k[0] = wa * a.k_hat  + wb * b.k_hat  + wc * c.k_hat  + wd * d.k_hat;
+    }
+    return status;
+}
+
 int
 Look_up_table::
 s_eval_diffusion_coefficients(Gas_data &Q)
@@ -328,7 +597,7 @@ s_molecular_weight(int isp)
     }
     int ie = 0; // coldest
     int ir = irsteps_ - 1; // quite dense 
-    double Rgas = R_hat_[ie][ir]; // J/kg/deg-K
+    double Rgas = node(ie, ir).R_hat; // J/kg/deg-K
     double M = PC_R_u_kmol / Rgas;
     return M;
 }
@@ -378,35 +647,21 @@ s_entropy(const Gas_data &Q, int isp)
     }
     double s;
     if ( with_entropy ) {
-	int ir, ie;
-	double lrfrac, efrac;
-	if ( determine_interpolants(Q, ir, ie, lrfrac, efrac) != SUCCESS ) {
-	    cout << "Bailing out!\n";
-	    exit(1);
+	LUT_record r;
+	if ( interpolate(Q, r) != SUCCESS ) {
+	    throw runtime_error("LUT gas: invalid state for entropy evaluation");
 	}
-	double Cv_eff = (1.0 - efrac) * (1.0 - lrfrac) * Cv_hat_[ie][ir] +
-	    efrac         * (1.0 - lrfrac) * Cv_hat_[ie+1][ir] +
-	    efrac         * lrfrac         * Cv_hat_[ie+1][ir+1] +
-	    (1.0 - efrac) * lrfrac         * Cv_hat_[ie][ir+1];
-	double R_eff  = (1.0 - efrac) * (1.0 - lrfrac) * R_hat_[ie][ir] +
-	    efrac         * (1.0 - lrfrac) * R_hat_[ie+1][ir] +
-	    efrac         * lrfrac         * R_hat_[ie+1][ir+1] +
-	    (1.0 - efrac) * lrfrac         * R_hat_[ie][ir+1];
-	double Cp_eff  = (1.0 - efrac) * (1.0 - lrfrac) * Cp_hat_[ie][ir] +
-	    efrac         * (1.0 - lrfrac) * Cp_hat_[ie+1][ir] +
-	    efrac         * lrfrac         * Cp_hat_[ie+1][ir+1] +
-	    (1.0 - efrac) * lrfrac         * Cp_hat_[ie][ir+1];
-	double T = Q.e[0] / Cv_eff;
-	double p = Q.rho*R_eff*T;
-	s = s1_ + Cp_eff*log(T/T1_) - R_eff*log(p/p1_);
+	double T = Q.e[0] / r.Cv_hat;
+	double p = Q.rho*r.R_hat*T;
+	s = s1_ + r.Cp_hat*log(T/T1_) - r.R_hat*log(p/p1_);
     } else {
 	// Without having the entropy recorded as part of the original table,
 	// the next best is to use a model of an ideal gas.
 	cout << "Caution: calling s_entropy for LUT species without tabular data." << endl;
 	int ie = 0; // coldest
 	int ir = irsteps_ - 1; // quite dense 
-	double R = R_hat_[ie][ir]; // J/kg/deg-K
-	double Cp = R + Cv_hat_[ie][ir];
+	double R = node(ie, ir).R_hat; // J/kg/deg-K
+	double Cp = R + node(ie, ir).Cv_hat;
 	constexpr double T1 = 300.0; // degrees K
 	constexpr double p1 = 100.0e3; // Pa
 	s = Cp * log(Q.T[0]/T1) - R * log(Q.p/p1);
@@ -418,76 +673,40 @@ double
 Look_up_table::
 s_dedT_const_v(const Gas_data &Q, int &status)
 {
-    double efrac, lrfrac;
-    int    ir, ie;
-    double Cv_actual;
-
-    if ( determine_interpolants(Q, ir, ie, lrfrac, efrac) != SUCCESS ) {
-	cout << "Bailing out!\n";
-	exit(1);
-    }
-
-    Cv_actual = (1.0 - efrac) * (1.0 - lrfrac) * Cv_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * Cv_[ie+1][ir] +
-	efrac         * lrfrac         * Cv_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * Cv_[ie][ir+1];
-
-    status = SUCCESS;
-    return Cv_actual;
-
+    LUT_record r;
+    status = interpolate(Q, r);
+    if ( status != SUCCESS ) return 0.0;
+    return r.Cv;
 }
 
 double
 Look_up_table::
 s_dhdT_const_p(const Gas_data &Q, int &status)
 {
-    double efrac, lrfrac;
-    int    ir, ie;
-    double Cv_actual, R_eff;
-
-    if ( determine_interpolants(Q, ir, ie, lrfrac, efrac) != SUCCESS ) {
-	cout << "Bailing out!\n";
-	exit(1);
-    }
-
-    Cv_actual = (1.0 - efrac) * (1.0 - lrfrac) * Cv_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * Cv_[ie+1][ir] +
-	efrac         * lrfrac         * Cv_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * Cv_[ie][ir+1];
-
-    R_eff  = (1.0 - efrac) * (1.0 - lrfrac) * R_hat_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * R_hat_[ie+1][ir] +
-	efrac         * lrfrac         * R_hat_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * R_hat_[ie][ir+1];
-
-    status = SUCCESS;
-    return (Cv_actual + R_eff);
-
+    LUT_record r;
+    status = interpolate(Q, r);
+    if ( status != SUCCESS ) return 0.0;
+    return (r.Cv + r.R_hat);
 }
 
 double
 Look_up_table::
 s_gas_constant(const Gas_data &Q, int &status)
 {
-    double efrac, lrfrac;
-    int    ir, ie;
-    double R_eff;
-
-    if ( determine_interpolants(Q, ir, ie, lrfrac, efrac) != SUCCESS ) {
-	cout << "Bailing out!\n";
-	exit(1);
-    }
-
-    R_eff  = (1.0 - efrac) * (1.0 - lrfrac) * R_hat_[ie][ir] +
-	efrac         * (1.0 - lrfrac) * R_hat_[ie+1][ir] +
-	efrac         * lrfrac         * R_hat_[ie+1][ir+1] +
-	(1.0 - efrac) * lrfrac         * R_hat_[ie][ir+1];
-
-    status = SUCCESS;
-    return R_eff;
+    LUT_record r;
+    status = interpolate(Q, r);
+    if ( status != SUCCESS ) return 0.0;
+    return r.R_hat;
 }
 
 Gas_model* create_look_up_table_gas_model(const string cfile)
 {
     return new Look_up_table(cfile);
 }
+
+/// \brief Read a look-up table (in either format) and write it as a binary file.
+int write_look_up_table_as_binary(const string cfile, const string fname)
+{
+    Look_up_table lut(cfile);
+    return lut.write_binary_table(fname);
+}
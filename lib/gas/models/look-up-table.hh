@@ -7,12 +7,20 @@
 //     - gzipped text files, instead of binary format
 //     - vector storage instead of arrays
 //     - reworked to fit in new class framework
+//   18-Oct-2026: All properties for a node are now stored together
+//     in one record; the table may also be read from a binary file,
+//     and the energy nodes may be non-uniformly spaced.
+//   19-Oct-2026: Cv and R from the table are used to start the
+//     generic inverse evaluations (pT, rhoT, rhop).
+//     The batched evaluations locate all of the states before
+//     interpolating any of them.
 //
 
 #ifndef LOOK_UP_TABLE_HH
 #define LOOK_UP_TABLE_HH
 
 #include <string>
+#include <vector>
 
 #include "gas_data.hh"
 #include "gas-model.hh"
@@ -21,19 +29,49 @@ class Look_up_table : public Gas_model {
 public:
     Look_up_table(const std::string cfile);
     ~Look_up_table();
+    int write_binary_table(const std::string fname) const;
 private:
+    // The tabulated properties for one (ie, ir) node, held together so
+    // that an interpolation reads four records rather than four scattered
+    // entries per property.  The padding makes a record 64 bytes long;
+    // the table is aligned so that each record sits in one cache line.
+    struct LUT_record {
+	double Cv_hat, Cv, R_hat, Cp_hat, g_hat, mu_hat, k_hat;
+	double pad;
+    };
+    Look_up_table(const Look_up_table &t) = delete;
+    Look_up_table & operator=(const Look_up_table &t) = delete;
+
+    void read_lua_table(const std::string cfile);
+    void read_binary_table(const std::string cfile);
+    void allocate_table();
+    void set_up_energy_index();
+    LUT_record & node(int ie, int ir)
+    { return table_[ie*(irsteps_+1) + ir]; }
+    const LUT_record & node(int ie, int ir) const
+    { return table_[ie*(irsteps_+1) + ir]; }
     int determine_interpolants(const Gas_data &Q, int &ir, int &ie,
-			       double &lrfrac, double &efrac);
+			       double &lrfrac, double &efrac) const;
+    void locate(double logrho, double e, int &ir, int &ie,
+		double &lrfrac, double &efrac) const;
+    int locate_batch(const std::vector<Gas_data *> &Q, std::vector<int> &ir,
+		     std::vector<int> &ie, std::vector<double> &lrfrac,
+		     std::vector<double> &efrac) const;
+    int interpolate(const Gas_data &Q, LUT_record &r) const;
     int s_eval_thermo_state_rhoe(Gas_data &Q);
+    int s_eval_thermo_state_rhoe_batch(std::vector<Gas_data *> &Q);
     int s_eval_transport_coefficients(Gas_data &Q);
+    int s_eval_transport_coefficients_batch(std::vector<Gas_data *> &Q);
     int s_eval_diffusion_coefficients(Gas_data &Q);
-    double s_molecular_weight(int isp); 
+    double s_molecular_weight(int isp);
     double s_internal_energy(const Gas_data &Q, int isp);
     double s_enthalpy(const Gas_data &Q, int isp);
     double s_entropy(const Gas_data &Q, int isp);
     double s_dedT_const_v(const Gas_data &Q, int &status);
     double s_dhdT_const_p(const Gas_data &Q, int &status);
     double s_gas_constant(const Gas_data &Q, int &status);
+    bool s_analytic_thermo_derivatives() const
+    { return true; }
 
     bool with_entropy;
     double s1_, p1_, T1_;
@@ -41,15 +79,20 @@ private:
     double emin_, emax_, de_;
     double lrmin_, lrmax_, dlr_;
 
-    matrix Cv_hat_;
-    matrix Cv_;
-    matrix R_hat_;
-    matrix g_hat_;
-    matrix mu_hat_;
-    matrix k_hat_;
-    matrix Cp_hat_;
+    // Energy values at the nodes.  When they are not uniformly spaced,
+    // e_index_ gives, for each of a set of uniform energy bins,
+    // the last node at or below the start of the bin, so that the
+    // enclosing interval is found with a short forward search.
+    bool uniform_e_;
+    std::vector<double> e_nodes_;
+    std::vector<int> e_index_;
+    double de_index_;
+
+    std::vector<double> storage_; // backing store for table_
+    LUT_record *table_;           // (iesteps_+1) x (irsteps_+1) records, ie-major
 };
 
 Gas_model* create_look_up_table_gas_model(const std::string cfile);
+int write_look_up_table_as_binary(const std::string cfile, const std::string fname);
 
 #endif
@@ -54,8 +54,44 @@ def get_e_range(mygas, T_min, T_max, log_rho_values):
     e_max = min(e_values)
     return e_min, e_max
 
+def get_adapted_e_values(mygas, e_min, e_max, iesteps, log_rho_values, e_offset):
+    """
+    Place the internal-energy nodes closer together where C_v_hat changes quickly.
+
+    :param mygas: cea2 Gas object
+    :param e_min, e_max: range of (CEA) internal energy for the table
+    :param iesteps: number of intervals in internal energy
+    :param log_rho_values: density values of the table, log-base-10
+    :param e_offset: offset to be added to the CEA internal energy
+    :returns: array of iesteps+1 increasing energy values from e_min to e_max
+
+    The gradient of C_v_hat, sampled along a few lines of constant density,
+    is large around the knees of the dissociation and ionization processes.
+    Half of the nodes are spread uniformly and the other half are
+    distributed in proportion to that gradient.
+    """
+    nfine = 2 * iesteps
+    e_fine = numpy.linspace(e_min, e_max, nfine+1)
+    weight = numpy.zeros(nfine)
+    n = len(log_rho_values)
+    for log_rho in [log_rho_values[0], log_rho_values[n//2], log_rho_values[-1]]:
+        Cv_hat = numpy.zeros(nfine+1)
+        for i, e in enumerate(e_fine):
+            mygas.set_rhoe(math.pow(10.0, log_rho), e)
+            Cv_hat[i] = (e + e_offset) / mygas.T
+        dCv = numpy.abs(numpy.diff(Cv_hat))
+        if dCv.sum() > 0.0:
+            weight = numpy.maximum(weight, dCv / dCv.mean())
+    weight = 1.0 + weight / max(weight.mean(), 1.0e-30)
+    cumulative = numpy.concatenate(([0.0], numpy.cumsum(weight)))
+    targets = numpy.linspace(0.0, cumulative[-1], iesteps+1)
+    e_values = numpy.interp(targets, cumulative, e_fine)
+    e_values[0] = e_min; e_values[-1] = e_max
+    return e_values
+
 def build_table(mygas, gasName, T_min=200.0, T_max=20000.0,
-                log_rho_min=-6.0, log_rho_max=2.0, T_for_offset=302.0):
+                log_rho_min=-6.0, log_rho_max=2.0, T_for_offset=302.0,
+                adaptive=False, binary=False):
     """
     Compute gas thermo properties for a mesh of internal-energy and density values
     and write an encoded form of the thermo data to a Lua-format file.
@@ -68,6 +104,8 @@ def build_table(mygas, gasName, T_min=200.0, T_max=20000.0,
     :param log_rho_max: log-base-10 of maximum density in kg/m**3
     :param T_for_offset: Temperature at which to determine energy offset.
         Mostly, any low temperature will suffice, however co2 needs T=600.
+    :param adaptive: if True, cluster the energy nodes where C_v_hat changes quickly.
+    :param binary: if True, also write the table in binary form (needs gaspy).
 
     The file produced is intended for later use by the LUT gas model.
     """
@@ -84,7 +122,11 @@ def build_table(mygas, gasName, T_min=200.0, T_max=20000.0,
     print "e_min=", e_min, "e_max=", e_max
     iesteps = 400
     de = (e_max - e_min) / iesteps
-    e_values = numpy.linspace(e_min, e_max, iesteps+1)
+    if adaptive:
+        e_values = get_adapted_e_values(mygas, e_min, e_max, iesteps,
+                                        log_rho_values, e_offset)
+    else:
+        e_values = numpy.linspace(e_min, e_max, iesteps+1)
     #
     # Set up a reference condition for the entropy data.
     # We pick a point that will not be coincident with any of
@@ -108,6 +150,11 @@ def build_table(mygas, gasName, T_min=200.0, T_max=20000.0,
     # It is nice to have e = Cv * T in the table.
     fp.write("emin = %g\n" % (e_min+e_offset))
     fp.write("de = %g\n" % de)
+    if adaptive:
+        fp.write("e_values = {\n")
+        for e in e_values:
+            fp.write("%.10g,\n" % (e+e_offset))
+        fp.write("}\n")
     fp.write("lrmin = %g\n" % log_rho_min)
     fp.write("dlr = %g\n" % dlr)
     # Now, write the table data.
@@ -129,6 +176,11 @@ def build_table(mygas, gasName, T_min=200.0, T_max=20000.0,
     fp.write("}\n\n")
     fp.close()
     print
+    if binary:
+        from gaspy import write_look_up_table_as_binary
+        bname = 'cea-lut-' + gasName + '.bin'
+        print "Writing out binary form of look-up table: %s" % bname
+        write_look_up_table_as_binary(fname, bname)
     return
 
 #-----------------------------------------------------------------------------
@@ -157,6 +209,10 @@ if __name__ == '__main__':
     parser.add_option("-T", "--T-for-offset", action="store", type="string", dest="T_for_offset",
                       default="302.0",
                       help="Temperature (degree K) at which to evaluate the internal energy offset.")
+    parser.add_option("-a", "--adaptive", action="store_true", dest="adaptive", default=False,
+                      help="cluster the energy nodes where the specific heat changes quickly")
+    parser.add_option("-B", "--binary", action="store_true", dest="binary", default=False,
+                      help="also write the table in binary form, for faster loading")
     group = OptionGroup(parser, "Custom gas options")
     group.add_option("-r", "--reactants", action="store", type="string", dest="reactants",
                      help="reactant fractions in dictionary form")
@@ -214,5 +270,6 @@ if __name__ == '__main__':
         print "Building table for gas name: ", options.gasName
         mygas = make_gas_from_name(options.gasName)
         gasName = options.gasName
-    build_table(mygas, gasName, T_min, T_max, log_rho_min, log_rho_max, T_for_offset)
+    build_table(mygas, gasName, T_min, T_max, log_rho_min, log_rho_max, T_for_offset,
+                options.adaptive, options.binary)
     print "Done."
@@ -1119,3 +1119,196 @@ double TS_data::quick_solve_for_planck_divq( double kappa_nu )
 
     return q_wall;
 }
+
+/* ---------- Streaming tangent-slab integration ----------- */
+
+StreamingTS_data::StreamingTS_data( RadiationSpectralModel * rsm, double T_i, double T_f, int binning_type, int N_bins )
+ : rsm_( rsm ), T_i_( T_i ), T_f_( T_f ), binning_type_( binning_type ), N_bins_( N_bins ), F_bin_( 0 ), q_shock_( 0.0 )
+{
+    if ( binning_type_!=NO_BINNING && N_bins_ < 1 ) {
+        cout << "StreamingTS_data::StreamingTS_data()" << endl
+             << "Spectral binning requires N_bins > 0." << endl
+             << "Exiting program." << endl;
+        exit( BAD_INPUT_ERROR );
+    }
+
+    X_ = new CoeffSpectra( rsm_ );
+
+    // Outer-boundary blackbody intensity (note optical thickness = 0)
+    F_ = new SpectralFlux( rsm_, T_i_ );
+    nnus_ = (int) F_->nu.size();
+    double q_int = 0.0;
+    for ( int inu=1; inu < nnus_; inu++ )
+        q_int += 0.5 * ( F_->q_nu[inu] + F_->q_nu[inu-1] ) * fabs( F_->nu[inu] - F_->nu[inu-1] );
+
+    // Save integrated flux at the shock
+    q_plus_.push_back( q_int );
+}
+
+StreamingTS_data::~StreamingTS_data()
+{
+    delete X_;
+    delete F_;
+    delete F_bin_;
+    for ( size_t irp=0; irp<Q_slab_.size(); ++irp )
+        delete Q_slab_[irp];
+    for ( size_t irp=0; irp<Y_.size(); ++irp )
+        delete Y_[irp];
+    for ( size_t iB=0; iB<B_.size(); ++iB )
+        delete B_[iB];
+}
+
+double StreamingTS_data::add_slab( Gas_data * Q, double s, double ds )
+{
+    // 1. Compute the spectra for this slab, overwriting the last slab's spectra
+    rsm_->radiative_spectra_for_gas_state( *Q, *X_ );
+    if ( (int) X_->nu.size() != nnus_ ) {
+        cout << "StreamingTS_data::add_slab()" << endl
+             << "The coefficient spectra has " << X_->nu.size() << " points but "
+             << nnus_ << " are expected." << endl
+             << "Adaptive spectral grids are not supported." << endl
+             << "Exiting program." << endl;
+        exit( FAILURE );
+    }
+    double j_total = X_->integrate_emission_spectra();
+
+    // 2. Create the spectral bins from the first (post-shock) slab
+    //    NOTE: opacity binning would ideally use the mean opacity over the whole
+    //          path, but that is not known until the march is complete.
+    if ( binning_type_!=NO_BINNING && s_.size()==0 ) {
+        int N_bins_star = 0;
+        if ( binning_type_==FREQUENCY_BINNING )
+            N_bins_star = create_spectral_bin_vector( X_->nu, binning_type_, N_bins_, B_ );
+        else
+            N_bins_star = create_spectral_bin_vector( X_->kappa_nu, binning_type_, N_bins_, B_ );
+        cout << "StreamingTS_data::add_slab()" << endl
+             << "Number of bins for discretisation: " << N_bins_ << endl
+             << "Number of non-zero bins: " << N_bins_star << endl;
+        F_bin_ = new BinnedSpectralFlux( rsm_, T_i_, B_ );
+        q_plus_bin_.push_back( F_bin_->sum_flux() );
+    }
+
+    // 3. Wall-directed (plus) flux through this slab
+    double q_int = 0.0;
+    double tau_nu = 0.0, tmpA = 0.0;
+    for ( int inu=0; inu < nnus_; inu++ ) {
+        // calculate optical thickness between intervals
+        tau_nu = fabs(ds) * X_->kappa_nu[inu];
+        // Attenuate incident flux
+        F_->q_nu[inu] *= 2.0 * E_3( tau_nu );
+        // Add contribution from this slab
+        tmpA = 0.0;
+        if ( X_->j_nu[inu] != 0.0 ) tmpA = X_->j_nu[inu] / X_->kappa_nu[inu];
+        F_->q_nu[inu] += tmpA * M_PI * ( 1.0 -  2.0 * E_3( tau_nu ) );
+        // Integrate
+        if ( inu>0 )
+            q_int += 0.5 * ( F_->q_nu[inu] + F_->q_nu[inu-1] ) * fabs( F_->nu[inu] - F_->nu[inu-1] );
+    }
+
+    // 4. Save the slab data and the coefficients needed for the shock-directed flux
+    s_.push_back( s );
+    ds_.push_back( ds );
+    j_total_.push_back( j_total );
+    q_plus_.push_back( q_int );
+    if ( binning_type_==NO_BINNING ) {
+        Q_slab_.push_back( new Gas_data( *Q ) );
+    }
+    else {
+        Y_.push_back( new BinnedCoeffSpectra( X_, B_ ) );
+        // The binned plus flux is marched alongside so that the divergence
+        // is formed from fluxes of the same spectral resolution.
+        q_plus_bin_.push_back( march_binned_flux( *F_bin_, *Y_.back(), ds ) );
+    }
+
+    return j_total;
+}
+
+double StreamingTS_data::march_binned_flux( BinnedSpectralFlux &F, BinnedCoeffSpectra &Y, double ds )
+{
+    double q_int = 0.0;
+    for ( size_t iB=0; iB < B_.size(); iB++ ) {
+        // emission and absorption coefficients for this slab
+        double kappa = Y.kappa_bin[iB];
+        double j = Y.j_bin[iB];
+        // calculate optical thickness between intervals
+        double tau = fabs(ds) * kappa;
+        // Attenuate incident flux
+        F.q_bin[iB] *= 2.0 * E_3( tau );
+        // Add contribution from this slab
+        double tmpA = 0.0;
+        if ( j != 0.0 ) tmpA = j / kappa;
+        F.q_bin[iB] += tmpA * M_PI * ( 1.0 -  2.0 * E_3( tau ) );
+        // Integrate
+        q_int += F.q_bin[iB];
+    }
+
+    return q_int;
+}
+
+double StreamingTS_data::finalise()
+{
+    int nrps = (int) s_.size();
+
+    // Make vectors to store integrated fluxes
+    vector<double> q_minus;
+
+    /* ------- Wall-to-shock (minus) direction ------- */
+
+    if ( binning_type_==NO_BINNING ) {
+        // Outer-boundary blackbody intensity at full spectral resolution
+        SpectralFlux F_f( rsm_, T_f_ );
+        double q_int = 0.0;
+        for ( int inu=1; inu < nnus_; inu++ )
+            q_int += 0.5 * ( F_f.q_nu[inu] + F_f.q_nu[inu-1] ) * fabs( F_f.nu[inu] - F_f.nu[inu-1] );
+        q_minus.push_back( q_int );
+
+        // integrate over emitting slabs, recomputing the spectra of each
+        for ( int irp=(nrps-1); irp >= 0; --irp ) {
+            rsm_->radiative_spectra_for_gas_state( *Q_slab_[irp], *X_ );
+            q_int = 0.0;
+            for ( int inu=0; inu < nnus_; inu++ ) {
+                // emission and absorption coefficients for this slab
+                double kappa_nu = X_->kappa_nu[inu];
+                double j_nu = X_->j_nu[inu];
+                // calculate optical thickness between intervals
+                double tau_nu = fabs(ds_[irp]) * kappa_nu;
+                // Attenuate incident flux
+                F_f.q_nu[inu] *= 2.0 * E_3( tau_nu );
+                // Add contribution from this slab
+                double tmpA = 0.0;
+                if ( j_nu != 0.0 ) tmpA = j_nu / kappa_nu;
+                F_f.q_nu[inu] += tmpA * M_PI * ( 1.0 -  2.0 * E_3( tau_nu ) );
+                // Integrate
+                if ( inu>0 )
+                    q_int += 0.5 * ( F_f.q_nu[inu] + F_f.q_nu[inu-1] ) * fabs( F_f.nu[inu] - F_f.nu[inu-1] );
+            }
+            // Save integrated flux
+            q_minus.push_back( q_int );
+        }
+    }
+    else {
+        // Outer-boundary blackbody intensity (note optical thickness = 0)
+        BinnedSpectralFlux F_f( rsm_, T_f_, B_ );
+        q_minus.push_back( F_f.sum_flux() );
+
+        // integrate over emitting slabs
+        for ( int irp=(nrps-1); irp >= 0; --irp )
+            q_minus.push_back( march_binned_flux( F_f, *Y_[irp], ds_[irp] ) );
+    }
+    q_shock_ = q_minus.back();
+
+    // calculate radiative divergence from plus and minus fluxes
+    // of the same spectral resolution
+    const vector<double> &q_plus = ( binning_type_==NO_BINNING ) ? q_plus_ : q_plus_bin_;
+    divq_.resize( nrps );
+    for ( int irp=0; irp<nrps; ++irp ) {
+        // use forward differencing to evaluate divergence
+        double q_net_i = q_plus[irp] - q_minus[nrps-irp];
+        double q_net_ip1 = q_plus[irp+1] - q_minus[nrps-irp-1];
+        divq_[irp] = ( q_net_i - q_net_ip1 ) / ds_[irp];
+    }
+
+    // return wall directed flux at full resolution
+    // NOTE: omitting wall emission - which is correct
+    return q_plus_.back();
+}
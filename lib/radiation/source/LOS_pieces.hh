@@ -122,4 +122,72 @@ public:
     SpectralFlux * F_;
 };
 
+class StreamingTS_data {
+public:
+    StreamingTS_data( RadiationSpectralModel * rsm, double T_i=0.0, double T_f=0.0, int binning_type=NO_BINNING, int N_bins=100 );
+
+    ~StreamingTS_data();
+
+public:
+    //       |                  |#
+    // Shock |------------------|# Wall
+    //       |  --> slabs are added in this order as they are computed
+    //
+    // The wall-directed (plus) flux is marched at full spectral resolution as
+    // each slab is added.  The shock-directed (minus) flux depends on all
+    // downstream slabs, so it is marched in finalise().  With NO_BINNING only
+    // the gas state of each slab is kept and its spectra are recomputed during
+    // that march, so no full spectra are held per slab; otherwise N_bins binned
+    // coefficients are kept per slab.  With binning the plus flux is also
+    // marched on the bins, and the divergence is formed from the binned
+    // plus and minus fluxes.
+
+    double add_slab( Gas_data * Q, double s, double ds );
+
+    double finalise();
+
+    int get_nslabs()
+    { return (int) s_.size(); }
+
+private:
+    double march_binned_flux( BinnedSpectralFlux &F, BinnedCoeffSpectra &Y, double ds );
+
+public:
+    RadiationSpectralModel * rsm_;
+
+    int nnus_;
+    double T_i_;
+    double T_f_;
+
+    int binning_type_;
+    int N_bins_;
+
+    /* Coefficient spectra workspace for the current slab */
+    CoeffSpectra * X_;
+
+    /* Wall-directed spectral flux */
+    SpectralFlux * F_;
+
+public:
+    /* Gas state of each slab (NO_BINNING only) */
+    std::vector<Gas_data*> Q_slab_;
+
+    /* Spectral bins, the binned coefficients for each slab
+       and the binned wall-directed flux */
+    std::vector<SpectralBin*> B_;
+    std::vector<BinnedCoeffSpectra*> Y_;
+    BinnedSpectralFlux * F_bin_;
+
+    /* Slab data */
+    std::vector<double> s_;
+    std::vector<double> ds_;
+    std::vector<double> j_total_;
+    std::vector<double> q_plus_;
+    std::vector<double> q_plus_bin_;
+    std::vector<double> divq_;
+
+    /* Shock-directed flux escaping through the shock */
+    double q_shock_;
+};
+
 #endif
@@ -164,6 +164,7 @@ calculate_spectrum( CoeffSpectra &X )
     inu_start = get_nu_index(X.nu,nu_lower,X.adaptive) + 1;
     inu_end = get_nu_index(X.nu,nu_upper,X.adaptive) + 1;
 #   endif
+    X.declare_active_range( inu_start, inu_end );
 
     double nu, delta_nu, b_nu;
 
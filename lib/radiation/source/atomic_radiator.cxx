@@ -553,13 +553,21 @@ QSSAtomicRadiator( lua_State * L, string name )
     	     << name << endl;
     }
     
+    // 3. Options for the rate tables and the population cache
+    QSS_options = new QSSOptions( L );
+    
     lua_pop(L, 1);	// pop QSS_model table
     
-    // 3. Initialise the working matrices and vectors
+    // 4. Initialise the working matrices and vectors
     dGdy = new Valmatrix();
     dGdy->resize( noneq_elevs.size(), noneq_elevs.size() );
     C.resize( noneq_elevs.size(), 0.0 );
     y_out.resize( noneq_elevs.size(), 0.0 );
+    
+    // The rates are tabulated on first use, when a gas-state is available
+    rates_tabulated = false;
+    QSS_solver = new QSSBatchSolver( noneq_elevs.size() );
+    QSS_cache = new QSSPopulationCache( QSS_options->cache_tolerance, QSS_options->cache_size );
 }
  
 QSSAtomicRadiator::
@@ -572,6 +580,9 @@ QSSAtomicRadiator::
     	delete reactions[i];
     
     delete dGdy;
+    delete QSS_options;
+    delete QSS_solver;
+    delete QSS_cache;
 }
 
 void
@@ -855,45 +866,26 @@ calculate_n_e( Gas_data &Q )
     	return;
     }
     
-    // 0. Reset Jacobian matrix and source and solution vectors
-    for ( size_t i=0; i<noneq_elevs.size(); ++i ) {
-	C[i] = 0.0;
-	y_out[i] = 0.0;
-	for ( size_t j=0; j<noneq_elevs.size(); ++j ) {
-	    dGdy->set( i, j, 0.0 );
+    // 0-4. Assemble and solve the system, unless the populations for
+    //      this gas-state are already known
+    if ( !QSS_cache->lookup( Q, y_out ) ) {
+	if ( !rates_tabulated ) {
+	    if ( tabulate_QSS_rates( reactions, Q, *QSS_options ) != SUCCESS ) exit( FAILURE );
+	    rates_tabulated = true;
 	}
-    }
-    
-    // 1.  Population summations, first matrix row
-    for ( size_t ne_ilev=0; ne_ilev<noneq_elevs.size(); ++ne_ilev ) {
-    	double bf_acc = 0.0;	// accumulated boltzmann fractions
-    	for ( size_t eq_ilev=0; eq_ilev<noneq_elevs[ne_ilev]->eq_elevs.size(); ++eq_ilev ) {
-    	    bf_acc += noneq_elevs[ne_ilev]->eq_elevs[eq_ilev]->get_Q_el() / noneq_elevs[ne_ilev]->elev->get_Q_el();
-    	}
-    	double tmp = dGdy->get(0,ne_ilev) + 1.0 + bf_acc;
-    	dGdy->set(0,ne_ilev,tmp);
-    }
-    
-    // 2. Contributions from reactions
-    for ( size_t ir=0; ir<reactions.size(); ++ir )
-	reactions[ir]->add_jacobian_contributions( Q, *dGdy );
-    
-    // 3. Construct source vector
-    C[0] = Q.massf[isp] * Q.rho / m_w / 1.0e6;		// Convert moles/m**3 to moles/cm**3
-    // NOTE: some reactions such as EII have terms that will not be a function of the unknown
-    //       populations, therefore they need to go in the source vector for this method
-    for ( size_t ir=0; ir<reactions.size(); ++ir )
-    	reactions[ir]->add_source_vector_contributions( Q, C );
-    
-    // 4. Solve the system
-    if( dGdy->gaussian_elimination(y_out, C) ) {
-        cout << "QSSAtomicRadiator::calculate_n_e()" << endl
-             << "Gaussian elimination failed for QSSAtomicRadiator: " << name << endl
-             << "The gas-state was: " << endl
-             << "Q.T[0] = " << Q.T[0] << endl
-             << "Q.p = " << Q.p << endl
-             << "Q.p_e = " << Q.p_e << endl;
-        exit( FAILURE );
+	assemble_QSS_system( Q );
+	
+        // 4. Solve the system
+        if( dGdy->gaussian_elimination(y_out, C) ) {
+            cout << "QSSAtomicRadiator::calculate_n_e()" << endl
+                 << "Gaussian elimination failed for QSSAtomicRadiator: " << name << endl
+                 << "The gas-state was: " << endl
+                 << "Q.T[0] = " << Q.T[0] << endl
+                 << "Q.p = " << Q.p << endl
+                 << "Q.p_e = " << Q.p_e << endl;
+            exit( FAILURE );
+        }
+	if ( QSS_cache->get_tolerance() > 0.0 ) QSS_cache->store( Q, y_out );
     }
     
     // 5.  Map results back onto radiator
@@ -954,6 +946,90 @@ calculate_n_e( Gas_data &Q )
 #   endif
 }
 
+void
+QSSAtomicRadiator::
+assemble_QSS_system( Gas_data &Q )
+{
+    // 0. Reset Jacobian matrix and source and solution vectors
+    for ( size_t i=0; i<noneq_elevs.size(); ++i ) {
+	C[i] = 0.0;
+	y_out[i] = 0.0;
+	for ( size_t j=0; j<noneq_elevs.size(); ++j ) {
+	    dGdy->set( i, j, 0.0 );
+	}
+    }
+    
+    // 1.  Population summations, first matrix row
+    for ( size_t ne_ilev=0; ne_ilev<noneq_elevs.size(); ++ne_ilev ) {
+    	double bf_acc = 0.0;	// accumulated boltzmann fractions
+    	for ( size_t eq_ilev=0; eq_ilev<noneq_elevs[ne_ilev]->eq_elevs.size(); ++eq_ilev ) {
+    	    bf_acc += noneq_elevs[ne_ilev]->eq_elevs[eq_ilev]->get_Q_el() / noneq_elevs[ne_ilev]->elev->get_Q_el();
+    	}
+    	double tmp = dGdy->get(0,ne_ilev) + 1.0 + bf_acc;
+    	dGdy->set(0,ne_ilev,tmp);
+    }
+    
+    // 2. Contributions from reactions
+    for ( size_t ir=0; ir<reactions.size(); ++ir )
+	reactions[ir]->add_jacobian_contributions( Q, *dGdy );
+    
+    // 3. Construct source vector
+    C[0] = Q.massf[isp] * Q.rho / m_w / 1.0e6;		// Convert moles/m**3 to moles/cm**3
+    // NOTE: some reactions such as EII have terms that will not be a function of the unknown
+    //       populations, therefore they need to go in the source vector for this method
+    for ( size_t ir=0; ir<reactions.size(); ++ir )
+    	reactions[ir]->add_source_vector_contributions( Q, C );
+    
+    return;
+}
+
+void
+QSSAtomicRadiator::
+prepare_n_e( vector<Gas_data*> &Q )
+{
+    // 0. Select the gas-states that calculate_n_e() would solve for
+    if ( QSS_cache->get_tolerance()==0.0 ) QSS_cache->clear();
+    vector<Gas_data*> Q_solve;
+    for ( size_t iQ=0; iQ<Q.size(); ++iQ ) {
+    	if ( Q[iQ]->T.back() < T_lower || QSS_cache->lookup( *Q[iQ], y_out ) ) continue;
+    	Q_solve.push_back( Q[iQ] );
+    }
+    if ( Q_solve.size()==0 ) return;
+    
+    if ( !rates_tabulated ) {
+	if ( tabulate_QSS_rates( reactions, *Q_solve[0], *QSS_options ) != SUCCESS ) exit( FAILURE );
+	rates_tabulated = true;
+    }
+    
+    // 1. Assemble and solve in batches, keeping the accepted solutions;
+    //    calculate_n_e() solves the rejected ones directly.  Once the
+    //    pattern is known to fill in, each system is solved as it is
+    //    assembled instead.
+    size_t i0 = 0;
+    while ( i0<Q_solve.size() ) {
+    	size_t nsys = min( QSS_solver->get_batch_size(), Q_solve.size() - i0 );
+    	QSS_solver->reset( nsys );
+    	for ( size_t isys=0; isys<nsys; ++isys ) {
+    	    // The conservation row needs this gas-state's partition functions
+    	    calculate_Q_int( *Q_solve[i0+isys] );
+    	    assemble_QSS_system( *Q_solve[i0+isys] );
+    	    if ( !QSS_solver->is_dense() ) QSS_solver->load_system( isys, *dGdy, C );
+    	    if ( QSS_solver->is_dense() && dGdy->gaussian_elimination( y_out, C )==0 )
+    	    	QSS_cache->store( *Q_solve[i0+isys], y_out );
+    	}
+    	if ( !QSS_solver->is_dense() ) {
+    	    QSS_solver->solve();
+    	    for ( size_t isys=0; isys<nsys; ++isys ) {
+    	    	if ( QSS_solver->get_solution( isys, y_out ) )
+    	    	    QSS_cache->store( *Q_solve[i0+isys], y_out );
+    	    }
+    	}
+    	i0 += nsys;
+    }
+    
+    return;
+}
+
 /********************* FirstOrderLTNEAtomicRadiator *********************/
 
 FirstOrderLTNEAtomicRadiator::
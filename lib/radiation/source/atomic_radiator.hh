@@ -24,6 +24,7 @@ extern "C" {
 #include "radiator.hh"
 #include "atomic_line.hh"
 #include "cr_reactions.hh"
+#include "qss_solver.hh"
 
 // For creating atomic radiative transitions
 #define MIN_TRANSITION_PROBABILITY 0.0
@@ -195,6 +196,12 @@ private:
     /// \brief Calculate electronic state number densities
     void calculate_n_e( Gas_data &Q );
     
+    /// \brief Solve for the electronic state number densities of many gas-states together
+    void prepare_n_e( std::vector<Gas_data*> &Q );
+    
+    /// \brief Assemble the QSS system (dGdy and C) for a gas-state
+    void assemble_QSS_system( Gas_data &Q );
+    
 private:
     Radiator * ion;
     Radiator * elec;
@@ -206,6 +213,11 @@ private:
     std::vector<double> y_out;
     
     double T_lower;
+    
+    QSSOptions * QSS_options;
+    bool rates_tabulated;
+    QSSBatchSolver * QSS_solver;
+    QSSPopulationCache * QSS_cache;
 };
 
 class FirstOrderLTNEAtomicRadiator : public AtomicRadiator {
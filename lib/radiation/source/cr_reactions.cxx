@@ -7,6 +7,7 @@
  *
  **/
 #include <cstdlib> 
+#include <cmath>
 #include <sstream>
  
 #include "../../util/source/useful.h"
@@ -20,6 +21,58 @@
 
 using namespace std;
 
+/******************************* CR_RateTable *******************************/
+
+CR_RateTable::CR_RateTable()
+: T_min( 0.0 ), T_max( 0.0 ), lnT_min( 0.0 ), dlnT( 1.0 ), logarithmic( false )
+{}
+
+void
+CR_RateTable::
+set( double T_min_, double T_max_, const vector<double> &f_ )
+{
+    T_min = T_min_;
+    T_max = T_max_;
+    lnT_min = log( T_min );
+    dlnT = ( log( T_max ) - lnT_min ) / double( f_.size() - 1 );
+    
+    // Interpolate the logarithm unless the function reaches zero,
+    // as it does below the threshold of some curve fits
+    logarithmic = true;
+    for ( size_t i=0; i<f_.size(); ++i ) {
+    	if ( !( f_[i] > 0.0 ) ) logarithmic = false;
+    }
+    f.resize( f_.size() );
+    for ( size_t i=0; i<f_.size(); ++i )
+    	f[i] = ( logarithmic ) ? log( f_[i] ) : f_[i];
+    
+    return;
+}
+
+double
+CR_RateTable::
+eval( double T ) const
+{
+    int n = int( f.size() );
+    double x = ( log( T ) - lnT_min ) / dlnT;
+    
+    if ( !logarithmic || n < 4 ) {
+	int i = min( max( int( x ), 0 ), n - 2 );
+	double t = x - double( i );
+	return ( 1.0 - t ) * f[i] + t * f[i+1];
+    }
+    
+    // Cubic Lagrange interpolation through nodes i-1, i, i+1 and i+2
+    int i = min( max( int( x ), 1 ), n - 3 );
+    double t = x - double( i );
+    double w0 = - t * ( t - 1.0 ) * ( t - 2.0 ) / 6.0;
+    double w1 = ( t + 1.0 ) * ( t - 1.0 ) * ( t - 2.0 ) / 2.0;
+    double w2 = - ( t + 1.0 ) * t * ( t - 2.0 ) / 2.0;
+    double w3 = ( t + 1.0 ) * t * ( t - 1.0 ) / 6.0;
+    
+    return exp( w0 * f[i-1] + w1 * f[i] + w2 * f[i+1] + w3 * f[i+2] );
+}
+
 /******************************* CR_Reaction ********************************/
 
 CR_Reaction::CR_Reaction( string type )
@@ -51,7 +104,10 @@ int
 CR_Reaction::
 eval_reaction_rates( double T_f, double T_b, Gas_data &Q, double &k_f, double &k_b )
 {
-    if ( backward_rate_coeff->get_equilibrium_flag() ) {
+    if ( this->eval_tabulated_rates( T_f, T_b, k_f, k_b ) ) {
+	// Both temperatures are within the tabulated range
+    }
+    else if ( backward_rate_coeff->get_equilibrium_flag() ) {
 	k_f = forward_rate_coeff->get_rate( T_f, Q );
 	double Kc = this->eval_equilibrium_constant( T_b );
 	double k_f_star;
@@ -84,6 +140,71 @@ eval_reaction_rates( double T_f, double T_b, Gas_data &Q, double &k_f, double &k
     return SUCCESS;
 }
 
+int
+CR_Reaction::
+tabulate_rates( Gas_data &Q, double T_min, double T_max, int nT )
+{
+    if ( nT < 2 || T_min <= 0.0 || T_max <= T_min ) {
+    	cout << "CR_Reaction::tabulate_rates()" << endl
+    	     << "Invalid table: T_min = " << T_min << ", T_max = " << T_max
+    	     << ", nT = " << nT << endl;
+    	return FAILURE;
+    }
+    
+    // The same branches as eval_reaction_rates(), so that the tables
+    // reproduce the direct evaluation at the nodes
+    bool forward_eq = !backward_rate_coeff->get_equilibrium_flag() &&
+		       forward_rate_coeff->get_equilibrium_flag();
+    vector<double> k_f_vals( nT ), k_b_vals( nT ), Kc_vals( nT );
+    for ( int i=0; i<nT; ++i ) {
+    	double T = T_min * pow( T_max / T_min, double(i) / double(nT-1) );
+    	if ( i==nT-1 ) T = T_max;
+    	if ( backward_rate_coeff->get_equilibrium_flag() ) {
+    	    k_f_vals[i] = forward_rate_coeff->get_rate( T, Q );
+    	    k_b_vals[i] = k_f_vals[i] / this->eval_equilibrium_constant( T );
+    	}
+    	else if ( forward_eq ) {
+    	    k_b_vals[i] = backward_rate_coeff->get_rate( T, Q );
+    	    Kc_vals[i] = this->eval_equilibrium_constant( T );
+    	}
+    	else {
+    	    k_f_vals[i] = forward_rate_coeff->get_rate( T, Q );
+    	    k_b_vals[i] = backward_rate_coeff->get_rate( T, Q );
+    	}
+    	if ( !isfinite(k_f_vals[i]) || !isfinite(k_b_vals[i]) || !isfinite(Kc_vals[i]) ) {
+    	    cout << "CR_Reaction::tabulate_rates()" << endl
+    	         << "Non-finite rate at T = " << T << " for: " << this->get_equation() << endl;
+    	    return FAILURE;
+    	}
+    }
+    
+    k_b_table.set( T_min, T_max, k_b_vals );
+    if ( forward_eq ) Kc_table.set( T_min, T_max, Kc_vals );
+    else k_f_table.set( T_min, T_max, k_f_vals );
+    
+    return SUCCESS;
+}
+
+bool
+CR_Reaction::
+eval_tabulated_rates( double T_f, double T_b, double &k_f, double &k_b )
+{
+    if ( !k_b_table.in_range( T_b ) ) return false;
+    
+    if ( Kc_table.in_range( T_f ) ) {
+    	k_b = k_b_table.eval( T_b );
+    	k_f = k_b * Kc_table.eval( T_f );
+    	return true;
+    }
+    else if ( k_f_table.in_range( T_f ) ) {
+    	k_f = k_f_table.eval( T_f );
+    	k_b = k_b_table.eval( T_b );
+    	return true;
+    }
+    
+    return false;
+}
+
 /************************ HeavyParticleImpactExcitation **************************/
 
 HeavyParticleImpactExcitation::
@@ -1114,6 +1235,19 @@ eval_reaction_rates( double T_f, double T_b, Gas_data &Q, double &k_f, double &k
     return SUCCESS;
 }
 
+int
+RadiativeTransition::
+tabulate_rates( Gas_data &Q, double T_min, double T_max, int nT )
+{
+    // The decay rates are evaluated at a dummy temperature, so there is nothing to tabulate
+    UNUSED_VARIABLE(Q);
+    UNUSED_VARIABLE(T_min);
+    UNUSED_VARIABLE(T_max);
+    UNUSED_VARIABLE(nT);
+    
+    return SUCCESS;
+}
+
 double
 RadiativeTransition::
 eval_equilibrium_constant( double T )
@@ -1259,7 +1393,8 @@ int
 PhotoRecombination::
 eval_reaction_rates( double T_f, double T_b, Gas_data &Q, double &k_f, double &k_b )
 {
-    k_f = forward_rate_coeff->get_rate( T_f, Q );
+    if ( k_f_table.in_range( T_f ) ) k_f = k_f_table.eval( T_f );
+    else k_f = forward_rate_coeff->get_rate( T_f, Q );
     k_b = 0.0;
 
     return SUCCESS;
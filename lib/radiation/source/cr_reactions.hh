@@ -11,6 +11,7 @@
 #define CR_REACTIONS_HH
 
 #include <string>
+#include <vector>
 
 extern "C" {
 #include <lua.h>
@@ -24,6 +25,28 @@ extern "C" {
 #include "radiator.hh"
 #include "cr_rr_coeffs.hh"
 
+/// \brief A function of temperature tabulated at points evenly spaced in ln(T)
+class CR_RateTable {
+public:
+    CR_RateTable();
+    
+public:
+    /// \brief Store the values f[i] at T_min*(T_max/T_min)^(i/(n-1))
+    void set( double T_min, double T_max, const std::vector<double> &f );
+    
+    bool in_range( double T ) const
+    { return f.size() > 0 && T >= T_min && T <= T_max; }
+    
+    /// \brief Interpolate the table (cubic in ln(f) if all values are positive, otherwise linear in f)
+    double eval( double T ) const;
+    
+private:
+    double T_min, T_max;
+    double lnT_min, dlnT;
+    bool logarithmic;
+    std::vector<double> f;
+};
+
 class CR_Reaction {
 public:
     /// \brief Constructor
@@ -39,17 +62,29 @@ public:
     
 public:
     virtual int eval_reaction_rates( double T_f, double T_b, Gas_data &Q, double &k_f, double &k_b );
+    /// \brief Tabulate the rate coefficients in T for later use by eval_reaction_rates()
+    virtual int tabulate_rates( Gas_data &Q, double T_min, double T_max, int nT );
     virtual double eval_equilibrium_constant( double T ) = 0;
     virtual int add_jacobian_contributions( Gas_data &Q, Valmatrix &dGdy ) = 0;
     virtual int add_eval_contributions( Gas_data &Q, std::vector<double> &G ) = 0;
     virtual int add_source_vector_contributions( Gas_data &Q, std::vector<double> &C ) = 0;
     virtual std::string get_latex_string() = 0;
     
+protected:
+    bool eval_tabulated_rates( double T_f, double T_b, double &k_f, double &k_b );
+    
 protected:
     std::string type;
     std::string equation;
     CR_ReactionRateCoefficient *forward_rate_coeff;
     CR_ReactionRateCoefficient *backward_rate_coeff;
+    
+    // Tabulated forms of the rate coefficients.  When the backward rate
+    // comes from the equilibrium constant k_b_table holds k_f/Kc, and
+    // when the forward rate does Kc_table holds Kc.
+    CR_RateTable k_f_table;
+    CR_RateTable k_b_table;
+    CR_RateTable Kc_table;
 };
 
 class HeavyParticleImpactExcitation : public CR_Reaction {
@@ -228,6 +263,7 @@ public:
     
 public:
     int eval_reaction_rates( double T_f, double T_b, Gas_data &Q, double &k_f, double &k_b );
+    int tabulate_rates( Gas_data &Q, double T_min, double T_max, int nT );
     double eval_equilibrium_constant( double T );
     int add_jacobian_contributions( Gas_data &Q, Valmatrix &dGdy );
     int add_eval_contributions( Gas_data &Q, std::vector<double> &G );
@@ -26,6 +26,7 @@ extern "C" {
 
 class CR_ReactionRateCoefficient {
 public:
+    CR_ReactionRateCoefficient() : equilibrium_flag( false ) {};
     virtual ~CR_ReactionRateCoefficient() {};
 public:
     virtual double get_rate( double T, Gas_data &Q ) = 0;
@@ -238,6 +238,7 @@ calculate_spectrum( CoeffSpectra &X )
     inu_start = get_nu_index(X.nu,nu_lower,X.adaptive) + 1;
     inu_end = get_nu_index(X.nu,nu_upper,X.adaptive) + 1;
 #   endif
+    X.declare_active_range( inu_start, inu_end );
 	
     // 2. Loop over predetermined frequency range,
     //    compute j_nu and kappa_nu
@@ -23,6 +23,7 @@ extern "C" {
 #include "radiator.hh"
 #include "diatomic_system.hh"
 #include "cr_reactions.hh"
+#include "qss_solver.hh"
 
 /*** Control flags ***/
 #define EXACT_Q_ROT 0			// Exact (1) or approx (0) rotational partition functions (NOTE: requires LIMIT_V_TO_GLOBAL_MAX==1)
@@ -354,6 +355,12 @@ private:
     /// \brief Calculate electronic state number densities
     void calculate_n_e( Gas_data &Q );
     
+    /// \brief Solve for the electronic state number densities of many gas-states together
+    void prepare_n_e( std::vector<Gas_data*> &Q );
+    
+    /// \brief Assemble the QSS system (dGdy and C) for a gas-state
+    void assemble_QSS_system( Gas_data &Q );
+    
 public:
     std::vector<NoneqElecLev*> noneq_elevs;    
     
@@ -368,6 +375,11 @@ private:
     std::vector<double> y_out;
     
     double T_lower;
+    
+    QSSOptions * QSS_options;
+    bool rates_tabulated;
+    QSSBatchSolver * QSS_solver;
+    QSSPopulationCache * QSS_cache;
 };
 
 class NoneqDiatomicRadiator : public DiatomicRadiator {
@@ -66,6 +66,7 @@ FreeFreeHydrogenic::calculate_spectrum( Gas_data &Q, CoeffSpectra &X, double n_e
     double kappa_ff_tmpB = j_ff_tmpB;
     
     /* 2. Loop over frequency */
+    X.declare_active_range( 0, nnu );
     for ( int inu=0; inu<nnu; ++inu ) {
 	double nu = X.nu[inu];
 	double j_ff_nu = j_ff_tmpA * j_ff_tmpB * exp ( - RC_h_SI * nu / (RC_k_SI * T) ) * 1.0e-1;     // erg / cm**-3 - Hz -> J / m**-3 - Hz
@@ -151,6 +152,7 @@ BoundFreeHydrogenic::calculate_spectrum( Gas_data &Q, CoeffSpectra &X, double n_
         // double nu_min = ( Rn->I - E_i ) / RC_h_SI;
         double nu_min = Rn->get_elev_pointer(ilev)->PICS_model->get_threshold_energy() / RC_h_SI;
         int inu_min = get_nu_index( X.nu, nu_min, X.adaptive ) + 1;
+        X.declare_active_range( inu_min, nnu );
         /* 2a. Loop over frequency and add contributions */
         for ( int inu=inu_min; inu<nnu; ++inu ) {
             double nu = X.nu[inu];
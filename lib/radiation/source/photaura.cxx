@@ -25,7 +25,8 @@ using namespace std;
 
 Photaura::
 Photaura( lua_State * L )
- : RadiationSpectralModel( L )
+ : RadiationSpectralModel( L ), fixed_nu_version( 0 ), fixed_nu_points( 0 ),
+   fixed_nu_lambda_min( 0.0 ), fixed_nu_lambda_max( 0.0 )
 {
     lua_getfield(L, -1, "radiators" );
     if ( !lua_istable(L, -1) ) {
@@ -85,7 +86,8 @@ Photaura( lua_State * L )
 
 Photaura::
 Photaura( const string input_file )
- : RadiationSpectralModel( input_file )
+ : RadiationSpectralModel( input_file ), fixed_nu_version( 0 ), fixed_nu_points( 0 ),
+   fixed_nu_lambda_min( 0.0 ), fixed_nu_lambda_max( 0.0 )
 {
     // 1. Get spectral_model string from lua file
     lua_State *L = initialise_radiation_lua_State();
@@ -289,8 +291,8 @@ variably_integrated_emission_for_gas_state( Gas_data &Q, double wavel_switch, do
     double j_total = 0.0;
     
     if ( spectrally_resolved == true ) {
-        // 0. Create a CoeffSpectra class to perform the spectral calculations
-        CoeffSpectra S;
+        // 0. Use the workspace to perform the spectral calculations
+        CoeffSpectra &S = S_work;
 
         // 1. Store the radiation spectrum for the specified gas-state
         spectra_for_gas_state( Q, S );
@@ -318,8 +320,8 @@ double
 Photaura::
 integrate_emission_spectrum( Gas_data &Q )
 {
-    // 0. Create a CoeffSpectra class to perform the spectral calculations
-    CoeffSpectra S;
+    // 0. Use the workspace to perform the spectral calculations
+    CoeffSpectra &S = S_work;
     
     // 1. Store the radiation spectrum for the specified gas-state
     spectra_for_gas_state( Q, S );
@@ -382,18 +384,23 @@ spectra_for_gas_state( Gas_data &Q, CoeffSpectra &X )
     /* 1. Initialise all radiator mechanisms (partition functions, populations, linewidths) */
     initialise_all_radiators(Q);
     
-    /* 2. Calculate the frequency distribution to be used for the spectrum. */
-    make_spectral_grid(X.nu);
+    /* 2. Calculate the frequency distribution to be used for the spectrum,
+          and initialise the j_nu and kappa_nu vectors to zero */
+    if ( adaptive_spectral_grid ) {
+	make_spectral_grid(X.nu);
+	X.unbind_grid();
+	X.j_nu.assign(X.nu.size(),0.0);
+	X.kappa_nu.assign(X.nu.size(),0.0);
+    }
+    else {
+	// The uniform grid does not depend on the gas-state, so spectra
+	// that were last computed on it need only their active parts cleared
+	bind_to_fixed_spectral_grid(X);
+    }
 #   if DEBUG_RAD > 0
     cout << "Photaura::spectra_for_gas_state() - X.nu.size() = " << X.nu.size() << endl;
     cout << "lambda_min = " << nu2lambda(X.nu.back()) << ", lambda_max = " << nu2lambda(X.nu.front()) << endl;
 #   endif
-
-    /* 2a. Clear, resize and initialise to zero the j_nu and kappa_nu vectors */
-    X.j_nu.clear();
-    X.j_nu.resize(X.nu.size(),0.0);
-    X.kappa_nu.clear();
-    X.kappa_nu.resize(X.nu.size(),0.0);
     
     /* 3. Proceed with spectral emission and absorption calculations */
     for ( int irad=0; irad<nrad; ++irad)  {
@@ -413,6 +420,25 @@ spectra_for_gas_state( Gas_data &Q, CoeffSpectra &X )
     return;
 }
 
+void
+Photaura::
+bind_to_fixed_spectral_grid( CoeffSpectra &X )
+{
+    // Remake the grid if the spectral parameters have changed (eg. for a new spectral block)
+    if ( fixed_nu_points!=get_spectral_points() || fixed_nu_lambda_min!=get_lambda_min() ||
+         fixed_nu_lambda_max!=get_lambda_max() ) {
+	make_spectral_grid(fixed_nu);
+	fixed_nu_points = get_spectral_points();
+	fixed_nu_lambda_min = get_lambda_min();
+	fixed_nu_lambda_max = get_lambda_max();
+	++fixed_nu_version;
+    }
+    
+    X.bind_to_grid( fixed_nu, fixed_nu_version );
+    
+    return;
+}
+
 void
 Photaura::
 make_spectral_grid(vector<double> &nus)
@@ -580,6 +606,23 @@ write_QSS_analysis_files( Gas_data &Q, int index )
     return;
 }
 
+void
+Photaura::
+prep_level_pops( vector<Gas_data*> &Q )
+{
+    for ( size_t irad=0; irad<radiators.size(); ++irad ) {
+    	if ( radiators[irad]->EPM!="QSS" ) continue;
+    	// The same concentration limit as initialise_all_radiators()
+    	vector<Gas_data*> Q_rad;
+    	for ( size_t iQ=0; iQ<Q.size(); ++iQ ) {
+    	    if ( get_rad_conc(*Q[iQ],irad) > MIN_CONC ) Q_rad.push_back( Q[iQ] );
+    	}
+    	radiators[irad]->prep_elec_pops( Q_rad );
+    }
+    
+    return;
+}
+
 void impose_min_interval( std::vector<double> &V, double delta_min )
 {
     size_t iV = 1, Vsize = V.size();
@@ -65,6 +65,8 @@ private:
     
     void make_spectral_grid(std::vector<double> &nus);
     
+    void bind_to_fixed_spectral_grid( CoeffSpectra &X );
+    
     void write_line_widths( Gas_data &Q );
     
     void initialise_all_radiators( Gas_data &Q );
@@ -77,11 +79,23 @@ private:
     
     void write_QSS_analysis_files( Gas_data &Q, int index );
     
+    void prep_level_pops( std::vector<Gas_data*> &Q );
+    
 private:
     
     int nrad;
     
     std::vector<Radiator*> radiators;
+    
+    /* The uniform spectral grid, made once for the current spectral
+       parameters, and its version number */
+    std::vector<double> fixed_nu;
+    int fixed_nu_version;
+    int fixed_nu_points;
+    double fixed_nu_lambda_min, fixed_nu_lambda_max;
+    
+    /* Workspace for spectra that are only integrated */
+    CoeffSpectra S_work;
 };
 
 void impose_min_interval( std::vector<double> &X, double delta_X_min );
@@ -95,6 +95,7 @@ calculate_spectrum( Gas_data &Q, CoeffSpectra &X )
 {
     double T = Q.T[iTe];
     
+    X.declare_active_range( 0, int(X.nu.size()) );
     for ( size_t inu=0; inu<X.nu.size(); ++inu ) {
 	double nu = X.nu[inu];
 	X.j_nu[inu] += kappa_const * planck_intensity( nu, T );
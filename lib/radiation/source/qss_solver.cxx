@@ -0,0 +1,367 @@
+/** \file qss_solver.cxx
+ *  \ingroup radiation
+ *
+ *  \version 19-Oct-2026: initial implementation
+ *  \brief Batched solution of the quasi-steady-state level population systems
+ *
+ **/
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+#include "../../util/source/useful.h"
+#include "../../util/source/lua_service.hh"
+
+#include "qss_solver.hh"
+#include "cr_reactions.hh"
+
+using namespace std;
+
+/******************************** QSSOptions *********************************/
+
+namespace {
+    double get_optional_number( lua_State * L, const char * key, double default_value )
+    {
+	lua_getfield(L, -1, key);
+	double value = default_value;
+	if ( !lua_isnil(L, -1) ) value = luaL_checknumber(L, -1);
+	lua_pop(L, 1);
+	return value;
+    }
+}
+
+QSSOptions::
+QSSOptions( lua_State * L )
+{
+    // All optional entries in the QSS_model table
+    rate_table_T_min = get_optional_number( L, "rate_table_T_min", QSS_RATE_TABLE_T_MIN );
+    rate_table_T_max = get_optional_number( L, "rate_table_T_max", QSS_RATE_TABLE_T_MAX );
+    rate_table_points = int( get_optional_number( L, "rate_table_points", QSS_RATE_TABLE_POINTS ) );
+    cache_tolerance = get_optional_number( L, "cache_tolerance", 0.0 );
+    cache_size = int( get_optional_number( L, "cache_size", QSS_CACHE_SIZE ) );
+
+    if ( rate_table_points != 0 && ( rate_table_points < 4 || rate_table_T_min <= 0.0 ||
+				     rate_table_T_max <= rate_table_T_min ) ) {
+	ostringstream ost;
+	ost << "QSSOptions::QSSOptions()\n";
+	ost << "Invalid rate table: T_min = " << rate_table_T_min << ", T_max = "
+	    << rate_table_T_max << ", points = " << rate_table_points << endl;
+	input_error(ost);
+    }
+    if ( cache_tolerance < 0.0 ) {
+	ostringstream ost;
+	ost << "QSSOptions::QSSOptions()\n";
+	ost << "cache_tolerance must not be negative." << endl;
+	input_error(ost);
+    }
+    if ( cache_size < 1 ) {
+	ostringstream ost;
+	ost << "QSSOptions::QSSOptions()\n";
+	ost << "cache_size must be at least 1." << endl;
+	input_error(ost);
+    }
+}
+
+int tabulate_QSS_rates( vector<CR_Reaction*> &reactions, Gas_data &Q, const QSSOptions &options )
+{
+    if ( options.rate_table_points==0 ) return SUCCESS;
+
+    for ( size_t ir=0; ir<reactions.size(); ++ir ) {
+	if ( reactions[ir]->tabulate_rates( Q, options.rate_table_T_min, options.rate_table_T_max,
+					    options.rate_table_points ) != SUCCESS ) {
+	    cout << "tabulate_QSS_rates()" << endl
+		 << "Failed to tabulate the rates for: " << reactions[ir]->get_equation() << endl;
+	    return FAILURE;
+	}
+    }
+
+    return SUCCESS;
+}
+
+/****************************** QSSBatchSolver *******************************/
+
+QSSBatchSolver::
+QSSBatchSolver( size_t n )
+ : n( n ), nsys( 0 )
+{
+    // Excited levels first, the ground state and population sum last
+    for ( size_t k=1; k<n; ++k ) order.push_back( k );
+    order.push_back( 0 );
+
+    // Pivots are always part of the pattern
+    pattern.resize( n*n, false );
+    for ( size_t i=0; i<n; ++i ) pattern[i*n+i] = true;
+
+    symbolic_factorisation();
+}
+
+size_t
+QSSBatchSolver::
+get_batch_size() const
+{
+    if ( is_dense() ) return 1;
+    size_t bytes = sizeof(double) * ( A_row.size() + nentries + 3*n );
+    return max( size_t(1), size_t(QSS_BATCH_MEMORY) / bytes );
+}
+
+void
+QSSBatchSolver::
+reset( size_t nsys_ )
+{
+    nsys = nsys_;
+    A_vals.assign( A_row.size()*nsys, 0.0 );
+    rhs.assign( n*nsys, 0.0 );
+    accepted.assign( nsys, false );
+
+    return;
+}
+
+void
+QSSBatchSolver::
+load_system( size_t isys, const Valmatrix &A, const vector<double> &b )
+{
+    // 1. Extend the pattern with any new non-zero entries.  The systems
+    //    already loaded are zero there, so their values carry over.
+    bool grown = false;
+    for ( size_t i=0; i<n; ++i ) {
+	for ( size_t j=0; j<n; ++j ) {
+	    if ( !pattern[i*n+j] && A.get(i,j) != 0.0 ) {
+		pattern[i*n+j] = true;
+		grown = true;
+	    }
+	}
+    }
+    if ( grown ) {
+	vector<size_t> old_row = A_row, old_col = A_col;
+	vector<double> old_vals = A_vals;
+	symbolic_factorisation();
+	vector<int> index( n*n, -1 );
+	for ( size_t e=0; e<A_row.size(); ++e ) index[A_row[e]*n+A_col[e]] = int(e);
+	A_vals.assign( A_row.size()*nsys, 0.0 );
+	for ( size_t e=0; e<old_row.size(); ++e ) {
+	    size_t ie = size_t( index[old_row[e]*n+old_col[e]] );
+	    for ( size_t s=0; s<nsys; ++s ) A_vals[ie*nsys+s] = old_vals[e*nsys+s];
+	}
+    }
+
+    // 2. Gather the values
+    for ( size_t e=0; e<A_row.size(); ++e )
+	A_vals[e*nsys+isys] = A.get( A_row[e], A_col[e] );
+    for ( size_t i=0; i<n; ++i )
+	rhs[i*nsys+isys] = b[i];
+
+    return;
+}
+
+void
+QSSBatchSolver::
+symbolic_factorisation()
+{
+    // 1. Pattern in elimination order, with the fill-in
+    vector<size_t> pos( n );
+    for ( size_t k=0; k<n; ++k ) pos[order[k]] = k;
+    vector<bool> S( n*n, false );
+    for ( size_t i=0; i<n; ++i ) {
+	for ( size_t j=0; j<n; ++j ) {
+	    if ( pattern[i*n+j] ) S[pos[i]*n+pos[j]] = true;
+	}
+    }
+    for ( size_t k=0; k<n; ++k ) {
+	for ( size_t i=k+1; i<n; ++i ) {
+	    if ( !S[i*n+k] ) continue;
+	    for ( size_t j=k+1; j<n; ++j ) {
+		if ( S[k*n+j] ) S[i*n+j] = true;
+	    }
+	}
+    }
+
+    // 2. Number the entries of the factors
+    entry.assign( n*n, -1 );
+    nentries = 0;
+    for ( size_t p=0; p<n*n; ++p ) {
+	if ( S[p] ) entry[p] = int(nentries++);
+    }
+
+    // 3. Rows below and columns right of each pivot
+    L_start.assign( n+1, 0 ); U_start.assign( n+1, 0 );
+    L_row.clear(); U_col.clear();
+    for ( size_t k=0; k<n; ++k ) {
+	L_start[k] = L_row.size();
+	U_start[k] = U_col.size();
+	for ( size_t i=k+1; i<n; ++i ) {
+	    if ( S[i*n+k] ) L_row.push_back( i );
+	    if ( S[k*n+i] ) U_col.push_back( i );
+	}
+    }
+    L_start[n] = L_row.size();
+    U_start[n] = U_col.size();
+
+    // 4. Where the gathered entries go
+    A_row.clear(); A_col.clear(); A_entry.clear();
+    for ( size_t i=0; i<n; ++i ) {
+	for ( size_t j=0; j<n; ++j ) {
+	    if ( !pattern[i*n+j] ) continue;
+	    A_row.push_back( i );
+	    A_col.push_back( j );
+	    A_entry.push_back( entry[pos[i]*n+pos[j]] );
+	}
+    }
+
+    return;
+}
+
+void
+QSSBatchSolver::
+solve()
+{
+    // 1. Scatter the gathered entries into the factor storage
+    LU.assign( nentries*nsys, 0.0 );
+    for ( size_t e=0; e<A_row.size(); ++e ) {
+	double *lu = &LU[A_entry[e]*nsys];
+	const double *a = &A_vals[e*nsys];
+	for ( size_t s=0; s<nsys; ++s ) lu[s] = a[s];
+    }
+    vector<double> y( n*nsys );
+    for ( size_t k=0; k<n; ++k ) {
+	for ( size_t s=0; s<nsys; ++s ) y[k*nsys+s] = rhs[order[k]*nsys+s];
+    }
+
+    // 2. Factorise, applying the forward substitution as we go
+    for ( size_t k=0; k<n; ++k ) {
+	const double *u_kk = &LU[entry[k*n+k]*nsys];
+	const double *y_k = &y[k*nsys];
+	for ( size_t il=L_start[k]; il<L_start[k+1]; ++il ) {
+	    size_t i = L_row[il];
+	    double *l_ik = &LU[entry[i*n+k]*nsys];
+	    for ( size_t s=0; s<nsys; ++s ) l_ik[s] /= u_kk[s];
+	    for ( size_t iu=U_start[k]; iu<U_start[k+1]; ++iu ) {
+		size_t j = U_col[iu];
+		double *a_ij = &LU[entry[i*n+j]*nsys];
+		const double *u_kj = &LU[entry[k*n+j]*nsys];
+		for ( size_t s=0; s<nsys; ++s ) a_ij[s] -= l_ik[s] * u_kj[s];
+	    }
+	    double *y_i = &y[i*nsys];
+	    for ( size_t s=0; s<nsys; ++s ) y_i[s] -= l_ik[s] * y_k[s];
+	}
+    }
+
+    // 3. Back substitution
+    for ( size_t kk=n; kk>0; --kk ) {
+	size_t k = kk - 1;
+	double *y_k = &y[k*nsys];
+	for ( size_t iu=U_start[k]; iu<U_start[k+1]; ++iu ) {
+	    size_t j = U_col[iu];
+	    const double *u_kj = &LU[entry[k*n+j]*nsys];
+	    const double *y_j = &y[j*nsys];
+	    for ( size_t s=0; s<nsys; ++s ) y_k[s] -= u_kj[s] * y_j[s];
+	}
+	const double *u_kk = &LU[entry[k*n+k]*nsys];
+	for ( size_t s=0; s<nsys; ++s ) y_k[s] /= u_kk[s];
+    }
+    x_vals.resize( n*nsys );
+    for ( size_t k=0; k<n; ++k ) {
+	for ( size_t s=0; s<nsys; ++s ) x_vals[order[k]*nsys+s] = y[k*nsys+s];
+    }
+
+    // 4. Accept finite, non-negative solutions with a small componentwise
+    //    backward error: |A x - b| <= tol ( |A| |x| + |b| ) in every row
+    vector<double> r( n*nsys ), d( n*nsys );
+    for ( size_t p=0; p<n*nsys; ++p ) {
+	r[p] = - rhs[p];
+	d[p] = fabs( rhs[p] );
+    }
+    for ( size_t e=0; e<A_row.size(); ++e ) {
+	const double *a = &A_vals[e*nsys];
+	const double *x = &x_vals[A_col[e]*nsys];
+	double *r_i = &r[A_row[e]*nsys];
+	double *d_i = &d[A_row[e]*nsys];
+	for ( size_t s=0; s<nsys; ++s ) {
+	    r_i[s] += a[s] * x[s];
+	    d_i[s] += fabs( a[s] * x[s] );
+	}
+    }
+    for ( size_t s=0; s<nsys; ++s ) {
+	bool ok = true;
+	for ( size_t i=0; i<n && ok; ++i ) {
+	    double x = x_vals[i*nsys+s];
+	    ok = isfinite(x) && x >= 0.0 &&
+		fabs( r[i*nsys+s] ) <= QSS_BACKWARD_ERROR_TOL * d[i*nsys+s];
+	}
+	accepted[s] = ok;
+    }
+
+    return;
+}
+
+bool
+QSSBatchSolver::
+get_solution( size_t isys, vector<double> &x ) const
+{
+    x.resize( n );
+    for ( size_t i=0; i<n; ++i ) x[i] = x_vals[i*nsys+isys];
+
+    return accepted[isys];
+}
+
+/**************************** QSSPopulationCache *****************************/
+
+QSSPopulationCache::
+QSSPopulationCache( double tolerance, size_t max_entries )
+ : tolerance( tolerance ), max_entries( max_entries )
+{}
+
+bool
+QSSPopulationCache::
+lookup( const Gas_data &Q, vector<double> &y ) const
+{
+    map<const Gas_data*, Entry>::const_iterator it = entries.find( &Q );
+    if ( it==entries.end() || !matches( it->second, Q ) ) return false;
+    y = it->second.y;
+
+    return true;
+}
+
+void
+QSSPopulationCache::
+store( const Gas_data &Q, const vector<double> &y )
+{
+    if ( entries.find( &Q )==entries.end() ) {
+	if ( entries.size() >= max_entries ) {
+	    entries.erase( order.front() );
+	    order.pop_front();
+	}
+	order.push_back( &Q );
+    }
+    Entry &e = entries[&Q];
+    e.T = Q.T;
+    e.massf = Q.massf;
+    e.rho = Q.rho;
+    e.p = Q.p;
+    e.p_e = Q.p_e;
+    e.y = y;
+
+    return;
+}
+
+namespace {
+    inline bool close( double a, double b, double tol )
+    { return fabs( a - b ) <= tol * fabs( b ); }
+}
+
+bool
+QSSPopulationCache::
+matches( const Entry &e, const Gas_data &Q ) const
+{
+    if ( e.T.size() != Q.T.size() || e.massf.size() != Q.massf.size() ) return false;
+    if ( !close( Q.rho, e.rho, tolerance ) || !close( Q.p, e.p, tolerance ) ||
+	 !close( Q.p_e, e.p_e, tolerance ) ) return false;
+    for ( size_t i=0; i<e.T.size(); ++i ) {
+	if ( !close( Q.T[i], e.T[i], tolerance ) ) return false;
+    }
+    for ( size_t i=0; i<e.massf.size(); ++i ) {
+	if ( !close( Q.massf[i], e.massf[i], tolerance ) ) return false;
+    }
+
+    return true;
+}
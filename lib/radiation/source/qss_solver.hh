@@ -0,0 +1,159 @@
+/** \file qss_solver.hh
+ *  \ingroup radiation
+ *
+ *  \version 19-Oct-2026: initial implementation
+ *  \brief Batched solution of the quasi-steady-state level population systems
+ *
+ **/
+
+#ifndef QSS_SOLVER_HH
+#define QSS_SOLVER_HH
+
+#include <vector>
+#include <map>
+#include <deque>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+}
+
+#include "../../gas/models/gas_data.hh"
+#include "../../nm/source/no_fuss_linear_algebra.hh"
+
+/* Default control parameters for the QSS radiators */
+#define QSS_RATE_TABLE_T_MIN   1.0e3
+#define QSS_RATE_TABLE_T_MAX   1.0e5
+#define QSS_RATE_TABLE_POINTS  256
+#define QSS_BATCH_MEMORY       33554432	// bytes of matrix storage per batch
+#define QSS_BACKWARD_ERROR_TOL 1.0e-8
+#define QSS_CACHE_SIZE         100000	// gas-states kept by the population cache
+#define QSS_BATCH_MAX_FILL     0.5	// fraction of n*n above which the factors count as dense
+
+class CR_Reaction;
+
+/// \brief Options controlling the QSS population calculations, read from the QSS_model table
+class QSSOptions {
+public:
+    QSSOptions( lua_State * L );
+
+public:
+    double rate_table_T_min;
+    double rate_table_T_max;
+    int rate_table_points;	// 0 to evaluate the rate coefficients directly
+    double cache_tolerance;	// relative change in the gas-state below which populations are reused
+    int cache_size;		// maximum number of gas-states in the population cache
+};
+
+/// \brief Tabulate the rate coefficients of the reactions as requested by the options
+int tabulate_QSS_rates( std::vector<CR_Reaction*> &reactions, Gas_data &Q, const QSSOptions &options );
+
+/// \brief LU solver for many systems that share one sparsity pattern
+///
+/// The systems are solved without pivoting in a fixed order: the excited
+/// levels first and the ground state with the population-sum equation
+/// last.  The rate matrix is diagonally dominant by columns in the excited
+/// levels, so this order needs no pivoting; solutions that fail a
+/// componentwise backward-error check are rejected so that the caller can
+/// fall back to Valmatrix::gaussian_elimination().
+///
+/// The pattern is learnt from the systems as they are loaded, and the
+/// symbolic factorisation is redone only when an entry outside the current
+/// pattern is seen.  The matrix entries are stored entry-major with the
+/// systems contiguous, so each elimination step is a loop over the batch.
+/// This only pays while the factors are sparse: once they fill in, a batch
+/// no longer fits in cache and solving the systems one at a time is faster,
+/// which is what is_dense() tells the caller.
+class QSSBatchSolver {
+public:
+    QSSBatchSolver( size_t n );
+
+public:
+    /// \brief Number of systems that fit in one batch
+    size_t get_batch_size() const;
+
+    /// \brief True if the factors of the loaded pattern are too full to batch
+    bool is_dense() const
+    { return nentries > QSS_BATCH_MAX_FILL * n * n; }
+
+    /// \brief Start a new batch of nsys systems
+    void reset( size_t nsys );
+
+    /// \brief Gather system isys from an assembled matrix and source vector
+    void load_system( size_t isys, const Valmatrix &A, const std::vector<double> &b );
+
+    /// \brief Factorise and solve all loaded systems
+    void solve();
+
+    /// \brief Copy out the solution of system isys, returning false if it was rejected
+    bool get_solution( size_t isys, std::vector<double> &x ) const;
+
+private:
+    void symbolic_factorisation();
+
+private:
+    size_t n;
+    size_t nsys;
+
+    // Elimination order: the equation/unknown eliminated at step k
+    std::vector<size_t> order;
+    // Structural pattern of the loaded matrices, in original indices
+    std::vector<bool> pattern;
+    // Entry index of (i,j) in elimination-ordered indices, -1 if structurally zero
+    std::vector<int> entry;
+    size_t nentries;
+    // The pattern entries, in the order they are gathered
+    std::vector<size_t> A_row, A_col;
+    std::vector<int> A_entry;
+    // For each step k: the entries (i,k) below and (k,j) right of the pivot
+    std::vector<size_t> L_start, U_start;
+    std::vector<size_t> L_row, U_col;
+
+    std::vector<double> A_vals;		// [pattern entry][system]
+    std::vector<double> LU;		// [entry][system]
+    std::vector<double> rhs;		// [row][system]
+    std::vector<double> x_vals;		// [unknown][system]
+    std::vector<bool> accepted;
+};
+
+/// \brief Level populations stored for a set of gas-states
+///
+/// Entries are keyed by the address of the gas-state and are reused
+/// while the state is within the relative tolerance of the one that
+/// produced them.  Callers may hand over copies of their gas-states
+/// at new addresses, so once max_entries states are held the oldest
+/// entry is dropped for each new one.
+class QSSPopulationCache {
+public:
+    QSSPopulationCache( double tolerance, size_t max_entries );
+
+public:
+    double get_tolerance() const
+    { return tolerance; }
+
+    /// \brief Find populations for Q, returning false if there are none valid
+    bool lookup( const Gas_data &Q, std::vector<double> &y ) const;
+
+    void store( const Gas_data &Q, const std::vector<double> &y );
+
+    void clear()
+    { entries.clear(); order.clear(); }
+
+private:
+    struct Entry {
+	std::vector<double> T;
+	std::vector<double> massf;
+	double rho, p, p_e;
+	std::vector<double> y;
+    };
+    bool matches( const Entry &e, const Gas_data &Q ) const;
+
+private:
+    double tolerance;
+    size_t max_entries;
+    std::map<const Gas_data*, Entry> entries;
+    std::deque<const Gas_data*> order;	// keys, oldest first
+};
+
+#endif
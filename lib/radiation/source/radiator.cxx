@@ -153,6 +153,13 @@ Radiator::eval_translational_partition_function_from_T( double T )
     return pow( 2.0 * M_PI * m_w / RC_Na * RC_k_SI * T / RC_h_SI / RC_h_SI, 1.5 );
 }
 
+void
+Radiator::prepare_n_e( vector<Gas_data*> &Q )
+{
+    // Radiators that find their populations directly have nothing to prepare
+    UNUSED_VARIABLE(Q);
+}
+
 void
 Radiator::read_photoionization_data( lua_State * L )
 {
@@ -152,6 +152,10 @@ public:
     void calc_elec_pops(Gas_data &Q)
     { calculate_n_e(Q); }
     
+    /// \brief Prepare the electronic state number densities for a set of gas-states
+    void prep_elec_pops( std::vector<Gas_data*> &Q )
+    { prepare_n_e(Q); }
+    
     /// \brief Calculate and store the spectrum for this radiator
     void calc_spectrum( Gas_data &Q, CoeffSpectra &X )
     { calculate_spectrum( Q, X ); }
@@ -211,6 +215,10 @@ protected:
 
     /// \brief Calculate and store electronic state number densities
     virtual void calculate_n_e(Gas_data &Q) = 0;
+    
+    /// \brief Precompute electronic state number densities for a set of gas-states
+    ///        so that calculate_n_e() can look them up (optional)
+    virtual void prepare_n_e( std::vector<Gas_data*> &Q );
 
     /// \brief Calculate the total equilibrium partition function for this radiator
     virtual double calculate_total_equil_partition_function( double T ) = 0;
@@ -143,10 +143,11 @@ write_data_to_file( string fname, int spectral_units,
 
 /* ------------ CoeffSpectra class ------------ */
 
-CoeffSpectra::CoeffSpectra() {}
+CoeffSpectra::CoeffSpectra()
+ : bound_grid( 0 ), bound_grid_version( 0 ) {}
 
 CoeffSpectra::CoeffSpectra( RadiationSpectralModel * rsm )
- : SpectralContainer( rsm )
+ : SpectralContainer( rsm ), bound_grid( 0 ), bound_grid_version( 0 )
 {
     j_nu.resize( nu.size(), 0.0 );
     kappa_nu.resize( nu.size(), 0.0 );
@@ -154,6 +155,7 @@ CoeffSpectra::CoeffSpectra( RadiationSpectralModel * rsm )
 }
 
 CoeffSpectra::CoeffSpectra( CoeffSpectra * X )
+ : bound_grid( 0 ), bound_grid_version( 0 )
 {
     // FIXME: use C++ vector copying functions here
     nu.resize( X->nu.size() );
@@ -195,6 +197,7 @@ CoeffSpectra * CoeffSpectra::clone()
 
 void CoeffSpectra::clear_data()
 {
+    unbind_grid();
     nu.clear();
     j_nu.clear();
     kappa_nu.clear();
@@ -548,6 +551,57 @@ void CoeffSpectra::apply_apparatus_function( ApparatusFunction * A  )
     	    j_int[inu] = 0.5 * ( j_nu[inu] + j_nu[inu-1] ) * ( nu[inu] - nu[inu-1] );
     }
 
+    // The grid has been resampled
+    unbind_grid();
+
+    return;
+}
+
+void CoeffSpectra::bind_to_grid( const vector<double> &nu_grid, int grid_version )
+{
+    size_t nnu = nu_grid.size();
+    
+    if ( bound_grid==&nu_grid && bound_grid_version==grid_version &&
+         nu.size()==nnu && j_nu.size()==nnu && kappa_nu.size()==nnu ) {
+    	// Same grid: clear only the blocks that were written
+	for ( size_t ib=0; ib<active_blocks.size(); ++ib ) {
+	    if ( !active_blocks[ib] ) continue;
+	    size_t inu_start = ib * SPECTRAL_BLOCK_SIZE;
+	    size_t inu_end = min( inu_start + SPECTRAL_BLOCK_SIZE, nnu );
+	    fill( j_nu.begin() + inu_start, j_nu.begin() + inu_end, 0.0 );
+	    fill( kappa_nu.begin() + inu_start, kappa_nu.begin() + inu_end, 0.0 );
+	    active_blocks[ib] = 0;
+	}
+    }
+    else {
+	nu.assign( nu_grid.begin(), nu_grid.end() );
+	j_nu.assign( nnu, 0.0 );
+	kappa_nu.assign( nnu, 0.0 );
+	active_blocks.assign( ( nnu + SPECTRAL_BLOCK_SIZE - 1 ) / SPECTRAL_BLOCK_SIZE, 0 );
+	bound_grid = &nu_grid;
+	bound_grid_version = grid_version;
+    }
+    
+    return;
+}
+
+void CoeffSpectra::declare_active_range( int inu_start, int inu_end )
+{
+    // Nothing to record unless bound to a grid
+    if ( bound_grid==0 || inu_start>=inu_end ) return;
+    
+    int ib_end = min( ( inu_end - 1 ) / SPECTRAL_BLOCK_SIZE + 1, int(active_blocks.size()) );
+    for ( int ib=max( inu_start, 0 ) / SPECTRAL_BLOCK_SIZE; ib<ib_end; ++ib )
+    	active_blocks[ib] = 1;
+    
+    return;
+}
+
+void CoeffSpectra::unbind_grid()
+{
+    bound_grid = 0;
+    active_blocks.clear();
+    
     return;
 }
 
@@ -21,6 +21,8 @@
 
 #define NWIDTHS    10
 
+#define SPECTRAL_BLOCK_SIZE 256	// spectral points per block when tracking the active parts of a spectrum
+
 // Forward declaration of RadiationSpectralModel
 class RadiationSpectralModel;
 
@@ -119,6 +121,25 @@ public:
 
     /// \brief Apply an apparatus (smearing) function to the spectra
     void apply_apparatus_function( ApparatusFunction * A );
+    
+    /// \brief Set the spectra to zero on the given fixed grid
+    /// 
+    /// If the spectra are already on this grid (same vector and version)
+    /// only the blocks declared active since the last call are cleared,
+    /// otherwise the grid is copied and the spectra are zeroed in full.
+    void bind_to_grid( const std::vector<double> &nu_grid, int grid_version );
+    
+    /// \brief Declare that j_nu and kappa_nu will be accumulated over [inu_start,inu_end)
+    void declare_active_range( int inu_start, int inu_end );
+    
+    /// \brief Forget the grid so that the next bind_to_grid() starts afresh
+    void unbind_grid();
+
+private:
+    /* The grid these spectra are bound to, and the blocks that have been written */
+    const std::vector<double> * bound_grid;
+    int bound_grid_version;
+    std::vector<char> active_blocks;
 };
 
 #define NO_BINNING        0
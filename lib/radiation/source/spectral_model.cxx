@@ -253,6 +253,14 @@ write_QSS_analysis_files( Gas_data &Q, int index )
     exit( FAILURE );
 }
 
+void
+RadiationSpectralModel::
+prep_level_pops( vector<Gas_data*> &Q )
+{
+    // Only a hint, so models without level population solvers ignore it
+    UNUSED_VARIABLE(Q);
+}
+
 RadiationSpectralModel * create_radiation_spectral_model( const string input_file )
 {
     // 0. Create a Radiation_spectral_model pointer
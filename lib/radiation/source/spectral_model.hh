@@ -77,6 +77,11 @@ public:
     
     void write_QSS_population_analysis_files( Gas_data &Q, int index )
     { return write_QSS_analysis_files( Q, index ); }
+    
+    /// \brief Solve for the level populations of a set of gas-states together,
+    ///        ahead of calls for the individual states
+    void prepare_level_populations( std::vector<Gas_data*> &Q )
+    { return prep_level_pops( Q ); }
 
 protected:
     virtual double integrated_emission_for_gas_state( Gas_data &Q, bool spectrally_resolved ) = 0;
@@ -95,6 +100,8 @@ protected:
     
     virtual void write_QSS_analysis_files( Gas_data &Q, int index );
     
+    virtual void prep_level_pops( std::vector<Gas_data*> &Q );
+    
 protected:
     double lambda_min, lambda_min_star;
     double lambda_max, lambda_max_star;
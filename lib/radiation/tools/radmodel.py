@@ -47,6 +47,9 @@ class GlobalRadData(object):
         self.binning = "none"
         self.N_bins = 0
         self.exact_formulation = False
+        self.emission_surrogate = False
+        self.surrogate_T_points = 100
+        self.surrogate_tolerance = 0.05
 	self.parade_population = "none"
 
         return
@@ -125,6 +128,10 @@ class GlobalRadData(object):
             ofile.write(tab+"upper_escape_factor = %f,\n" % self.upper_escape_factor )
         elif self.transport_model=="tangent slab":
             ofile.write(tab+"exact_formulation = %s,\n" % str(self.exact_formulation).lower() )
+        elif self.transport_model=="optically thin":
+            ofile.write(tab+"emission_surrogate = %s,\n" % str(bool(self.emission_surrogate)).lower() )
+            ofile.write(tab+"surrogate_T_points = %d,\n" % self.surrogate_T_points )
+            ofile.write(tab+"surrogate_tolerance = %e,\n" % self.surrogate_tolerance )
         ofile.write("}\n\n")
             # radiator data
         for rad in self.radiators:
@@ -195,6 +195,11 @@ class AtomicQSSModel(object):
             self.comments = "# Description of the atomic QSS model"
             self.inc_eq_elevs = 1
             self.T_lower = 4000.0
+            self.rate_table_T_min = 1.0e3
+            self.rate_table_T_max = 1.0e5
+            self.rate_table_points = 256
+            self.cache_tolerance = 0.0
+            self.cache_size = 100000
             
     def get_LUA_string(self, aname, special = ""):
         ostring  = ""
@@ -204,6 +209,11 @@ class AtomicQSSModel(object):
         ostring += tab+"noneq_elevs = { %s },\n" % ( self.noneq_elevs )
         ostring += tab+"inc_eq_elevs = %d,\n" % ( self.inc_eq_elevs )
         ostring += tab+"T_lower = %e,\n" % ( self.T_lower )
+        ostring += tab+"rate_table_T_min = %e,\n" % ( self.rate_table_T_min )
+        ostring += tab+"rate_table_T_max = %e,\n" % ( self.rate_table_T_max )
+        ostring += tab+"rate_table_points = %d,\n" % ( self.rate_table_points )
+        ostring += tab+"cache_tolerance = %e,\n" % ( self.cache_tolerance )
+        ostring += tab+"cache_size = %d,\n" % ( self.cache_size )
         ostring += tab+"electron_impact_excitation = '%s',\n" % ( self.eie_model )
         ostring += tab+"electron_impact_ionization = '%s',\n" % ( self.eii_model )
         ostring += tab+"radiative_transitions = '%s',\n" % ( self.rt_model )
@@ -222,6 +232,11 @@ class DiatomicQSSModel(object):
             self.comments = "# Description of the diatomic QSS model"
             self.inc_eq_elevs = 1
             self.T_lower = 4000.0
+            self.rate_table_T_min = 1.0e3
+            self.rate_table_T_max = 1.0e5
+            self.rate_table_points = 256
+            self.cache_tolerance = 0.0
+            self.cache_size = 100000
             
     def get_LUA_string(self, mname):
         ostring  = ""
@@ -232,6 +247,11 @@ class DiatomicQSSModel(object):
         ostring += tab+"noneq_elev_labels = { %s },\n" % ( self.noneq_elev_labels )
         ostring += tab+"inc_eq_elevs = %d,\n" % ( self.inc_eq_elevs )
         ostring += tab+"T_lower = %e,\n" % ( self.T_lower )
+        ostring += tab+"rate_table_T_min = %e,\n" % ( self.rate_table_T_min )
+        ostring += tab+"rate_table_T_max = %e,\n" % ( self.rate_table_T_max )
+        ostring += tab+"rate_table_points = %d,\n" % ( self.rate_table_points )
+        ostring += tab+"cache_tolerance = %e,\n" % ( self.cache_tolerance )
+        ostring += tab+"cache_size = %d,\n" % ( self.cache_size )
         ostring += tab+"reactions = {\n"
         for reaction in self.reactions:
             ostring += tab*2+"{\n"
@@ -3,6 +3,7 @@
  *  \author RJG
  *  \version 12-Feb-06
  *  \version 30-Jun-08 PJ zero-length and multiword strings handled; boolean values also.
+ *  \version 18-Oct-26 may also be constructed from text already in memory.
  **/
 
 #include <fstream>
@@ -32,7 +33,21 @@ ConfigParser::ConfigParser( string fname )
 	     << "No configuration information has been read!" << endl;
 	throw runtime_error("File not found.");
     }
-    
+    parse_stream( infile );
+}
+
+// Constructor for text that has already been read, perhaps by another process.
+// fname is kept only to identify the source of the text.
+ConfigParser::ConfigParser( string fname, const string &text )
+    : file_name( fname )
+{
+    istringstream instream( text );
+    parse_stream( instream );
+}
+
+// Fill the config_map from the lines of an INI file.
+void ConfigParser::parse_stream( istream &infile )
+{
     string line, buffer, key_name;
     string hash_sign( "#" );
     string open_brace( "[" );
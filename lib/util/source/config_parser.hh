@@ -22,6 +22,7 @@ public:
 
     // Constructors
     ConfigParser( string fname );
+    ConfigParser( string fname, const string &text );
 
     // Destructors
     virtual ~ConfigParser();
@@ -57,6 +58,8 @@ public:
 
     bool has_section_and_key( const string section, const string key );
 
+private:
+    void parse_stream( istream &infile );
 };
 
 ostream& operator<<( ostream &os, const ConfigParser &cfg );